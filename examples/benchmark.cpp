@@ -7,9 +7,15 @@
 #define LOG_LEVEL LOG_LEVEL_INFO
 #endif
 #include "bench_utils.hpp"
+#include "buffer_pool.hpp"
 #include "example_types.hpp"
 #include "log_macro.hpp"
 
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
 #include <cmath>
 
 #include <algorithm>
@@ -17,8 +23,16 @@
 #include <chrono>
 #include <iomanip>
 #include <iostream>
+#include <mccc/bus_recorder.hpp>
 #include <mccc/component.hpp>
+#include <mccc/lane_bus.hpp>
+#include <mccc/shm_bus.hpp>
+#include <mccc/timer_wheel.hpp>
+#include <mccc/udp_bridge.hpp>
+#include <memory>
 #include <numeric>
+#include <shared_mutex>
+#include <string>
 #include <thread>
 #include <vector>
 
@@ -252,6 +266,1190 @@ void run_performance_mode_comparison(uint32_t message_count, uint32_t rounds) {
   ExampleBus::Instance().SetPerformanceMode(ExampleBus::PerformanceMode::FULL_FEATURED);
 }
 
+/**
+ * One-way latency across a process boundary through ShmBus: a forked
+ * producer publishes probes carrying its SteadyClock time, the busy-polling
+ * consumer measures receive time minus probe time.
+ */
+void run_shm_latency_test(uint32_t samples) {
+  LOG_INFO("");
+  LOG_INFO("========== Shared-Memory IPC Latency (%u samples) ==========", samples);
+
+  struct ShmProbe {
+    uint64_t publish_ns;
+  };
+  using ProbeBus = ShmBus<std::variant<ShmProbe>, 1024U>;
+  const std::string name = "/mccc_bench_" + std::to_string(getpid());
+  auto consumer = std::make_unique<ProbeBus>();
+  if (consumer->Create(name.c_str()) != ShmError::OK) {
+    LOG_INFO("[SHM Latency] shm_open failed, skipped");
+    return;
+  }
+
+  std::vector<double> latencies;
+  latencies.reserve(samples);
+  consumer->Subscribe<ShmProbe>([&latencies](const ProbeBus::EnvelopeType& env) {
+    latencies.push_back(static_cast<double>(SteadyClock::NowNs() - std::get<ShmProbe>(env.payload).publish_ns));
+  });
+
+  const pid_t pid = fork();
+  if (pid == 0) {
+    ProbeBus producer;
+    if (producer.Attach(name.c_str()) != ShmError::OK) {
+      _exit(1);
+    }
+    for (uint32_t i = 0U; i < samples; ++i) {
+      while (producer.QueueDepth() > 0U) {
+        std::this_thread::yield();  // one probe in flight at a time
+      }
+      (void)producer.Publish(ShmProbe{SteadyClock::NowNs()}, 1U);
+    }
+    _exit(0);
+  }
+
+  while (latencies.size() < samples) {
+    if (consumer->ProcessBatch() == 0U) {
+      std::this_thread::yield();
+    }
+  }
+  int status = 0;
+  (void)waitpid(pid, &status, 0);
+
+  Statistics stats = calculate_statistics(latencies);
+  LOG_INFO("[SHM Latency] Mean=%.2f StdDev=%.2f P50=%.2f P95=%.2f P99=%.2f Max=%.2f ns", stats.mean, stats.std_dev,
+           stats.p50, stats.p95, stats.p99, stats.max_val);
+}
+
+/**
+ * Cross-node forwarding cost on the sending side over loopback UDP: a
+ * subscriber calling sendto() per message versus UdpBridge packing records
+ * into MTU-sized datagrams sent with sendmmsg(). The receiving socket is
+ * not drained; only the forwarding path is timed.
+ */
+void run_udp_bridge_comparison(uint32_t message_count) {
+  LOG_INFO("");
+  LOG_INFO("========== UDP Forwarding: sendto per Message vs UdpBridge ==========");
+
+  using NetBus = AsyncBus<ExamplePayload, 8192U>;
+  using Bridge = UdpBridge<ExamplePayload, NetBus>;
+  constexpr uint32_t kBatch = 4096U;
+
+  const int sink_fd = socket(AF_INET, SOCK_DGRAM, 0);
+  sockaddr_in sink{};
+  sink.sin_family = AF_INET;
+  sink.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  socklen_t sink_len = sizeof(sink);
+  if ((sink_fd < 0) || (bind(sink_fd, reinterpret_cast<sockaddr*>(&sink), sizeof(sink)) != 0) ||
+      (getsockname(sink_fd, reinterpret_cast<sockaddr*>(&sink), &sink_len) != 0)) {
+    LOG_INFO("[UDP] loopback socket unavailable, skipped");
+    return;
+  }
+
+  auto run = [message_count](NetBus& bus, auto&& after_batch) {
+    auto t0 = high_resolution_clock::now();
+    for (uint32_t done = 0U; done < message_count; done += kBatch) {
+      for (uint32_t i = 0U; i < kBatch; ++i) {
+        bus.PublishFast(MotionData(1.0f, 2.0f, 3.0f, 4.0f), 1U, 0U);
+      }
+      while (bus.ProcessBatch() > 0U) {}
+      after_batch();
+    }
+    auto t1 = high_resolution_clock::now();
+    return static_cast<double>(duration_cast<nanoseconds>(t1 - t0).count());
+  };
+
+  // Baseline: one syscall per message
+  auto naive_bus = std::make_unique<NetBus>();
+  naive_bus->SetPerformanceMode(NetBus::PerformanceMode::NO_STATS);
+  const int tx_fd = socket(AF_INET, SOCK_DGRAM, 0);
+  uint64_t syscalls = 0U;
+  naive_bus->Subscribe<MotionData>([tx_fd, &sink, &syscalls](const ExampleEnvelope& env) {
+    const MotionData& m = std::get<MotionData>(env.payload);
+    (void)sendto(tx_fd, &m, sizeof(m), 0, reinterpret_cast<const sockaddr*>(&sink), sizeof(sink));
+    ++syscalls;
+  });
+  const double naive_ns = run(*naive_bus, []() {});
+  (void)close(tx_fd);
+
+  // UdpBridge: coalesced datagrams, sendmmsg
+  auto bridge_bus = std::make_unique<NetBus>();
+  bridge_bus->SetPerformanceMode(NetBus::PerformanceMode::NO_STATS);
+  auto bridge = std::make_shared<Bridge>(*bridge_bus);
+  UdpBridgeConfig cfg;
+  cfg.bind_address = "127.0.0.1";
+  cfg.remote_address = "127.0.0.1";
+  cfg.remote_port = ntohs(sink.sin_port);
+  if (!bridge->Open(cfg) || !bridge->Forward<MotionData>()) {
+    LOG_INFO("[UDP] bridge open failed, skipped");
+    (void)close(sink_fd);
+    return;
+  }
+  const double bridge_ns = run(*bridge_bus, [&bridge]() { (void)bridge->Flush(); });
+  const BridgeStatistics& stats = bridge->GetStatistics();
+  (void)close(sink_fd);
+
+  const double n = static_cast<double>(message_count);
+  LOG_INFO("sendto per message: %.2f M msg/s (%lu syscalls)", n * 1000.0 / naive_ns,
+           static_cast<unsigned long>(syscalls));
+  LOG_INFO("UdpBridge:          %.2f M msg/s (%lu datagrams, %lu syscalls)", n * 1000.0 / bridge_ns,
+           static_cast<unsigned long>(stats.datagrams_sent), static_cast<unsigned long>(stats.send_syscalls));
+}
+
+/**
+ * Per-message dispatch cost of ProcessBatch, measured on an owned bus with no
+ * concurrent producer. "shared_lock" adds one reader lock per message inside
+ * the callback, which is what the previous mutex-guarded callback table paid
+ * on every dispatch; "snapshot" is the current lock-free table read.
+ */
+void run_dispatch_cost_comparison(uint32_t rounds) {
+  LOG_INFO("");
+  LOG_INFO("========== Callback Dispatch Cost ==========");
+
+  using DispatchBus = AsyncBus<ExamplePayload, 8192U>;
+  constexpr uint32_t kBatch = 4096U;
+  auto bus = std::make_unique<DispatchBus>();
+  bus->SetPerformanceMode(DispatchBus::PerformanceMode::NO_STATS);
+
+  std::shared_mutex legacy_mutex;
+  uint64_t sink = 0U;
+
+  auto measure = [&bus](uint32_t n_rounds) {
+    std::vector<double> ns_per_msg;
+    for (uint32_t r = 0U; r < n_rounds; ++r) {
+      for (uint32_t i = 0U; i < kBatch; ++i) {
+        bus->PublishFast(MotionData(1.0f, 2.0f, 3.0f, 4.0f), 1U, 0U);
+      }
+      auto t0 = high_resolution_clock::now();
+      uint32_t processed = 0U;
+      while (processed < kBatch) {
+        processed += bus->ProcessBatch();
+      }
+      auto t1 = high_resolution_clock::now();
+      ns_per_msg.push_back(static_cast<double>(duration_cast<nanoseconds>(t1 - t0).count()) / kBatch);
+    }
+    return calculate_statistics(ns_per_msg);
+  };
+
+  auto legacy = bus->Subscribe<MotionData>([&legacy_mutex, &sink](const ExampleEnvelope& env) {
+    std::shared_lock<std::shared_mutex> lock(legacy_mutex);
+    sink += env.header.msg_id;
+  });
+  (void)measure(config::WARMUP_ROUNDS);  // touch the ring before timing
+  Statistics locked = measure(rounds);
+  bus->Unsubscribe(legacy);
+
+  auto snapshot = bus->Subscribe<MotionData>([&sink](const ExampleEnvelope& env) { sink += env.header.msg_id; });
+  Statistics lock_free = measure(rounds);
+  bus->Unsubscribe(snapshot);
+
+  LOG_INFO("shared_lock per message: %.2f +/- %.2f ns/msg", locked.mean, locked.std_dev);
+  LOG_INFO("snapshot table:          %.2f +/- %.2f ns/msg", lock_free.mean, lock_free.std_dev);
+  LOG_INFO("Saved: %.2f ns/msg (checksum %lu)", locked.mean - lock_free.mean, static_cast<unsigned long>(sink));
+}
+
+/**
+ * High fan-out dispatch: MCCC_MAX_CALLBACKS_PER_TYPE callbacks on one type,
+ * each interested in a single sender. "callback filter" checks sender_id
+ * inside every callback; "subscribe filter" registers SubscriptionFilter::
+ * Sender() so the bus visits only the matching callback.
+ */
+void run_filter_fanout_comparison(uint32_t rounds) {
+  LOG_INFO("");
+  LOG_INFO("========== Filtered Fan-out: In-callback vs Subscribe Filter ==========");
+
+  using FanoutBus = AsyncBus<ExamplePayload, 8192U>;
+  constexpr uint32_t kBatch = 4096U;
+  constexpr uint32_t kSubscribers = MCCC_MAX_CALLBACKS_PER_TYPE;
+  auto bus = std::make_unique<FanoutBus>();
+  bus->SetPerformanceMode(FanoutBus::PerformanceMode::NO_STATS);
+  uint64_t sink = 0U;
+
+  auto measure = [&bus](uint32_t n_rounds) {
+    std::vector<double> ns_per_msg;
+    for (uint32_t r = 0U; r < n_rounds; ++r) {
+      for (uint32_t i = 0U; i < kBatch; ++i) {
+        bus->PublishFast(MotionData(1.0f, 2.0f, 3.0f, 4.0f), i % kSubscribers, 0U);
+      }
+      auto t0 = high_resolution_clock::now();
+      uint32_t processed = 0U;
+      while (processed < kBatch) {
+        processed += bus->ProcessBatch();
+      }
+      auto t1 = high_resolution_clock::now();
+      ns_per_msg.push_back(static_cast<double>(duration_cast<nanoseconds>(t1 - t0).count()) / kBatch);
+    }
+    return calculate_statistics(ns_per_msg);
+  };
+
+  std::vector<SubscriptionHandle> handles;
+  for (uint32_t id = 0U; id < kSubscribers; ++id) {
+    handles.push_back(bus->Subscribe<MotionData>([&sink, id](const ExampleEnvelope& env) {
+      if (env.header.sender_id == id) {
+        sink += env.header.msg_id;
+      }
+    }));
+  }
+  (void)measure(config::WARMUP_ROUNDS);
+  Statistics in_callback = measure(rounds);
+  for (const auto& h : handles) {
+    bus->Unsubscribe(h);
+  }
+
+  handles.clear();
+  for (uint32_t id = 0U; id < kSubscribers; ++id) {
+    handles.push_back(bus->Subscribe<MotionData>(SubscriptionFilter::Sender(id),
+                                                 [&sink](const ExampleEnvelope& env) { sink += env.header.msg_id; }));
+  }
+  Statistics indexed = measure(rounds);
+  for (const auto& h : handles) {
+    bus->Unsubscribe(h);
+  }
+
+  LOG_INFO("callback filter (%u subscribers):  %.2f +/- %.2f ns/msg", kSubscribers, in_callback.mean,
+           in_callback.std_dev);
+  LOG_INFO("subscribe filter (%u subscribers): %.2f +/- %.2f ns/msg", kSubscribers, indexed.mean, indexed.std_dev);
+  LOG_INFO("Saved: %.2f ns/msg (checksum %lu)", in_callback.mean - indexed.mean, static_cast<unsigned long>(sink));
+}
+
+/**
+ * DMABufferPool borrow/return cost: every call on the shard free list (one
+ * CAS each way) versus the per-thread magazine. Each thread keeps a small
+ * working set in flight, like a pipeline stage holding a few frames.
+ */
+void run_buffer_pool_comparison(uint32_t rounds) {
+  LOG_INFO("");
+  LOG_INFO("========== DMABufferPool: Shard CAS vs Thread Magazine ==========");
+
+  constexpr uint32_t kOps = 200000U;
+  constexpr uint32_t kInFlight = 4U;
+  constexpr uint32_t kThreads = 4U;
+
+  auto measure = [](bool thread_cache, uint32_t n_threads, uint32_t n_rounds) {
+    streaming::BufferPoolOptions options;
+    options.thread_cache = thread_cache;
+    streaming::DMABufferPool pool(256U, 4096U, options);
+    std::vector<double> ns_per_op;
+    for (uint32_t r = 0U; r < n_rounds; ++r) {
+      auto t0 = high_resolution_clock::now();
+      std::vector<std::thread> threads;
+      for (uint32_t t = 0U; t < n_threads; ++t) {
+        threads.emplace_back([&pool, t]() {
+          (void)pool.BindThreadToShard(t % pool.ShardCount());
+          streaming::DataToken held[kInFlight];
+          for (uint32_t i = 0U; i < kOps; ++i) {
+            held[i % kInFlight] = pool.Borrow();  // returns the previous occupant
+          }
+        });
+      }
+      for (auto& th : threads) {
+        th.join();
+      }
+      auto t1 = high_resolution_clock::now();
+      ns_per_op.push_back(static_cast<double>(duration_cast<nanoseconds>(t1 - t0).count()) / (kOps * n_threads));
+    }
+    return calculate_statistics(ns_per_op);
+  };
+
+  (void)measure(true, 1U, config::WARMUP_ROUNDS);
+  Statistics shard_1 = measure(false, 1U, rounds);
+  Statistics magazine_1 = measure(true, 1U, rounds);
+  Statistics shard_n = measure(false, kThreads, rounds);
+  Statistics magazine_n = measure(true, kThreads, rounds);
+
+  LOG_INFO("shard CAS, 1 thread:           %.2f +/- %.2f ns/pair", shard_1.mean, shard_1.std_dev);
+  LOG_INFO("thread magazine, 1 thread:     %.2f +/- %.2f ns/pair", magazine_1.mean, magazine_1.std_dev);
+  LOG_INFO("shard CAS, %u threads:         %.2f +/- %.2f ns/pair", kThreads, shard_n.mean, shard_n.std_dev);
+  LOG_INFO("thread magazine, %u threads:   %.2f +/- %.2f ns/pair", kThreads, magazine_n.mean, magazine_n.std_dev);
+}
+
+/**
+ * DMABufferPool layout: 10K x 4 KiB per-buffer allocations versus one slab,
+ * with and without huge pages. Construction includes faulting every page in
+ * (malloc headers touch each buffer's page; the slab prefaults explicitly).
+ */
+void run_buffer_pool_slab_comparison(uint32_t rounds) {
+  LOG_INFO("");
+  LOG_INFO("========== DMABufferPool: Per-buffer Heap vs Slab ==========");
+
+  constexpr uint32_t kBuffers = 10000U;
+  constexpr uint32_t kBufferSize = 4096U;
+
+  auto measure = [](bool slab, bool huge_pages, uint32_t n_rounds) {
+    std::vector<double> ctor_us;
+    for (uint32_t r = 0U; r < n_rounds; ++r) {
+      streaming::BufferPoolOptions options;
+      options.slab = slab;
+      options.huge_pages = huge_pages;
+      auto t0 = high_resolution_clock::now();
+      streaming::DMABufferPool pool(kBufferSize, kBuffers, options);
+      auto t1 = high_resolution_clock::now();
+      ctor_us.push_back(static_cast<double>(duration_cast<nanoseconds>(t1 - t0).count()) / 1000.0);
+    }
+    return calculate_statistics(ctor_us);
+  };
+
+  (void)measure(true, false, config::WARMUP_ROUNDS);
+  Statistics heap = measure(false, false, rounds);
+  Statistics slab = measure(true, false, rounds);
+  Statistics huge = measure(true, true, rounds);
+
+  LOG_INFO("per-buffer heap:    construct %.1f +/- %.1f us", heap.mean, heap.std_dev);
+  LOG_INFO("slab (4 KiB pages): construct %.1f +/- %.1f us", slab.mean, slab.std_dev);
+  LOG_INFO("slab (huge pages):  construct %.1f +/- %.1f us", huge.mean, huge.std_dev);
+}
+
+/**
+ * One-frame fan-out to three consumers: TokenRef (std::shared_ptr<DataToken>,
+ * one heap control block per frame) versus SharedDataToken (refcount in the
+ * pool's per-buffer metadata). Each iteration borrows, makes three copies and
+ * drops them all.
+ */
+void run_shared_token_comparison(uint32_t rounds) {
+  LOG_INFO("");
+  LOG_INFO("========== Frame Fan-out: TokenRef vs SharedDataToken ==========");
+
+  constexpr uint32_t kFrames = 200000U;
+  streaming::DMABufferPool pool(4096U, 64U);
+  uint64_t sink = 0U;
+
+  auto measure = [&pool, &sink](bool shared, uint32_t n_rounds) {
+    std::vector<double> ns_per_frame;
+    for (uint32_t r = 0U; r < n_rounds; ++r) {
+      auto t0 = high_resolution_clock::now();
+      for (uint32_t i = 0U; i < kFrames; ++i) {
+        if (shared) {
+          streaming::SharedDataToken frame = pool.BorrowShared();
+          streaming::SharedDataToken a = frame;
+          streaming::SharedDataToken b = frame;
+          streaming::SharedDataToken c = frame;
+          sink += a.size() + b.size() + c.size();
+        } else {
+          streaming::TokenRef frame = std::make_shared<streaming::DataToken>(pool.Borrow());
+          streaming::TokenRef a = frame;
+          streaming::TokenRef b = frame;
+          streaming::TokenRef c = frame;
+          sink += a->size() + b->size() + c->size();
+        }
+      }
+      auto t1 = high_resolution_clock::now();
+      ns_per_frame.push_back(static_cast<double>(duration_cast<nanoseconds>(t1 - t0).count()) / kFrames);
+    }
+    return calculate_statistics(ns_per_frame);
+  };
+
+  (void)measure(true, config::WARMUP_ROUNDS);
+  Statistics token_ref = measure(false, rounds);
+  Statistics shared = measure(true, rounds);
+
+  LOG_INFO("TokenRef (shared_ptr):  %.2f +/- %.2f ns/frame", token_ref.mean, token_ref.std_dev);
+  LOG_INFO("SharedDataToken:        %.2f +/- %.2f ns/frame (checksum %lu)", shared.mean, shared.std_dev,
+           static_cast<unsigned long>(sink));
+}
+
+/**
+ * Publish producers x per_producer messages from concurrent threads while this
+ * thread drains the bus. make_publisher(bus) runs once in each producer thread
+ * and returns its publish callable. Returns throughput in M msg/s.
+ */
+template <typename BusT, typename MakePublisher>
+double measure_multi_producer(BusT& bus, uint32_t producers, uint32_t per_producer, MakePublisher make_publisher) {
+  std::atomic<uint32_t> ready{0U};
+  std::atomic<bool> go{false};
+  std::vector<std::thread> threads;
+  for (uint32_t t = 0U; t < producers; ++t) {
+    threads.emplace_back([&bus, &ready, &go, &make_publisher, per_producer]() {
+      auto publish = make_publisher(bus);
+      ready.fetch_add(1U, std::memory_order_release);
+      while (!go.load(std::memory_order_acquire)) {
+        std::this_thread::yield();
+      }
+      for (uint32_t i = 0U; i < per_producer; ++i) {
+        while (!publish(MotionData(1.0f, 2.0f, 3.0f, static_cast<float>(i)))) {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+  while (ready.load(std::memory_order_acquire) < producers) {
+    std::this_thread::yield();
+  }
+
+  const uint64_t total = static_cast<uint64_t>(producers) * per_producer;
+  uint64_t processed = 0U;
+  auto t0 = high_resolution_clock::now();
+  go.store(true, std::memory_order_release);
+  while (processed < total) {
+    const uint32_t n = bus.ProcessBatch();
+    if (n == 0U) {
+      std::this_thread::yield();
+    }
+    processed += n;
+  }
+  auto t1 = high_resolution_clock::now();
+  for (auto& t : threads) {
+    t.join();
+  }
+  return static_cast<double>(total) / static_cast<double>(duration_cast<microseconds>(t1 - t0).count());
+}
+
+/**
+ * Multi-producer throughput: producers sharing one MPSC ring (CAS on
+ * producer_pos_) versus one LaneBus lane per producer (wait-free SPSC claim),
+ * drained by one consumer. BARE_METAL; producers yield and retry when full.
+ */
+void run_lane_bus_comparison(uint32_t rounds) {
+  LOG_INFO("");
+  LOG_INFO("========== Multi-Producer: Shared MPSC Ring vs LaneBus ==========");
+
+  constexpr uint32_t kProducers = 4U;
+  constexpr uint32_t kPerProducer = 100000U;
+  constexpr uint32_t kDepth = 16384U;
+  using SharedRing = AsyncBus<ExamplePayload, kDepth, SteadyClock, false>;
+  using Lanes = LaneBus<ExamplePayload, kProducers, kDepth>;
+
+  std::vector<double> shared_rates;
+  std::vector<double> lane_rates;
+  for (uint32_t r = 0U; r < config::WARMUP_ROUNDS + rounds; ++r) {
+    auto shared = std::make_unique<SharedRing>();
+    shared->SetPerformanceMode(SharedRing::PerformanceMode::BARE_METAL);
+    const double shared_rate = measure_multi_producer(*shared, kProducers, kPerProducer, [](SharedRing& bus) {
+      return [&bus](ExamplePayload&& payload) { return bus.Publish(std::move(payload), 1U); };
+    });
+
+    auto lanes = std::make_unique<Lanes>();
+    lanes->SetPerformanceMode(Lanes::PerformanceMode::BARE_METAL);
+    const double lane_rate = measure_multi_producer(*lanes, kProducers, kPerProducer, [](Lanes& bus) {
+      return [producer = bus.RegisterProducer()](ExamplePayload&& payload) mutable {
+        return producer.Publish(std::move(payload), 1U);
+      };
+    });
+
+    if (r >= config::WARMUP_ROUNDS) {
+      shared_rates.push_back(shared_rate);
+      lane_rates.push_back(lane_rate);
+    }
+  }
+
+  Statistics shared = calculate_statistics(shared_rates);
+  Statistics lanes = calculate_statistics(lane_rates);
+  LOG_INFO("%u producers, %u msgs each, depth %u", kProducers, kPerProducer, kDepth);
+  LOG_INFO("Shared MPSC ring: %.2f +/- %.2f M msg/s", shared.mean, shared.std_dev);
+  LOG_INFO("LaneBus:          %.2f +/- %.2f M msg/s", lanes.mean, lanes.std_dev);
+}
+
+struct QueuedPose {
+  float x, y, z;
+  uint32_t seq;
+};
+
+struct ConflatedPose {
+  float x, y, z;
+  uint32_t seq;
+};
+
+template <>
+struct mccc::ConflationTraits<ConflatedPose> {
+  static constexpr uint32_t KEYS = 16U;
+};
+
+/**
+ * State-stream backlog: kSenders senders each publish kUpdates pose samples
+ * before the consumer drains. Queued keeps every sample in the ring;
+ * ConflationTraits keeps the newest sample per sender. Publish and drain are
+ * timed separately (NO_STATS).
+ */
+void run_conflation_comparison(uint32_t rounds) {
+  LOG_INFO("");
+  LOG_INFO("========== State Backlog: Queued vs Conflated ==========");
+
+  constexpr uint32_t kSenders = 8U;
+  constexpr uint32_t kUpdates = 1000U;
+  constexpr uint32_t kDepth = 16384U;
+  uint64_t sink = 0U;
+
+  struct Result {
+    Statistics publish_ns;
+    Statistics drain_us;
+    uint32_t callbacks;
+  };
+
+  auto measure = [&sink](auto& bus, auto make_sample, uint32_t n_rounds) {
+    using Sample = decltype(make_sample(0U));
+    using Env = MessageEnvelope<std::variant<Sample>>;
+    uint32_t delivered = 0U;
+    bus.template Subscribe<Sample>([&sink, &delivered](const Env& env) {
+      sink += std::get<Sample>(env.payload).seq;
+      ++delivered;
+    });
+    std::vector<double> publish_ns;
+    std::vector<double> drain_us;
+    for (uint32_t r = 0U; r < config::WARMUP_ROUNDS + n_rounds; ++r) {
+      delivered = 0U;
+      auto t0 = high_resolution_clock::now();
+      for (uint32_t i = 0U; i < kUpdates; ++i) {
+        for (uint32_t s = 0U; s < kSenders; ++s) {
+          (void)bus.Publish(make_sample(i), s);
+        }
+      }
+      auto t1 = high_resolution_clock::now();
+      while (bus.ProcessBatch() > 0U) {}
+      auto t2 = high_resolution_clock::now();
+      if (r >= config::WARMUP_ROUNDS) {
+        publish_ns.push_back(static_cast<double>(duration_cast<nanoseconds>(t1 - t0).count()) /
+                             (kSenders * kUpdates));
+        drain_us.push_back(static_cast<double>(duration_cast<nanoseconds>(t2 - t1).count()) / 1000.0);
+      }
+    }
+    return Result{calculate_statistics(publish_ns), calculate_statistics(drain_us), delivered};
+  };
+
+  using QueuedBus = AsyncBus<std::variant<QueuedPose>, kDepth>;
+  using ConflatedBus = AsyncBus<std::variant<ConflatedPose>, kDepth>;
+  auto queued_bus = std::make_unique<QueuedBus>();
+  auto conflated_bus = std::make_unique<ConflatedBus>();
+  queued_bus->SetPerformanceMode(QueuedBus::PerformanceMode::NO_STATS);
+  conflated_bus->SetPerformanceMode(ConflatedBus::PerformanceMode::NO_STATS);
+
+  const Result queued = measure(*queued_bus, [](uint32_t i) { return QueuedPose{1.0f, 2.0f, 3.0f, i}; }, rounds);
+  const Result conflated =
+      measure(*conflated_bus, [](uint32_t i) { return ConflatedPose{1.0f, 2.0f, 3.0f, i}; }, rounds);
+
+  LOG_INFO("%u senders x %u updates per tick", kSenders, kUpdates);
+  LOG_INFO("Queued:    publish %.2f ns/msg, drain %.2f +/- %.2f us/tick, %u callbacks", queued.publish_ns.mean,
+           queued.drain_us.mean, queued.drain_us.std_dev, queued.callbacks);
+  LOG_INFO("Conflated: publish %.2f ns/msg, drain %.2f +/- %.2f us/tick, %u callbacks (checksum %lu)",
+           conflated.publish_ns.mean, conflated.drain_us.mean, conflated.drain_us.std_dev, conflated.callbacks,
+           static_cast<unsigned long>(sink));
+}
+
+struct QueuedCmd {
+  float x, y, z;
+  uint32_t seq;
+};
+
+struct ExpiringCmd {
+  float x, y, z;
+  uint32_t seq;
+};
+
+template <>
+struct mccc::ExpiryTraits<ExpiringCmd> {
+  static constexpr uint64_t TTL_US = 1000U;
+};
+
+/**
+ * Overload recovery: the consumer stalls while a CRITICAL backlog (90% of
+ * the ring) of commands goes stale, then drains it. Without a TTL every stale
+ * command is dispatched; with ExpiryTraits they are skipped. FULL_FEATURED.
+ */
+void run_expiry_comparison(uint32_t rounds) {
+  LOG_INFO("");
+  LOG_INFO("========== Overload Recovery: Stale Backlog With/Without TTL ==========");
+
+  constexpr uint32_t kDepth = 16384U;
+  uint64_t sink = 0U;
+
+  auto measure = [&sink](auto& bus, auto make_cmd, uint32_t n_rounds, uint32_t& callbacks) {
+    using Cmd = decltype(make_cmd(0U));
+    using Env = MessageEnvelope<std::variant<Cmd>>;
+    using BusT = std::remove_reference_t<decltype(bus)>;
+    uint32_t delivered = 0U;
+    bus.template Subscribe<Cmd>([&sink, &delivered](const Env& env) {
+      sink += std::get<Cmd>(env.payload).seq;
+      ++delivered;
+    });
+    std::vector<double> drain_us;
+    for (uint32_t r = 0U; r < config::WARMUP_ROUNDS + n_rounds; ++r) {
+      delivered = 0U;
+      for (uint32_t i = 0U; bus.QueueDepth() < BusT::BACKPRESSURE_CRITICAL_THRESHOLD; ++i) {
+        (void)bus.PublishWithPriority(make_cmd(i), 1U, MessagePriority::HIGH);
+      }
+      std::this_thread::sleep_for(milliseconds(2));  // backlog ages past the TTL
+      auto t0 = high_resolution_clock::now();
+      while (bus.ProcessBatch() > 0U) {}
+      auto t1 = high_resolution_clock::now();
+      if (r >= config::WARMUP_ROUNDS) {
+        drain_us.push_back(static_cast<double>(duration_cast<nanoseconds>(t1 - t0).count()) / 1000.0);
+      }
+    }
+    callbacks = delivered;
+    return calculate_statistics(drain_us);
+  };
+
+  using QueuedBus = AsyncBus<std::variant<QueuedCmd>, kDepth>;
+  using ExpiringBus = AsyncBus<std::variant<ExpiringCmd>, kDepth>;
+  auto queued_bus = std::make_unique<QueuedBus>();
+  auto expiring_bus = std::make_unique<ExpiringBus>();
+
+  uint32_t queued_callbacks = 0U;
+  uint32_t expiring_callbacks = 0U;
+  Statistics queued = measure(
+      *queued_bus, [](uint32_t i) { return QueuedCmd{1.0f, 2.0f, 3.0f, i}; }, rounds, queued_callbacks);
+  Statistics expiring = measure(
+      *expiring_bus, [](uint32_t i) { return ExpiringCmd{1.0f, 2.0f, 3.0f, i}; }, rounds, expiring_callbacks);
+
+  LOG_INFO("Backlog: %u messages, TTL %lu us", QueuedBus::BACKPRESSURE_CRITICAL_THRESHOLD,
+           static_cast<unsigned long>(ExpiryTraits<ExpiringCmd>::TTL_US));
+  LOG_INFO("No TTL:   drain %.2f +/- %.2f us, %u callbacks", queued.mean, queued.std_dev, queued_callbacks);
+  LOG_INFO("With TTL: drain %.2f +/- %.2f us, %u callbacks (checksum %lu)", expiring.mean, expiring.std_dev,
+           expiring_callbacks, static_cast<unsigned long>(sink));
+}
+
+/**
+ * Capture cost on the consumer thread: draining a backlog with no recorder,
+ * with a BusRecorder tap (copy into the staging ring, mmap writes on the
+ * writer thread), and with a subscriber that fwrite()s each message itself.
+ * Then replays the capture at full speed (ReplayConfig::speedup = 0).
+ */
+void run_recorder_comparison(uint32_t rounds) {
+  LOG_INFO("");
+  LOG_INFO("========== Traffic Capture: Recorder Tap vs fwrite Subscriber ==========");
+
+  constexpr uint32_t kDepth = 16384U;
+  constexpr uint32_t kBatch = 8192U;
+  using CapBus = AsyncBus<std::variant<QueuedCmd>, kDepth>;
+  using CapEnv = MessageEnvelope<std::variant<QueuedCmd>>;
+  uint64_t sink = 0U;
+
+  auto measure = [rounds](CapBus& bus) {
+    bus.SetPerformanceMode(CapBus::PerformanceMode::BARE_METAL);
+    std::vector<double> drain_ns;
+    for (uint32_t r = 0U; r < config::WARMUP_ROUNDS + rounds; ++r) {
+      for (uint32_t i = 0U; i < kBatch; ++i) {
+        (void)bus.Publish(QueuedCmd{1.0f, 2.0f, 3.0f, i}, 1U);
+      }
+      auto t0 = high_resolution_clock::now();
+      while (bus.ProcessBatch() > 0U) {}
+      auto t1 = high_resolution_clock::now();
+      if (r >= config::WARMUP_ROUNDS) {
+        drain_ns.push_back(static_cast<double>(duration_cast<nanoseconds>(t1 - t0).count()) / kBatch);
+      }
+      std::this_thread::sleep_for(milliseconds(2));  // recorder writer catches up between bursts
+    }
+    return calculate_statistics(drain_ns);
+  };
+
+  char prefix[64];
+  (void)std::snprintf(prefix, sizeof(prefix), "/tmp/mccc_bench_capture_%d", static_cast<int>(getpid()));
+  char segment[96];
+  (void)CaptureSegmentPath(segment, sizeof(segment), prefix, 0U);
+
+  auto plain_bus = std::make_unique<CapBus>();
+  plain_bus->Subscribe<QueuedCmd>([&sink](const CapEnv& env) { sink += std::get<QueuedCmd>(env.payload).seq; });
+  Statistics plain = measure(*plain_bus);
+
+  auto tap_bus = std::make_unique<CapBus>();
+  tap_bus->Subscribe<QueuedCmd>([&sink](const CapEnv& env) { sink += std::get<QueuedCmd>(env.payload).seq; });
+  auto recorder = std::make_shared<BusRecorder<std::variant<QueuedCmd>, CapBus, kDepth>>(*tap_bus);
+  (void)recorder->Record<QueuedCmd>();
+  RecorderConfig cfg;
+  cfg.path_prefix = prefix;
+  cfg.segment_bytes = 1ULL << 30U;
+  if (recorder->Start(cfg) != CaptureError::OK) {
+    LOG_INFO("Cannot create %s, skipped", segment);
+    return;
+  }
+  Statistics tapped = measure(*tap_bus);
+  recorder->Stop();
+  const RecorderStatistics rs = recorder->GetStatistics();
+
+  auto fwrite_bus = std::make_unique<CapBus>();
+  FILE* file = std::fopen("/dev/null", "wb");
+  fwrite_bus->Subscribe<QueuedCmd>([&sink, file](const CapEnv& env) {
+    sink += std::get<QueuedCmd>(env.payload).seq;
+    (void)std::fwrite(&env.header, sizeof(env.header), 1U, file);
+    (void)std::fwrite(&std::get<QueuedCmd>(env.payload), sizeof(QueuedCmd), 1U, file);
+  });
+  Statistics fwritten = measure(*fwrite_bus);
+  (void)std::fclose(file);
+
+  LOG_INFO("Per message (%u-message drain, BARE_METAL):", kBatch);
+  LOG_INFO("  No capture:         %.1f +/- %.1f ns", plain.mean, plain.std_dev);
+  LOG_INFO("  BusRecorder tap:    %.1f +/- %.1f ns  (%lu written, %lu dropped)", tapped.mean, tapped.std_dev,
+           static_cast<unsigned long>(rs.records_written), static_cast<unsigned long>(rs.staging_dropped));
+  LOG_INFO("  fwrite subscriber:  %.1f +/- %.1f ns  (/dev/null)", fwritten.mean, fwritten.std_dev);
+
+  // Replay throughput onto a bus drained by a second thread
+  auto replay_bus = std::make_unique<CapBus>();
+  replay_bus->Subscribe<QueuedCmd>([&sink](const CapEnv& env) { sink += std::get<QueuedCmd>(env.payload).seq; });
+  std::atomic<bool> done{false};
+  std::thread consumer([&replay_bus, &done]() {
+    while (!done.load(std::memory_order_acquire)) {
+      if (replay_bus->ProcessBatch() == 0U) {
+        std::this_thread::yield();
+      }
+    }
+    while (replay_bus->ProcessBatch() > 0U) {}
+  });
+  BusReplayer<std::variant<QueuedCmd>, CapBus> replayer(*replay_bus);
+  uint64_t replayed = 0U;
+  double replay_ms = 0.0;
+  if (replayer.Open(segment) == CaptureError::OK) {
+    ReplayConfig rc;
+    rc.speedup = 0U;
+    auto t0 = high_resolution_clock::now();
+    replayed = replayer.Replay(rc);
+    auto t1 = high_resolution_clock::now();
+    replay_ms = static_cast<double>(duration_cast<microseconds>(t1 - t0).count()) / 1000.0;
+    replayer.Close();
+  }
+  done.store(true, std::memory_order_release);
+  consumer.join();
+  (void)std::remove(segment);
+  LOG_INFO("Replay (speedup 0): %lu records in %.2f ms, %.2f M msg/s (checksum %lu)",
+           static_cast<unsigned long>(replayed), replay_ms,
+           (replay_ms > 0.0) ? (static_cast<double>(replayed) / replay_ms / 1000.0) : 0.0,
+           static_cast<unsigned long>(sink));
+}
+
+/**
+ * Heartbeats: kSources periodic messages produced by one sleep_for() thread
+ * each versus one TimerWheel driven by the consumer loop. Reports process CPU
+ * time and voluntary context switches over the same wall time, then the
+ * idle cost TimerWheel::ProcessBatch() adds to an empty poll.
+ */
+void run_timer_wheel_comparison(uint32_t rounds) {
+  LOG_INFO("");
+  LOG_INFO("========== Heartbeats: sleep_for Threads vs TimerWheel ==========");
+
+  constexpr uint32_t kSources = 32U;
+  static constexpr milliseconds kPeriod{10};
+  static constexpr milliseconds kRun{500};
+  using BeatBus = AsyncBus<std::variant<QueuedCmd>, 1024U>;
+  using BeatEnv = MessageEnvelope<std::variant<QueuedCmd>>;
+
+  struct Usage {
+    double cpu_ms;
+    long switches;
+  };
+  auto usage_now = []() {
+    rusage ru{};
+    (void)getrusage(RUSAGE_SELF, &ru);
+    const double cpu_ms = static_cast<double>(ru.ru_utime.tv_sec + ru.ru_stime.tv_sec) * 1000.0 +
+                          static_cast<double>(ru.ru_utime.tv_usec + ru.ru_stime.tv_usec) / 1000.0;
+    return Usage{cpu_ms, ru.ru_nvcsw};
+  };
+
+  // sleep_for thread per source
+  auto thread_bus = std::make_unique<BeatBus>();
+  std::atomic<uint32_t> thread_beats{0U};
+  thread_bus->Subscribe<QueuedCmd>([&thread_beats](const BeatEnv&) { thread_beats.fetch_add(1U); });
+  std::atomic<bool> running{true};
+  const Usage t0 = usage_now();
+  std::thread thread_consumer([&thread_bus, &running]() {
+    while (running.load(std::memory_order_acquire)) {
+      (void)thread_bus->ProcessBatchWait(milliseconds(50));
+    }
+  });
+  std::vector<std::thread> sources;
+  for (uint32_t s = 0U; s < kSources; ++s) {
+    sources.emplace_back([&thread_bus, &running, s]() {
+      while (running.load(std::memory_order_acquire)) {
+        std::this_thread::sleep_for(kPeriod);
+        (void)thread_bus->Publish(QueuedCmd{0.0f, 0.0f, 0.0f, s}, s);
+      }
+    });
+  }
+  std::this_thread::sleep_for(kRun);
+  running.store(false, std::memory_order_release);
+  for (auto& t : sources) {
+    t.join();
+  }
+  thread_bus->Wakeup();
+  thread_consumer.join();
+  const Usage t1 = usage_now();
+
+  // One TimerWheel in the consumer loop
+  auto wheel_bus = std::make_unique<BeatBus>();
+  std::atomic<uint32_t> wheel_beats{0U};
+  wheel_bus->Subscribe<QueuedCmd>([&wheel_beats](const BeatEnv&) { wheel_beats.fetch_add(1U); });
+  auto wheel = std::make_unique<TimerWheel<std::variant<QueuedCmd>, BeatBus, kSources>>(*wheel_bus);
+  for (uint32_t s = 0U; s < kSources; ++s) {
+    (void)wheel->PublishEvery(kPeriod, QueuedCmd{0.0f, 0.0f, 0.0f, s}, s);
+  }
+  running.store(true, std::memory_order_release);
+  const Usage w0 = usage_now();
+  std::thread wheel_consumer([&wheel, &running]() {
+    while (running.load(std::memory_order_acquire)) {
+      (void)wheel->ProcessBatchWait(milliseconds(50));
+    }
+  });
+  std::this_thread::sleep_for(kRun);
+  running.store(false, std::memory_order_release);
+  wheel_bus->Wakeup();
+  wheel_consumer.join();
+  const Usage w1 = usage_now();
+
+  LOG_INFO("%u sources x %lld ms period, %lld ms run:", kSources, static_cast<long long>(kPeriod.count()),
+           static_cast<long long>(kRun.count()));
+  LOG_INFO("  sleep_for threads: %u msgs, CPU %.1f ms, %ld voluntary switches", thread_beats.load(),
+           t1.cpu_ms - t0.cpu_ms, t1.switches - t0.switches);
+  LOG_INFO("  TimerWheel:        %u msgs, CPU %.1f ms, %ld voluntary switches", wheel_beats.load(),
+           w1.cpu_ms - w0.cpu_ms, w1.switches - w0.switches);
+
+  // Empty poll: AsyncBus::ProcessBatch() vs TimerWheel::ProcessBatch() with armed timers not yet due
+  constexpr uint32_t kPolls = 100000U;
+  auto far_wheel = std::make_unique<TimerWheel<std::variant<QueuedCmd>, BeatBus, kSources>>(*wheel_bus);
+  (void)far_wheel->PublishAfter(seconds(3600), QueuedCmd{0.0f, 0.0f, 0.0f, 0U}, 0U);
+  std::vector<double> bus_ns;
+  std::vector<double> wheel_ns;
+  for (uint32_t r = 0U; r < config::WARMUP_ROUNDS + rounds; ++r) {
+    auto a = high_resolution_clock::now();
+    for (uint32_t i = 0U; i < kPolls; ++i) {
+      (void)wheel_bus->ProcessBatch();
+    }
+    auto b = high_resolution_clock::now();
+    for (uint32_t i = 0U; i < kPolls; ++i) {
+      (void)far_wheel->ProcessBatch();
+    }
+    auto c = high_resolution_clock::now();
+    if (r >= config::WARMUP_ROUNDS) {
+      bus_ns.push_back(static_cast<double>(duration_cast<nanoseconds>(b - a).count()) / kPolls);
+      wheel_ns.push_back(static_cast<double>(duration_cast<nanoseconds>(c - b).count()) / kPolls);
+    }
+  }
+  Statistics bus_poll = calculate_statistics(bus_ns);
+  Statistics wheel_poll = calculate_statistics(wheel_ns);
+  LOG_INFO("Empty poll: AsyncBus %.1f ns, TimerWheel %.1f ns", bus_poll.mean, wheel_poll.mean);
+}
+
+/**
+ * Hot-path logging cost: the synchronous log_print (mutex + fprintf + fflush
+ * per call) versus the LOG_ASYNC=1 backend (record into a per-thread ring).
+ * stderr is redirected to /dev/null, so the synchronous numbers are a lower
+ * bound; a terminal or file on slow storage costs more.
+ */
+void run_log_comparison(uint32_t rounds) {
+  LOG_INFO("");
+  LOG_INFO("========== Logging: synchronous vs LOG_ASYNC ==========");
+
+  constexpr uint32_t kBurst = 200U;  // per thread, below the ring size
+  constexpr uint32_t kThreads = 4U;
+  const int saved_stderr = ::dup(STDERR_FILENO);
+  const int null_fd = ::open("/dev/null", O_WRONLY);
+  if ((saved_stderr < 0) || (null_fd < 0)) {
+    LOG_WARN("cannot redirect stderr, skipping");
+    return;
+  }
+  const uint64_t dropped_before = log_internal::log_dropped();
+
+  // ns per call, averaged over every thread's burst
+  auto measure = [](bool async_backend, uint32_t threads) {
+    std::vector<double> per_thread(threads, 0.0);
+    std::vector<std::thread> workers;
+    for (uint32_t t = 0U; t < threads; ++t) {
+      workers.emplace_back([async_backend, t, &per_thread]() {
+        const double x = 1.25 * t;
+        if (async_backend) {
+          log_internal::async_log_print("INFO", __FILE__, __LINE__, __func__, "warm-up");  // registers the ring
+        }
+        auto start = high_resolution_clock::now();
+        for (uint32_t i = 0U; i < kBurst; ++i) {
+          if (async_backend) {
+            log_internal::async_log_print("INFO", __FILE__, __LINE__, __func__, "motion seq=%u x=%.2f", i, x);
+          } else {
+            log_internal::log_print("INFO", __FILE__, __LINE__, __func__, "motion seq=%u x=%.2f", i, x);
+          }
+        }
+        auto end = high_resolution_clock::now();
+        per_thread[t] = static_cast<double>(duration_cast<nanoseconds>(end - start).count()) / kBurst;
+      });
+    }
+    for (auto& w : workers) {
+      w.join();
+    }
+    return std::accumulate(per_thread.begin(), per_thread.end(), 0.0) / threads;
+  };
+
+  std::fflush(stderr);
+  (void)::dup2(null_fd, STDERR_FILENO);
+  std::vector<double> sync_1;
+  std::vector<double> async_1;
+  std::vector<double> sync_n;
+  std::vector<double> async_n;
+  for (uint32_t r = 0U; r < config::WARMUP_ROUNDS + rounds; ++r) {
+    const double s1 = measure(false, 1U);
+    const double a1 = measure(true, 1U);
+    std::this_thread::sleep_for(milliseconds(5));  // let the backend drain
+    const double sn = measure(false, kThreads);
+    const double an = measure(true, kThreads);
+    std::this_thread::sleep_for(milliseconds(5));
+    if (r >= config::WARMUP_ROUNDS) {
+      sync_1.push_back(s1);
+      async_1.push_back(a1);
+      sync_n.push_back(sn);
+      async_n.push_back(an);
+    }
+  }
+  LOG_FLUSH();
+  (void)::dup2(saved_stderr, STDERR_FILENO);
+  (void)::close(saved_stderr);
+  (void)::close(null_fd);
+
+  LOG_INFO("1 thread:  sync %.1f ns/call, async %.1f ns/call", calculate_statistics(sync_1).mean,
+           calculate_statistics(async_1).mean);
+  LOG_INFO("%u threads: sync %.1f ns/call, async %.1f ns/call", kThreads, calculate_statistics(sync_n).mean,
+           calculate_statistics(async_n).mean);
+  LOG_INFO("Async records dropped: %lu", static_cast<unsigned long>(log_internal::log_dropped() - dropped_before));
+}
+
+/**
+ * Component dispatch: 16 components on one bus, each subscribed to
+ * MotionData. "SubscribeSafe" locks the component's weak_ptr (two atomic RMWs
+ * on the control block) per callback; "SubscribeMember" is the Create()-owned
+ * path that calls the member function through a raw pointer.
+ */
+void run_component_dispatch_comparison(uint32_t rounds) {
+  LOG_INFO("");
+  LOG_INFO("========== Component Dispatch: SubscribeSafe vs SubscribeMember ==========");
+
+  using DispatchBus = AsyncBus<ExamplePayload, 8192U>;
+  using DispatchComponent = Component<ExamplePayload, DispatchBus>;
+  constexpr uint32_t kComponents = 16U;
+  constexpr uint32_t kBatch = 1024U;
+
+  class Counter : public DispatchComponent {
+   public:
+    explicit Counter(DispatchBus& bus) noexcept : DispatchComponent(bus) {}
+
+    void UseSafe() noexcept {
+      SubscribeSafe<MotionData>([](std::shared_ptr<DispatchComponent> self_base, const MotionData& data,
+                                   const MessageHeader& header) noexcept {
+        static_cast<Counter*>(self_base.get())->OnMotion(data, header);
+      });
+    }
+    void UseMember() noexcept { (void)SubscribeMember<MotionData>(&Counter::OnMotion); }
+
+    void OnMotion(const MotionData& /*data*/, const MessageHeader& header) noexcept { sum_ += header.msg_id; }
+
+    uint64_t sum_{0U};
+  };
+
+  auto bus = std::make_unique<DispatchBus>();
+  bus->SetPerformanceMode(DispatchBus::PerformanceMode::NO_STATS);
+
+  auto measure = [&bus](bool member, uint32_t n_rounds, uint64_t& checksum) {
+    std::vector<std::shared_ptr<Counter>> components;
+    for (uint32_t c = 0U; c < kComponents; ++c) {
+      components.push_back(DispatchComponent::Create<Counter>(*bus));
+      if (member) {
+        components.back()->UseMember();
+      } else {
+        components.back()->UseSafe();
+      }
+    }
+    std::vector<double> ns_per_callback;
+    for (uint32_t r = 0U; r < n_rounds; ++r) {
+      for (uint32_t i = 0U; i < kBatch; ++i) {
+        bus->PublishFast(MotionData(1.0f, 2.0f, 3.0f, 4.0f), 1U, 0U);
+      }
+      auto t0 = high_resolution_clock::now();
+      uint32_t processed = 0U;
+      while (processed < kBatch) {
+        processed += bus->ProcessBatch();
+      }
+      auto t1 = high_resolution_clock::now();
+      ns_per_callback.push_back(static_cast<double>(duration_cast<nanoseconds>(t1 - t0).count()) /
+                                (static_cast<double>(kBatch) * kComponents));
+    }
+    for (const auto& component : components) {
+      checksum += component->sum_;
+    }
+    return calculate_statistics(ns_per_callback);
+  };
+
+  uint64_t checksum = 0U;
+  (void)measure(false, config::WARMUP_ROUNDS, checksum);  // touch the ring before timing
+  Statistics safe = measure(false, rounds, checksum);
+  Statistics member = measure(true, rounds, checksum);
+
+  LOG_INFO("SubscribeSafe   (weak_ptr lock): %.2f +/- %.2f ns/callback", safe.mean, safe.std_dev);
+  LOG_INFO("SubscribeMember (raw this):      %.2f +/- %.2f ns/callback", member.mean, member.std_dev);
+  LOG_INFO("Saved: %.2f ns/callback, %.1f ns/msg at %u components (checksum %lu)", safe.mean - member.mean,
+           (safe.mean - member.mean) * kComponents, kComponents, static_cast<unsigned long>(checksum));
+}
+
+/**
+ * Sustained 2x overload on one thread: each step publishes two LOW commands
+ * and dispatches one, whose callback spins ~2 us. With the static thresholds
+ * the backlog parks at 60% of the ring; the adaptive controller shrinks the
+ * LOW limit to what the consumer drains within its target delay. Sojourn is
+ * publish stamp to callback (SteadyClock), sampled over the second half of
+ * the run, once the controller has settled.
+ */
+void run_admission_comparison(uint32_t rounds) {
+  LOG_INFO("");
+  LOG_INFO("========== Admission Under Overload: Static vs Adaptive (CoDel) ==========");
+
+  constexpr uint32_t kDepth = 4096U;
+  constexpr uint32_t kSteps = 40000U;
+  static constexpr AdaptiveAdmissionConfig kAdaptive{500U, 5000U, 32U};  // 500 us target, 5 ms interval
+  using AdmBus = AsyncBus<std::variant<QueuedCmd>, kDepth>;
+  using AdmEnv = MessageEnvelope<std::variant<QueuedCmd>>;
+
+  struct Result {
+    double mean_us;
+    double p99_us;
+    double drop_pct;
+    uint32_t low_limit;
+  };
+
+  auto measure = [](bool adaptive) {
+    auto bus = std::make_unique<AdmBus>();
+    if (adaptive) {
+      bus->EnableAdaptiveAdmission(kAdaptive);
+    }
+    std::vector<uint64_t> sojourn_us;
+    sojourn_us.reserve(kSteps);
+    bool sampling = false;
+    bus->Subscribe<QueuedCmd>([&sojourn_us, &sampling](const AdmEnv& env) {
+      const uint64_t now_us = SteadyClock::NowNs() / 1000U;
+      const uint64_t spin_until = SteadyClock::NowNs() + 2000U;
+      while (SteadyClock::NowNs() < spin_until) {}
+      if (!sampling) {
+        return;
+      }
+      sojourn_us.push_back((now_us > env.header.timestamp_us) ? (now_us - env.header.timestamp_us) : 0U);
+    });
+    for (uint32_t i = 0U; i < kSteps; ++i) {
+      sampling = (i >= kSteps / 2U);
+      (void)bus->PublishWithPriority(QueuedCmd{1.0f, 2.0f, 3.0f, 2U * i}, 1U, MessagePriority::LOW);
+      (void)bus->PublishWithPriority(QueuedCmd{1.0f, 2.0f, 3.0f, 2U * i + 1U}, 1U, MessagePriority::LOW);
+      (void)bus->ProcessBatch(1U);
+    }
+    std::sort(sojourn_us.begin(), sojourn_us.end());
+    const BusStatisticsSnapshot stats = bus->GetStatistics();
+    const double total = static_cast<double>(stats.messages_published + stats.messages_dropped);
+    return Result{static_cast<double>(std::accumulate(sojourn_us.begin(), sojourn_us.end(), uint64_t{0U})) /
+                      static_cast<double>(sojourn_us.size()),
+                  static_cast<double>(sojourn_us[sojourn_us.size() * 99U / 100U]),
+                  100.0 * static_cast<double>(stats.low_priority_dropped) / total,
+                  bus->GetAdmissionSnapshot().low_limit};
+  };
+
+  std::vector<double> static_mean, static_p99, static_drop;
+  std::vector<double> adaptive_mean, adaptive_p99, adaptive_drop;
+  uint32_t adaptive_limit = 0U;
+  for (uint32_t r = 0U; r < config::WARMUP_ROUNDS + rounds; ++r) {
+    const Result fixed = measure(false);
+    const Result adapted = measure(true);
+    if (r >= config::WARMUP_ROUNDS) {
+      static_mean.push_back(fixed.mean_us);
+      static_p99.push_back(fixed.p99_us);
+      static_drop.push_back(fixed.drop_pct);
+      adaptive_mean.push_back(adapted.mean_us);
+      adaptive_p99.push_back(adapted.p99_us);
+      adaptive_drop.push_back(adapted.drop_pct);
+      adaptive_limit = adapted.low_limit;
+    }
+  }
+
+  LOG_INFO("Static   (LOW limit %u): sojourn mean %.1f us, p99 %.1f us, LOW dropped %.1f%%",
+           AdmBus::LOW_PRIORITY_THRESHOLD, calculate_statistics(static_mean).mean,
+           calculate_statistics(static_p99).mean, calculate_statistics(static_drop).mean);
+  LOG_INFO("Adaptive (LOW limit %u): sojourn mean %.1f us, p99 %.1f us, LOW dropped %.1f%%", adaptive_limit,
+           calculate_statistics(adaptive_mean).mean, calculate_statistics(adaptive_p99).mean,
+           calculate_statistics(adaptive_drop).mean);
+}
+
+/**
+ * Per-message visitor dispatch cost: std::visit versus the index switch that
+ * ProcessBatchWith uses (detail::VisitByIndex), over the same mixed payloads.
+ * Measures the dispatch step alone, without the ring.
+ */
+void run_visitor_dispatch_comparison(uint32_t rounds) {
+  LOG_INFO("");
+  LOG_INFO("========== Visitor Dispatch: std::visit vs Index Switch ==========");
+
+  constexpr uint32_t kMessages = 4096U;
+  std::vector<ExamplePayload> payloads;
+  payloads.reserve(kMessages);
+  for (uint32_t i = 0U; i < kMessages; ++i) {
+    switch (i % 3U) {
+      case 0U:
+        payloads.emplace_back(MotionData(1.0f, 2.0f, 3.0f, static_cast<float>(i)));
+        break;
+      case 1U:
+        payloads.emplace_back(CameraFrame(static_cast<int32_t>(i), 480, "RGB"));
+        break;
+      default:
+        payloads.emplace_back(SystemLog(static_cast<int32_t>(i), "log"));
+        break;
+    }
+  }
+
+  uint64_t sink = 0U;
+  auto visitor =
+      make_overloaded([&sink](const MotionData& m) { sink += static_cast<uint64_t>(m.velocity); },
+                      [&sink](const CameraFrame& f) { sink += static_cast<uint64_t>(f.width); },
+                      [&sink](const SystemLog& l) { sink += static_cast<uint64_t>(l.level); });
+
+  auto measure = [&payloads](uint32_t n_rounds, auto&& dispatch_one) {
+    std::vector<double> ns_per_msg;
+    for (uint32_t r = 0U; r < config::WARMUP_ROUNDS + n_rounds; ++r) {
+      auto t0 = high_resolution_clock::now();
+      for (auto& payload : payloads) {
+        dispatch_one(payload);
+      }
+      auto t1 = high_resolution_clock::now();
+      if (r >= config::WARMUP_ROUNDS) {
+        ns_per_msg.push_back(static_cast<double>(duration_cast<nanoseconds>(t1 - t0).count()) / kMessages);
+      }
+    }
+    return calculate_statistics(ns_per_msg);
+  };
+
+  Statistics visit = measure(rounds, [&visitor](ExamplePayload& p) { std::visit(visitor, p); });
+  Statistics index_switch = measure(rounds, [&visitor](ExamplePayload& p) { detail::VisitByIndex(visitor, p); });
+
+  LOG_INFO("std::visit:   %.2f +/- %.2f ns/msg", visit.mean, visit.std_dev);
+  LOG_INFO("index switch: %.2f +/- %.2f ns/msg", index_switch.mean, index_switch.std_dev);
+  LOG_INFO("Saved: %.2f ns/msg (checksum %lu)", visit.mean - index_switch.mean, static_cast<unsigned long>(sink));
+}
+
+/**
+ * Per-message Publish() cost with each header timestamp Clock policy.
+ * Publishes kBatch messages into an owned bus (NO_STATS), drains untimed.
+ */
+template <typename ClockT>
+Statistics measure_publish_cost(uint32_t rounds) {
+  using ClockBus = AsyncBus<ExamplePayload, 8192U, ClockT>;
+  constexpr uint32_t kBatch = 4096U;
+  auto bus = std::make_unique<ClockBus>();
+  bus->SetPerformanceMode(ClockBus::PerformanceMode::NO_STATS);
+  (void)ClockT::NowNs();  // one-time calibration outside the timed region
+
+  std::vector<double> ns_per_msg;
+  for (uint32_t r = 0U; r < config::WARMUP_ROUNDS + rounds; ++r) {
+    auto t0 = high_resolution_clock::now();
+    for (uint32_t i = 0U; i < kBatch; ++i) {
+      bus->Publish(MotionData(1.0f, 2.0f, 3.0f, 4.0f), 1U);
+    }
+    auto t1 = high_resolution_clock::now();
+    while (bus->ProcessBatch() > 0U) {}
+    if (r >= config::WARMUP_ROUNDS) {
+      ns_per_msg.push_back(static_cast<double>(duration_cast<nanoseconds>(t1 - t0).count()) / kBatch);
+    }
+  }
+  return calculate_statistics(ns_per_msg);
+}
+
+void run_clock_cost_comparison(uint32_t rounds) {
+  LOG_INFO("");
+  LOG_INFO("========== Publish Timestamp Clock Cost ==========");
+
+  TscClock::Calibrate();  // otherwise the first rounds measure its steady_clock fallback
+  Statistics steady = measure_publish_cost<SteadyClock>(rounds);
+  Statistics tsc = measure_publish_cost<TscClock>(rounds);
+  Statistics coarse = measure_publish_cost<CoarseClock>(rounds);
+  Statistics none = measure_publish_cost<NoClock>(rounds);
+
+  LOG_INFO("SteadyClock: %.2f +/- %.2f ns/msg", steady.mean, steady.std_dev);
+  LOG_INFO("TscClock:    %.2f +/- %.2f ns/msg", tsc.mean, tsc.std_dev);
+  LOG_INFO("CoarseClock: %.2f +/- %.2f ns/msg", coarse.mean, coarse.std_dev);
+  LOG_INFO("NoClock:     %.2f +/- %.2f ns/msg", none.mean, none.std_dev);
+}
+
 void run_backpressure_test(uint32_t burst_size, std::atomic<bool>& pause_worker) {
   LOG_INFO("");
   LOG_INFO("========== Backpressure Stress Test ==========");
@@ -376,6 +1574,23 @@ int main() {
   run_benchmark_with_stats("Medium Batch", 10000U, config::TEST_ROUNDS);
   run_benchmark_with_stats("Large Batch", 100000U, config::TEST_ROUNDS);
   run_e2e_latency_test(config::E2E_LATENCY_SAMPLES);
+  run_shm_latency_test(config::E2E_LATENCY_SAMPLES);
+  run_udp_bridge_comparison(409600U);
+  run_dispatch_cost_comparison(config::TEST_ROUNDS * 10U);
+  run_filter_fanout_comparison(config::TEST_ROUNDS * 10U);
+  run_visitor_dispatch_comparison(config::TEST_ROUNDS * 10U);
+  run_clock_cost_comparison(config::TEST_ROUNDS * 10U);
+  run_buffer_pool_comparison(config::TEST_ROUNDS);
+  run_buffer_pool_slab_comparison(config::TEST_ROUNDS);
+  run_shared_token_comparison(config::TEST_ROUNDS);
+  run_lane_bus_comparison(config::TEST_ROUNDS);
+  run_conflation_comparison(config::TEST_ROUNDS);
+  run_expiry_comparison(config::TEST_ROUNDS);
+  run_recorder_comparison(config::TEST_ROUNDS);
+  run_timer_wheel_comparison(config::TEST_ROUNDS);
+  run_log_comparison(config::TEST_ROUNDS);
+  run_component_dispatch_comparison(config::TEST_ROUNDS);
+  run_admission_comparison(config::TEST_ROUNDS);
   run_backpressure_test(config::BACKPRESSURE_BURST_SIZE, pause_worker);
   run_sustained_test(config::SUSTAINED_DURATION_SEC);
 
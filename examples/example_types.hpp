@@ -58,6 +58,31 @@ struct SystemLog {
   SystemLog(int32_t lvl, const char* msg) noexcept : level(lvl), content(mccc::TruncateToCapacity, msg) {}
 };
 
+/**
+ * Fixed-size benchmark payloads: 8/24/64/128/256 bytes (the sizes of
+ * competitive_benchmark.cpp plus an 8-byte message). `seq` comes first and
+ * carries a sequence number or a send timestamp.
+ */
+struct Msg8 {
+  uint64_t seq;
+};
+struct Msg24 {
+  uint64_t seq;
+  float x, y, z, w;
+};
+struct Msg64 {
+  uint64_t seq;
+  char data[56];
+};
+struct Msg128 {
+  uint64_t seq;
+  char data[120];
+};
+struct Msg256 {
+  uint64_t seq;
+  char data[248];
+};
+
 /**
  * Example payload variant containing all demo message types.
  */
@@ -0,0 +1,156 @@
+/**
+ * @file hsm_benchmark.cpp
+ * @brief HSM dispatch cost: dynamic bubble-up vs the frozen flat table
+ *
+ * Both machines run over the same State objects and the same pre-generated
+ * event stream, so the only difference is how Dispatch() resolves the
+ * transition: per-state linear scan plus runtime LCA/entry path, or one
+ * (state, event_id) table lookup with precomputed exit/entry runs.
+ */
+
+#ifndef LOG_LEVEL
+#define LOG_LEVEL LOG_LEVEL_INFO
+#endif
+#include "bench_utils.hpp"
+#include "log_macro.hpp"
+#include "state_machine.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+using namespace std::chrono;
+
+namespace config {
+constexpr uint32_t ROUNDS = 5U;
+constexpr uint32_t EVENTS = 2000000U;
+constexpr uint32_t EVENT_KINDS = 16U;
+}  // namespace config
+
+struct BenchContext {
+  uint64_t actions{0U};
+  uint64_t entries{0U};
+  uint32_t battery{100U};
+};
+
+using BenchState = hsm::State<BenchContext>;
+using BenchMachine = hsm::StateMachine<BenchContext>;
+
+/**
+ * Robot-style chart, three levels deep:
+ *   Root { Operational { Idle, Active { Moving, Docking }, Paused }, Fault { Recovering, Halted } }
+ * Each leaf handles a few events itself; the rest bubble up to Active,
+ * Operational or Root, which is where the dynamic path pays its scan cost.
+ */
+struct BenchChart {
+  BenchState root{"Root"};
+  BenchState operational{"Operational"};
+  BenchState idle{"Idle"};
+  BenchState active{"Active"};
+  BenchState moving{"Moving"};
+  BenchState docking{"Docking"};
+  BenchState paused{"Paused"};
+  BenchState fault{"Fault"};
+  BenchState recovering{"Recovering"};
+  BenchState halted{"Halted"};
+
+  BenchChart() {
+    BenchState* all[] = {&root, &operational, &idle, &active, &moving, &docking, &paused, &fault, &recovering, &halted};
+    for (BenchState* s : all) {
+      s->set_on_entry([](BenchContext& ctx, const hsm::Event&) { ++ctx.entries; });
+    }
+    operational.set_parent(root);
+    idle.set_parent(operational);
+    active.set_parent(operational);
+    moving.set_parent(active);
+    docking.set_parent(active);
+    paused.set_parent(operational);
+    fault.set_parent(root);
+    recovering.set_parent(fault);
+    halted.set_parent(fault);
+
+    const BenchState::ActionFn count = [](BenchContext& ctx, const hsm::Event&) { ++ctx.actions; };
+    const BenchState::GuardFn charged = [](const BenchContext& ctx, const hsm::Event&) { return ctx.battery > 20U; };
+    const BenchState::ActionFn drain = [](BenchContext& ctx, const hsm::Event&) {
+      ctx.battery = (ctx.battery > 0U) ? ctx.battery - 1U : 100U;
+    };
+
+    idle.AddTransition(1U, moving, charged, count).AddTransition(2U, docking, count);
+    moving.AddInternalTransition(3U, drain).AddTransition(4U, docking, count).AddTransition(5U, idle, count);
+    docking.AddTransition(6U, idle, count).AddInternalTransition(3U, drain);
+    active.AddTransition(7U, paused, count).AddInternalTransition(8U, count);
+    paused.AddTransition(9U, moving, charged, count).AddTransition(9U, docking, count);
+    operational.AddTransition(10U, fault, count).AddInternalTransition(11U, count).AddTransition(12U, idle, count);
+    fault.AddTransition(13U, recovering, count).AddInternalTransition(11U, count);
+    recovering.AddTransition(14U, idle, count).AddTransition(10U, halted, count);
+    halted.AddTransition(15U, recovering, count);
+    root.AddInternalTransition(0U, count);
+  }
+};
+
+uint64_t run_dispatch(BenchMachine& machine, const std::vector<hsm::Event>& events) {
+  uint64_t handled = 0U;
+  for (const hsm::Event& e : events) {
+    handled += machine.Dispatch(e) ? 1U : 0U;
+  }
+  return handled;
+}
+
+int main() {
+  LOG_INFO("========================================");
+  LOG_INFO("   HSM Dispatch Benchmark");
+  LOG_INFO("========================================");
+  LOG_INFO("10 states, 3 levels, %u event kinds, %u events x %u rounds", config::EVENT_KINDS, config::EVENTS,
+           config::ROUNDS);
+  bench::pin_thread_to_core(0);
+
+  auto chart = std::make_unique<BenchChart>();
+  std::vector<hsm::Event> events;
+  events.reserve(config::EVENTS);
+  uint32_t lcg = 12345U;
+  for (uint32_t i = 0U; i < config::EVENTS; ++i) {
+    lcg = lcg * 1103515245U + 12345U;
+    events.emplace_back((lcg >> 16U) % config::EVENT_KINDS);
+  }
+
+  BenchContext dyn_ctx;
+  BenchContext flat_ctx;
+  BenchMachine dynamic(chart->idle, dyn_ctx);
+  BenchMachine flat(chart->idle, flat_ctx);
+  flat.Freeze();
+
+  std::vector<double> dyn_ns;
+  std::vector<double> flat_ns;
+  uint64_t dyn_handled = 0U;
+  uint64_t flat_handled = 0U;
+  for (uint32_t r = 0U; r < config::ROUNDS; ++r) {
+    dynamic.Reset();
+    flat.Reset();
+    dyn_ctx = BenchContext{};
+    flat_ctx = BenchContext{};
+
+    auto start = steady_clock::now();
+    dyn_handled = run_dispatch(dynamic, events);
+    auto mid = steady_clock::now();
+    flat_handled = run_dispatch(flat, events);
+    auto end = steady_clock::now();
+
+    dyn_ns.push_back(static_cast<double>(duration_cast<nanoseconds>(mid - start).count()) / config::EVENTS);
+    flat_ns.push_back(static_cast<double>(duration_cast<nanoseconds>(end - mid).count()) / config::EVENTS);
+  }
+  std::sort(dyn_ns.begin(), dyn_ns.end());
+  std::sort(flat_ns.begin(), flat_ns.end());
+
+  const bool same = (dyn_handled == flat_handled) && (dyn_ctx.actions == flat_ctx.actions) &&
+                    (dyn_ctx.entries == flat_ctx.entries) && (&dynamic.current_state() == &flat.current_state());
+  LOG_INFO("Dynamic: median %6.2f ns/event (handled %lu, actions %lu, entries %lu)", dyn_ns[dyn_ns.size() / 2U],
+           static_cast<unsigned long>(dyn_handled), static_cast<unsigned long>(dyn_ctx.actions),
+           static_cast<unsigned long>(dyn_ctx.entries));
+  LOG_INFO("Frozen:  median %6.2f ns/event (handled %lu, actions %lu, entries %lu)", flat_ns[flat_ns.size() / 2U],
+           static_cast<unsigned long>(flat_handled), static_cast<unsigned long>(flat_ctx.actions),
+           static_cast<unsigned long>(flat_ctx.entries));
+  LOG_INFO("Speedup: %.2fx, identical behavior: %s", dyn_ns[dyn_ns.size() / 2U] / flat_ns[flat_ns.size() / 2U],
+           same ? "yes" : "NO");
+  return same ? 0 : 1;
+}
@@ -16,6 +16,8 @@
 #include <chrono>
 #include <iostream>
 #include <mccc/component.hpp>
+#include <mccc/timer_wheel.hpp>
+#include <mutex>
 #include <thread>
 
 using namespace example;
@@ -45,8 +47,16 @@ constexpr uint32_t PAUSE = 3U;
 constexpr uint32_t RESUME = 4U;
 constexpr uint32_t FAULT = 5U;
 constexpr uint32_t RESET = 6U;
+constexpr uint32_t PAUSE_TIMEOUT = 7U;
 }  // namespace RobotEvents
 
+using ExampleTimers = TimerWheel<ExamplePayload>;
+
+/** sender_id of the timer messages the controller arms for itself. */
+constexpr uint32_t TIMER_SENDER_ID = 900U;
+/** PAUSED returns to IDLE if not resumed within this time. */
+constexpr std::chrono::milliseconds PAUSE_TIMEOUT_MS(300);
+
 struct RobotContext {
   std::atomic<RobotState> current_state{RobotState::IDLE};
   std::atomic<uint64_t> motion_count{0U};
@@ -55,6 +65,8 @@ struct RobotContext {
   float last_y{0.0F};
   float last_z{0.0F};
   bool verbose{true};
+  ExampleTimers* timers{nullptr};
+  TimerHandle pause_timer;
 };
 
 class RobotController : public ExampleComponent {
@@ -64,8 +76,9 @@ class RobotController : public ExampleComponent {
   RobotController(RobotController&&) = delete;
   RobotController& operator=(RobotController&&) = delete;
 
-  static std::shared_ptr<RobotController> create() noexcept {
+  static std::shared_ptr<RobotController> create(ExampleTimers& timers) noexcept {
     std::shared_ptr<RobotController> ptr(new RobotController());
+    ptr->context_.timers = &timers;
     ptr->init();
     return ptr;
   }
@@ -80,15 +93,21 @@ class RobotController : public ExampleComponent {
           if (self)
             self->on_motion(data, header);
         });
+    SubscribeSafe<SystemLog>(
+        [](std::shared_ptr<ExampleComponent> self_base, const SystemLog&, const MessageHeader& header) noexcept {
+          auto self = std::static_pointer_cast<RobotController>(self_base);
+          if (self && (header.sender_id == TIMER_SENDER_ID))
+            self->dispatch(RobotEvents::PAUSE_TIMEOUT);
+        });
     LOG_INFO("[RobotController] Initialized with HSM");
   }
 
-  bool start() noexcept { return hsm_ ? hsm_->Dispatch(hsm::Event(RobotEvents::START)) : false; }
-  bool stop() noexcept { return hsm_ ? hsm_->Dispatch(hsm::Event(RobotEvents::STOP)) : false; }
-  bool pause() noexcept { return hsm_ ? hsm_->Dispatch(hsm::Event(RobotEvents::PAUSE)) : false; }
-  bool resume() noexcept { return hsm_ ? hsm_->Dispatch(hsm::Event(RobotEvents::RESUME)) : false; }
-  bool trigger_fault() noexcept { return hsm_ ? hsm_->Dispatch(hsm::Event(RobotEvents::FAULT)) : false; }
-  bool reset() noexcept { return hsm_ ? hsm_->Dispatch(hsm::Event(RobotEvents::RESET)) : false; }
+  bool start() noexcept { return dispatch(RobotEvents::START); }
+  bool stop() noexcept { return dispatch(RobotEvents::STOP); }
+  bool pause() noexcept { return dispatch(RobotEvents::PAUSE); }
+  bool resume() noexcept { return dispatch(RobotEvents::RESUME); }
+  bool trigger_fault() noexcept { return dispatch(RobotEvents::FAULT); }
+  bool reset() noexcept { return dispatch(RobotEvents::RESET); }
 
   RobotState get_state() const noexcept { return context_.current_state.load(std::memory_order_acquire); }
   const char* get_state_name() const noexcept { return robot_state_to_string(get_state()); }
@@ -100,6 +119,12 @@ class RobotController : public ExampleComponent {
  private:
   RobotController() noexcept = default;
 
+  // Events come from the caller's thread and from timer messages on the bus consumer thread
+  bool dispatch(uint32_t event_id) noexcept {
+    std::lock_guard<std::mutex> lock(hsm_mutex_);
+    return hsm_ ? hsm_->Dispatch(hsm::Event(event_id)) : false;
+  }
+
   void setup_state_machine() noexcept {
     idle_state_ = std::make_unique<hsm::State<RobotContext>>("IDLE");
     running_state_ = std::make_unique<hsm::State<RobotContext>>("RUNNING");
@@ -128,9 +153,17 @@ class RobotController : public ExampleComponent {
       ctx.current_state.store(RobotState::PAUSED, std::memory_order_release);
       if (ctx.verbose)
         LOG_INFO("[HSM] -> PAUSED");
+      // State timeout: one pooled timer instead of a watchdog thread
+      ctx.pause_timer =
+          ctx.timers->PublishAfter(PAUSE_TIMEOUT_MS, SystemLog(1, "pause timeout"), TIMER_SENDER_ID);
     });
+    paused_state_->set_on_exit([](RobotContext& ctx, const hsm::Event&) { (void)ctx.timers->Cancel(ctx.pause_timer); });
     paused_state_->AddTransition(RobotEvents::RESUME, *running_state_);
     paused_state_->AddTransition(RobotEvents::STOP, *idle_state_);
+    paused_state_->AddTransition(RobotEvents::PAUSE_TIMEOUT, *idle_state_, [](RobotContext& ctx, const hsm::Event&) {
+      if (ctx.verbose)
+        LOG_INFO("[HSM] PAUSED for %lld ms, stopping", static_cast<long long>(PAUSE_TIMEOUT_MS.count()));
+    });
 
     error_state_->set_on_entry([](RobotContext& ctx, const hsm::Event&) {
       ctx.current_state.store(RobotState::ERROR, std::memory_order_release);
@@ -157,6 +190,7 @@ class RobotController : public ExampleComponent {
   std::unique_ptr<hsm::State<RobotContext>> paused_state_;
   std::unique_ptr<hsm::State<RobotContext>> error_state_;
   std::unique_ptr<hsm::StateMachine<RobotContext>> hsm_;
+  std::mutex hsm_mutex_;
 };
 
 void send_motion_commands(uint32_t count, uint32_t sender_id) noexcept {
@@ -172,17 +206,17 @@ int main() {
   LOG_INFO("   MCCC + HSM Demo");
   LOG_INFO("========================================");
 
+  // Timer messages are published from the consumer loop; ProcessBatchWait parks until the next one is due
+  ExampleTimers timers(ExampleBus::Instance());
   std::atomic<bool> stop_worker{false};
-  std::thread worker([&stop_worker]() noexcept {
+  std::thread worker([&stop_worker, &timers]() noexcept {
     while (!stop_worker.load(std::memory_order_acquire)) {
-      uint32_t processed = ExampleBus::Instance().ProcessBatch();
-      if (processed == 0U)
-        std::this_thread::sleep_for(std::chrono::microseconds(100));
+      (void)timers.ProcessBatchWait(std::chrono::milliseconds(10));
     }
-    while (ExampleBus::Instance().ProcessBatch() > 0U) {}
+    while (timers.ProcessBatch() > 0U) {}
   });
 
-  auto robot = RobotController::create();
+  auto robot = RobotController::create(timers);
 
   // Test state transitions
   LOG_INFO("\n--- Test: State Transitions ---");
@@ -210,6 +244,12 @@ int main() {
   robot->start();
   LOG_INFO("State after reset+start: %s", robot->get_state_name());
 
+  // Test state timeout
+  LOG_INFO("\n--- Test: Pause Timeout ---");
+  robot->pause();
+  std::this_thread::sleep_for(std::chrono::milliseconds(400));
+  LOG_INFO("State after 400 ms paused: %s", robot->get_state_name());
+
   robot->stop();
   stop_worker.store(true, std::memory_order_release);
   worker.join();
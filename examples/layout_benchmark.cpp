@@ -0,0 +1,98 @@
+/**
+ * @file layout_benchmark.cpp
+ * @brief Ring layout comparison: memory footprint and E2E throughput per payload size
+ *
+ * Build twice (mccc_layout_bench / mccc_layout_bench_compact) to compare the
+ * default cache-line node layout with MCCC_COMPACT_RING=1. Payloads are the
+ * fixed-size example::Msg* types.
+ */
+
+#ifndef LOG_LEVEL
+#define LOG_LEVEL LOG_LEVEL_INFO
+#endif
+#include "bench_utils.hpp"
+#include "example_types.hpp"
+#include "log_macro.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mccc/mccc.hpp>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono;
+
+namespace config {
+constexpr uint32_t ROUNDS = 5U;
+constexpr uint32_t MESSAGES = 2000000U;
+constexpr uint32_t DEPTH = 131072U;
+}  // namespace config
+
+using example::Msg128;
+using example::Msg24;
+using example::Msg256;
+using example::Msg64;
+using example::Msg8;
+
+template <typename MsgT>
+void run_layout_case(const char* name) {
+  using Payload = std::variant<MsgT>;
+  using Bus = mccc::AsyncBus<Payload, config::DEPTH>;
+
+  auto bus = std::make_unique<Bus>();
+  bus->SetPerformanceMode(Bus::PerformanceMode::BARE_METAL);
+  uint64_t sink = 0U;
+  bus->template Subscribe<MsgT>(
+      [&sink](const mccc::MessageEnvelope<Payload>& env) { sink += std::get<MsgT>(env.payload).seq; });
+
+  std::vector<double> mps;
+  for (uint32_t r = 0U; r < config::ROUNDS; ++r) {
+    std::atomic<bool> stop{false};
+    std::thread consumer([&bus, &stop]() {
+      bench::pin_thread_to_core(1);
+      while (!stop.load(std::memory_order_acquire)) {
+        bus->ProcessBatch();
+      }
+      while (bus->ProcessBatch() > 0U) {}
+    });
+
+    bench::pin_thread_to_core(0);
+    MsgT msg{};
+    auto start = steady_clock::now();
+    for (uint32_t i = 0U; i < config::MESSAGES;) {
+      msg.seq = i;
+      if (bus->Publish(MsgT(msg), 0U)) {
+        ++i;
+      }
+    }
+    stop.store(true, std::memory_order_release);
+    consumer.join();
+    auto end = steady_clock::now();
+
+    double elapsed_us = static_cast<double>(duration_cast<nanoseconds>(end - start).count()) / 1e3;
+    mps.push_back(static_cast<double>(config::MESSAGES) / elapsed_us);
+  }
+  std::sort(mps.begin(), mps.end());
+
+  constexpr size_t kBytes = Bus::RingMemoryBytes();
+  LOG_INFO("%-8s payload=%3zu B  slot=%4zu B  ring=%7.2f MiB  E2E median=%6.2f M/s (checksum %lu)", name,
+           sizeof(MsgT), kBytes / config::DEPTH, static_cast<double>(kBytes) / (1024.0 * 1024.0),
+           mps[mps.size() / 2U], static_cast<unsigned long>(sink));
+}
+
+int main() {
+  LOG_INFO("========================================");
+  LOG_INFO("   MCCC Ring Layout Benchmark");
+  LOG_INFO("========================================");
+  LOG_INFO("MCCC_COMPACT_RING=%d, MCCC_SINGLE_PRODUCER=%d, depth=%u, BARE_METAL, %u msgs x %u rounds",
+           MCCC_COMPACT_RING, MCCC_SINGLE_PRODUCER, config::DEPTH, config::MESSAGES, config::ROUNDS);
+
+  run_layout_case<Msg8>("8B");
+  run_layout_case<Msg24>("24B");
+  run_layout_case<Msg64>("64B");
+  run_layout_case<Msg128>("128B");
+  run_layout_case<Msg256>("256B");
+  return 0;
+}
@@ -0,0 +1,459 @@
+/**
+ * @file scaling_benchmark.cpp
+ * @brief Parameterised scaling sweep: producers x payload size x mode x SPSC/MPSC x pinning plan
+ *
+ * Each case runs two phases on a fresh bus:
+ * - Throughput: every producer publishes as fast as it can for --duration-ms;
+ *   reports delivered messages per second and the share of rejected publishes.
+ * - Latency: producers follow a fixed schedule that splits --rate evenly.
+ *   Each message carries its scheduled send time, and latency is measured
+ *   from that time to the callback. A producer that falls behind sends
+ *   immediately but keeps its schedule, so stalls are charged to every
+ *   message they delay (no coordinated omission).
+ *
+ * Results go to the log and, optionally, to --csv / --json for regression
+ * tracking. SPSC cases run with one producer only.
+ *
+ * Usage:
+ *   mccc_scaling_bench --producers=1,2,4,8,16 --payloads=8,64,256 --modes=full,bare \
+ *                      --bus=mpsc,spsc --pin=cache,socket --rate=1000000 --csv=out.csv --json=out.json
+ */
+
+#ifndef LOG_LEVEL
+#define LOG_LEVEL LOG_LEVEL_INFO
+#endif
+#include "bench_utils.hpp"
+#include "example_types.hpp"
+#include "log_macro.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <atomic>
+#include <memory>
+#include <mccc/mccc.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+using example::Msg128;
+using example::Msg24;
+using example::Msg256;
+using example::Msg64;
+using example::Msg8;
+using mccc::SteadyClock;
+
+namespace config {
+constexpr uint32_t DEPTH = 65536U;
+constexpr uint32_t CLOCK_CHECK_EVERY = 256U;  // throughput phase: publishes between clock reads
+}  // namespace config
+
+struct Options {
+  std::vector<uint32_t> producers{1U, 2U, 4U};
+  std::vector<uint32_t> payloads{8U, 24U, 64U, 128U, 256U};
+  std::vector<uint8_t> modes{0U, 2U, 1U};  // PerformanceMode values: FULL_FEATURED, NO_STATS, BARE_METAL
+  std::vector<bool> spsc{false, true};
+  std::vector<bench::PinPlan> pins{bench::PinPlan::NONE};
+  uint32_t duration_ms{200U};
+  uint64_t rate{200000U};  // msgs/s offered in the latency phase, all producers together
+  std::string csv;
+  std::string json;
+};
+
+struct CaseResult {
+  const char* bus;
+  const char* mode;
+  uint32_t producers;
+  uint32_t payload_bytes;
+  const char* pin;
+  bool pin_exact;
+  double throughput_mps;
+  double drop_pct;
+  uint64_t latency_dropped;
+  mccc::LatencySnapshot latency;
+};
+
+const char* ModeName(uint8_t mode) {
+  switch (mode) {
+    case 1U:
+      return "bare";
+    case 2U:
+      return "nostats";
+    default:
+      return "full";
+  }
+}
+
+/** The same payload type for both phases: seq is 0 while measuring throughput, the scheduled send time otherwise. */
+template <typename MsgT, bool SingleProducer>
+class ScalingCase {
+ public:
+  using Payload = std::variant<MsgT>;
+  using Bus = mccc::AsyncBus<Payload, config::DEPTH, SteadyClock, SingleProducer>;
+
+  ScalingCase(const Options& options, uint8_t mode, uint32_t producers, const std::vector<uint32_t>& cpus)
+      : options_(options), producers_(producers), cpus_(cpus), bus_(std::make_unique<Bus>()) {
+    bus_->SetPerformanceMode(static_cast<typename Bus::PerformanceMode>(mode));
+    bus_->template Subscribe<MsgT>([this](const mccc::MessageEnvelope<Payload>& env) {
+      const uint64_t scheduled = std::get<MsgT>(env.payload).seq;
+      if (scheduled != 0U) {
+        const uint64_t now = SteadyClock::NowNs();
+        latency_.Record((now > scheduled) ? (now - scheduled) : 0U);
+      }
+      ++delivered_;
+    });
+  }
+
+  void Run(CaseResult& result) {
+    const uint64_t duration_ns = static_cast<uint64_t>(options_.duration_ms) * 1000000U;
+
+    // Throughput phase
+    std::vector<uint64_t> sent(producers_, 0U);
+    std::vector<uint64_t> rejected(producers_, 0U);
+    delivered_ = 0U;
+    const uint64_t elapsed_ns = RunPhase([this, duration_ns, &sent, &rejected](uint32_t p, uint64_t start) {
+      MsgT msg{};
+      const uint64_t end = start + duration_ns;
+      uint64_t now = start;
+      while (now < end) {
+        for (uint32_t i = 0U; i < config::CLOCK_CHECK_EVERY; ++i) {
+          if (bus_->Publish(MsgT(msg), p)) {
+            ++sent[p];
+          } else {
+            ++rejected[p];
+          }
+        }
+        now = SteadyClock::NowNs();
+      }
+    });
+    uint64_t total_sent = 0U;
+    uint64_t total_rejected = 0U;
+    for (uint32_t p = 0U; p < producers_; ++p) {
+      total_sent += sent[p];
+      total_rejected += rejected[p];
+    }
+    result.throughput_mps = static_cast<double>(delivered_) * 1e3 / static_cast<double>(elapsed_ns);
+    const uint64_t attempts = total_sent + total_rejected;
+    result.drop_pct =
+        (attempts == 0U) ? 0.0 : 100.0 * static_cast<double>(total_rejected) / static_cast<double>(attempts);
+
+    // Latency phase: producer p sends at start + offset_p + k * interval
+    std::vector<uint64_t> missed(producers_, 0U);
+    const uint64_t interval_ns = (static_cast<uint64_t>(producers_) * 1000000000U) / options_.rate;
+    const uint64_t step_ns = (interval_ns > 0U) ? interval_ns : 1U;
+    latency_.Reset();
+    (void)RunPhase([this, duration_ns, step_ns, &missed](uint32_t p, uint64_t start) {
+      MsgT msg{};
+      const uint64_t end = start + duration_ns;
+      for (uint64_t scheduled = start + (step_ns * p) / producers_; scheduled < end; scheduled += step_ns) {
+        while (SteadyClock::NowNs() < scheduled) {
+          std::this_thread::yield();
+        }
+        msg.seq = scheduled;
+        if (!bus_->Publish(MsgT(msg), p)) {
+          ++missed[p];
+        }
+      }
+    });
+    result.latency_dropped = 0U;
+    for (uint64_t m : missed) {
+      result.latency_dropped += m;
+    }
+    result.latency = latency_.Snapshot();
+  }
+
+ private:
+  /** Starts the consumer and the producers, waits for them and for the drain. @return Elapsed ns. */
+  template <typename ProducerFn>
+  uint64_t RunPhase(ProducerFn producer) {
+    std::atomic<uint32_t> ready{0U};
+    std::atomic<bool> go{false};
+    std::atomic<bool> stop{false};
+    uint64_t start = 0U;
+    std::thread consumer([this, &ready, &stop]() {
+      Pin(0U);
+      ready.fetch_add(1U, std::memory_order_acq_rel);
+      while (!stop.load(std::memory_order_acquire)) {
+        if (bus_->ProcessBatch() == 0U) {
+          std::this_thread::yield();
+        }
+      }
+      while (bus_->ProcessBatch() > 0U) {}
+    });
+    std::vector<std::thread> threads;
+    for (uint32_t p = 0U; p < producers_; ++p) {
+      threads.emplace_back([this, p, &producer, &ready, &go, &start]() {
+        Pin(1U + p);
+        ready.fetch_add(1U, std::memory_order_acq_rel);
+        while (!go.load(std::memory_order_acquire)) {
+          std::this_thread::yield();
+        }
+        while (SteadyClock::NowNs() < start) {
+          std::this_thread::yield();
+        }
+        producer(p, start);
+      });
+    }
+    while (ready.load(std::memory_order_acquire) < producers_ + 1U) {
+      std::this_thread::yield();
+    }
+    start = SteadyClock::NowNs() + 1000000U;  // 1 ms for everyone to reach the start line
+    go.store(true, std::memory_order_release);
+    for (auto& t : threads) {
+      t.join();
+    }
+    stop.store(true, std::memory_order_release);
+    consumer.join();
+    return SteadyClock::NowNs() - start;
+  }
+
+  void Pin(uint32_t thread_index) const {
+    if (thread_index < cpus_.size()) {
+      (void)bench::pin_thread_to_core(cpus_[thread_index]);
+    }
+  }
+
+  const Options& options_;
+  uint32_t producers_;
+  std::vector<uint32_t> cpus_;
+  std::unique_ptr<Bus> bus_;
+  mccc::LatencyHistogram latency_;  // written by the consumer thread only
+  uint64_t delivered_{0U};
+};
+
+template <bool SingleProducer>
+bool RunPayload(uint32_t bytes, const Options& options, uint8_t mode, uint32_t producers,
+                const std::vector<uint32_t>& cpus, CaseResult& result) {
+  switch (bytes) {
+    case 8U:
+      ScalingCase<Msg8, SingleProducer>(options, mode, producers, cpus).Run(result);
+      return true;
+    case 24U:
+      ScalingCase<Msg24, SingleProducer>(options, mode, producers, cpus).Run(result);
+      return true;
+    case 64U:
+      ScalingCase<Msg64, SingleProducer>(options, mode, producers, cpus).Run(result);
+      return true;
+    case 128U:
+      ScalingCase<Msg128, SingleProducer>(options, mode, producers, cpus).Run(result);
+      return true;
+    case 256U:
+      ScalingCase<Msg256, SingleProducer>(options, mode, producers, cpus).Run(result);
+      return true;
+    default:
+      return false;
+  }
+}
+
+// ============================================================================
+// Command line and output
+// ============================================================================
+
+std::vector<std::string> SplitList(const char* value) {
+  std::vector<std::string> items;
+  std::string item;
+  for (const char* c = value; *c != '\0'; ++c) {
+    if (*c == ',') {
+      items.push_back(item);
+      item.clear();
+    } else {
+      item.push_back(*c);
+    }
+  }
+  items.push_back(item);
+  return items;
+}
+
+bool ParseUints(const char* value, std::vector<uint32_t>& out) {
+  out.clear();
+  for (const std::string& item : SplitList(value)) {
+    char* end = nullptr;
+    const unsigned long v = std::strtoul(item.c_str(), &end, 10);
+    if (item.empty() || (*end != '\0') || (v == 0U)) {
+      return false;
+    }
+    out.push_back(static_cast<uint32_t>(v));
+  }
+  return true;
+}
+
+bool ParseOption(const char* arg, Options& options) {
+  const char* eq = std::strchr(arg, '=');
+  if ((std::strncmp(arg, "--", 2U) != 0) || (eq == nullptr)) {
+    return false;
+  }
+  const std::string key(arg + 2, eq);
+  const char* value = eq + 1;
+  if (key == "producers") {
+    return ParseUints(value, options.producers);
+  }
+  if (key == "payloads") {
+    return ParseUints(value, options.payloads);
+  }
+  if (key == "modes") {
+    options.modes.clear();
+    for (const std::string& m : SplitList(value)) {
+      if ((m != "full") && (m != "nostats") && (m != "bare")) {
+        return false;
+      }
+      options.modes.push_back((m == "full") ? 0U : ((m == "bare") ? 1U : 2U));
+    }
+    return true;
+  }
+  if (key == "bus") {
+    options.spsc.clear();
+    for (const std::string& b : SplitList(value)) {
+      if ((b != "mpsc") && (b != "spsc")) {
+        return false;
+      }
+      options.spsc.push_back(b == "spsc");
+    }
+    return true;
+  }
+  if (key == "pin") {
+    options.pins.clear();
+    for (const std::string& p : SplitList(value)) {
+      bool known = false;
+      for (bench::PinPlan plan : {bench::PinPlan::NONE, bench::PinPlan::SAME_CORE, bench::PinPlan::SAME_CACHE,
+                                  bench::PinPlan::CROSS_SOCKET}) {
+        if (p == bench::pin_plan_name(plan)) {
+          options.pins.push_back(plan);
+          known = true;
+        }
+      }
+      if (!known) {
+        return false;
+      }
+    }
+    return true;
+  }
+  std::vector<uint32_t> number;
+  if ((key == "duration-ms") && ParseUints(value, number) && (number.size() == 1U)) {
+    options.duration_ms = number[0];
+    return true;
+  }
+  if ((key == "rate") && ParseUints(value, number) && (number.size() == 1U)) {
+    options.rate = number[0];
+    return true;
+  }
+  if (key == "csv") {
+    options.csv = value;
+    return !options.csv.empty();
+  }
+  if (key == "json") {
+    options.json = value;
+    return !options.json.empty();
+  }
+  return false;
+}
+
+void PrintUsage(const char* argv0) {
+  std::fprintf(stderr,
+               "Usage: %s [--producers=1,2,4] [--payloads=8,24,64,128,256] [--modes=full,nostats,bare]\n"
+               "          [--bus=mpsc,spsc] [--pin=none,core,cache,socket] [--duration-ms=200]\n"
+               "          [--rate=200000] [--csv=FILE] [--json=FILE]\n",
+               argv0);
+}
+
+void WriteCsv(const std::string& path, const std::vector<CaseResult>& results) {
+  FILE* f = std::fopen(path.c_str(), "w");
+  if (f == nullptr) {
+    LOG_ERROR("cannot write %s", path.c_str());
+    return;
+  }
+  std::fprintf(f,
+               "bus,mode,producers,payload_bytes,pin,pin_exact,throughput_mps,drop_pct,latency_samples,"
+               "latency_dropped,p50_ns,p99_ns,p999_ns,max_ns\n");
+  for (const CaseResult& r : results) {
+    std::fprintf(f, "%s,%s,%u,%u,%s,%d,%.3f,%.3f,%lu,%lu,%lu,%lu,%lu,%lu\n", r.bus, r.mode, r.producers,
+                 r.payload_bytes, r.pin, r.pin_exact ? 1 : 0, r.throughput_mps, r.drop_pct,
+                 static_cast<unsigned long>(r.latency.count), static_cast<unsigned long>(r.latency_dropped),
+                 static_cast<unsigned long>(r.latency.p50_ns), static_cast<unsigned long>(r.latency.p99_ns),
+                 static_cast<unsigned long>(r.latency.p999_ns), static_cast<unsigned long>(r.latency.max_ns));
+  }
+  std::fclose(f);
+}
+
+void WriteJson(const std::string& path, const Options& options, size_t cpus, const std::vector<CaseResult>& results) {
+  FILE* f = std::fopen(path.c_str(), "w");
+  if (f == nullptr) {
+    LOG_ERROR("cannot write %s", path.c_str());
+    return;
+  }
+  std::fprintf(f, "{\n  \"config\": {\"depth\": %u, \"duration_ms\": %u, \"rate\": %lu, \"cpus\": %zu},\n",
+               config::DEPTH, options.duration_ms, static_cast<unsigned long>(options.rate), cpus);
+  std::fprintf(f, "  \"results\": [\n");
+  for (size_t i = 0U; i < results.size(); ++i) {
+    const CaseResult& r = results[i];
+    std::fprintf(f,
+                 "    {\"bus\": \"%s\", \"mode\": \"%s\", \"producers\": %u, \"payload_bytes\": %u, \"pin\": \"%s\", "
+                 "\"pin_exact\": %s, \"throughput_mps\": %.3f, \"drop_pct\": %.3f, \"latency\": {\"samples\": %lu, "
+                 "\"dropped\": %lu, \"p50_ns\": %lu, \"p99_ns\": %lu, \"p999_ns\": %lu, \"max_ns\": %lu}}%s\n",
+                 r.bus, r.mode, r.producers, r.payload_bytes, r.pin, r.pin_exact ? "true" : "false", r.throughput_mps,
+                 r.drop_pct, static_cast<unsigned long>(r.latency.count),
+                 static_cast<unsigned long>(r.latency_dropped), static_cast<unsigned long>(r.latency.p50_ns),
+                 static_cast<unsigned long>(r.latency.p99_ns), static_cast<unsigned long>(r.latency.p999_ns),
+                 static_cast<unsigned long>(r.latency.max_ns), (i + 1U < results.size()) ? "," : "");
+  }
+  std::fprintf(f, "  ]\n}\n");
+  std::fclose(f);
+}
+
+int main(int argc, char** argv) {
+  Options options;
+  for (int i = 1; i < argc; ++i) {
+    if (!ParseOption(argv[i], options)) {
+      PrintUsage(argv[0]);
+      return 2;
+    }
+  }
+  const std::vector<bench::CpuTopology> topo = bench::read_cpu_topology();
+
+  LOG_INFO("========================================");
+  LOG_INFO("   MCCC Scaling Benchmark");
+  LOG_INFO("========================================");
+  LOG_INFO("depth=%u, %u ms per phase, latency phase offers %lu msgs/s, %zu CPUs visible", config::DEPTH,
+           options.duration_ms, static_cast<unsigned long>(options.rate), topo.size());
+
+  std::vector<CaseResult> results;
+  for (bool spsc : options.spsc) {
+    for (bench::PinPlan plan : options.pins) {
+      for (uint32_t producers : options.producers) {
+        if (spsc && (producers != 1U)) {
+          continue;  // a single-producer bus with several producers is undefined
+        }
+        bool exact = true;
+        const std::vector<uint32_t> cpus = bench::plan_cpus(topo, plan, producers + 1U, &exact);
+        for (uint8_t mode : options.modes) {
+          for (uint32_t bytes : options.payloads) {
+            CaseResult r{spsc ? "spsc" : "mpsc", ModeName(mode), producers, bytes, bench::pin_plan_name(plan),
+                         exact, 0.0, 0.0, 0U, mccc::LatencySnapshot{0U, 0U, 0U, 0U, 0U}};
+            const bool known = spsc ? RunPayload<true>(bytes, options, mode, producers, cpus, r)
+                                    : RunPayload<false>(bytes, options, mode, producers, cpus, r);
+            if (!known) {
+              LOG_WARN("no payload type of %u bytes (8, 24, 64, 128, 256), skipped", bytes);
+              continue;
+            }
+            LOG_INFO("%s %-7s P=%-2u %3uB pin=%-6s%s %8.2f M/s drop %5.1f%% | p50 %7lu p99 %8lu p999 %9lu ns",
+                     r.bus, r.mode, r.producers, r.payload_bytes, r.pin, r.pin_exact ? " " : "*", r.throughput_mps,
+                     r.drop_pct, static_cast<unsigned long>(r.latency.p50_ns),
+                     static_cast<unsigned long>(r.latency.p99_ns), static_cast<unsigned long>(r.latency.p999_ns));
+            results.push_back(r);
+          }
+        }
+      }
+    }
+  }
+  LOG_INFO("(* pinning plan not available on this machine, fallback placement)");
+
+  if (!options.csv.empty()) {
+    WriteCsv(options.csv, results);
+    LOG_INFO("CSV written to %s", options.csv.c_str());
+  }
+  if (!options.json.empty()) {
+    WriteJson(options.json, options, topo.size(), results);
+    LOG_INFO("JSON written to %s", options.json.c_str());
+  }
+  return 0;
+}
@@ -7,14 +7,26 @@
  * - Cache cold-start after migration
  * - Scheduling jitter from other processes
  *
+ * Pinning plans place a consumer and its producers relative to each other
+ * (same physical core, same last-level cache, different socket) using the
+ * Linux sysfs topology.
+ *
  * Usage:
  *   bench::pin_thread_to_core(0);  // pin current thread to core 0
+ *
+ *   auto topo = bench::read_cpu_topology();
+ *   auto cpus = bench::plan_cpus(topo, bench::PinPlan::SAME_CACHE, 1 + producers);
+ *   // cpus[0] for the consumer, cpus[1..] for the producers
  */
 
 #ifndef BENCH_UTILS_HPP
 #define BENCH_UTILS_HPP
 
 #include <cstdint>
+#include <cstdio>
+
+#include <string>
+#include <vector>
 
 #ifdef __linux__
 #include <pthread.h>
@@ -54,6 +66,165 @@ inline void pin_and_log(uint32_t core_id, LogFn log_fn) {
     }
 }
 
+/**
+ * @brief Position of one logical CPU (from /sys/devices/system/cpu).
+ */
+struct CpuTopology {
+    uint32_t cpu;     ///< Logical CPU number
+    int32_t core;     ///< Physical core id within the package
+    int32_t package;  ///< Socket
+    int32_t l3;       ///< Last-level cache domain (CCX / cluster); the package if unknown
+};
+
+/**
+ * @brief Producer placement relative to the consumer.
+ */
+enum class PinPlan : uint8_t {
+    NONE = 0U,        ///< Leave placement to the scheduler
+    SAME_CORE = 1U,   ///< Every thread on the consumer's physical core (SMT siblings, or one CPU)
+    SAME_CACHE = 2U,  ///< Other cores sharing the consumer's L3 (same CCX / cluster)
+    CROSS_SOCKET = 3U ///< Producers on another package than the consumer
+};
+
+inline const char* pin_plan_name(PinPlan plan) {
+    switch (plan) {
+        case PinPlan::SAME_CORE:
+            return "core";
+        case PinPlan::SAME_CACHE:
+            return "cache";
+        case PinPlan::CROSS_SOCKET:
+            return "socket";
+        case PinPlan::NONE:
+        default:
+            return "none";
+    }
+}
+
+inline int32_t read_sysfs_int(const std::string& path) {
+    int32_t value = -1;
+    FILE* file = std::fopen(path.c_str(), "r");
+    if (file != nullptr) {
+        if (std::fscanf(file, "%d", &value) != 1) {
+            value = -1;
+        }
+        std::fclose(file);
+    }
+    return value;
+}
+
+/**
+ * @brief CPUs the calling thread may run on, with their core/package/L3 ids.
+ *
+ * Call before pinning the calling thread, since the result follows its
+ * affinity mask. Empty when the topology cannot be read.
+ */
+inline std::vector<CpuTopology> read_cpu_topology() {
+    std::vector<CpuTopology> cpus;
+#ifdef __linux__
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+        return cpus;
+    }
+    for (uint32_t cpu = 0U; cpu < CPU_SETSIZE; ++cpu) {
+        if (!CPU_ISSET(cpu, &allowed)) {
+            continue;
+        }
+        const std::string base = "/sys/devices/system/cpu/cpu" + std::to_string(cpu);
+        CpuTopology t{cpu, read_sysfs_int(base + "/topology/core_id"),
+                      read_sysfs_int(base + "/topology/physical_package_id"),
+                      read_sysfs_int(base + "/cache/index3/id")};
+        if (t.l3 < 0) {
+            t.l3 = read_sysfs_int(base + "/cache/index3/shared_cpu_list");  // first CPU of the domain
+        }
+        if (t.l3 < 0) {
+            t.l3 = t.package;
+        }
+        cpus.push_back(t);
+    }
+#endif
+    return cpus;
+}
+
+/**
+ * @brief Append the CPUs matching pred, one per physical core first, then their SMT siblings.
+ */
+template <typename Pred>
+inline void append_distinct_cores(const std::vector<CpuTopology>& topo, Pred pred, std::vector<uint32_t>& out) {
+    std::vector<bool> taken(topo.size(), false);
+    for (int pass = 0; pass < 2; ++pass) {
+        for (size_t i = 0U; i < topo.size(); ++i) {
+            if (taken[i] || !pred(topo[i])) {
+                continue;
+            }
+            bool sibling_taken = false;
+            for (size_t j = 0U; j < topo.size(); ++j) {
+                sibling_taken = sibling_taken || (taken[j] && (topo[j].package == topo[i].package) &&
+                                                  (topo[j].core == topo[i].core));
+            }
+            if ((pass == 0) && sibling_taken) {
+                continue;
+            }
+            taken[i] = true;
+            out.push_back(topo[i].cpu);
+        }
+    }
+}
+
+/**
+ * @brief CPU for each of `threads` threads under a plan; index 0 is the consumer.
+ *
+ * The consumer takes the first CPU of the topology. Producers wrap round the
+ * plan's CPUs when there are more producers than CPUs. If the machine cannot
+ * honour the plan (one socket for CROSS_SOCKET, one core for SAME_CACHE),
+ * producers fall back to any other core, then to the consumer's core, and
+ * `exact` is set to false. Empty for PinPlan::NONE or an unknown topology.
+ */
+inline std::vector<uint32_t> plan_cpus(const std::vector<CpuTopology>& topo, PinPlan plan, uint32_t threads,
+                                       bool* exact = nullptr) {
+    std::vector<uint32_t> result;
+    if (exact != nullptr) {
+        *exact = true;
+    }
+    if ((plan == PinPlan::NONE) || topo.empty() || (threads == 0U)) {
+        return result;
+    }
+    const CpuTopology anchor = topo.front();
+    const auto same_core = [&anchor](const CpuTopology& t) {
+        return (t.package == anchor.package) && (t.core == anchor.core);
+    };
+    std::vector<uint32_t> pool;
+    switch (plan) {
+        case PinPlan::SAME_CORE:
+            append_distinct_cores(topo, [&](const CpuTopology& t) { return same_core(t) && (t.cpu != anchor.cpu); },
+                                  pool);
+            break;
+        case PinPlan::SAME_CACHE:
+            append_distinct_cores(topo, [&](const CpuTopology& t) { return (t.l3 == anchor.l3) && !same_core(t); },
+                                  pool);
+            break;
+        case PinPlan::CROSS_SOCKET:
+        default:
+            append_distinct_cores(topo, [&](const CpuTopology& t) { return t.package != anchor.package; }, pool);
+            break;
+    }
+    const bool honoured = (plan == PinPlan::SAME_CORE) ? true : (pool.size() + 1U >= threads);
+    if (pool.empty() && (plan != PinPlan::SAME_CORE)) {
+        append_distinct_cores(topo, [&](const CpuTopology& t) { return !same_core(t); }, pool);
+    }
+    if (pool.empty()) {
+        append_distinct_cores(topo, same_core, pool);  // consumer's own core, anchor CPU included
+    }
+    if (exact != nullptr) {
+        *exact = honoured;
+    }
+    result.push_back(anchor.cpu);
+    for (uint32_t i = 1U; i < threads; ++i) {
+        result.push_back(pool[(i - 1U) % pool.size()]);
+    }
+    return result;
+}
+
 }  // namespace bench
 
 #endif  // BENCH_UTILS_HPP
@@ -5,6 +5,13 @@
  * Thread Safety:
  * - Uses tagged pointer to solve ABA problem
  * - Uses sharding to reduce contention on free list head
+ * - Per-thread magazines serve most Borrow()/Return() calls without atomics
+ *
+ * Memory Layout:
+ * - Default: one aligned allocation per buffer
+ * - Slab mode (BufferPoolOptions::slab): one contiguous mapping, optionally
+ *   backed by huge pages and bound to a NUMA node (Linux), so the pool can be
+ *   registered once with a DMA engine / io_uring fixed buffers
  *
  * MISRA C++ Compliance:
  * - Rule 18-4-1: No heap allocation in Borrow() hot path
@@ -13,6 +20,8 @@
  * Compile-time Configuration:
  * - STREAMING_DMA_ALIGNMENT: Buffer alignment in bytes (default: 64)
  *   Override: -DSTREAMING_DMA_ALIGNMENT=0 (disable alignment on MCUs)
+ * - STREAMING_POOL_MAGAZINE_SIZE: Buffer indices cached per thread (default: 32)
+ * - STREAMING_POOL_MAX_MAGAZINES: Threads per pool with a magazine (default: 16)
  */
 
 #ifndef BUFFER_POOL_HPP_
@@ -20,6 +29,7 @@
 
 #include "data_token.hpp"
 
+#include <cstddef>
 #include <cstdlib>
 
 #include <atomic>
@@ -40,6 +50,25 @@ namespace streaming {
 #define STREAMING_DMA_ALIGNMENT 64U
 #endif
 
+/**
+ * @brief Capacity of a per-thread magazine (LIFO cache of buffer indices).
+ *
+ * Refill and flush move half a magazine at a time between the magazine and
+ * the shard free lists. Must be at least 2.
+ */
+#ifndef STREAMING_POOL_MAGAZINE_SIZE
+#define STREAMING_POOL_MAGAZINE_SIZE 32U
+#endif
+
+/**
+ * @brief Number of magazines a pool owns; threads beyond this use the shards directly.
+ */
+#ifndef STREAMING_POOL_MAX_MAGAZINES
+#define STREAMING_POOL_MAX_MAGAZINES 16U
+#endif
+
+static_assert(STREAMING_POOL_MAGAZINE_SIZE >= 2U, "STREAMING_POOL_MAGAZINE_SIZE must be at least 2");
+
 /**
  * @brief Tagged pointer to solve ABA problem
  */
@@ -65,6 +94,28 @@ struct BufferPoolShard {
   BufferPoolShard() noexcept : free_head(0), available_count(0) {}
 };
 
+/**
+ * @brief Construction options for DMABufferPool
+ */
+struct BufferPoolOptions {
+  uint32_t shard_count = 4U; /**< Free-list shards (DMABufferPool::kDefaultShardCount) */
+  bool thread_cache = true;  /**< Per-thread magazines in front of the shards */
+  bool slab = false;         /**< One contiguous allocation: buffer i at base + i * stride */
+  bool huge_pages = false;   /**< Slab only: try MAP_HUGETLB, else a 2 MiB-aligned MADV_HUGEPAGE mapping */
+  int32_t numa_node = -1;    /**< Slab only: mbind() the slab to this node (-1 = no binding) */
+};
+
+/**
+ * @brief Extent of a slab-mode pool, for one-time DMA / io_uring registration
+ */
+struct SlabExtent {
+  uint8_t* base;     /**< nullptr unless the pool was built with BufferPoolOptions::slab */
+  size_t bytes;      /**< Allocated length (whole pages of the page size in use) */
+  uint32_t stride;   /**< Distance between consecutive buffers (buffer size rounded to alignment) */
+  bool huge_pages;   /**< Backed by MAP_HUGETLB pages (transparent huge pages are best effort, not reported) */
+  int32_t numa_node; /**< Node the slab is bound to, -1 if unbound or mbind() failed */
+};
+
 /**
  * @brief DMA-aligned buffer pool for zero-copy data flow
  *
@@ -72,8 +123,17 @@ struct BufferPoolShard {
  * - Lock-free free list with O(1) borrow/return
  * - Tagged pointer for ABA safety
  * - Sharding to reduce contention (each CPU core has preferred shard)
+ * - Per-thread magazine: Borrow()/Return() hit a thread-owned LIFO of indices
+ *   with no atomic RMW; the magazine refills/flushes half its capacity from/to
+ *   the thread's shard (flush is a single CAS for the whole chain)
  * - Cache line aligned to avoid false sharing
  * - Zero heap allocation in Borrow() hot path (function pointer releaser)
+ *
+ * Buffers parked in another thread's magazine are not visible to Borrow()
+ * until that thread flushes (magazine full, ReleaseThreadCache(), thread exit
+ * followed by a steal). To bound this, the magazine capacity is clamped to
+ * buffer_count / (2 * STREAMING_POOL_MAX_MAGAZINES); pools too small for a
+ * magazine of 2 run without the thread cache.
  */
 class DMABufferPool {
  public:
@@ -81,6 +141,7 @@ class DMABufferPool {
   static constexpr uint32_t kDefaultShardCount = 4U;
 
   DMABufferPool(uint32_t buffer_size, uint32_t buffer_count, uint32_t shard_count = kDefaultShardCount);
+  DMABufferPool(uint32_t buffer_size, uint32_t buffer_count, const BufferPoolOptions& options);
   ~DMABufferPool();
 
   // Non-copyable, non-movable
@@ -93,32 +154,113 @@ class DMABufferPool {
    */
   DataToken Borrow();
 
+  /**
+   * @brief Borrow a buffer for a payload of @p len bytes
+   * @return Token whose size() is @p len, or invalid token if len > BufferSize() or the pool is empty
+   */
+  DataToken Borrow(uint32_t len);
+
+  /**
+   * @brief Borrow a buffer as a reference-counted token (count starts at 1)
+   * @return SharedDataToken, or invalid token if the pool is empty
+   */
+  SharedDataToken BorrowShared();
+
+  /**
+   * @brief Borrow a shared token for a payload of @p len bytes
+   * @return Token whose size() is @p len, or invalid token if len > BufferSize() or the pool is empty
+   */
+  SharedDataToken BorrowShared(uint32_t len);
+
   /**
    * @brief Return a buffer to the pool by index (lock-free)
    */
   void Return(uint32_t index);
 
+  /**
+   * @brief Pin the calling thread to a shard for refills, flushes and direct borrows.
+   *
+   * Replaces the default thread-id hash, which can put two hot threads on
+   * one shard. The binding is per pool and per thread.
+   *
+   * @param shard Shard index, must be < ShardCount()
+   * @return false if the shard index is out of range
+   */
+  bool BindThreadToShard(uint32_t shard) noexcept;
+
+  /**
+   * @brief Flush the calling thread's magazine to its shard and release it.
+   *
+   * Call before a worker thread goes idle for long so its cached buffers
+   * become visible to other threads. Also drops the thread's shard binding.
+   */
+  void ReleaseThreadCache() noexcept;
+
   /**
    * @brief Get total number of buffers
    */
   uint32_t TotalBuffers() const { return buffer_count_; }
 
   /**
-   * @brief Get number of available buffers (approximate)
+   * @brief Get capacity of each buffer in bytes
+   */
+  uint32_t BufferSize() const { return buffer_size_; }
+
+  /**
+   * @brief Get slab base, length and stride (base == nullptr if not in slab mode)
+   */
+  SlabExtent Slab() const noexcept { return slab_; }
+
+  /**
+   * @brief Get number of shards
+   */
+  uint32_t ShardCount() const { return shard_count_; }
+
+  /**
+   * @brief Get per-thread magazine capacity (0 = thread cache disabled)
+   */
+  uint32_t MagazineCapacity() const { return magazine_capacity_; }
+
+  /**
+   * @brief Get number of available buffers, including those parked in magazines (approximate)
    */
   uint32_t AvailableBuffers() const;
 
+  /**
+   * @brief Get number of buffers held by callers (approximate)
+   */
+  uint32_t InUse() const { return buffer_count_ - AvailableBuffers(); }
+
+  /**
+   * @brief Get the peak number of buffers taken out of the shard free lists
+   *
+   * Exact with the thread cache disabled. With magazines, buffers parked in a
+   * magazine count as taken, so the peak can exceed the true in-use peak by
+   * the magazines' contents.
+   */
+  uint32_t HighWatermark() const { return peak_outstanding_.load(std::memory_order_relaxed); }
+
+  /**
+   * @brief Get number of Borrow() calls that found the pool empty
+   */
+  uint64_t ExhaustedCount() const { return exhausted_count_.load(std::memory_order_relaxed); }
+
   /**
    * @brief Get borrow count
    */
-  uint64_t BorrowCount() const { return borrow_count_.load(std::memory_order_relaxed); }
+  uint64_t BorrowCount() const;
 
   /**
    * @brief Get return count
    */
-  uint64_t ReturnCount() const { return return_count_.load(std::memory_order_relaxed); }
+  uint64_t ReturnCount() const;
 
  private:
+  struct Magazine;
+  struct MagazineTable;
+  struct ThreadSlot;
+  struct ThreadCache;
+
   /**
    * @brief Static release callback for DataToken RAII.
    *
@@ -144,8 +286,42 @@ class DMABufferPool {
   // Get shard for a buffer index (determined at allocation time)
   uint32_t GetBufferShard(uint32_t buffer_index) const noexcept { return buffer_index % shard_count_; }
 
-  // Try to borrow from a specific shard
-  DataToken TryBorrowFromShard(uint32_t shard_idx);
+  // Reserve the slab mapping (huge pages / NUMA binding when requested)
+  void AllocateSlab(const BufferPoolOptions& options);
+  void FreeSlab() noexcept;
+
+  // Buffer address: computed in slab mode, looked up otherwise
+  uint8_t* BufferAddress(uint32_t index) const noexcept {
+    return (slab_.base != nullptr) ? (slab_.base + static_cast<size_t>(index) * slab_.stride) : buffers_[index];
+  }
+
+  // Calling thread's state for this pool; nullptr during thread teardown
+  ThreadSlot* LocalSlot() noexcept;
+
+  // Claim an unowned magazine for the calling thread (nullptr if none left)
+  Magazine* ClaimMagazine() noexcept;
+
+  // Shard free-list primitives
+  uint32_t PopFromShard(uint32_t shard_idx) noexcept;
+  uint32_t PopFromAnyShard(uint32_t preferred_shard) noexcept;
+  void PushChainToShard(uint32_t shard_idx, uint32_t first, uint32_t last, uint32_t count) noexcept;
+
+  // Magazine batch transfer
+  uint32_t RefillMagazine(Magazine& mag, uint32_t preferred_shard) noexcept;
+  void FlushMagazine(Magazine& mag, uint32_t shard_idx, uint32_t count) noexcept;
+
+  // Take a buffer from a magazine whose thread has exited
+  uint32_t StealFromIdleMagazines(uint32_t shard_idx) noexcept;
+
+  // Take one buffer index (magazine, shards, idle magazines); kInvalidIndex if empty
+  uint32_t AcquireIndex() noexcept;
+
+  // Account buffers leaving the shard free lists (returns are counted in PushChainToShard)
+  void NoteTaken(uint32_t count) noexcept;
+
+  // Wrap a borrowed index in a DataToken / SharedDataToken
+  DataToken MakeToken(uint32_t index, uint32_t len) noexcept;
+  SharedDataToken MakeSharedToken(uint32_t index, uint32_t len) noexcept;
 
   // Helper functions for tagged pointer
   static uint64_t PackTaggedIndex(TaggedIndex ti) noexcept {
@@ -156,7 +332,7 @@ class DMABufferPool {
     return TaggedIndex(static_cast<uint32_t>(packed & 0xFFFFFFFFU), static_cast<uint32_t>(packed >> 32U));
   }
 
-  // Buffer storage
+  // Buffer storage (per-buffer allocations; empty in slab mode)
   std::vector<uint8_t*> buffers_;
   uint32_t buffer_size_;
   uint32_t buffer_count_;
@@ -165,14 +341,122 @@ class DMABufferPool {
   // Per-buffer next pointer for free list
   std::unique_ptr<std::atomic<uint32_t>[]> next_free_;
 
+  // Per-buffer reference count for SharedDataToken
+  std::unique_ptr<std::atomic<uint32_t>[]> refcounts_;
+
   // Sharded free list heads (cache-line aligned)
   std::unique_ptr<BufferPoolShard[]> shards_;
 
-  // Global statistics (cache line aligned)
+  // Contiguous slab (slab mode only)
+  SlabExtent slab_;
+  bool slab_mapped_;  // slab_ came from mmap() rather than operator new
+
+  // Per-thread magazines; shared so exiting threads can release their slot safely
+  uint64_t pool_id_;
+  uint32_t magazine_capacity_;
+  std::shared_ptr<MagazineTable> magazines_;
+
+  // Occupancy of the shard free lists (slow path only: refills, flushes, direct borrows)
+  std::atomic<uint32_t> outstanding_;
+  std::atomic<uint32_t> peak_outstanding_;
+  std::atomic<uint64_t> exhausted_count_;
+
+  // Direct-path statistics; magazine hits are counted per magazine (cache line aligned)
   alignas(64) std::atomic<uint64_t> borrow_count_;
   alignas(64) std::atomic<uint64_t> return_count_;
 };
 
+/**
+ * @brief One size class of a SizeClassBufferPool
+ */
+struct BufferSizeClass {
+  uint32_t buffer_size;  /**< Capacity of each buffer in bytes */
+  uint32_t buffer_count; /**< Number of buffers in the class */
+};
+
+/**
+ * @brief Per-class statistics snapshot
+ */
+struct BufferClassStats {
+  uint32_t buffer_size;    /**< Class capacity in bytes */
+  uint32_t total;          /**< Buffers in the class */
+  uint32_t in_use;         /**< Buffers currently held by callers (approximate) */
+  uint32_t high_watermark; /**< See DMABufferPool::HighWatermark() */
+  uint64_t borrows;        /**< Successful borrows */
+  uint64_t exhausted;      /**< Borrows that found the class empty */
+};
+
+/**
+ * @brief Buffer pool with size classes (slab-allocator style)
+ *
+ * Each class is an independent DMABufferPool with its own sharded free
+ * lists, magazines and (optionally) slab. Borrow(len) picks the smallest
+ * class whose buffers fit @p len; it does not spill into a larger class
+ * when that one is empty. The returned token's release callback context is
+ * the class pool, so a release goes straight back to the right class with
+ * no lookup.
+ *
+ * Example (CAN frames, jumbo Ethernet, camera frames):
+ * @code
+ *   streaming::SizeClassBufferPool pool({{256U, 4096U}, {9216U, 512U}, {2U << 20U, 16U}});
+ *   auto token = pool.Borrow(frame_len);
+ * @endcode
+ */
+class SizeClassBufferPool {
+ public:
+  /**
+   * @param classes Size classes in any order; classes with zero buffers are ignored
+   * @param options Applied to every class (shards, thread cache, slab placement)
+   */
+  explicit SizeClassBufferPool(const std::vector<BufferSizeClass>& classes,
+                               const BufferPoolOptions& options = BufferPoolOptions());
+
+  // Non-copyable, non-movable
+  SizeClassBufferPool(const SizeClassBufferPool&) = delete;
+  SizeClassBufferPool& operator=(const SizeClassBufferPool&) = delete;
+
+  /**
+   * @brief Borrow a buffer from the smallest class that fits @p len
+   * @return Token whose size() is @p len, or invalid token if no class fits or the class is empty
+   */
+  DataToken Borrow(uint32_t len);
+
+  /**
+   * @brief Borrow a reference-counted token from the smallest class that fits @p len
+   */
+  SharedDataToken BorrowShared(uint32_t len);
+
+  /**
+   * @brief Get index of the smallest class that fits @p len, or -1 if none does
+   */
+  int32_t ClassFor(uint32_t len) const noexcept;
+
+  /**
+   * @brief Get number of classes (sorted by ascending buffer size)
+   */
+  uint32_t ClassCount() const { return static_cast<uint32_t>(classes_.size()); }
+
+  /**
+   * @brief Access the pool backing a class (e.g. for Slab() registration)
+   */
+  DMABufferPool& Class(uint32_t class_index) { return *classes_[class_index]; }
+  const DMABufferPool& Class(uint32_t class_index) const { return *classes_[class_index]; }
+
+  /**
+   * @brief Get occupancy and watermark statistics of a class
+   */
+  BufferClassStats ClassStats(uint32_t class_index) const;
+
+  /**
+   * @brief Get number of Borrow() calls larger than the largest class
+   */
+  uint64_t OversizeCount() const { return oversize_count_.load(std::memory_order_relaxed); }
+
+ private:
+  std::vector<std::unique_ptr<DMABufferPool>> classes_;
+  std::atomic<uint64_t> oversize_count_;
+};
+
 } /* namespace streaming */
 
 #endif /* BUFFER_POOL_HPP_ */
@@ -5,19 +5,146 @@
 
 #include "buffer_pool.hpp"
 
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
 #include <chrono>
 
 namespace streaming {
 
+namespace {
+
+constexpr uint32_t kMagazineFree = 0U;
+constexpr uint32_t kMagazineOwned = 1U;
+constexpr uint32_t kMagazineDraining = 2U;
+
+/** Huge page size assumed for MAP_HUGETLB slabs (x86-64 / AArch64 default). */
+constexpr size_t kHugePageSize = static_cast<size_t>(2U) * 1024U * 1024U;
+
+/** MPOL_BIND from <numaif.h>; defined here to avoid a libnuma dependency. */
+constexpr int kMpolBind = 2;
+
+size_t RoundUp(size_t value, size_t granule) noexcept { return ((value + granule - 1U) / granule) * granule; }
+
+/** Pools a thread can hold a magazine for at the same time. */
+constexpr uint32_t kThreadCacheEntries = 4U;
+
+std::atomic<uint64_t> g_next_pool_id{1U};
+
+/** Set once the calling thread's cache has been destroyed (trivially destructible). */
+thread_local bool t_thread_cache_destroyed = false;
+
+}  // namespace
+
+// ============================================================================
+// Per-thread magazine
+// ============================================================================
+
+/**
+ * @brief LIFO cache of free buffer indices owned by one thread.
+ *
+ * Only the owning thread writes `count`, `indices`, `borrows` and `returns`;
+ * they are atomics so statistics readers on other threads see torn-free
+ * values, but the owner only ever does relaxed loads and stores (no RMW).
+ * Ownership changes hands through `state` (acquire/release).
+ */
+#if STREAMING_DMA_ALIGNMENT > 0
+struct alignas(STREAMING_DMA_ALIGNMENT) DMABufferPool::Magazine {
+#else
+struct DMABufferPool::Magazine {
+#endif
+  std::atomic<uint32_t> state{kMagazineFree};
+  std::atomic<uint32_t> count{0U};
+  std::atomic<uint64_t> borrows{0U};
+  std::atomic<uint64_t> returns{0U};
+  uint32_t indices[STREAMING_POOL_MAGAZINE_SIZE];
+};
+
+struct DMABufferPool::MagazineTable {
+  Magazine slots[STREAMING_POOL_MAX_MAGAZINES];
+};
+
+/** @brief Calling thread's view of one pool. */
+struct DMABufferPool::ThreadSlot {
+  uint64_t pool_id = 0U;
+  std::weak_ptr<MagazineTable> table;
+  Magazine* magazine = nullptr;
+  uint32_t shard = 0U;
+};
+
+/**
+ * @brief Thread-local cache of ThreadSlots.
+ *
+ * On thread exit each magazine is handed back to its pool (if the pool is
+ * still alive) with its buffers inside; the next thread to claim it adopts
+ * them, and an exhausted Borrow() steals from it.
+ */
+struct DMABufferPool::ThreadCache {
+  ThreadSlot entries[kThreadCacheEntries];
+  uint32_t next_victim = 0U;
+
+  static void Release(ThreadSlot& slot) noexcept {
+    std::shared_ptr<MagazineTable> table = slot.table.lock();
+    if ((table != nullptr) && (slot.magazine != nullptr)) {
+      slot.magazine->state.store(kMagazineFree, std::memory_order_release);
+    }
+    slot = ThreadSlot();
+  }
+
+  ~ThreadCache() {
+    for (ThreadSlot& slot : entries) {
+      if (slot.pool_id != 0U) {
+        Release(slot);
+      }
+    }
+    t_thread_cache_destroyed = true;
+  }
+};
+
+// ============================================================================
+// Construction
+// ============================================================================
+
 DMABufferPool::DMABufferPool(uint32_t buffer_size, uint32_t buffer_count, uint32_t shard_count)
+    : DMABufferPool(buffer_size, buffer_count, BufferPoolOptions{shard_count, true}) {}
+
+DMABufferPool::DMABufferPool(uint32_t buffer_size, uint32_t buffer_count, const BufferPoolOptions& options)
     : buffer_size_(buffer_size),
       buffer_count_(buffer_count),
-      shard_count_(shard_count > 0U ? shard_count : 1U),
+      shard_count_(options.shard_count > 0U ? options.shard_count : 1U),
       next_free_(new std::atomic<uint32_t>[buffer_count]),
+      refcounts_(new std::atomic<uint32_t>[buffer_count]),
       shards_(new BufferPoolShard[shard_count_]),
+      slab_{nullptr, 0U, 0U, false, -1},
+      slab_mapped_(false),
+      pool_id_(g_next_pool_id.fetch_add(1U, std::memory_order_relaxed)),
+      magazine_capacity_(0U),
+      outstanding_(0U),
+      peak_outstanding_(0U),
+      exhausted_count_(0U),
       borrow_count_(0U),
       return_count_(0U) {
-  buffers_.reserve(buffer_count);
+  if (options.slab) {
+    AllocateSlab(options);
+  } else {
+    buffers_.reserve(buffer_count);
+  }
+
+  // Bound what magazines can park to half the pool
+  if (options.thread_cache) {
+    uint32_t capacity = buffer_count / (2U * STREAMING_POOL_MAX_MAGAZINES);
+    if (capacity > STREAMING_POOL_MAGAZINE_SIZE) {
+      capacity = STREAMING_POOL_MAGAZINE_SIZE;
+    }
+    if (capacity >= 2U) {
+      magazine_capacity_ = capacity;
+      magazines_ = std::make_shared<MagazineTable>();
+    }
+  }
 
   // Initialize shards with invalid head
   for (uint32_t s = 0U; s < shard_count_; ++s) {
@@ -27,13 +154,15 @@ DMABufferPool::DMABufferPool(uint32_t buffer_size, uint32_t buffer_count, uint32
 
   // Allocate buffers and distribute to shards
   for (uint32_t i = 0U; i < buffer_count; ++i) {
-    // Allocate aligned memory for DMA/cache efficiency
+    if (slab_.base == nullptr) {
+      // Allocate aligned memory for DMA/cache efficiency
 #if STREAMING_DMA_ALIGNMENT > 0
-    uint8_t* ptr = static_cast<uint8_t*>(::operator new(buffer_size, std::align_val_t{STREAMING_DMA_ALIGNMENT}));
+      uint8_t* ptr = static_cast<uint8_t*>(::operator new(buffer_size, std::align_val_t{STREAMING_DMA_ALIGNMENT}));
 #else
-    uint8_t* ptr = static_cast<uint8_t*>(::operator new(buffer_size));
+      uint8_t* ptr = static_cast<uint8_t*>(::operator new(buffer_size));
 #endif
-    buffers_.push_back(ptr);
+      buffers_.push_back(ptr);
+    }
 
     // Determine which shard this buffer belongs to
     uint32_t shard_idx = GetBufferShard(i);
@@ -50,6 +179,7 @@ DMABufferPool::DMABufferPool(uint32_t buffer_size, uint32_t buffer_count, uint32
 }
 
 DMABufferPool::~DMABufferPool() {
+  FreeSlab();
   for (auto* buf : buffers_) {
 #if STREAMING_DMA_ALIGNMENT > 0
     ::operator delete(buf, std::align_val_t{STREAMING_DMA_ALIGNMENT});
@@ -59,7 +189,119 @@ DMABufferPool::~DMABufferPool() {
   }
 }
 
-DataToken DMABufferPool::TryBorrowFromShard(uint32_t shard_idx) {
+// ============================================================================
+// Slab
+// ============================================================================
+
+void DMABufferPool::AllocateSlab(const BufferPoolOptions& options) {
+#if STREAMING_DMA_ALIGNMENT > 0
+  const size_t alignment = STREAMING_DMA_ALIGNMENT;
+#else
+  const size_t alignment = 1U;
+#endif
+  const size_t stride = RoundUp((buffer_size_ > 0U) ? buffer_size_ : 1U, alignment);
+  const size_t payload_bytes = stride * ((buffer_count_ > 0U) ? buffer_count_ : 1U);
+  slab_.stride = static_cast<uint32_t>(stride);
+
+#if defined(__linux__)
+  const size_t page_size = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+  void* base = MAP_FAILED;
+  size_t bytes = 0U;
+#if defined(MAP_HUGETLB)
+  if (options.huge_pages) {
+    bytes = RoundUp(payload_bytes, kHugePageSize);
+    base = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    slab_.huge_pages = (base != MAP_FAILED);
+  }
+#endif
+#if defined(MADV_HUGEPAGE)
+  if (options.huge_pages && (base == MAP_FAILED)) {
+    // No hugetlbfs pages reserved: 2 MiB-aligned mapping advised for transparent huge pages
+    bytes = RoundUp(payload_bytes, kHugePageSize);
+    void* raw = ::mmap(nullptr, bytes + kHugePageSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (raw != MAP_FAILED) {
+      uint8_t* raw_begin = static_cast<uint8_t*>(raw);
+      uint8_t* aligned = reinterpret_cast<uint8_t*>(RoundUp(reinterpret_cast<uintptr_t>(raw_begin), kHugePageSize));
+      const size_t head = static_cast<size_t>(aligned - raw_begin);
+      if (head > 0U) {
+        (void)::munmap(raw_begin, head);
+      }
+      if ((kHugePageSize - head) > 0U) {
+        (void)::munmap(aligned + bytes, kHugePageSize - head);
+      }
+      (void)::madvise(aligned, bytes, MADV_HUGEPAGE);
+      base = aligned;
+    }
+  }
+#endif
+  if (base == MAP_FAILED) {
+    // Normal pages
+    bytes = RoundUp(payload_bytes, page_size);
+    base = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  }
+  if (base != MAP_FAILED) {
+    slab_.base = static_cast<uint8_t*>(base);
+    slab_.bytes = bytes;
+    slab_mapped_ = true;
+
+#if defined(SYS_mbind)
+    // Bind before first touch so the pages are faulted in on the requested node
+    constexpr uint32_t kMaskWords = 16U;  // up to 1024 nodes
+    constexpr uint32_t kWordBits = 8U * sizeof(unsigned long);
+    if ((options.numa_node >= 0) && (static_cast<uint32_t>(options.numa_node) < kMaskWords * kWordBits)) {
+      unsigned long mask[kMaskWords] = {};
+      const uint32_t node = static_cast<uint32_t>(options.numa_node);
+      mask[node / kWordBits] = 1UL << (node % kWordBits);
+      if (::syscall(SYS_mbind, base, bytes, kMpolBind, mask, kMaskWords * kWordBits, 0U) == 0) {
+        slab_.numa_node = options.numa_node;
+      }
+    }
+#endif
+
+    // Prefault now rather than on the first Borrow() of each page
+    const size_t touch_step = slab_.huge_pages ? kHugePageSize : page_size;
+    for (size_t offset = 0U; offset < bytes; offset += touch_step) {
+      slab_.base[offset] = 0U;
+    }
+    return;
+  }
+#else
+  (void)options;
+#endif
+
+  // No mmap(): still one contiguous, aligned allocation
+#if STREAMING_DMA_ALIGNMENT > 0
+  slab_.base = static_cast<uint8_t*>(::operator new(payload_bytes, std::align_val_t{STREAMING_DMA_ALIGNMENT}));
+#else
+  slab_.base = static_cast<uint8_t*>(::operator new(payload_bytes));
+#endif
+  slab_.bytes = payload_bytes;
+}
+
+void DMABufferPool::FreeSlab() noexcept {
+  if (slab_.base == nullptr) {
+    return;
+  }
+#if defined(__linux__)
+  if (slab_mapped_) {
+    (void)::munmap(slab_.base, slab_.bytes);
+    slab_.base = nullptr;
+    return;
+  }
+#endif
+#if STREAMING_DMA_ALIGNMENT > 0
+  ::operator delete(slab_.base, std::align_val_t{STREAMING_DMA_ALIGNMENT});
+#else
+  ::operator delete(slab_.base);
+#endif
+  slab_.base = nullptr;
+}
+
+// ============================================================================
+// Shard free lists
+// ============================================================================
+
+uint32_t DMABufferPool::PopFromShard(uint32_t shard_idx) noexcept {
   BufferPoolShard& shard = shards_[shard_idx];
 
   uint64_t old_head_packed = shard.free_head.load(std::memory_order_acquire);
@@ -69,7 +311,7 @@ DataToken DMABufferPool::TryBorrowFromShard(uint32_t shard_idx) {
 
     if (old_head.index == kInvalidIndex) {
       // This shard is empty
-      return DataToken();
+      return kInvalidIndex;
     }
 
     // Read next pointer BEFORE CAS
@@ -82,50 +324,25 @@ DataToken DMABufferPool::TryBorrowFromShard(uint32_t shard_idx) {
     // Try to CAS the head
     if (shard.free_head.compare_exchange_weak(old_head_packed, new_head_packed, std::memory_order_acq_rel,
                                               std::memory_order_acquire)) {
-      // Successfully borrowed buffer
       shard.available_count.fetch_sub(1U, std::memory_order_relaxed);
-      borrow_count_.fetch_add(1U, std::memory_order_relaxed);
-
-      auto now = std::chrono::steady_clock::now();
-      uint64_t timestamp = std::chrono::duration_cast<std::chrono::microseconds>(now.time_since_epoch()).count();
-
-      // Zero heap allocation: function pointer + context instead of new DMABufferReleaser
-      return DataToken(buffers_[old_head.index], buffer_size_, timestamp,
-                       &DMABufferPool::ReleaseBuffer, this, old_head.index);
+      return old_head.index;
     }
     // CAS failed, retry with updated value
   }
 }
 
-DataToken DMABufferPool::Borrow() {
-  // First, try the preferred shard for this thread
-  uint32_t preferred_shard = GetShardIndex();
-  DataToken token = TryBorrowFromShard(preferred_shard);
-
-  if (token.Valid()) {
-    return token;
-  }
-
-  // If preferred shard is empty, try other shards (work stealing)
-  for (uint32_t i = 1U; i < shard_count_; ++i) {
-    uint32_t shard_idx = (preferred_shard + i) % shard_count_;
-    token = TryBorrowFromShard(shard_idx);
-    if (token.Valid()) {
-      return token;
+uint32_t DMABufferPool::PopFromAnyShard(uint32_t preferred_shard) noexcept {
+  // First, try the preferred shard, then the others (work stealing)
+  for (uint32_t i = 0U; i < shard_count_; ++i) {
+    uint32_t index = PopFromShard((preferred_shard + i) % shard_count_);
+    if (index != kInvalidIndex) {
+      return index;
     }
   }
-
-  // All shards are empty
-  return DataToken();
+  return kInvalidIndex;
 }
 
-void DMABufferPool::Return(uint32_t index) {
-  if (index >= buffer_count_) {
-    return;  // Invalid index
-  }
-
-  // Return to the buffer's original shard
-  uint32_t shard_idx = GetBufferShard(index);
+void DMABufferPool::PushChainToShard(uint32_t shard_idx, uint32_t first, uint32_t last, uint32_t count) noexcept {
   BufferPoolShard& shard = shards_[shard_idx];
 
   uint64_t old_head_packed = shard.free_head.load(std::memory_order_acquire);
@@ -133,31 +350,385 @@ void DMABufferPool::Return(uint32_t index) {
   while (true) {
     TaggedIndex old_head = UnpackTaggedIndex(old_head_packed);
 
-    // Set next pointer of returned buffer to current head
-    next_free_[index].store(old_head.index, std::memory_order_relaxed);
+    // Link the tail of the chain to the current head
+    next_free_[last].store(old_head.index, std::memory_order_relaxed);
 
     // Create new head with incremented version (ABA protection)
-    TaggedIndex new_head(index, old_head.version + 1U);
+    TaggedIndex new_head(first, old_head.version + 1U);
     uint64_t new_head_packed = PackTaggedIndex(new_head);
 
     // Try to CAS the head
     if (shard.free_head.compare_exchange_weak(old_head_packed, new_head_packed, std::memory_order_acq_rel,
                                               std::memory_order_acquire)) {
-      // Successfully returned buffer
-      shard.available_count.fetch_add(1U, std::memory_order_relaxed);
-      return_count_.fetch_add(1U, std::memory_order_relaxed);
+      shard.available_count.fetch_add(count, std::memory_order_relaxed);
+      outstanding_.fetch_sub(count, std::memory_order_relaxed);
       return;
     }
     // CAS failed, retry with updated value
   }
 }
 
+// ============================================================================
+// Magazines
+// ============================================================================
+
+DMABufferPool::ThreadSlot* DMABufferPool::LocalSlot() noexcept {
+  if (t_thread_cache_destroyed) {
+    return nullptr;
+  }
+  static thread_local ThreadCache cache;
+
+  for (ThreadSlot& slot : cache.entries) {
+    if (slot.pool_id == pool_id_) {
+      return &slot;
+    }
+  }
+
+  // Miss: prefer an empty entry or one whose pool is gone, else evict round-robin
+  ThreadSlot* victim = nullptr;
+  for (ThreadSlot& slot : cache.entries) {
+    if ((slot.pool_id == 0U) || slot.table.expired()) {
+      victim = &slot;
+      break;
+    }
+  }
+  if (victim == nullptr) {
+    victim = &cache.entries[cache.next_victim];
+    cache.next_victim = (cache.next_victim + 1U) % kThreadCacheEntries;
+  }
+  ThreadCache::Release(*victim);
+
+  victim->pool_id = pool_id_;
+  victim->table = magazines_;
+  victim->magazine = ClaimMagazine();
+  victim->shard = GetShardIndex();
+  return victim;
+}
+
+DMABufferPool::Magazine* DMABufferPool::ClaimMagazine() noexcept {
+  if (magazines_ == nullptr) {
+    return nullptr;
+  }
+  for (Magazine& mag : magazines_->slots) {
+    uint32_t expected = kMagazineFree;
+    if (mag.state.compare_exchange_strong(expected, kMagazineOwned, std::memory_order_acquire,
+                                          std::memory_order_relaxed)) {
+      return &mag;  // Adopts whatever a previous owner left behind
+    }
+  }
+  return nullptr;
+}
+
+uint32_t DMABufferPool::RefillMagazine(Magazine& mag, uint32_t preferred_shard) noexcept {
+  const uint32_t batch = magazine_capacity_ / 2U;
+  uint32_t count = 0U;
+  for (uint32_t i = 0U; (i < shard_count_) && (count < batch); ++i) {
+    const uint32_t shard_idx = (preferred_shard + i) % shard_count_;
+    while (count < batch) {
+      uint32_t index = PopFromShard(shard_idx);
+      if (index == kInvalidIndex) {
+        break;
+      }
+      mag.indices[count] = index;
+      ++count;
+    }
+  }
+  if (count > 0U) {
+    NoteTaken(count);
+  }
+  mag.count.store(count, std::memory_order_relaxed);
+  return count;
+}
+
+void DMABufferPool::FlushMagazine(Magazine& mag, uint32_t shard_idx, uint32_t count) noexcept {
+  const uint32_t held = mag.count.load(std::memory_order_relaxed);
+  if ((count == 0U) || (count > held)) {
+    return;
+  }
+
+  // Flush the oldest entries (bottom of the LIFO) as one chain, one CAS
+  for (uint32_t i = 0U; (i + 1U) < count; ++i) {
+    next_free_[mag.indices[i]].store(mag.indices[i + 1U], std::memory_order_relaxed);
+  }
+  PushChainToShard(shard_idx, mag.indices[0], mag.indices[count - 1U], count);
+
+  const uint32_t remaining = held - count;
+  for (uint32_t i = 0U; i < remaining; ++i) {
+    mag.indices[i] = mag.indices[count + i];
+  }
+  mag.count.store(remaining, std::memory_order_relaxed);
+}
+
+uint32_t DMABufferPool::StealFromIdleMagazines(uint32_t shard_idx) noexcept {
+  if (magazines_ == nullptr) {
+    return kInvalidIndex;
+  }
+  for (Magazine& mag : magazines_->slots) {
+    if (mag.count.load(std::memory_order_relaxed) == 0U) {
+      continue;
+    }
+    uint32_t expected = kMagazineFree;
+    if (!mag.state.compare_exchange_strong(expected, kMagazineDraining, std::memory_order_acquire,
+                                           std::memory_order_relaxed)) {
+      continue;
+    }
+    uint32_t held = mag.count.load(std::memory_order_relaxed);
+    uint32_t index = kInvalidIndex;
+    if (held > 0U) {
+      index = mag.indices[held - 1U];
+      mag.count.store(held - 1U, std::memory_order_relaxed);
+      // Spill the rest so other threads see them too
+      FlushMagazine(mag, shard_idx, held - 1U);
+    }
+    mag.state.store(kMagazineFree, std::memory_order_release);
+    if (index != kInvalidIndex) {
+      return index;
+    }
+  }
+  return kInvalidIndex;
+}
+
+// ============================================================================
+// Borrow / Return
+// ============================================================================
+
+void DMABufferPool::NoteTaken(uint32_t count) noexcept {
+  const uint32_t outstanding = outstanding_.fetch_add(count, std::memory_order_relaxed) + count;
+  uint32_t peak = peak_outstanding_.load(std::memory_order_relaxed);
+  while ((outstanding > peak) && !peak_outstanding_.compare_exchange_weak(peak, outstanding, std::memory_order_relaxed,
+                                                                           std::memory_order_relaxed)) {
+  }
+}
+
+DataToken DMABufferPool::MakeToken(uint32_t index, uint32_t len) noexcept {
+  auto now = std::chrono::steady_clock::now();
+  uint64_t timestamp = std::chrono::duration_cast<std::chrono::microseconds>(now.time_since_epoch()).count();
+
+  // Zero heap allocation: function pointer + context instead of new DMABufferReleaser
+  return DataToken(BufferAddress(index), len, timestamp, &DMABufferPool::ReleaseBuffer, this, index);
+}
+
+SharedDataToken DMABufferPool::MakeSharedToken(uint32_t index, uint32_t len) noexcept {
+  auto now = std::chrono::steady_clock::now();
+  uint64_t timestamp = std::chrono::duration_cast<std::chrono::microseconds>(now.time_since_epoch()).count();
+
+  // Published to other owners through whatever hands them the token
+  refcounts_[index].store(1U, std::memory_order_relaxed);
+  return SharedDataToken(BufferAddress(index), len, timestamp, &DMABufferPool::ReleaseBuffer, this, index,
+                         &refcounts_[index]);
+}
+
+uint32_t DMABufferPool::AcquireIndex() noexcept {
+  ThreadSlot* slot = LocalSlot();
+  const uint32_t shard_idx = (slot != nullptr) ? slot->shard : GetShardIndex();
+  Magazine* mag = (slot != nullptr) ? slot->magazine : nullptr;
+
+  if (mag != nullptr) {
+    // Fast path: thread-owned LIFO, no atomic RMW
+    uint32_t count = mag->count.load(std::memory_order_relaxed);
+    if (count == 0U) {
+      count = RefillMagazine(*mag, shard_idx);
+    }
+    if (count > 0U) {
+      --count;
+      const uint32_t index = mag->indices[count];
+      mag->count.store(count, std::memory_order_relaxed);
+      mag->borrows.store(mag->borrows.load(std::memory_order_relaxed) + 1U, std::memory_order_relaxed);
+      return index;
+    }
+  } else {
+    const uint32_t index = PopFromAnyShard(shard_idx);
+    if (index != kInvalidIndex) {
+      NoteTaken(1U);
+      borrow_count_.fetch_add(1U, std::memory_order_relaxed);
+      return index;
+    }
+  }
+
+  // Shards are empty: reclaim buffers stranded in magazines of exited threads
+  const uint32_t index = StealFromIdleMagazines(shard_idx);
+  if (index != kInvalidIndex) {
+    borrow_count_.fetch_add(1U, std::memory_order_relaxed);
+    return index;
+  }
+
+  // All shards are empty
+  exhausted_count_.fetch_add(1U, std::memory_order_relaxed);
+  return kInvalidIndex;
+}
+
+DataToken DMABufferPool::Borrow() {
+  const uint32_t index = AcquireIndex();
+  return (index != kInvalidIndex) ? MakeToken(index, buffer_size_) : DataToken();
+}
+
+DataToken DMABufferPool::Borrow(uint32_t len) {
+  if (len > buffer_size_) {
+    return DataToken();
+  }
+  const uint32_t index = AcquireIndex();
+  return (index != kInvalidIndex) ? MakeToken(index, len) : DataToken();
+}
+
+SharedDataToken DMABufferPool::BorrowShared() {
+  const uint32_t index = AcquireIndex();
+  return (index != kInvalidIndex) ? MakeSharedToken(index, buffer_size_) : SharedDataToken();
+}
+
+SharedDataToken DMABufferPool::BorrowShared(uint32_t len) {
+  if (len > buffer_size_) {
+    return SharedDataToken();
+  }
+  const uint32_t index = AcquireIndex();
+  return (index != kInvalidIndex) ? MakeSharedToken(index, len) : SharedDataToken();
+}
+
+void DMABufferPool::Return(uint32_t index) {
+  if (index >= buffer_count_) {
+    return;  // Invalid index
+  }
+
+  ThreadSlot* slot = LocalSlot();
+  Magazine* mag = (slot != nullptr) ? slot->magazine : nullptr;
+
+  if (mag != nullptr) {
+    uint32_t count = mag->count.load(std::memory_order_relaxed);
+    if (count == magazine_capacity_) {
+      FlushMagazine(*mag, slot->shard, magazine_capacity_ / 2U);
+      count = mag->count.load(std::memory_order_relaxed);
+    }
+    mag->indices[count] = index;
+    mag->count.store(count + 1U, std::memory_order_relaxed);
+    mag->returns.store(mag->returns.load(std::memory_order_relaxed) + 1U, std::memory_order_relaxed);
+    return;
+  }
+
+  // Return to the buffer's original shard
+  PushChainToShard(GetBufferShard(index), index, index, 1U);
+  return_count_.fetch_add(1U, std::memory_order_relaxed);
+}
+
+bool DMABufferPool::BindThreadToShard(uint32_t shard) noexcept {
+  if (shard >= shard_count_) {
+    return false;
+  }
+  ThreadSlot* slot = LocalSlot();
+  if (slot == nullptr) {
+    return false;
+  }
+  slot->shard = shard;
+  return true;
+}
+
+void DMABufferPool::ReleaseThreadCache() noexcept {
+  ThreadSlot* slot = LocalSlot();
+  if (slot == nullptr) {
+    return;
+  }
+  if (slot->magazine != nullptr) {
+    FlushMagazine(*slot->magazine, slot->shard, slot->magazine->count.load(std::memory_order_relaxed));
+  }
+  ThreadCache::Release(*slot);
+}
+
+// ============================================================================
+// Statistics
+// ============================================================================
+
 uint32_t DMABufferPool::AvailableBuffers() const {
   uint32_t total = 0U;
   for (uint32_t s = 0U; s < shard_count_; ++s) {
     total += shards_[s].available_count.load(std::memory_order_relaxed);
   }
+  if (magazines_ != nullptr) {
+    for (const Magazine& mag : magazines_->slots) {
+      total += mag.count.load(std::memory_order_relaxed);
+    }
+  }
+  return total;
+}
+
+uint64_t DMABufferPool::BorrowCount() const {
+  uint64_t total = borrow_count_.load(std::memory_order_relaxed);
+  if (magazines_ != nullptr) {
+    for (const Magazine& mag : magazines_->slots) {
+      total += mag.borrows.load(std::memory_order_relaxed);
+    }
+  }
+  return total;
+}
+
+uint64_t DMABufferPool::ReturnCount() const {
+  uint64_t total = return_count_.load(std::memory_order_relaxed);
+  if (magazines_ != nullptr) {
+    for (const Magazine& mag : magazines_->slots) {
+      total += mag.returns.load(std::memory_order_relaxed);
+    }
+  }
   return total;
 }
 
+// ============================================================================
+// SizeClassBufferPool
+// ============================================================================
+
+SizeClassBufferPool::SizeClassBufferPool(const std::vector<BufferSizeClass>& classes,
+                                         const BufferPoolOptions& options)
+    : oversize_count_(0U) {
+  std::vector<BufferSizeClass> sorted;
+  sorted.reserve(classes.size());
+  for (const BufferSizeClass& cls : classes) {
+    if (cls.buffer_count > 0U) {
+      sorted.push_back(cls);
+    }
+  }
+  std::sort(sorted.begin(), sorted.end(), [](const BufferSizeClass& a, const BufferSizeClass& b) {
+    return a.buffer_size < b.buffer_size;
+  });
+
+  classes_.reserve(sorted.size());
+  for (const BufferSizeClass& cls : sorted) {
+    classes_.push_back(std::make_unique<DMABufferPool>(cls.buffer_size, cls.buffer_count, options));
+  }
+}
+
+int32_t SizeClassBufferPool::ClassFor(uint32_t len) const noexcept {
+  for (uint32_t i = 0U; i < classes_.size(); ++i) {
+    if (classes_[i]->BufferSize() >= len) {
+      return static_cast<int32_t>(i);
+    }
+  }
+  return -1;
+}
+
+DataToken SizeClassBufferPool::Borrow(uint32_t len) {
+  const int32_t class_index = ClassFor(len);
+  if (class_index < 0) {
+    oversize_count_.fetch_add(1U, std::memory_order_relaxed);
+    return DataToken();
+  }
+  return classes_[static_cast<uint32_t>(class_index)]->Borrow(len);
+}
+
+SharedDataToken SizeClassBufferPool::BorrowShared(uint32_t len) {
+  const int32_t class_index = ClassFor(len);
+  if (class_index < 0) {
+    oversize_count_.fetch_add(1U, std::memory_order_relaxed);
+    return SharedDataToken();
+  }
+  return classes_[static_cast<uint32_t>(class_index)]->BorrowShared(len);
+}
+
+BufferClassStats SizeClassBufferPool::ClassStats(uint32_t class_index) const {
+  const DMABufferPool& pool = *classes_[class_index];
+  BufferClassStats stats;
+  stats.buffer_size = pool.BufferSize();
+  stats.total = pool.TotalBuffers();
+  stats.in_use = pool.InUse();
+  stats.high_watermark = pool.HighWatermark();
+  stats.borrows = pool.BorrowCount();
+  stats.exhausted = pool.ExhaustedCount();
+  return stats;
+}
+
 } /* namespace streaming */
@@ -19,6 +19,7 @@
 
 #include <cstdint>
 
+#include <atomic>
 #include <memory>
 #include <utility>
 
@@ -154,6 +155,165 @@ class DataToken {
  */
 using TokenRef = std::shared_ptr<DataToken>;
 
+/**
+ * @brief Reference-counted zero-copy token for fan-out to multiple consumers
+ *
+ * The reference count lives in the pool's per-buffer metadata rather than in
+ * a heap control block, so copying (Clone()) is a single relaxed increment.
+ * The last release returns the buffer through the same function-pointer
+ * releaser as DataToken. Copyable and the same size as DataToken, so it can
+ * be a PayloadVariant alternative: each subscriber that needs the frame
+ * beyond its callback copies the token out of the envelope.
+ */
+class SharedDataToken {
+ public:
+  /**
+   * @brief Default constructor - creates invalid token
+   */
+  SharedDataToken() noexcept
+      : ptr_(nullptr), timestamp_us_(0U), release_fn_(nullptr), release_ctx_(nullptr), refcount_(nullptr),
+        len_(0U), buffer_index_(0U) {}
+
+  /**
+   * @brief Construct token adopting one reference already counted in @p refcount
+   * @param ptr Pointer to data buffer
+   * @param len Size of data in bytes
+   * @param timestamp Timestamp in microseconds
+   * @param release_fn Function pointer for buffer return (called by the last owner)
+   * @param release_ctx Opaque context (typically pool pointer)
+   * @param buffer_index Buffer index in the pool
+   * @param refcount Pool-side reference count of the buffer
+   */
+  SharedDataToken(const uint8_t* ptr, uint32_t len, uint64_t timestamp, ReleaseCallback release_fn,
+                  void* release_ctx, uint32_t buffer_index, std::atomic<uint32_t>* refcount) noexcept
+      : ptr_(ptr), timestamp_us_(timestamp), release_fn_(release_fn), release_ctx_(release_ctx),
+        refcount_(refcount), len_(len), buffer_index_(buffer_index) {}
+
+  /**
+   * @brief Copy constructor - adds a reference
+   * @param other Token to share
+   */
+  SharedDataToken(const SharedDataToken& other) noexcept
+      : ptr_(other.ptr_), timestamp_us_(other.timestamp_us_), release_fn_(other.release_fn_),
+        release_ctx_(other.release_ctx_), refcount_(other.refcount_), len_(other.len_),
+        buffer_index_(other.buffer_index_) {
+    Retain();
+  }
+
+  /**
+   * @brief Move constructor
+   * @param other Token to move from
+   */
+  SharedDataToken(SharedDataToken&& other) noexcept
+      : ptr_(other.ptr_), timestamp_us_(other.timestamp_us_), release_fn_(other.release_fn_),
+        release_ctx_(other.release_ctx_), refcount_(other.refcount_), len_(other.len_),
+        buffer_index_(other.buffer_index_) {
+    other.Clear();
+  }
+
+  /**
+   * @brief Copy assignment operator
+   * @param other Token to share
+   * @return Reference to this
+   */
+  SharedDataToken& operator=(const SharedDataToken& other) noexcept {
+    if (this != &other) {
+      other.Retain();
+      Release();
+      Assign(other);
+    }
+    return *this;
+  }
+
+  /**
+   * @brief Move assignment operator
+   * @param other Token to move from
+   * @return Reference to this
+   */
+  SharedDataToken& operator=(SharedDataToken&& other) noexcept {
+    if (this != &other) {
+      Release();
+      Assign(other);
+      other.Clear();
+    }
+    return *this;
+  }
+
+  /**
+   * @brief Destructor - drops a reference, the last one returns the buffer
+   */
+  ~SharedDataToken() noexcept { Release(); }
+
+  /**
+   * @brief Add a reference (same as copying)
+   */
+  SharedDataToken Clone() const noexcept { return SharedDataToken(*this); }
+
+  // --- Accessors (lowercase per Google style) ---
+
+  /** @brief Get pointer to data */
+  const uint8_t* data() const noexcept { return ptr_; }
+
+  /** @brief Get size of data in bytes */
+  uint32_t size() const noexcept { return len_; }
+
+  /** @brief Get timestamp in microseconds */
+  uint64_t timestamp() const noexcept { return timestamp_us_; }
+
+  /** @brief Check if token is valid */
+  bool valid() const noexcept { return ptr_ != nullptr; }
+
+  /** @brief Get number of tokens sharing the buffer (0 if invalid; approximate under concurrency) */
+  uint32_t use_count() const noexcept {
+    return (refcount_ != nullptr) ? refcount_->load(std::memory_order_relaxed) : 0U;
+  }
+
+ private:
+  void Retain() const noexcept {
+    if (refcount_ != nullptr) {
+      refcount_->fetch_add(1U, std::memory_order_relaxed);
+    }
+  }
+
+  void Release() noexcept {
+    if (refcount_ != nullptr) {
+      // acq_rel: all owners' accesses happen-before the buffer goes back to the pool
+      if ((refcount_->fetch_sub(1U, std::memory_order_acq_rel) == 1U) && (release_fn_ != nullptr)) {
+        release_fn_(release_ctx_, buffer_index_);
+      }
+    }
+    Clear();
+  }
+
+  void Assign(const SharedDataToken& other) noexcept {
+    ptr_ = other.ptr_;
+    timestamp_us_ = other.timestamp_us_;
+    release_fn_ = other.release_fn_;
+    release_ctx_ = other.release_ctx_;
+    refcount_ = other.refcount_;
+    len_ = other.len_;
+    buffer_index_ = other.buffer_index_;
+  }
+
+  void Clear() noexcept {
+    ptr_ = nullptr;
+    timestamp_us_ = 0U;
+    release_fn_ = nullptr;
+    release_ctx_ = nullptr;
+    refcount_ = nullptr;
+    len_ = 0U;
+    buffer_index_ = 0U;
+  }
+
+  const uint8_t* ptr_;
+  uint64_t timestamp_us_;
+  ReleaseCallback release_fn_;       /**< Function pointer for buffer return (no heap alloc) */
+  void* release_ctx_;                /**< Opaque context (e.g., DMABufferPool*) */
+  std::atomic<uint32_t>* refcount_;  /**< Pool-side per-buffer reference count */
+  uint32_t len_;
+  uint32_t buffer_index_; /**< Buffer index in pool */
+};
+
 } /* namespace streaming */
 
 #endif /* INCLUDE_DATA_TOKEN_HPP_ */
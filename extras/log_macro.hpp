@@ -8,6 +8,8 @@
  * - Automatic file, line, and function information
  * - Thread-safe output
  * - Minimal performance impact when disabled
+ * - Optional asynchronous backend (LOG_ASYNC=1): deferred formatting,
+ *   per-thread lock-free rings, batched writev() from a background thread
  *
  * Usage:
  *   Define LOG_LEVEL before including this header:
@@ -17,17 +19,41 @@
  *   Then use:
  *   LOG_INFO("Server started on port %d", port);
  *   LOG_ERROR("Failed to connect: %s", error_msg);
+ *
+ * Asynchronous backend:
+ *   #define LOG_ASYNC 1 before including the header. LOG_* then copies the
+ *   timestamp, format pointer and arguments into a fixed-size record in the
+ *   calling thread's SPSC ring (no lock, no heap, no syscall) and returns.
+ *   A background thread formats the records and writes them to stderr in
+ *   batches. A full ring drops the record and counts it (log_dropped()).
+ *   - Format strings must be literals (only the pointer is stored)
+ *   - Arguments: arithmetic types, pointers and C strings; strings are copied
+ *     into the record (up to LOG_ASYNC_TEXT_BYTES in total per record)
+ *   - Output is delayed by up to LOG_ASYNC_POLL_US; LOG_FATAL / LOG_ASSERT
+ *     and LOG_FLUSH() drain every ring before returning
+ *   The setting is per translation unit, like LOG_LEVEL.
  */
 
 #pragma once
 
+#include <sys/uio.h>
+#include <unistd.h>
+
 #include <cinttypes>
 #include <cstdint>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <chrono>
+#include <memory>
 #include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
 
 // ============================================================================
 // Log Level Definitions
@@ -46,6 +72,11 @@
 #define LOG_LEVEL LOG_LEVEL_INFO
 #endif
 
+// Asynchronous backend (per translation unit, default: synchronous)
+#ifndef LOG_ASYNC
+#define LOG_ASYNC 0
+#endif
+
 // ============================================================================
 // Internal Implementation
 // ============================================================================
@@ -90,53 +121,559 @@ inline void log_print(const char* level, const char* file, int32_t line, const c
   std::fflush(stderr);
 }
 
+// ============================================================================
+// Asynchronous Backend (LOG_ASYNC=1)
+// ============================================================================
+//
+// The sizes below define the record layout shared by every translation unit,
+// so they are fixed constants rather than per-TU macros.
+
+/** Records per thread ring (power of 2). 256 x 256 B = 64 KiB per logging thread. */
+constexpr uint32_t LOG_ASYNC_RING_RECORDS = 256U;
+/** Maximum printf arguments per LOG_* call. */
+constexpr uint32_t LOG_ASYNC_MAX_ARGS = 12U;
+/** Bytes per record for copied %s arguments; longer strings are truncated. */
+constexpr uint32_t LOG_ASYNC_TEXT_BYTES = 96U;
+/** Background thread sleep when every ring is empty. */
+constexpr uint32_t LOG_ASYNC_POLL_US = 1000U;
+/** Formatted lines per writev() call. */
+constexpr uint32_t LOG_ASYNC_BATCH_LINES = 64U;
+/** Maximum formatted line length; longer lines are truncated. */
+constexpr uint32_t LOG_ASYNC_LINE_BYTES = 512U;
+
+static_assert((LOG_ASYNC_RING_RECORDS & (LOG_ASYNC_RING_RECORDS - 1U)) == 0U,
+              "LOG_ASYNC_RING_RECORDS must be a power of 2");
+
+/** Promoted printf argument type, as the synchronous path would pass it. */
+enum class LogArgType : uint8_t { kInt, kUInt, kLong, kULong, kLLong, kULLong, kDouble, kLDouble, kPtr, kStr };
+
+/** One deferred LOG_* call: format pointer plus captured arguments. */
+struct AsyncLogRecord {
+  uint64_t timestamp_us;
+  const char* level;
+  const char* file;
+  const char* func;
+  const char* fmt;
+  int32_t line;
+  uint8_t arg_count;
+  uint8_t text_used;
+  LogArgType types[LOG_ASYNC_MAX_ARGS];
+  uint64_t args[LOG_ASYNC_MAX_ARGS];  // value bits; kStr: text offset << 8 | length
+  char text[LOG_ASYNC_TEXT_BYTES];
+};
+static_assert(sizeof(AsyncLogRecord) == 256U, "AsyncLogRecord should stay 4 cache lines");
+static_assert(std::is_trivially_copyable<AsyncLogRecord>::value, "AsyncLogRecord must be trivially copyable");
+
+/** kStr marker for a null char pointer (printed as "(null)", like glibc). */
+constexpr uint64_t LOG_ASYNC_NULL_STR = UINT64_MAX;
+
+/**
+ * @brief Per-thread SPSC ring: the owning thread produces, the backend consumes.
+ *
+ * Shared between the thread_local holder and the backend registry so records
+ * written just before a thread exits are still drained.
+ */
+struct AsyncLogRing {
+  std::array<AsyncLogRecord, LOG_ASYNC_RING_RECORDS> records;
+  alignas(64) std::atomic<uint32_t> head{0U};
+  uint32_t cached_tail{0U};  // producer-side copy of tail
+  alignas(64) std::atomic<uint32_t> tail{0U};
+  std::atomic<uint64_t> dropped{0U};
+  std::atomic<bool> retired{false};  // owning thread has exited
+};
+
+template <typename T>
+struct LogAlwaysFalse : std::false_type {};
+
+/**
+ * @brief Precision of the conversion in rec.fmt that consumes argument index.
+ *
+ * Walks the format like format_log_record(); a '*' precision is read from the
+ * argument already captured before it.
+ *
+ * @return Precision, or -1 when the conversion has none (or a negative '*')
+ */
+inline int log_arg_precision(const AsyncLogRecord& rec, uint32_t index) noexcept {
+  const char* f = rec.fmt;
+  uint32_t arg = 0U;
+  while (*f != '\0') {
+    if (*f != '%') {
+      ++f;
+      continue;
+    }
+    if (f[1] == '%') {
+      f += 2;
+      continue;
+    }
+    ++f;
+    int precision = -1;
+    bool in_precision = false;
+    while ((*f != '\0') && (std::strchr("diouxXeEfFgGaAcspn", *f) == nullptr)) {
+      if (*f == '.') {
+        in_precision = true;
+        precision = 0;
+      } else if (*f == '*') {
+        if (in_precision && (arg < index)) {
+          precision = static_cast<int>(rec.args[arg]);
+        }
+        ++arg;
+      } else if (in_precision && (*f >= '0') && (*f <= '9')) {
+        precision = precision * 10 + (*f - '0');
+      }
+      ++f;
+    }
+    if ((*f == '\0') || (arg > index)) {
+      return -1;
+    }
+    if (arg == index) {
+      return (precision < 0) ? -1 : precision;
+    }
+    ++arg;
+    ++f;
+  }
+  return -1;
+}
+
+/** Store one argument with the type default argument promotion would give it. */
+template <typename T>
+inline void capture_log_arg(AsyncLogRecord& rec, const T& value) noexcept {
+  using U = std::decay_t<T>;
+  const uint32_t i = rec.arg_count++;
+  if constexpr (std::is_same<U, const char*>::value || std::is_same<U, char*>::value) {
+    const char* str = value;  // also decays char arrays and string literals
+    rec.types[i] = LogArgType::kStr;
+    if (str == nullptr) {
+      rec.args[i] = LOG_ASYNC_NULL_STR;
+      return;
+    }
+    // Read no further than printf would: the precision ("%.*s" on unterminated data) and the array extent
+    size_t bound = LOG_ASYNC_TEXT_BYTES - rec.text_used;
+    if constexpr (std::is_array<T>::value) {
+      bound = std::min(bound, std::extent<T>::value);
+    }
+    const int precision = log_arg_precision(rec, i);
+    if ((precision >= 0) && (static_cast<size_t>(precision) < bound)) {
+      bound = static_cast<size_t>(precision);
+    }
+    const size_t len = strnlen(str, bound);
+    if (len > 0U) {
+      std::memcpy(&rec.text[rec.text_used], str, len);
+    }
+    rec.args[i] = (static_cast<uint64_t>(rec.text_used) << 8U) | len;
+    rec.text_used = static_cast<uint8_t>(rec.text_used + len);
+  } else if constexpr (std::is_pointer<U>::value || std::is_null_pointer<U>::value) {
+    rec.types[i] = LogArgType::kPtr;
+    rec.args[i] = reinterpret_cast<uintptr_t>(static_cast<const volatile void*>(value));
+  } else if constexpr (std::is_floating_point<U>::value) {
+    const double d = static_cast<double>(value);  // long double is narrowed to double
+    rec.types[i] = std::is_same<U, long double>::value ? LogArgType::kLDouble : LogArgType::kDouble;
+    std::memcpy(&rec.args[i], &d, sizeof(d));
+  } else if constexpr (std::is_integral<U>::value || std::is_enum<U>::value) {
+    using P = decltype(+value);  // integral promotion (unscoped enums included)
+    static_assert(std::is_integral<P>::value, "scoped enums must be cast before logging");
+    if constexpr (std::is_same<P, int>::value) {
+      rec.types[i] = LogArgType::kInt;
+    } else if constexpr (std::is_same<P, unsigned int>::value) {
+      rec.types[i] = LogArgType::kUInt;
+    } else if constexpr (std::is_same<P, long>::value) {
+      rec.types[i] = LogArgType::kLong;
+    } else if constexpr (std::is_same<P, unsigned long>::value) {
+      rec.types[i] = LogArgType::kULong;
+    } else if constexpr (std::is_same<P, long long>::value) {
+      rec.types[i] = LogArgType::kLLong;
+    } else {
+      rec.types[i] = LogArgType::kULLong;
+    }
+    rec.args[i] = static_cast<uint64_t>(+value);
+  } else {
+    static_assert(LogAlwaysFalse<U>::value, "async LOG_* arguments must be arithmetic, pointers or C strings");
+  }
+}
+
+/** snprintf one conversion, forwarding '*' width/precision arguments. */
+template <typename V>
+inline int format_log_conversion(char* out, size_t cap, const char* spec, const int* stars, uint32_t star_count,
+                                 V value) noexcept {
+  if (star_count == 0U) {
+    return std::snprintf(out, cap, spec, value);
+  }
+  if (star_count == 1U) {
+    return std::snprintf(out, cap, spec, stars[0], value);
+  }
+  return std::snprintf(out, cap, spec, stars[0], stars[1], value);
+}
+
+inline int format_log_arg(char* out, size_t cap, const char* spec, const int* stars, uint32_t star_count,
+                          const AsyncLogRecord& rec, uint32_t i) noexcept {
+  const uint64_t bits = rec.args[i];
+  double d = 0.0;
+  switch (rec.types[i]) {
+    case LogArgType::kInt:
+      return format_log_conversion(out, cap, spec, stars, star_count, static_cast<int>(bits));
+    case LogArgType::kUInt:
+      return format_log_conversion(out, cap, spec, stars, star_count, static_cast<unsigned int>(bits));
+    case LogArgType::kLong:
+      return format_log_conversion(out, cap, spec, stars, star_count, static_cast<long>(bits));
+    case LogArgType::kULong:
+      return format_log_conversion(out, cap, spec, stars, star_count, static_cast<unsigned long>(bits));
+    case LogArgType::kLLong:
+      return format_log_conversion(out, cap, spec, stars, star_count, static_cast<long long>(bits));
+    case LogArgType::kULLong:
+      return format_log_conversion(out, cap, spec, stars, star_count, static_cast<unsigned long long>(bits));
+    case LogArgType::kDouble:
+      std::memcpy(&d, &bits, sizeof(d));
+      return format_log_conversion(out, cap, spec, stars, star_count, d);
+    case LogArgType::kLDouble:
+      std::memcpy(&d, &bits, sizeof(d));
+      return format_log_conversion(out, cap, spec, stars, star_count, static_cast<long double>(d));
+    case LogArgType::kPtr:
+      return format_log_conversion(out, cap, spec, stars, star_count, reinterpret_cast<void*>(bits));
+    case LogArgType::kStr: {
+      if (bits == LOG_ASYNC_NULL_STR) {
+        return format_log_conversion(out, cap, spec, stars, star_count, "(null)");
+      }
+      char str[LOG_ASYNC_TEXT_BYTES + 1U];
+      const size_t len = bits & 0xFFU;
+      std::memcpy(str, &rec.text[bits >> 8U], len);
+      str[len] = '\0';
+      return format_log_conversion(out, cap, spec, stars, star_count, static_cast<const char*>(str));
+    }
+    default:
+      return 0;
+  }
+}
+
+/**
+ * @brief Format one record as "[ts] [LEVEL] [file:line:func] message\n".
+ * @return Line length (at most cap - 1, always newline-terminated).
+ */
+inline size_t format_log_record(const AsyncLogRecord& rec, char* out, size_t cap) noexcept {
+  const size_t limit = cap - 1U;  // room for '\n'
+  auto advance = [limit](size_t pos, int written) {
+    return (written <= 0) ? pos : std::min(limit, pos + static_cast<size_t>(written));
+  };
+  size_t pos = advance(0U, std::snprintf(out, cap, "[%" PRIu64 "] [%s] [%s:%d:%s] ", rec.timestamp_us, rec.level,
+                                          rec.file, rec.line, rec.func));
+
+  const char* f = rec.fmt;
+  if (rec.arg_count == 0U) {
+    // Same as the no-args synchronous overload: printed verbatim
+    pos = advance(pos, std::snprintf(out + pos, cap - pos, "%s", f));
+    f = "";
+  }
+  uint32_t arg = 0U;
+  while ((*f != '\0') && (pos < limit)) {
+    if (*f != '%') {
+      out[pos++] = *f++;
+      continue;
+    }
+    if (f[1] == '%') {
+      out[pos++] = '%';
+      f += 2;
+      continue;
+    }
+    // Collect one conversion spec: flags, width, precision, length, type
+    char spec[32];
+    size_t n = 0U;
+    int stars[2] = {0, 0};
+    uint32_t star_count = 0U;
+    spec[n++] = *f++;
+    while ((*f != '\0') && (std::strchr("diouxXeEfFgGaAcspn", *f) == nullptr) && (n < sizeof(spec) - 2U)) {
+      if ((*f == '*') && (star_count < 2U) && (arg < rec.arg_count)) {
+        stars[star_count++] = static_cast<int>(rec.args[arg++]);
+      }
+      spec[n++] = *f++;
+    }
+    if ((*f == '\0') || (arg >= rec.arg_count)) {
+      break;  // malformed spec or missing argument: stop like a truncated line
+    }
+    const char conversion = *f++;
+    spec[n++] = conversion;
+    spec[n] = '\0';
+    if (conversion != 'n') {
+      pos = advance(pos, format_log_arg(out + pos, cap - pos, spec, stars, star_count, rec, arg));
+    }
+    ++arg;
+  }
+  out[pos++] = '\n';
+  return pos;
+}
+
+/**
+ * @brief Background writer: owns the ring registry and drains it in batches.
+ *
+ * Started by the first async LOG_* call of the process. The destructor
+ * (static destruction at exit) stops the thread and drains what is left.
+ */
+class AsyncLogBackend {
+ public:
+  static AsyncLogBackend& Instance() {
+    static AsyncLogBackend backend;
+    return backend;
+  }
+
+  /** nullptr until the first async LOG_* call (LOG_FLUSH() does not start it). */
+  static AsyncLogBackend* Started() noexcept { return started().load(std::memory_order_acquire); }
+
+  AsyncLogBackend(const AsyncLogBackend&) = delete;
+  AsyncLogBackend& operator=(const AsyncLogBackend&) = delete;
+
+  ~AsyncLogBackend() {
+    stop_.store(true, std::memory_order_release);
+    if (thread_.joinable()) {
+      thread_.join();
+    }
+    Flush();
+    started().store(nullptr, std::memory_order_release);
+  }
+
+  void Register(std::shared_ptr<AsyncLogRing> ring) {
+    std::lock_guard<std::mutex> lock(registry_mutex_);
+    rings_.push_back(std::move(ring));
+  }
+
+  /** Write every record committed before the call, then return. */
+  void Flush() noexcept {
+    std::lock_guard<std::mutex> lock(drain_mutex_);
+    (void)DrainAll();
+  }
+
+  /** Records dropped because a thread's ring was full. */
+  uint64_t Dropped() noexcept {
+    std::lock_guard<std::mutex> lock(registry_mutex_);
+    uint64_t total = retired_dropped_;
+    for (const auto& ring : rings_) {
+      total += ring->dropped.load(std::memory_order_relaxed);
+    }
+    return total;
+  }
+
+  /** Output file descriptor (default 2, stderr). */
+  void set_fd(int fd) noexcept { fd_.store(fd, std::memory_order_relaxed); }
+
+ private:
+  static std::atomic<AsyncLogBackend*>& started() noexcept {
+    static std::atomic<AsyncLogBackend*> ptr{nullptr};
+    return ptr;
+  }
+
+  AsyncLogBackend() {
+    started().store(this, std::memory_order_release);
+    thread_ = std::thread([this]() { Run(); });
+  }
+
+  void Run() noexcept {
+    while (!stop_.load(std::memory_order_acquire)) {
+      uint32_t written = 0U;
+      {
+        std::lock_guard<std::mutex> lock(drain_mutex_);
+        written = DrainAll();
+      }
+      if (written == 0U) {
+        std::this_thread::sleep_for(std::chrono::microseconds(LOG_ASYNC_POLL_US));
+      }
+    }
+  }
+
+  /** One pass over all rings (caller holds drain_mutex_). @return Records written. */
+  uint32_t DrainAll() noexcept {
+    std::lock_guard<std::mutex> lock(registry_mutex_);
+    uint32_t written = 0U;
+    uint64_t dropped = retired_dropped_;
+    for (size_t r = 0U; r < rings_.size();) {
+      AsyncLogRing& ring = *rings_[r];
+      // Read retired before the records so the final records are not missed
+      const bool retired = ring.retired.load(std::memory_order_acquire);
+      uint32_t tail = ring.tail.load(std::memory_order_relaxed);
+      const uint32_t head = ring.head.load(std::memory_order_acquire);
+      while (tail != head) {
+        AddLine(ring.records[tail & (LOG_ASYNC_RING_RECORDS - 1U)]);
+        ++tail;
+        ++written;
+        if (lines_ == LOG_ASYNC_BATCH_LINES) {
+          ring.tail.store(tail, std::memory_order_release);  // free space before the syscall
+          WriteBatch();
+        }
+      }
+      ring.tail.store(tail, std::memory_order_release);
+      dropped += ring.dropped.load(std::memory_order_relaxed);
+      if (retired) {
+        retired_dropped_ += ring.dropped.load(std::memory_order_relaxed);
+        rings_[r] = std::move(rings_.back());
+        rings_.pop_back();
+      } else {
+        ++r;
+      }
+    }
+    if (dropped != reported_dropped_) {
+      const int len = std::snprintf(batch_[lines_].data(), LOG_ASYNC_LINE_BYTES,
+                                    "[log_macro] %" PRIu64 " async log records dropped (ring full)\n",
+                                    dropped - reported_dropped_);
+      iov_[lines_].iov_base = batch_[lines_].data();
+      iov_[lines_].iov_len = static_cast<size_t>(len);
+      ++lines_;
+      reported_dropped_ = dropped;
+    }
+    WriteBatch();
+    return written;
+  }
+
+  void AddLine(const AsyncLogRecord& rec) noexcept {
+    char* line = batch_[lines_].data();
+    iov_[lines_].iov_base = line;
+    iov_[lines_].iov_len = format_log_record(rec, line, LOG_ASYNC_LINE_BYTES);
+    ++lines_;
+  }
+
+  void WriteBatch() noexcept {
+    uint32_t first = 0U;
+    while (first < lines_) {
+      const ssize_t n = ::writev(fd_.load(std::memory_order_relaxed), &iov_[first], static_cast<int>(lines_ - first));
+      if (n < 0) {
+        break;  // nowhere to report it; drop the batch
+      }
+      // Skip fully written lines, trim a partially written one
+      size_t left = static_cast<size_t>(n);
+      while ((first < lines_) && (left >= iov_[first].iov_len)) {
+        left -= iov_[first].iov_len;
+        ++first;
+      }
+      if (first < lines_) {
+        iov_[first].iov_base = static_cast<char*>(iov_[first].iov_base) + left;
+        iov_[first].iov_len -= left;
+      }
+    }
+    lines_ = 0U;
+  }
+
+  std::array<std::array<char, LOG_ASYNC_LINE_BYTES>, LOG_ASYNC_BATCH_LINES> batch_{};
+  std::array<struct iovec, LOG_ASYNC_BATCH_LINES> iov_{};
+  uint32_t lines_{0U};
+  uint64_t retired_dropped_{0U};
+  uint64_t reported_dropped_{0U};
+  std::vector<std::shared_ptr<AsyncLogRing>> rings_;
+  std::mutex registry_mutex_;  // rings_, retired_dropped_
+  std::mutex drain_mutex_;     // single consumer: backend thread or Flush()
+  std::atomic<int> fd_{STDERR_FILENO};
+  std::atomic<bool> stop_{false};
+  std::thread thread_;
+};
+
+/** Registers the calling thread's ring on first use and retires it at thread exit. */
+struct AsyncLogRingHolder {
+  AsyncLogRingHolder() : ring(std::make_shared<AsyncLogRing>()) { AsyncLogBackend::Instance().Register(ring); }
+  ~AsyncLogRingHolder() { ring->retired.store(true, std::memory_order_release); }
+  AsyncLogRingHolder(const AsyncLogRingHolder&) = delete;
+  AsyncLogRingHolder& operator=(const AsyncLogRingHolder&) = delete;
+
+  std::shared_ptr<AsyncLogRing> ring;
+};
+
+inline AsyncLogRing& thread_log_ring() {
+  thread_local AsyncLogRingHolder holder;
+  return *holder.ring;
+}
+
+// Capture a log call into the calling thread's ring (lock-free, no formatting)
+template <typename... Args>
+inline void async_log_print(const char* level, const char* file, int32_t line, const char* func, const char* fmt,
+                            const Args&... args) noexcept {
+  static_assert(sizeof...(Args) <= LOG_ASYNC_MAX_ARGS, "too many arguments for an async LOG_* call");
+  AsyncLogRing& ring = thread_log_ring();
+  const uint32_t head = ring.head.load(std::memory_order_relaxed);
+  if ((head - ring.cached_tail) >= LOG_ASYNC_RING_RECORDS) {
+    ring.cached_tail = ring.tail.load(std::memory_order_acquire);
+    if ((head - ring.cached_tail) >= LOG_ASYNC_RING_RECORDS) {
+      ring.dropped.store(ring.dropped.load(std::memory_order_relaxed) + 1U, std::memory_order_relaxed);
+      return;
+    }
+  }
+  AsyncLogRecord& rec = ring.records[head & (LOG_ASYNC_RING_RECORDS - 1U)];
+  rec.timestamp_us = get_timestamp_us();
+  rec.level = level;
+  rec.file = file;
+  rec.func = func;
+  rec.fmt = fmt;
+  rec.line = line;
+  rec.arg_count = 0U;
+  rec.text_used = 0U;
+  (capture_log_arg(rec, args), ...);
+  ring.head.store(head + 1U, std::memory_order_release);
+}
+
+// Drain the asynchronous backend (if started) and stderr
+inline void log_flush() noexcept {
+  AsyncLogBackend* backend = AsyncLogBackend::Started();
+  if (backend != nullptr) {
+    backend->Flush();
+  }
+  std::fflush(stderr);
+}
+
+// Records dropped by the asynchronous backend (0 if it never started)
+inline uint64_t log_dropped() noexcept {
+  AsyncLogBackend* backend = AsyncLogBackend::Started();
+  return (backend != nullptr) ? backend->Dropped() : 0U;
+}
+
 }  // namespace log_internal
 
 // ============================================================================
 // Public Logging Macros
 // ============================================================================
 
+#if LOG_ASYNC
+#define LOG_INTERNAL_PRINT log_internal::async_log_print
+#else
+#define LOG_INTERNAL_PRINT log_internal::log_print
+#endif
+
+// Write out pending records (async backend) and flush stderr
+#define LOG_FLUSH() log_internal::log_flush()
+
 // TRACE level (most verbose)
 #if LOG_LEVEL <= LOG_LEVEL_TRACE
-#define LOG_TRACE(fmt, ...) log_internal::log_print("TRACE", __FILE__, __LINE__, __func__, fmt, ##__VA_ARGS__)
+#define LOG_TRACE(fmt, ...) LOG_INTERNAL_PRINT("TRACE", __FILE__, __LINE__, __func__, fmt, ##__VA_ARGS__)
 #else
 #define LOG_TRACE(fmt, ...) ((void)0)
 #endif
 
 // DEBUG level
 #if LOG_LEVEL <= LOG_LEVEL_DEBUG
-#define LOG_DEBUG(fmt, ...) log_internal::log_print("DEBUG", __FILE__, __LINE__, __func__, fmt, ##__VA_ARGS__)
+#define LOG_DEBUG(fmt, ...) LOG_INTERNAL_PRINT("DEBUG", __FILE__, __LINE__, __func__, fmt, ##__VA_ARGS__)
 #else
 #define LOG_DEBUG(fmt, ...) ((void)0)
 #endif
 
 // INFO level
 #if LOG_LEVEL <= LOG_LEVEL_INFO
-#define LOG_INFO(fmt, ...) log_internal::log_print("INFO", __FILE__, __LINE__, __func__, fmt, ##__VA_ARGS__)
+#define LOG_INFO(fmt, ...) LOG_INTERNAL_PRINT("INFO", __FILE__, __LINE__, __func__, fmt, ##__VA_ARGS__)
 #else
 #define LOG_INFO(fmt, ...) ((void)0)
 #endif
 
 // WARN level
 #if LOG_LEVEL <= LOG_LEVEL_WARN
-#define LOG_WARN(fmt, ...) log_internal::log_print("WARN", __FILE__, __LINE__, __func__, fmt, ##__VA_ARGS__)
+#define LOG_WARN(fmt, ...) LOG_INTERNAL_PRINT("WARN", __FILE__, __LINE__, __func__, fmt, ##__VA_ARGS__)
 #else
 #define LOG_WARN(fmt, ...) ((void)0)
 #endif
 
 // ERROR level
 #if LOG_LEVEL <= LOG_LEVEL_ERROR
-#define LOG_ERROR(fmt, ...) log_internal::log_print("ERROR", __FILE__, __LINE__, __func__, fmt, ##__VA_ARGS__)
+#define LOG_ERROR(fmt, ...) LOG_INTERNAL_PRINT("ERROR", __FILE__, __LINE__, __func__, fmt, ##__VA_ARGS__)
 #else
 #define LOG_ERROR(fmt, ...) ((void)0)
 #endif
 
 // FATAL level (always enabled unless LOG_LEVEL_OFF)
 #if LOG_LEVEL <= LOG_LEVEL_FATAL
-#define LOG_FATAL(fmt, ...)                                                             \
-  do {                                                                                  \
-    log_internal::log_print("FATAL", __FILE__, __LINE__, __func__, fmt, ##__VA_ARGS__); \
-    std::abort();                                                                       \
+// Synchronous even with LOG_ASYNC: drain pending records, then print the last line directly
+#define LOG_FATAL(fmt, ...)                                                                \
+  do {                                                                                     \
+    log_internal::log_flush();                                                             \
+    log_internal::log_print("FATAL", __FILE__, __LINE__, __func__, fmt, ##__VA_ARGS__);    \
+    std::abort();                                                                          \
   } while (0)
 #else
 #define LOG_FATAL(fmt, ...) ((void)0)
@@ -220,13 +757,14 @@ inline void log_print(const char* level, const char* file, int32_t line, const c
 // ============================================================================
 
 #ifndef NDEBUG
-#define LOG_ASSERT(cond, fmt, ...)                                                                          \
-  do {                                                                                                      \
-    if (!(cond)) {                                                                                          \
+#define LOG_ASSERT(cond, fmt, ...)                                                                           \
+  do {                                                                                                       \
+    if (!(cond)) {                                                                                           \
+      log_internal::log_flush();                                                                             \
       log_internal::log_print("ASSERT", __FILE__, __LINE__, __func__, "Assertion failed: " #cond " - " fmt, \
-                              ##__VA_ARGS__);                                                               \
-      std::abort();                                                                                         \
-    }                                                                                                       \
+                              ##__VA_ARGS__);                                                                \
+      std::abort();                                                                                          \
+    }                                                                                                        \
   } while (0)
 #else
 #define LOG_ASSERT(cond, fmt, ...) ((void)0)
@@ -256,4 +794,14 @@ Example 4: Compile-time control
 
 Example 5: Assertions
     LOG_ASSERT(ptr != nullptr, "Pointer must not be null");
+
+Example 6: Asynchronous backend for hot paths
+    #define LOG_ASYNC 1
+    #include "log_macro.hpp"
+    bus.Subscribe<MotionData>([](const Envelope& env) {
+      LOG_DEBUG("motion x=%.2f", static_cast<double>(std::get<MotionData>(env.payload).x));  // ~tens of ns
+    });
+    ...
+    LOG_FLUSH();                                  // e.g. before a controlled shutdown
+    uint64_t lost = log_internal::log_dropped();  // records lost to full rings
 */
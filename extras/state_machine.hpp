@@ -8,6 +8,8 @@
  * - std::optional for optional parent
  * - std::function for flexible callbacks
  * - Minimal inheritance, maximum composition
+ * - Optional frozen dispatch: StateMachine::Freeze() flattens the finished
+ *   configuration into a (state, event_id) table with precomputed exit/entry paths
  *
  * MISRA C++ Compliance:
  * - Rule 5-0-13: Explicit boolean comparisons
@@ -26,6 +28,7 @@
 #include <cassert>
 #include <cstdint>
 
+#include <algorithm>
 #include <functional>
 #include <optional>
 #include <string>
@@ -237,6 +240,7 @@ class State final {
   State* parent() const noexcept { return parent_; }
   bool has_parent() const noexcept { return parent_ != nullptr; }
   bool has_default_handler() const noexcept { return default_event_handler_ != nullptr; }
+  const std::vector<Transition>& transitions() const noexcept { return transitions_; }
 
   uint8_t depth() const noexcept {
     uint8_t d = 0U;
@@ -328,6 +332,10 @@ class StateMachine final {
   // --- Public API (Regular functions: PascalCase) ---
 
   bool Dispatch(const Event& event) noexcept {
+    if (frozen()) {
+      return DispatchFrozen(event);
+    }
+
     // Bubble up through hierarchy - first try specific transitions
     for (StateType* s = current_state_; s != nullptr; s = s->parent()) {
       const typename StateType::Transition* t = s->FindTransition(context_, event);
@@ -352,7 +360,110 @@ class StateMachine final {
     return false;
   }
 
-  void Reset() noexcept { TransitionTo(*initial_state_, nullptr); }
+  void Reset() noexcept {
+    TransitionTo(*initial_state_, nullptr);
+    current_index_ = 0U;  // initial state is always flat index 0
+  }
+
+  /**
+   * @brief Compile the finished configuration into a flat dispatch table.
+   *
+   * Collects every state reachable from the initial state (transition targets
+   * and parents) and builds one cell per (state, event_id). A cell lists the
+   * candidate transitions in bubble-up order, each with its exit and entry
+   * path already resolved, so Dispatch() becomes an index, the guards, the
+   * action and two linear runs of entry/exit calls. Behavior is identical to
+   * the dynamic path.
+   *
+   * With every event_id below kMaxDenseEvents the table holds (max event_id
+   * + 1) cells per state and Dispatch() indexes it directly. Sparse ids
+   * (hashed, 0x10000000-style, up to UINT32_MAX) instead get a per-state
+   * array of (event_id, cell) pairs sorted by id and searched with a binary
+   * search, so the table size never depends on the id values. States must
+   * not be reconfigured afterwards without calling Freeze() again: cells
+   * point into each state's transition list.
+   *
+   * @note Allocates (may throw std::bad_alloc); call once during setup, not
+   *       from Dispatch() context.
+   */
+  void Freeze() {
+    flat_states_.clear();
+    flat_defaults_.clear();
+    flat_cells_.clear();
+    flat_transitions_.clear();
+    flat_path_.clear();
+    flat_keys_.clear();
+    flat_rows_.clear();
+    flat_event_count_ = 0U;
+
+    // Index 0 is the initial state so Reset() needs no lookup
+    AddFlatState(initial_state_);
+    AddFlatState(current_state_);
+    uint64_t event_count = 0U;  // 64-bit: event_id + 1 must not wrap at UINT32_MAX
+    for (uint32_t i = 0U; i < flat_states_.size(); ++i) {
+      const StateType* s = flat_states_[i];
+      AddFlatState(s->parent());
+      for (const auto& t : s->transitions()) {
+        AddFlatState(t.target);
+        event_count = std::max(event_count, static_cast<uint64_t>(t.event_id) + 1U);
+      }
+    }
+
+    const uint32_t state_count = static_cast<uint32_t>(flat_states_.size());
+    const bool dense = (event_count <= kMaxDenseEvents);
+    if (dense) {
+      flat_event_count_ = static_cast<uint32_t>(event_count);
+      flat_cells_.assign(static_cast<size_t>(state_count) * flat_event_count_, FlatRange{0U, 0U});
+    }
+    std::vector<FlatTransition> row;
+    for (uint32_t si = 0U; si < state_count; ++si) {
+      StateType* source = flat_states_[si];
+
+      // Default handlers in bubble-up order
+      FlatRange defaults{static_cast<uint32_t>(flat_path_.size()), 0U};
+      for (StateType* s = source; s != nullptr; s = s->parent()) {
+        if (s->has_default_handler()) {
+          flat_path_.push_back(s);
+          ++defaults.count;
+        }
+      }
+      flat_defaults_.push_back(defaults);
+
+      // Candidates in bubble-up order, then grouped by event id (stable)
+      row.clear();
+      for (StateType* s = source; s != nullptr; s = s->parent()) {
+        for (const auto& t : s->transitions()) {
+          row.push_back(FlattenTransition(*source, t));
+        }
+      }
+      std::stable_sort(row.begin(), row.end(), [](const FlatTransition& a, const FlatTransition& b) {
+        return a.transition->event_id < b.transition->event_id;
+      });
+      FlatRange keys{static_cast<uint32_t>(flat_keys_.size()), 0U};
+      for (const FlatTransition& ft : row) {
+        const uint32_t event_id = ft.transition->event_id;
+        FlatRange* cell = nullptr;
+        if (dense) {
+          cell = &flat_cells_[static_cast<size_t>(si) * flat_event_count_ + event_id];
+        } else {
+          if ((keys.count == 0U) || (flat_keys_.back().event_id != event_id)) {
+            flat_keys_.push_back(FlatKey{event_id, FlatRange{0U, 0U}});
+            ++keys.count;
+          }
+          cell = &flat_keys_.back().cell;
+        }
+        if (cell->count == 0U) {
+          cell->begin = static_cast<uint32_t>(flat_transitions_.size());
+        }
+        flat_transitions_.push_back(ft);
+        ++cell->count;
+      }
+      if (!dense) {
+        flat_rows_.push_back(keys);
+      }
+    }
+    current_index_ = IndexOf(current_state_);
+  }
 
   bool IsInState(const StateType& state) const noexcept {
     for (const StateType* s = current_state_; s != nullptr; s = s->parent()) {
@@ -370,12 +481,133 @@ class StateMachine final {
   const std::string& current_state_name() const noexcept { return current_state_->name(); }
   Context& context() noexcept { return context_; }
   const Context& context() const noexcept { return context_; }
+  bool frozen() const noexcept { return !flat_states_.empty(); }
 
   // --- Mutator (set_xxx) ---
 
   void set_unhandled_event_handler(UnhandledEventFn fn) noexcept { unhandled_event_fn_ = std::move(fn); }
 
  private:
+  static constexpr uint32_t kNoTarget = UINT32_MAX;
+  static constexpr uint64_t kMaxDenseEvents = 256U;  // larger ids use the sorted per-state arrays
+
+  /** Contiguous run in flat_transitions_ or flat_path_. */
+  struct FlatRange {
+    uint32_t begin;
+    uint32_t count;
+  };
+
+  /** Sparse-table entry: the cell of one event id (rows sorted by event_id). */
+  struct FlatKey {
+    uint32_t event_id;
+    FlatRange cell;
+  };
+
+  /** One candidate of a (state, event_id) cell with its paths resolved. */
+  struct FlatTransition {
+    const typename StateType::Transition* transition;
+    uint32_t target_index;  // kNoTarget for internal transitions
+    FlatRange exits;        // source up to (excluding) the LCA
+    FlatRange entries;      // LCA child down to the target
+  };
+
+  bool DispatchFrozen(const Event& event) noexcept {
+    const FlatRange cell = FindFlatCell(event.id());
+    for (uint32_t i = cell.begin; i < cell.begin + cell.count; ++i) {
+      const FlatTransition& ft = flat_transitions_[i];
+      const typename StateType::Transition& t = *ft.transition;
+      // MISRA 5-0-13: Explicit boolean comparison for std::function
+      if ((t.guard != nullptr) && (t.guard(context_, event) == false)) {
+        continue;
+      }
+      if (t.action != nullptr) {
+        t.action(context_, event);
+      }
+      if (ft.target_index != kNoTarget) {
+        for (uint32_t p = ft.exits.begin; p < ft.exits.begin + ft.exits.count; ++p) {
+          flat_path_[p]->ExecuteExit(context_, event);
+        }
+        current_state_ = flat_states_[ft.target_index];
+        current_index_ = ft.target_index;
+        for (uint32_t p = ft.entries.begin; p < ft.entries.begin + ft.entries.count; ++p) {
+          flat_path_[p]->ExecuteEntry(context_, event);
+        }
+      }
+      return true;
+    }
+
+    const FlatRange defaults = flat_defaults_[current_index_];
+    for (uint32_t p = defaults.begin; p < defaults.begin + defaults.count; ++p) {
+      if (flat_path_[p]->TryDefaultHandler(context_, event)) {
+        return true;
+      }
+    }
+
+    // MISRA 5-0-13: Explicit boolean comparison for std::function
+    if (unhandled_event_fn_ != nullptr) {
+      unhandled_event_fn_(context_, event);
+    }
+    return false;
+  }
+
+  FlatRange FindFlatCell(uint32_t id) const noexcept {
+    if (flat_rows_.empty()) {
+      return (id < flat_event_count_) ? flat_cells_[static_cast<size_t>(current_index_) * flat_event_count_ + id]
+                                      : FlatRange{0U, 0U};
+    }
+    const FlatRange row = flat_rows_[current_index_];
+    const auto first = flat_keys_.begin() + row.begin;
+    const auto last = first + row.count;
+    const auto it =
+        std::lower_bound(first, last, id, [](const FlatKey& key, uint32_t value) { return key.event_id < value; });
+    return ((it != last) && (it->event_id == id)) ? it->cell : FlatRange{0U, 0U};
+  }
+
+  void AddFlatState(StateType* state) {
+    if ((state != nullptr) && (IndexOf(state) == kNoTarget)) {
+      flat_states_.push_back(state);
+    }
+  }
+
+  uint32_t IndexOf(const StateType* state) const noexcept {
+    for (uint32_t i = 0U; i < flat_states_.size(); ++i) {
+      if (flat_states_[i] == state) {
+        return i;
+      }
+    }
+    return kNoTarget;
+  }
+
+  /** Resolve exit/entry runs exactly as TransitionTo() would from @p source. */
+  FlatTransition FlattenTransition(StateType& source, const typename StateType::Transition& t) {
+    FlatTransition ft{&t, kNoTarget, FlatRange{0U, 0U}, FlatRange{0U, 0U}};
+    if ((t.type != TransitionType::kExternal) || (t.target == nullptr)) {
+      return ft;
+    }
+    ft.target_index = IndexOf(t.target);
+
+    ft.exits.begin = static_cast<uint32_t>(flat_path_.size());
+    if (&source == t.target) {
+      // Self-transition: exit and re-enter the source
+      flat_path_.push_back(&source);
+      ft.exits.count = 1U;
+      ft.entries = FlatRange{static_cast<uint32_t>(flat_path_.size()), 1U};
+      flat_path_.push_back(&source);
+      return ft;
+    }
+
+    StateType* lca = FindLCA(source, *t.target);
+    for (StateType* s = &source; s != nullptr && s != lca; s = s->parent()) {
+      flat_path_.push_back(s);
+      ++ft.exits.count;
+    }
+    BuildEntryPath(*t.target, lca);
+    ft.entries.begin = static_cast<uint32_t>(flat_path_.size());
+    ft.entries.count = static_cast<uint32_t>(entry_path_.size());
+    flat_path_.insert(flat_path_.end(), entry_path_.rbegin(), entry_path_.rend());
+    return ft;
+  }
+
   void EnterInitialState() noexcept {
     // Build path from initial state to root
     BuildEntryPath(*initial_state_, nullptr);
@@ -482,6 +714,17 @@ class StateMachine final {
   uint32_t max_depth_;
   std::vector<StateType*> entry_path_;
   UnhandledEventFn unhandled_event_fn_;
+
+  // Frozen dispatch table (empty until Freeze())
+  std::vector<StateType*> flat_states_;
+  std::vector<FlatRange> flat_defaults_;  // per state: run in flat_path_
+  std::vector<FlatRange> flat_cells_;     // dense: [state * flat_event_count_ + event_id]
+  std::vector<FlatKey> flat_keys_;        // sparse: per-state runs sorted by event_id
+  std::vector<FlatRange> flat_rows_;      // sparse: per state, run in flat_keys_ (empty when dense)
+  std::vector<FlatTransition> flat_transitions_;
+  std::vector<StateType*> flat_path_;
+  uint32_t flat_event_count_ = 0U;
+  uint32_t current_index_ = 0U;
 };
 
 } /* namespace hsm */
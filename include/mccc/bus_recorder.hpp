@@ -0,0 +1,655 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2024 liudegui
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * @file bus_recorder.hpp
+ * @brief Binary capture of bus traffic to mmap-ed segment files, and replay.
+ *
+ * A BusRecorder is a Component that subscribes to chosen trivially-copyable
+ * alternatives and copies each MessageHeader + payload into a fixed-slot SPSC
+ * staging ring. The tap never blocks or allocates on the bus consumer
+ * thread; a full staging ring drops the record and counts it. A background
+ * writer thread drains the staging ring into append-only segment files that
+ * are ftruncate()-d to segment_bytes and written through a MAP_SHARED
+ * mapping, rotating to the next file when one is full.
+ *
+ * A BusReplayer maps one segment read-only and re-publishes its records on a
+ * bus, either at full speed or paced by the recorded inter-arrival times
+ * (optionally sped up and with long gaps cut).
+ *
+ * File format (native byte order; the PayloadVariant type hash rejects
+ * captures from a different message set):
+ *   CaptureFileHeader, then record_count x (CaptureRecordHeader + payload
+ *   bytes padded to 8)
+ *
+ * POSIX only.
+ */
+
+#ifndef MCCC_BUS_RECORDER_HPP_
+#define MCCC_BUS_RECORDER_HPP_
+
+#include "mccc/component.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <thread>
+#include <utility>
+
+namespace mccc {
+
+/** @brief Segment file header; data_bytes and record_count are committed after each writer pass. */
+struct CaptureFileHeader {
+  uint32_t magic;         /**< CAPTURE_MAGIC */
+  uint16_t version;       /**< CAPTURE_VERSION */
+  uint16_t header_bytes;  /**< sizeof(CaptureFileHeader) */
+  uint64_t type_hash;     /**< PayloadVariant signature hash of the recorder */
+  uint64_t data_bytes;    /**< Record bytes that follow the header */
+  uint64_t record_count;  /**< Records that follow the header */
+  uint32_t segment_index; /**< Position of this file in the capture */
+  uint32_t reserved;
+};
+
+/** @brief Per-message record header, followed by payload_size bytes padded to a multiple of 8. */
+struct CaptureRecordHeader {
+  uint64_t msg_id;       /**< Original MessageHeader::msg_id */
+  uint64_t timestamp_us; /**< Original MessageHeader::timestamp_us */
+  uint64_t publish_ns;   /**< Replay pacing time: timestamp_ns if the header has it, else timestamp_us * 1000 */
+  uint32_t sender_id;    /**< Original sender_id */
+  uint16_t payload_size; /**< sizeof(alternative) */
+  uint8_t type_index;    /**< PayloadVariant alternative index */
+  uint8_t priority;      /**< MessagePriority */
+};
+
+static_assert(sizeof(CaptureFileHeader) == 40U, "CaptureFileHeader must stay packed");
+static_assert(sizeof(CaptureRecordHeader) == 32U, "CaptureRecordHeader must stay packed");
+
+constexpr uint32_t CAPTURE_MAGIC = 0x4D434352U;  // "MCCR"
+constexpr uint16_t CAPTURE_VERSION = 1U;
+
+/**
+ * @brief Result of BusRecorder::Start() / BusReplayer::Open().
+ */
+enum class CaptureError : uint8_t {
+  OK = 0U,
+  ALREADY_OPEN = 1U,    /**< Recorder already running / replayer already has a file open */
+  OPEN_FAILED = 2U,     /**< open() / ftruncate() / fstat() failed (see errno), or the path is too long */
+  MMAP_FAILED = 3U,     /**< mmap() failed (see errno) */
+  LAYOUT_MISMATCH = 4U, /**< Not a capture file, or a different format version */
+  TYPE_MISMATCH = 5U,   /**< Captured with a different PayloadVariant */
+  TRUNCATED = 6U,       /**< Header claims more record bytes than the file holds */
+  EXISTS = 7U           /**< Start(): the segment file already exists; see RecorderConfig::overwrite */
+};
+
+/**
+ * @brief Path of one capture segment: "<prefix>.<index, 6 digits>.cap".
+ * @return false if the path does not fit in size bytes
+ */
+inline bool CaptureSegmentPath(char* out, size_t size, const char* prefix, uint32_t index) noexcept {
+  const int len = std::snprintf(out, size, "%s.%06u.cap", prefix, index);
+  return (len > 0) && (static_cast<size_t>(len) < size);
+}
+
+/** @brief BusRecorder configuration. */
+struct RecorderConfig {
+  const char* path_prefix = "mccc_capture"; /**< Segment files are CaptureSegmentPath(path_prefix, i) */
+  uint64_t segment_bytes = 64ULL << 20U;   /**< File size reserved per segment (header included) */
+  uint32_t writer_idle_us = 200U;           /**< Writer sleep when the staging ring is empty */
+  bool overwrite = false;                   /**< Replace existing segment files, numbering from 0 again */
+};
+
+/** @brief Recorder counters. */
+struct RecorderStatistics {
+  uint64_t messages_staged;  /**< Records the tap copied into the staging ring */
+  uint64_t staging_dropped;  /**< Records lost because the staging ring was full */
+  uint64_t records_written;  /**< Records copied into segment files */
+  uint64_t bytes_written;    /**< Record bytes copied into segment files */
+  uint64_t segments_written; /**< Segment files created */
+  uint64_t write_errors;     /**< Records lost because a segment could not be created */
+};
+
+namespace detail {
+
+/** @brief Largest trivially-copyable alternative (what a recorder can capture). */
+template <typename Variant>
+struct MaxTrivialPayload;
+
+template <typename... Ts>
+struct MaxTrivialPayload<std::variant<Ts...>> {
+  static constexpr size_t value = std::max({size_t{0U}, (std::is_trivially_copyable<Ts>::value ? sizeof(Ts) : 0U)...});
+};
+
+constexpr uint64_t CapturePad8(uint64_t bytes) noexcept { return (bytes + 7U) & ~uint64_t{7U}; }
+
+}  // namespace detail
+
+/**
+ * @brief Component copying selected message types into capture segment files.
+ *
+ * Usage:
+ * @code
+ *   auto recorder = std::make_shared<mccc::BusRecorder<Payload, Bus>>(bus);
+ *   recorder->RecordAll();
+ *   mccc::RecorderConfig cfg;
+ *   cfg.path_prefix = "/var/log/robot/run42";
+ *   recorder->Start(cfg);
+ *   while (running) { bus.ProcessBatch(); }
+ *   recorder->Stop();  // drains the staging ring, trims the last segment
+ * @endcode
+ *
+ * Record callbacks run on the bus consumer thread (the single staging
+ * producer); Start() and Stop() may be called from any one control thread.
+ *
+ * @tparam PayloadVariant std::variant of message types (recorded ones must be trivially copyable)
+ * @tparam BusT Bus type the recorder subscribes on
+ * @tparam StagingDepth Staging ring slots (power of 2)
+ */
+template <typename PayloadVariant, typename BusT = AsyncBus<PayloadVariant>, uint32_t StagingDepth = 4096U>
+class BusRecorder : public Component<PayloadVariant, BusT> {
+  using Base = Component<PayloadVariant, BusT>;
+
+ public:
+  static constexpr uint64_t TYPE_HASH = detail::PayloadLayoutHash<PayloadVariant>();
+  static constexpr uint32_t MAX_PAYLOAD = static_cast<uint32_t>(detail::MaxTrivialPayload<PayloadVariant>::value);
+  /** Largest record in a segment file. */
+  static constexpr uint64_t MAX_RECORD_BYTES = sizeof(CaptureRecordHeader) + detail::CapturePad8(MAX_PAYLOAD);
+
+  static_assert((StagingDepth & (StagingDepth - 1U)) == 0U, "StagingDepth must be a power of 2");
+  static_assert(std::variant_size<PayloadVariant>::value <= 255U, "type_index is stored in 8 bits");
+  static_assert(MAX_PAYLOAD <= 0xFFFFU, "payload_size is stored in 16 bits");
+
+  explicit BusRecorder(BusT& bus) noexcept : Base(bus) {}
+
+  ~BusRecorder() override {
+    this->UnsubscribeAll();  // record callbacks capture this
+    Stop();
+  }
+
+  // ======================== Tap ========================
+
+  /**
+   * @brief Record every T message that passes filter.
+   * @return false when the bus or component subscription capacity is exhausted
+   */
+  template <typename T>
+  bool Record(const SubscriptionFilter& filter = SubscriptionFilter{}) noexcept {
+    static_assert(std::is_trivially_copyable<T>::value, "BusRecorder records trivially-copyable types only");
+    constexpr auto type_idx = static_cast<uint8_t>(VariantIndex<T, PayloadVariant>::value);
+    return this->template SubscribeSimple<T>(filter, [this](const T& msg, const MessageHeader& header) noexcept {
+      Stage(type_idx, header, &msg, static_cast<uint16_t>(sizeof(T)));
+    });
+  }
+
+  /**
+   * @brief Record() every trivially-copyable alternative of PayloadVariant.
+   * @return false if any subscription failed
+   */
+  bool RecordAll() noexcept {
+    return RecordAllImpl(std::make_index_sequence<std::variant_size<PayloadVariant>::value>{});
+  }
+
+  // ======================== Writer ========================
+
+  /**
+   * @brief Create the first segment and start the writer thread.
+   *
+   * Records staged before Start() are written once it runs. Segment files are
+   * never replaced unless config.overwrite is set: an existing file fails
+   * Start() with EXISTS (and a later rollover with a write error). Starting
+   * again after Stop() with the same prefix continues the segment numbering,
+   * so the earlier segments stay part of one capture.
+   */
+  CaptureError Start(const RecorderConfig& config) noexcept {
+    if (writer_.joinable()) {
+      return CaptureError::ALREADY_OPEN;
+    }
+    std::array<char, 256U> prefix{};
+    const int len = std::snprintf(prefix.data(), prefix.size(), "%s", config.path_prefix);
+    if ((len <= 0) || (static_cast<size_t>(len) >= prefix.size())) {
+      return CaptureError::OPEN_FAILED;
+    }
+    if (config.overwrite || (prefix != prefix_)) {
+      next_segment_ = 0U;
+    }
+    prefix_ = prefix;
+    overwrite_ = config.overwrite;
+    segment_bytes_ = (config.segment_bytes < sizeof(CaptureFileHeader) + MAX_RECORD_BYTES)
+                         ? (sizeof(CaptureFileHeader) + MAX_RECORD_BYTES)
+                         : config.segment_bytes;
+    writer_idle_us_ = config.writer_idle_us;
+    const CaptureError err = OpenSegment();
+    if (err != CaptureError::OK) {
+      return err;
+    }
+    stop_.store(false, std::memory_order_relaxed);
+    writer_ = std::thread([this]() { WriterLoop(); });
+    return CaptureError::OK;
+  }
+
+  /**
+   * @brief Write every record staged so far, close the last segment and stop the writer.
+   *
+   * Call after the bus consumer has dispatched the messages to keep.
+   */
+  void Stop() noexcept {
+    if (!writer_.joinable()) {
+      return;
+    }
+    stop_.store(true, std::memory_order_release);
+    writer_.join();
+    CloseSegment();
+  }
+
+  bool Running() const noexcept { return writer_.joinable(); }
+
+  RecorderStatistics GetStatistics() const noexcept {
+    return RecorderStatistics{messages_staged_.load(std::memory_order_relaxed),
+                              staging_dropped_.load(std::memory_order_relaxed),
+                              records_written_.load(std::memory_order_relaxed),
+                              bytes_written_.load(std::memory_order_relaxed),
+                              segments_written_.load(std::memory_order_relaxed),
+                              write_errors_.load(std::memory_order_relaxed)};
+  }
+
+ private:
+  struct StagingSlot {
+    CaptureRecordHeader record;
+    alignas(8) std::array<uint8_t, (MAX_PAYLOAD > 0U) ? MAX_PAYLOAD : 1U> payload;
+  };
+
+  template <size_t... I>
+  bool RecordAllImpl(std::index_sequence<I...> /*unused*/) noexcept {
+    bool ok = true;
+    (void)((ok = RecordIfTrivial<I>() && ok), ...);
+    return ok;
+  }
+
+  template <size_t I>
+  bool RecordIfTrivial() noexcept {
+    using T = std::variant_alternative_t<I, PayloadVariant>;
+    if constexpr (std::is_trivially_copyable<T>::value) {
+      return Record<T>();
+    } else {
+      return true;
+    }
+  }
+
+  /** Bus consumer thread: copy one message into the staging ring, or count it as dropped. */
+  void Stage(uint8_t type_idx, const MessageHeader& header, const void* payload, uint16_t size) noexcept {
+    const uint32_t head = staging_head_.load(std::memory_order_relaxed);
+    if ((head - cached_tail_) >= StagingDepth) {
+      cached_tail_ = staging_tail_.load(std::memory_order_acquire);
+      if ((head - cached_tail_) >= StagingDepth) {
+        staging_dropped_.store(staging_dropped_.load(std::memory_order_relaxed) + 1U, std::memory_order_relaxed);
+        return;
+      }
+    }
+    StagingSlot& slot = staging_[head & (StagingDepth - 1U)];
+#if MCCC_HEADER_HAS_TIMESTAMP_NS
+    const uint64_t publish_ns = header.timestamp_ns;
+#else
+    const uint64_t publish_ns = header.timestamp_us * 1000U;
+#endif
+    slot.record = CaptureRecordHeader{header.msg_id, header.timestamp_us, publish_ns, header.sender_id,
+                                      size,          type_idx,           static_cast<uint8_t>(header.priority)};
+    (void)std::memcpy(slot.payload.data(), payload, size);
+    staging_head_.store(head + 1U, std::memory_order_release);
+    messages_staged_.store(messages_staged_.load(std::memory_order_relaxed) + 1U, std::memory_order_relaxed);
+  }
+
+  void WriterLoop() noexcept {
+    for (;;) {
+      const bool stopping = stop_.load(std::memory_order_acquire);
+      if ((DrainStaging() == 0U) && stopping) {
+        break;
+      }
+      if (staging_tail_.load(std::memory_order_relaxed) == staging_head_.load(std::memory_order_acquire)) {
+        std::this_thread::sleep_for(std::chrono::microseconds(writer_idle_us_));
+      }
+    }
+  }
+
+  /** Writer thread: copy every staged record into the mapped segment(s). */
+  uint32_t DrainStaging() noexcept {
+    uint32_t tail = staging_tail_.load(std::memory_order_relaxed);
+    const uint32_t head = staging_head_.load(std::memory_order_acquire);
+    const uint32_t count = head - tail;
+    for (; tail != head; ++tail) {
+      WriteRecord(staging_[tail & (StagingDepth - 1U)]);
+    }
+    staging_tail_.store(tail, std::memory_order_release);
+    if (count > 0U) {
+      CommitHeader();
+    }
+    return count;
+  }
+
+  void WriteRecord(const StagingSlot& slot) noexcept {
+    const uint64_t record_bytes = sizeof(CaptureRecordHeader) + detail::CapturePad8(slot.record.payload_size);
+    if ((map_ != nullptr) && ((sizeof(CaptureFileHeader) + header_.data_bytes + record_bytes) > segment_bytes_)) {
+      CloseSegment();
+    }
+    if ((map_ == nullptr) && (OpenSegment() != CaptureError::OK)) {
+      write_errors_.store(write_errors_.load(std::memory_order_relaxed) + 1U, std::memory_order_relaxed);
+      return;
+    }
+    uint8_t* dst = map_ + sizeof(CaptureFileHeader) + header_.data_bytes;
+    (void)std::memcpy(dst, &slot.record, sizeof(CaptureRecordHeader));
+    (void)std::memcpy(dst + sizeof(CaptureRecordHeader), slot.payload.data(), slot.record.payload_size);
+    header_.data_bytes += record_bytes;
+    ++header_.record_count;
+    records_written_.store(records_written_.load(std::memory_order_relaxed) + 1U, std::memory_order_relaxed);
+    bytes_written_.store(bytes_written_.load(std::memory_order_relaxed) + record_bytes, std::memory_order_relaxed);
+  }
+
+  CaptureError OpenSegment() noexcept {
+    std::array<char, 320U> path{};
+    if (!CaptureSegmentPath(path.data(), path.size(), prefix_.data(), next_segment_)) {
+      return CaptureError::OPEN_FAILED;
+    }
+    const int fd = open(path.data(), O_CREAT | O_RDWR | (overwrite_ ? O_TRUNC : O_EXCL), 0644);
+    if (fd < 0) {
+      return (errno == EEXIST) ? CaptureError::EXISTS : CaptureError::OPEN_FAILED;
+    }
+    if (ftruncate(fd, static_cast<off_t>(segment_bytes_)) != 0) {
+      (void)close(fd);
+      return CaptureError::OPEN_FAILED;
+    }
+    void* addr = mmap(nullptr, segment_bytes_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (addr == MAP_FAILED) {
+      (void)close(fd);
+      return CaptureError::MMAP_FAILED;
+    }
+    fd_ = fd;
+    map_ = static_cast<uint8_t*>(addr);
+    header_ = CaptureFileHeader{CAPTURE_MAGIC,
+                                CAPTURE_VERSION,
+                                static_cast<uint16_t>(sizeof(CaptureFileHeader)),
+                                TYPE_HASH,
+                                0U,
+                                0U,
+                                next_segment_,
+                                0U};
+    CommitHeader();
+    ++next_segment_;
+    segments_written_.store(segments_written_.load(std::memory_order_relaxed) + 1U, std::memory_order_relaxed);
+    return CaptureError::OK;
+  }
+
+  void CommitHeader() noexcept {
+    if (map_ != nullptr) {
+      (void)std::memcpy(map_, &header_, sizeof(header_));
+    }
+  }
+
+  /** Commit the header, unmap and trim the file to the bytes actually written. */
+  void CloseSegment() noexcept {
+    if (map_ == nullptr) {
+      return;
+    }
+    CommitHeader();
+    (void)munmap(map_, segment_bytes_);
+    (void)ftruncate(fd_, static_cast<off_t>(sizeof(CaptureFileHeader) + header_.data_bytes));
+    (void)close(fd_);
+    map_ = nullptr;
+    fd_ = -1;
+  }
+
+  // Staging ring: Stage() on the bus consumer thread, DrainStaging() on the writer
+  std::array<StagingSlot, StagingDepth> staging_{};
+  MCCC_ALIGN_CACHELINE std::atomic<uint32_t> staging_head_{0U};
+  uint32_t cached_tail_{0U};  // producer-side copy of staging_tail_
+  MCCC_ALIGN_CACHELINE std::atomic<uint32_t> staging_tail_{0U};
+
+  // Writer thread only (after Start(), until Stop() joins it)
+  CaptureFileHeader header_{};
+  uint8_t* map_{nullptr};
+  int fd_{-1};
+  uint32_t next_segment_{0U};
+  uint64_t segment_bytes_{0U};
+  uint32_t writer_idle_us_{0U};
+  bool overwrite_{false};
+  std::array<char, 256U> prefix_{};
+  std::thread writer_;
+  std::atomic<bool> stop_{false};
+
+  MCCC_ALIGN_CACHELINE std::atomic<uint64_t> messages_staged_{0U};
+  std::atomic<uint64_t> staging_dropped_{0U};
+  MCCC_ALIGN_CACHELINE std::atomic<uint64_t> records_written_{0U};
+  std::atomic<uint64_t> bytes_written_{0U};
+  std::atomic<uint64_t> segments_written_{0U};
+  std::atomic<uint64_t> write_errors_{0U};
+};
+
+// ============================================================================
+// Replay
+// ============================================================================
+
+/** @brief BusReplayer pacing and publish options. */
+struct ReplayConfig {
+  uint32_t speedup = 1U;          /**< Recorded gaps are divided by this; 0 = no pacing (full speed) */
+  uint64_t max_gap_us = 0U;       /**< Recorded gaps longer than this are cut to it; 0 = keep */
+  bool keep_timestamps = false;   /**< true: PublishFast() with the recorded timestamp_us (MEDIUM admission);
+                                       false: PublishWithPriority() with the recorded priority, stamped now */
+  bool retry_when_full = true;    /**< Yield and retry a message the bus refuses; false = count and skip it */
+};
+
+/** @brief Replayer counters. */
+struct ReplayStatistics {
+  uint64_t records_replayed; /**< Records accepted by the bus */
+  uint64_t publish_dropped;  /**< Records the bus refused (retry_when_full = false) */
+  uint64_t publish_retries;  /**< Refused publishes that were retried */
+  uint64_t decode_errors;    /**< Records with an unknown type index or a size mismatch */
+};
+
+/**
+ * @brief Re-publishes one capture segment on a bus.
+ *
+ * Usage:
+ * @code
+ *   mccc::BusReplayer<Payload, Bus> replayer(bus);
+ *   char path[256];
+ *   for (uint32_t i = 0U; mccc::CaptureSegmentPath(path, sizeof(path), "run42", i) &&
+ *                         (replayer.Open(path) == mccc::CaptureError::OK); ++i) {
+ *     replayer.Replay(mccc::ReplayConfig{});  // original timing
+ *     replayer.Close();
+ *   }
+ * @endcode
+ *
+ * Replay() publishes on the calling thread; run the bus consumer elsewhere.
+ */
+template <typename PayloadVariant, typename BusT = AsyncBus<PayloadVariant>>
+class BusReplayer {
+ public:
+  static constexpr uint64_t TYPE_HASH = detail::PayloadLayoutHash<PayloadVariant>();
+
+  explicit BusReplayer(BusT& bus) noexcept : bus_(bus) {}
+  ~BusReplayer() { Close(); }
+
+  BusReplayer(const BusReplayer&) = delete;
+  BusReplayer& operator=(const BusReplayer&) = delete;
+
+  /** @brief Map a segment file read-only and validate its header. */
+  CaptureError Open(const char* path) noexcept {
+    if (map_ != nullptr) {
+      return CaptureError::ALREADY_OPEN;
+    }
+    const int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+      return CaptureError::OPEN_FAILED;
+    }
+    struct stat st{};
+    if (fstat(fd, &st) != 0) {
+      (void)close(fd);
+      return CaptureError::OPEN_FAILED;
+    }
+    const auto size = static_cast<uint64_t>(st.st_size);
+    if (size < sizeof(CaptureFileHeader)) {
+      (void)close(fd);
+      return CaptureError::LAYOUT_MISMATCH;
+    }
+    void* addr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    (void)close(fd);
+    if (addr == MAP_FAILED) {
+      return CaptureError::MMAP_FAILED;
+    }
+
+    CaptureFileHeader header{};
+    (void)std::memcpy(&header, addr, sizeof(header));
+    CaptureError err = CaptureError::OK;
+    if ((header.magic != CAPTURE_MAGIC) || (header.version != CAPTURE_VERSION) ||
+        (header.header_bytes != sizeof(CaptureFileHeader))) {
+      err = CaptureError::LAYOUT_MISMATCH;
+    } else if (header.type_hash != TYPE_HASH) {
+      err = CaptureError::TYPE_MISMATCH;
+    } else if (header.data_bytes > (size - sizeof(CaptureFileHeader))) {
+      err = CaptureError::TRUNCATED;
+    }
+    if (err != CaptureError::OK) {
+      (void)munmap(addr, size);
+      return err;
+    }
+    map_ = static_cast<const uint8_t*>(addr);
+    map_bytes_ = size;
+    header_ = header;
+    return CaptureError::OK;
+  }
+
+  void Close() noexcept {
+    if (map_ != nullptr) {
+      (void)munmap(const_cast<uint8_t*>(map_), map_bytes_);
+      map_ = nullptr;
+      map_bytes_ = 0U;
+    }
+  }
+
+  uint64_t RecordCount() const noexcept { return (map_ != nullptr) ? header_.record_count : 0U; }
+  uint32_t SegmentIndex() const noexcept { return header_.segment_index; }
+
+  /**
+   * @brief Publish every record of the open segment, in capture order.
+   * @return Records accepted by the bus
+   */
+  uint64_t Replay(const ReplayConfig& config = ReplayConfig{}) noexcept {
+    if (map_ == nullptr) {
+      return 0U;
+    }
+    const uint64_t start_ns = SteadyClock::NowNs();
+    const uint64_t max_gap_ns = config.max_gap_us * 1000U;
+    uint64_t offset_ns = 0U;  // pacing target relative to start_ns
+    uint64_t prev_ns = 0U;
+    uint64_t replayed = 0U;
+    const uint8_t* cursor = map_ + sizeof(CaptureFileHeader);
+    const uint8_t* const end = cursor + header_.data_bytes;
+    for (uint64_t r = 0U;
+         (r < header_.record_count) && (static_cast<uint64_t>(end - cursor) >= sizeof(CaptureRecordHeader)); ++r) {
+      CaptureRecordHeader record{};
+      (void)std::memcpy(&record, cursor, sizeof(record));
+      const uint8_t* payload = cursor + sizeof(record);
+      const uint64_t record_bytes = sizeof(record) + detail::CapturePad8(record.payload_size);
+      if (static_cast<uint64_t>(end - cursor) < record_bytes) {
+        ++stats_.decode_errors;
+        break;
+      }
+      cursor += record_bytes;
+
+      if (config.speedup > 0U) {
+        if (r > 0U) {
+          uint64_t gap_ns = (record.publish_ns > prev_ns) ? (record.publish_ns - prev_ns) : 0U;
+          if ((max_gap_ns > 0U) && (gap_ns > max_gap_ns)) {
+            gap_ns = max_gap_ns;
+          }
+          offset_ns += gap_ns / config.speedup;
+          WaitUntil(start_ns + offset_ns);
+        }
+        prev_ns = record.publish_ns;
+      }
+      replayed += PublishRecord(record, payload, config) ? 1U : 0U;
+    }
+    return replayed;
+  }
+
+  const ReplayStatistics& GetStatistics() const noexcept { return stats_; }
+
+ private:
+  static void WaitUntil(uint64_t deadline_ns) noexcept {
+    constexpr uint64_t SPIN_NS = 100000U;  // sleep granularity is far coarser; spin the last 100 us
+    uint64_t now = SteadyClock::NowNs();
+    if ((deadline_ns > now) && ((deadline_ns - now) > SPIN_NS)) {
+      std::this_thread::sleep_for(std::chrono::nanoseconds(deadline_ns - now - SPIN_NS));
+    }
+    while (SteadyClock::NowNs() < deadline_ns) {
+      detail::CpuRelax();
+    }
+  }
+
+  bool PublishRecord(const CaptureRecordHeader& record, const uint8_t* bytes, const ReplayConfig& config) noexcept {
+    if (record.priority > static_cast<uint8_t>(MessagePriority::HIGH)) {
+      ++stats_.decode_errors;
+      return false;
+    }
+    for (;;) {
+      PayloadVariant payload;
+      if (!detail::DecodeTrivialPayload(record.type_index, bytes, record.payload_size, payload)) {
+        ++stats_.decode_errors;
+        return false;
+      }
+      const bool accepted =
+          config.keep_timestamps
+              ? bus_.PublishFast(std::move(payload), record.sender_id, record.timestamp_us)
+              : bus_.PublishWithPriority(std::move(payload), record.sender_id,
+                                         static_cast<MessagePriority>(record.priority));
+      if (accepted) {
+        ++stats_.records_replayed;
+        return true;
+      }
+      if (!config.retry_when_full) {
+        ++stats_.publish_dropped;
+        return false;
+      }
+      ++stats_.publish_retries;
+      std::this_thread::yield();
+    }
+  }
+
+  BusT& bus_;
+  const uint8_t* map_{nullptr};
+  uint64_t map_bytes_{0U};
+  CaptureFileHeader header_{};
+  ReplayStatistics stats_{};
+};
+
+}  // namespace mccc
+
+#endif  // MCCC_BUS_RECORDER_HPP_
@@ -36,6 +36,7 @@
 
 #include <functional>
 #include <memory>
+#include <type_traits>
 #include <utility>
 
 namespace mccc {
@@ -50,26 +51,56 @@ namespace mccc {
  *
  * Provides shared_from_this capability and automatic subscription cleanup.
  * Uses FixedVector for zero heap allocation in subscription management.
+ * Subscribes on BusT::Instance() unless bound to a bus in the constructor.
+ *
+ * Lifetime: SubscribeSafe() callbacks lock a weak_ptr per message and work
+ * however the component is owned. Components built with Create() are
+ * unsubscribed (grace period included) before any destructor runs, so their
+ * SubscribeMember() / SubscribeSimple() callbacks may use a raw `this`
+ * without per-message reference counting.
  *
  * @tparam PayloadVariant A std::variant<...> of user-defined message types.
+ * @tparam BusT           Bus type (default AsyncBus<PayloadVariant>).
  */
-template <typename PayloadVariant>
-class Component : public std::enable_shared_from_this<Component<PayloadVariant>> {
+template <typename PayloadVariant, typename BusT = AsyncBus<PayloadVariant>>
+class Component : public std::enable_shared_from_this<Component<PayloadVariant, BusT>> {
  public:
-  using BusType = AsyncBus<PayloadVariant>;
+  using BusType = BusT;
   using EnvelopeType = MessageEnvelope<PayloadVariant>;
 
-  virtual ~Component() {
-    for (const auto& handle : handles_) {
-      BusType::Instance().Unsubscribe(handle);
-    }
-  }
+  virtual ~Component() { UnsubscribeAll(); }
 
   // No-op by default, can be extended by subclasses
   void InitializeComponent() noexcept {}
 
+  /** @brief Bus this component subscribes on. */
+  BusType& Bus() const noexcept { return *bus_; }
+
+  /**
+   * @brief Construct a Derived component owned by a shared_ptr that unsubscribes it first.
+   *
+   * The deleter calls UnsubscribeAll(), which returns once no callback is
+   * running or will run, and only then deletes the object. Callbacks that
+   * capture `this` can therefore never see a partly destroyed component, and
+   * the consumer never holds a reference that would make it run the
+   * destructor. Derived's constructor must be accessible from this class.
+   * The last reference must not be dropped from a callback on the same bus
+   * (see AsyncBus::Unsubscribe()).
+   */
+  template <typename Derived, typename... Args>
+  static std::shared_ptr<Derived> Create(Args&&... args) {
+    static_assert(std::is_base_of<Component, Derived>::value, "Derived must derive from this Component");
+    return std::shared_ptr<Derived>(new Derived(std::forward<Args>(args)...), [](Derived* component) noexcept {
+      static_cast<Component*>(component)->UnsubscribeAll();
+      delete component;
+    });
+  }
+
  protected:
-  Component() noexcept = default;
+  Component() noexcept : bus_(&BusType::Instance()) {}
+
+  /** @brief Bind the component to a caller-owned bus (must outlive the component). */
+  explicit Component(BusType& bus) noexcept : bus_(&bus) {}
 
   Component(const Component&) = delete;
   Component& operator=(const Component&) = delete;
@@ -84,15 +115,12 @@ class Component : public std::enable_shared_from_this<Component<PayloadVariant>>
    */
   template <typename T, typename Func>
   void SubscribeSafe(Func&& callback) noexcept {
-    SubscriptionHandle handle = BusType::Instance().template Subscribe<T>(
+    SubscriptionHandle handle = bus_->template Subscribe<T>(
         [weak_self = std::weak_ptr<Component>(this->shared_from_this()),
          cb = std::forward<Func>(callback)](const EnvelopeType& env) noexcept {
           std::shared_ptr<Component> self = weak_self.lock();
           if (self != nullptr) {
-            const T* data = std::get_if<T>(&env.payload);
-            if (data != nullptr) {
-              cb(self, *data, env.header);
-            }
+            cb(self, PayloadOf<T>(env), env.header);
           }
         });
 
@@ -101,6 +129,31 @@ class Component : public std::enable_shared_from_this<Component<PayloadVariant>>
     }
   }
 
+  /**
+   * @brief Dispatch T messages straight to a member function of the derived component.
+   *
+   * No weak_ptr lock per message: the component must be built with Create(),
+   * or the derived destructor must call UnsubscribeAll() before its members
+   * go away.
+   *
+   * @return false when the bus or component subscription capacity is exhausted
+   */
+  template <typename T, typename Derived>
+  bool SubscribeMember(void (Derived::*method)(const T&, const MessageHeader&)) noexcept {
+    static_assert(std::is_base_of<Component, Derived>::value, "Derived must derive from this Component");
+    Derived* self = static_cast<Derived*>(this);
+    SubscriptionHandle handle = bus_->template Subscribe<T>(
+        [self, method](const EnvelopeType& env) noexcept { (self->*method)(PayloadOf<T>(env), env.header); });
+    if (handle.callback_id == static_cast<size_t>(-1)) {
+      return false;
+    }
+    if (!handles_.push_back(handle)) {
+      bus_->Unsubscribe(handle);
+      return false;
+    }
+    return true;
+  }
+
   /**
    * @brief Subscribe with simple callback (no self pointer).
    *
@@ -108,20 +161,62 @@ class Component : public std::enable_shared_from_this<Component<PayloadVariant>>
    */
   template <typename T, typename Func>
   void SubscribeSimple(Func&& callback) noexcept {
-    SubscriptionHandle handle = BusType::Instance().template Subscribe<T>(
-        [cb = std::forward<Func>(callback)](const EnvelopeType& env) noexcept {
-          const T* data = std::get_if<T>(&env.payload);
-          if (data != nullptr) {
-            cb(*data, env.header);
-          }
-        });
+    SubscriptionHandle handle = bus_->template Subscribe<T>(
+        [cb = std::forward<Func>(callback)](const EnvelopeType& env) noexcept { cb(PayloadOf<T>(env), env.header); });
 
     if (handle.callback_id != static_cast<size_t>(-1)) {
       (void)handles_.push_back(handle);
     }
   }
 
+  /**
+   * @brief SubscribeSimple() for the T messages that pass filter.
+   *
+   * Callback signature: (const T&, const MessageHeader&)
+   * @return false when the bus or component subscription capacity is exhausted
+   */
+  template <typename T, typename Func>
+  bool SubscribeSimple(const SubscriptionFilter& filter, Func&& callback) noexcept {
+    SubscriptionHandle handle = bus_->template Subscribe<T>(
+        filter,
+        [cb = std::forward<Func>(callback)](const EnvelopeType& env) noexcept { cb(PayloadOf<T>(env), env.header); });
+
+    if (handle.callback_id == static_cast<size_t>(-1)) {
+      return false;
+    }
+    if (!handles_.push_back(handle)) {
+      bus_->Unsubscribe(handle);
+      return false;
+    }
+    return true;
+  }
+
+  /**
+   * @brief Drop every subscription of this component.
+   *
+   * Returns after the grace period, so no callback is running or will run.
+   * Derived classes whose callbacks capture `this` call it first in their
+   * destructor, before their own members are destroyed.
+   */
+  void UnsubscribeAll() noexcept {
+    for (const auto& handle : handles_) {
+      bus_->Unsubscribe(handle);
+    }
+    handles_.clear();
+  }
+
  private:
+  /** Payload of a message delivered to a T callback; the bus's type-indexed table already matched the alternative. */
+  template <typename T>
+  static const T& PayloadOf(const EnvelopeType& env) noexcept {
+    const T* data = std::get_if<T>(&env.payload);
+    if (data == nullptr) {
+      __builtin_unreachable();  // lets the compiler drop the second index test
+    }
+    return *data;
+  }
+
+  BusType* bus_;
   FixedVector<SubscriptionHandle, MCCC_MAX_SUBSCRIPTIONS_PER_COMPONENT> handles_;
 };
 
@@ -0,0 +1,490 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2024 liudegui
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file lane_bus.hpp
+ * @brief Multi-producer bus built from per-producer SPSC lanes.
+ *
+ * In an MPSC AsyncBus every producer CASes the same producer_pos_ cache line,
+ * so throughput falls as producers are added. LaneBus gives each registered
+ * producer thread its own SingleProducer AsyncBus ring (the wait-free
+ * MCCC_SINGLE_PRODUCER claim, without a CAS) and the single consumer merges
+ * the lanes in ProcessBatch(), round-robin or by header timestamp.
+ */
+
+#ifndef MCCC_LANE_BUS_HPP_
+#define MCCC_LANE_BUS_HPP_
+
+#include "mccc/mccc.hpp"
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <utility>
+
+namespace mccc {
+
+/**
+ * @brief Order in which LaneBus::ProcessBatch merges its lanes.
+ */
+enum class LaneMerge : uint8_t {
+  ROUND_ROBIN = 0U, /**< Up to LANE_SLICE messages per lane per round */
+  TIMESTAMP = 1U    /**< Oldest header timestamp first across lanes */
+};
+
+/**
+ * @brief Per-producer SPSC lanes layered on AsyncBus.
+ *
+ * Usage:
+ * @code
+ * using MyLaneBus = mccc::LaneBus<MyPayload, 8U, 4096U>;
+ * MyLaneBus bus;                                   // ROUND_ROBIN
+ * bus.Subscribe<SensorData>([](const auto& env) { ... });
+ *
+ * // In each producer thread:
+ * MyLaneBus::Producer producer = bus.RegisterProducer();
+ * producer.Publish(SensorData{...}, 3U);          // no CAS, no shared cache line
+ *
+ * // In the consumer thread:
+ * bus.ProcessBatch();
+ * @endcode
+ *
+ * Ordering: messages of one Producer are dispatched in publish order. Across
+ * producers, ROUND_ROBIN interleaves lanes in slices; TIMESTAMP dispatches the
+ * lane head with the smallest timestamp_ns (timestamp_us when the header has
+ * no ns field), which needs a real Clock (NoClock degrades to lane order).
+ *
+ * Admission: thresholds are those of a single AsyncBus of the same Depth,
+ * applied to the summed depth of all lanes, so adding producers does not
+ * raise the backlog the consumer can face. Each producer caches the summed
+ * depth and re-reads the lanes every DEPTH_REFRESH_INTERVAL publishes or when
+ * its estimate reaches the threshold; the estimate only over-counts between
+ * refreshes, by the other producers' traffic since the last refresh.
+ *
+ * A Producer may only be used by one thread at a time. Message IDs are unique
+ * per lane, not across lanes. Single consumer: ProcessBatch() and Lane() draining.
+ *
+ * @tparam PayloadVariant A std::variant<...> of user-defined message types.
+ * @tparam NumLanes       Maximum number of registered producers.
+ * @tparam Depth          Queue depth of each lane (power of 2).
+ * @tparam Clock          Header timestamp source of every lane (see AsyncBus).
+ */
+template <typename PayloadVariant, uint32_t NumLanes, uint32_t Depth = static_cast<uint32_t>(MCCC_QUEUE_DEPTH),
+          typename Clock = SteadyClock>
+class LaneBus {
+  static_assert(NumLanes > 0U, "LaneBus needs at least one lane");
+
+ public:
+  using LaneType = AsyncBus<PayloadVariant, Depth, Clock, true>;
+  using EnvelopeType = MessageEnvelope<PayloadVariant>;
+  using PerformanceMode = typename LaneType::PerformanceMode;
+
+  static constexpr uint32_t LANE_COUNT = NumLanes;
+  static constexpr uint32_t PRIORITY_LEVELS = 3U;
+  static constexpr uint32_t BATCH_PROCESS_SIZE = LaneType::BATCH_PROCESS_SIZE;
+  static constexpr uint32_t LANE_SLICE = 64U;             /**< Messages per lane per ROUND_ROBIN round */
+  static constexpr uint32_t DEPTH_REFRESH_INTERVAL = 64U; /**< Publishes between two summed-depth reads */
+
+  static constexpr uint32_t LOW_PRIORITY_THRESHOLD = LaneType::LOW_PRIORITY_THRESHOLD;
+  static constexpr uint32_t MEDIUM_PRIORITY_THRESHOLD = LaneType::MEDIUM_PRIORITY_THRESHOLD;
+  static constexpr uint32_t HIGH_PRIORITY_THRESHOLD = LaneType::HIGH_PRIORITY_THRESHOLD;
+
+  /**
+   * @brief Publishing end of one lane, returned by RegisterProducer().
+   *
+   * Move-only; the lane is released on destruction or Release(). Messages
+   * still queued on a released lane are dispatched normally.
+   */
+  class Producer {
+   public:
+    Producer() noexcept = default;
+    ~Producer() { Release(); }
+
+    Producer(const Producer&) = delete;
+    Producer& operator=(const Producer&) = delete;
+
+    Producer(Producer&& other) noexcept : bus_(other.bus_), lane_(other.lane_) { other.bus_ = nullptr; }
+
+    Producer& operator=(Producer&& other) noexcept {
+      if (this != &other) {
+        Release();
+        bus_ = other.bus_;
+        lane_ = other.lane_;
+        other.bus_ = nullptr;
+      }
+      return *this;
+    }
+
+    bool Publish(PayloadVariant&& payload, uint32_t sender_id) noexcept {
+      return PublishWithPriority(std::move(payload), sender_id, MessagePriority::MEDIUM);
+    }
+
+    bool PublishWithPriority(PayloadVariant&& payload, uint32_t sender_id, MessagePriority priority) noexcept {
+      if ((bus_ == nullptr) || !bus_->Admit(lane_, payload, priority)) {
+        return false;
+      }
+      return bus_->Commit(lane_, bus_->Lane(lane_).PublishWithPriority(std::move(payload), sender_id, priority));
+    }
+
+    bool PublishFast(PayloadVariant&& payload, uint32_t sender_id, uint64_t timestamp_us) noexcept {
+      if ((bus_ == nullptr) || !bus_->Admit(lane_, payload, MessagePriority::MEDIUM)) {
+        return false;
+      }
+      return bus_->Commit(lane_, bus_->Lane(lane_).PublishFast(std::move(payload), sender_id, timestamp_us));
+    }
+
+    /** @brief Give the lane back to the bus (no-op when not registered). */
+    void Release() noexcept {
+      if (bus_ != nullptr) {
+        bus_->ReleaseLane(lane_);
+        bus_ = nullptr;
+      }
+    }
+
+    bool Valid() const noexcept { return bus_ != nullptr; }
+    explicit operator bool() const noexcept { return Valid(); }
+    uint32_t LaneIndex() const noexcept { return lane_; }
+
+   private:
+    friend class LaneBus;
+    Producer(LaneBus* bus, uint32_t lane) noexcept : bus_(bus), lane_(lane) {}
+
+    LaneBus* bus_{nullptr};
+    uint32_t lane_{0U};
+  };
+
+  /**
+   * @brief Subscription handle spanning the lanes.
+   */
+  struct LaneSubscriptionHandle {
+    std::array<SubscriptionHandle, NumLanes> handles; /**< Per-lane handle */
+    bool valid;                                       /**< Every lane accepted the callback */
+  };
+
+  explicit LaneBus(LaneMerge merge = LaneMerge::ROUND_ROBIN) : merge_(merge) {
+    for (uint32_t i = 0U; i < NumLanes; ++i) {
+      lanes_[i] = std::make_unique<LaneType>();
+      states_[i].claimed.store(false, std::memory_order_relaxed);
+      for (auto& dropped : states_[i].dropped) {
+        dropped.store(0U, std::memory_order_relaxed);
+      }
+    }
+  }
+
+  ~LaneBus() = default;
+  LaneBus(const LaneBus&) = delete;
+  LaneBus& operator=(const LaneBus&) = delete;
+  LaneBus(LaneBus&&) = delete;
+  LaneBus& operator=(LaneBus&&) = delete;
+
+  // ======================== Producer API ========================
+
+  /**
+   * @brief Claim a free lane for the calling producer thread.
+   * @return Invalid Producer if all NumLanes lanes are registered
+   */
+  Producer RegisterProducer() noexcept {
+    for (uint32_t i = 0U; i < NumLanes; ++i) {
+      LaneState& state = states_[i];
+      bool expected = false;
+      if (!state.claimed.load(std::memory_order_relaxed) &&
+          state.claimed.compare_exchange_strong(expected, true, std::memory_order_acq_rel,
+                                                std::memory_order_relaxed)) {
+        state.cached_depth = 0U;
+        state.since_refresh = DEPTH_REFRESH_INTERVAL;
+        return Producer(this, i);
+      }
+    }
+    return Producer();
+  }
+
+  /** @brief Number of lanes currently held by a Producer. */
+  uint32_t RegisteredProducers() const noexcept {
+    uint32_t count = 0U;
+    for (const auto& state : states_) {
+      count += state.claimed.load(std::memory_order_relaxed) ? 1U : 0U;
+    }
+    return count;
+  }
+
+  // ======================== Subscribe API ========================
+
+  /**
+   * @brief Subscribe on every lane.
+   *
+   * The callable is copied once per lane, so it must be copy-constructible.
+   */
+  template <typename T, typename Func>
+  LaneSubscriptionHandle Subscribe(Func&& func) {
+    LaneSubscriptionHandle result{};
+    result.valid = true;
+    for (uint32_t i = 0U; i < NumLanes; ++i) {
+      result.handles[i] = lanes_[i]->template Subscribe<T>(typename std::decay<Func>::type(func));
+      if (result.handles[i].callback_id == static_cast<size_t>(-1)) {
+        result.valid = false;
+      }
+    }
+    return result;
+  }
+
+  /**
+   * @return true if at least one lane removed the callback
+   */
+  bool Unsubscribe(const LaneSubscriptionHandle& handle) noexcept {
+    bool removed = false;
+    for (uint32_t i = 0U; i < NumLanes; ++i) {
+      removed = lanes_[i]->Unsubscribe(handle.handles[i]) || removed;
+    }
+    return removed;
+  }
+
+  // ======================== Processing API ========================
+
+  /**
+   * @brief Dispatch up to BATCH_PROCESS_SIZE messages merged across the lanes.
+   *
+   * ROUND_ROBIN: each round takes up to LANE_SLICE messages from every lane,
+   * starting one lane later than the previous call.
+   * TIMESTAMP: repeatedly dispatches the oldest lane head, draining that lane
+   * while its head is not newer than the next-oldest lane head. Updated
+   * ConflationTraits slots go ahead of their lane's ring (ROUND_ROBIN) or
+   * ahead of all lanes (TIMESTAMP).
+   *
+   * @return Number of messages processed
+   */
+  uint32_t ProcessBatch() noexcept {
+    return (merge_ == LaneMerge::ROUND_ROBIN) ? ProcessRoundRobin() : ProcessByTimestamp();
+  }
+
+  // ======================== Status API ========================
+
+  LaneType& Lane(uint32_t lane) noexcept { return *lanes_[lane]; }
+  const LaneType& Lane(uint32_t lane) const noexcept { return *lanes_[lane]; }
+
+  /** @brief Sum of all lane depths (the value admission is checked against). */
+  uint32_t QueueDepth() const noexcept {
+    uint32_t depth = 0U;
+    for (const auto& lane : lanes_) {
+      depth += lane->QueueDepth();
+    }
+    return depth;
+  }
+
+  /** @brief Statistics aggregated over all lanes, including summed-depth admission drops. */
+  BusStatisticsSnapshot GetStatistics() const noexcept {
+    BusStatisticsSnapshot total{};
+    for (const auto& lane : lanes_) {
+      AccumulateStatistics(total, lane->GetStatistics());
+    }
+    for (const auto& state : states_) {
+      const uint64_t low = state.dropped[static_cast<uint32_t>(MessagePriority::LOW)].load(std::memory_order_relaxed);
+      const uint64_t medium =
+          state.dropped[static_cast<uint32_t>(MessagePriority::MEDIUM)].load(std::memory_order_relaxed);
+      const uint64_t high = state.dropped[static_cast<uint32_t>(MessagePriority::HIGH)].load(std::memory_order_relaxed);
+      total.low_priority_dropped += low;
+      total.medium_priority_dropped += medium;
+      total.high_priority_dropped += high;
+      total.messages_dropped += low + medium + high;
+    }
+    return total;
+  }
+
+  void ResetStatistics() noexcept {
+    for (auto& lane : lanes_) {
+      lane->ResetStatistics();
+    }
+    for (auto& state : states_) {
+      for (auto& dropped : state.dropped) {
+        dropped.store(0U, std::memory_order_relaxed);
+      }
+    }
+  }
+
+  void SetPerformanceMode(PerformanceMode mode) noexcept {
+    performance_mode_.store(mode, std::memory_order_relaxed);
+    for (auto& lane : lanes_) {
+      lane->SetPerformanceMode(mode);
+    }
+  }
+
+  void SetErrorCallback(ErrorCallback callback) noexcept {
+    error_callback_.store(callback, std::memory_order_release);
+    for (auto& lane : lanes_) {
+      lane->SetErrorCallback(callback);
+    }
+  }
+
+ private:
+  /** Producer-side admission state of one lane (the cached fields belong to the lane owner). */
+  struct MCCC_ALIGN_CACHELINE LaneState {
+    std::atomic<bool> claimed;
+    uint32_t cached_depth{0U};                      /**< Summed depth at the last refresh */
+    uint32_t since_refresh{DEPTH_REFRESH_INTERVAL}; /**< Publishes on this lane since that refresh */
+    std::array<std::atomic<uint64_t>, PRIORITY_LEVELS> dropped; /**< Summed-depth drops by MessagePriority */
+  };
+
+  static uint32_t ThresholdFor(MessagePriority priority) noexcept {
+    switch (priority) {
+      case MessagePriority::HIGH:
+        return HIGH_PRIORITY_THRESHOLD;
+      case MessagePriority::MEDIUM:
+        return MEDIUM_PRIORITY_THRESHOLD;
+      case MessagePriority::LOW:
+      default:
+        return LOW_PRIORITY_THRESHOLD;
+    }
+  }
+
+  /**
+   * @brief Summed-depth admission for one publish on a lane.
+   *
+   * The estimate is the last summed depth plus this lane's publishes since
+   * then; the lanes are only read again when it reaches the threshold or the
+   * refresh interval is up. ConflationTraits types are not checked: like on
+   * AsyncBus they overwrite a latest-value slot instead of growing the
+   * backlog (and fall back to the lane's own admission when its table is full).
+   */
+  bool Admit(uint32_t lane, const PayloadVariant& payload, MessagePriority priority) noexcept {
+    const PerformanceMode mode = performance_mode_.load(std::memory_order_relaxed);
+    if ((mode == PerformanceMode::BARE_METAL) || LaneType::IsConflated(payload)) {
+      return true;
+    }
+    LaneState& state = states_[lane];
+    const uint32_t threshold = ThresholdFor(priority);
+    if ((state.since_refresh >= DEPTH_REFRESH_INTERVAL) || ((state.cached_depth + state.since_refresh) >= threshold)) {
+      state.cached_depth = QueueDepth();
+      state.since_refresh = 0U;
+      if (state.cached_depth >= threshold) {
+        if (mode != PerformanceMode::NO_STATS) {
+          const auto level = static_cast<uint32_t>(priority);
+          state.dropped[(level < PRIORITY_LEVELS) ? level : 0U].fetch_add(1U, std::memory_order_relaxed);
+          ReportError(BusError::QUEUE_FULL);
+        }
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool Commit(uint32_t lane, bool published) noexcept {
+    if (published) {
+      ++states_[lane].since_refresh;
+    }
+    return published;
+  }
+
+  void ReleaseLane(uint32_t lane) noexcept { states_[lane].claimed.store(false, std::memory_order_release); }
+
+  /** No message ID is assigned to a message rejected before it reaches a lane. */
+  void ReportError(BusError error) const noexcept {
+    ErrorCallback cb = error_callback_.load(std::memory_order_acquire);
+    if (cb != nullptr) {
+      cb(error, 0U);
+    }
+  }
+
+  static uint64_t MergeKey(const MessageHeader& header) noexcept {
+    if (header.msg_id == 0U) {
+      return 0U;  // cancelled slot: nothing to order, let it go first
+    }
+#if MCCC_HEADER_HAS_TIMESTAMP_NS
+    return header.timestamp_ns;
+#else
+    return header.timestamp_us;
+#endif
+  }
+
+  uint32_t ProcessRoundRobin() noexcept {
+    uint32_t processed = 0U;
+    const uint32_t start = next_lane_;
+    next_lane_ = (next_lane_ + 1U) % NumLanes;
+    while (processed < BATCH_PROCESS_SIZE) {
+      uint32_t round = 0U;
+      for (uint32_t k = 0U; (k < NumLanes) && ((processed + round) < BATCH_PROCESS_SIZE); ++k) {
+        const uint32_t budget = BATCH_PROCESS_SIZE - processed - round;
+        round += lanes_[(start + k) % NumLanes]->ProcessBatch((LANE_SLICE < budget) ? LANE_SLICE : budget);
+      }
+      if (round == 0U) {
+        break;
+      }
+      processed += round;
+    }
+    return processed;
+  }
+
+  uint32_t ProcessByTimestamp() noexcept {
+    // Latest-value samples are not in the rings: deliver them first, as AsyncBus::ProcessBatch() does
+    uint32_t processed = 0U;
+    for (uint32_t k = 0U; (k < NumLanes) && (processed < BATCH_PROCESS_SIZE); ++k) {
+      processed += lanes_[(next_lane_ + k) % NumLanes]->ProcessConflated(BATCH_PROCESS_SIZE - processed);
+    }
+    while (processed < BATCH_PROCESS_SIZE) {
+      // Oldest and next-oldest lane heads; ties go to the lane scanned first
+      uint32_t oldest = NumLanes;
+      uint64_t oldest_key = 0U;
+      uint64_t next_key = ~static_cast<uint64_t>(0U);
+      for (uint32_t k = 0U; k < NumLanes; ++k) {
+        const uint32_t i = (next_lane_ + k) % NumLanes;
+        const MessageHeader* head = lanes_[i]->PeekHeader();
+        if (head == nullptr) {
+          continue;
+        }
+        const uint64_t key = MergeKey(*head);
+        if ((oldest == NumLanes) || (key < oldest_key)) {
+          if (oldest != NumLanes) {
+            next_key = oldest_key;
+          }
+          oldest = i;
+          oldest_key = key;
+        } else if (key < next_key) {
+          next_key = key;
+        }
+      }
+      if (oldest == NumLanes) {
+        break;
+      }
+
+      LaneType& lane = *lanes_[oldest];
+      const MessageHeader* head = lane.PeekHeader();
+      // One slot at a time: an expired or cancelled head is released and the new head compared again
+      while ((head != nullptr) && (MergeKey(*head) <= next_key) && (processed < BATCH_PROCESS_SIZE)) {
+        processed += lane.ProcessHead();
+        head = lane.PeekHeader();
+      }
+      next_lane_ = (oldest + 1U) % NumLanes;
+    }
+    return processed;
+  }
+
+  const LaneMerge merge_;
+  std::array<std::unique_ptr<LaneType>, NumLanes> lanes_;
+  std::array<LaneState, NumLanes> states_;
+  std::atomic<PerformanceMode> performance_mode_{PerformanceMode::FULL_FEATURED};
+  std::atomic<ErrorCallback> error_callback_{nullptr};
+  uint32_t next_lane_{0U}; /**< Consumer-only rotation cursor */
+};
+
+}  // namespace mccc
+
+#endif  // MCCC_LANE_BUS_HPP_
@@ -54,17 +54,22 @@
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
+#include <ctime>
 
 #include <array>
 #include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <functional>
+#include <iterator>
 #include <limits>
 #include <mutex>
 #include <new>
-#include <shared_mutex>
 #include <string>
+#include <thread>
+#include <tuple>
 #include <type_traits>
+#include <utility>
 #include <variant>
 
 namespace mccc {
@@ -528,63 +533,6 @@ class FixedFunction<R(Args...), Capacity> {
   alignas(std::max_align_t) uint8_t storage_[Capacity];
 };
 
-// ============================================================================
-// Message Priority & Header
-// ============================================================================
-
-/**
- * @brief Message priority levels for backpressure control.
- */
-enum class MessagePriority : uint8_t {
-  LOW = 0U,    /** Dropped when queue >= 60% full */
-  MEDIUM = 1U, /** Dropped when queue >= 80% full */
-  HIGH = 2U    /** Dropped when queue >= 99% full (highest admission threshold) */
-};
-
-/**
- * @brief Message header for tracing and debugging.
- */
-struct MessageHeader {
-  uint64_t msg_id;          /** Global incremental ID */
-  uint64_t timestamp_us;    /** Microsecond timestamp */
-  uint32_t sender_id;       /** Sender identifier */
-  MessagePriority priority; /** Message priority level */
-
-  MessageHeader() noexcept : msg_id(0U), timestamp_us(0U), sender_id(0U), priority(MessagePriority::MEDIUM) {}
-  MessageHeader(uint64_t id, uint64_t ts, uint32_t sender, MessagePriority prio) noexcept
-      : msg_id(id), timestamp_us(ts), sender_id(sender), priority(prio) {}
-};
-
-// ============================================================================
-// Message Envelope (templatized on user-defined PayloadVariant)
-// ============================================================================
-
-/**
- * @brief Message envelope (value type, embeddable directly in ring buffer).
- *
- * @tparam PayloadVariant A std::variant<...> of user-defined message types.
- *
- * Example:
- *   using MyPayload = std::variant<SensorData, MotorCommand, AlarmEvent>;
- *   using MyEnvelope = mccc::MessageEnvelope<MyPayload>;
- */
-template <typename PayloadVariant>
-struct MessageEnvelope {
-  MessageHeader header;
-  PayloadVariant payload;
-
-  /** @brief Default constructor for ring buffer pre-allocation */
-  MessageEnvelope() noexcept : header(), payload() {}
-
-  explicit MessageEnvelope(const MessageHeader& hdr, PayloadVariant&& pl) noexcept
-      : header(hdr), payload(std::move(pl)) {}
-
-  MessageEnvelope(MessageEnvelope&&) noexcept = default;
-  MessageEnvelope& operator=(MessageEnvelope&&) noexcept = default;
-  MessageEnvelope(const MessageEnvelope&) = default;
-  MessageEnvelope& operator=(const MessageEnvelope&) = default;
-};
-
 // ============================================================================
 // Compile-time Configuration
 // ============================================================================
@@ -630,6 +578,38 @@ struct MessageEnvelope {
 #define MCCC_MAX_CALLBACKS_PER_TYPE 16U
 #endif
 
+// Buckets of the per-type filter index (power of 2, <= 64): a filtered
+// callback is visited only for messages whose key falls in one of its buckets
+#ifndef MCCC_FILTER_BUCKETS
+#define MCCC_FILTER_BUCKETS 16U
+#endif
+
+// Ring layout: 0 = one cache-line aligned node per slot (sequence + envelope),
+// 1 = split layout: densely packed sequence array + envelope array padded only
+//     to the envelope's natural alignment (small messages, lower footprint)
+#ifndef MCCC_COMPACT_RING
+#define MCCC_COMPACT_RING 0
+#endif
+
+// Dispatch latency histogram: 1 = record publish-to-dispatch latency per message
+// type and priority from MessageHeader::timestamp_ns (see
+// AsyncBus::GetLatencyStatistics). 0 = compiled out.
+#ifndef MCCC_ENABLE_LATENCY_HISTOGRAM
+#define MCCC_ENABLE_LATENCY_HISTOGRAM 0
+#endif
+
+// Nanosecond header timestamp: 1 = MessageHeader gains timestamp_ns (8 bytes).
+// Implied by MCCC_ENABLE_LATENCY_HISTOGRAM.
+#ifndef MCCC_HEADER_TIMESTAMP_NS
+#define MCCC_HEADER_TIMESTAMP_NS 0
+#endif
+
+#if MCCC_HEADER_TIMESTAMP_NS || MCCC_ENABLE_LATENCY_HISTOGRAM
+#define MCCC_HEADER_HAS_TIMESTAMP_NS 1
+#else
+#define MCCC_HEADER_HAS_TIMESTAMP_NS 0
+#endif
+
 // Single-core mode: disable cache-line alignment (no false sharing concern) + relaxed memory ordering
 #if MCCC_SINGLE_CORE
 #define MCCC_ALIGN_CACHELINE
@@ -654,151 +634,1101 @@ inline void ReleaseFence() noexcept {
   std::atomic_signal_fence(std::memory_order_release);
 #endif
 }
+/** Spin-wait hint (PAUSE / YIELD); a no-op where the ISA has none. */
+inline void CpuRelax() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+  __asm__ __volatile__("yield" ::: "memory");
+#endif
+}
 }  // namespace detail
 
 // ============================================================================
-// Template Helpers
+// Timestamp Clocks (AsyncBus Clock policy)
 // ============================================================================
 
 /**
- * @brief Compile-time variant index calculation (C++17 recursive template).
+ * A Clock policy is any type with `static uint64_t NowNs() noexcept` returning
+ * monotonic nanoseconds. The bus calls it once per Publish / PublishBatch /
+ * Commit to fill MessageHeader::timestamp_us (and timestamp_ns when present).
  */
-namespace detail {
-
-template <typename T, size_t I, typename Variant>
-struct VariantIndexImpl;
 
-template <typename T, size_t I>
-struct VariantIndexImpl<T, I, std::variant<>> {
-  static constexpr size_t value = static_cast<size_t>(-1);
+/**
+ * @brief std::chrono::steady_clock (default; vDSO clock_gettime on Linux).
+ */
+struct SteadyClock {
+  static uint64_t NowNs() noexcept {
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch());
+    return static_cast<uint64_t>(ns.count());
+  }
 };
 
-template <typename T, size_t I, typename First, typename... Rest>
-struct VariantIndexImpl<T, I, std::variant<First, Rest...>> {
-  static constexpr size_t value =
-      std::is_same<T, First>::value ? I : VariantIndexImpl<T, I + 1U, std::variant<Rest...>>::value;
-};
+namespace detail {
+
+/** (a * b) >> 32 with 64-bit multiplies only (exact while the result fits in 64 bits). */
+inline uint64_t MulShift32Split(uint64_t a, uint64_t b) noexcept {
+  const uint64_t a_hi = a >> 32U;
+  const uint64_t a_lo = a & 0xFFFFFFFFU;
+  const uint64_t b_hi = b >> 32U;
+  const uint64_t b_lo = b & 0xFFFFFFFFU;
+  return (a_hi * b) + (a_lo * b_hi) + ((a_lo * b_lo) >> 32U);
+}
+
+/** (a * b) >> 32; one 128-bit multiply where the target has it (not on 32-bit ARM / i386). */
+inline uint64_t MulShift32(uint64_t a, uint64_t b) noexcept {
+#if defined(__SIZEOF_INT128__)
+  return static_cast<uint64_t>((static_cast<unsigned __int128>(a) * b) >> 32U);
+#else
+  return MulShift32Split(a, b);
+#endif
+}
 
 }  // namespace detail
 
-template <typename T, typename Variant>
-struct VariantIndex;
+/**
+ * @brief Raw cycle counter (x86 TSC / ARMv8 CNTVCT_EL0) scaled to nanoseconds.
+ *
+ * Shares steady_clock's epoch. Each (counter, steady_clock) sample brackets
+ * the counter read between two steady_clock reads and is discarded when the
+ * bracket is wider than MAX_BRACKET_NS (preemption in between), so one bad
+ * sample cannot skew the scale. The first sample anchors the clock; the scale
+ * is then re-measured against the last anchor and the clock re-anchored on
+ * steady_clock after CALIBRATION_NS, with the window doubling up to
+ * RECALIBRATION_NS. Drift from steady_clock (including NTP slewing) therefore
+ * stays bounded by what accumulates over one window, which is also the largest
+ * step a re-anchor makes (microseconds for a steady counter rate).
+ *
+ * NowNs() never waits: while the scale is unknown (x86, first CALIBRATION_NS)
+ * it returns steady_clock time, and each update is a single bounded attempt by
+ * whichever caller finds it due. Calibrate() busy-waits for the first scale up
+ * front (once, at startup). On ARMv8 the initial scale comes from CNTFRQ_EL0.
+ * Assumes an invariant, synchronized counter (constant_tsc / nonstop_tsc on
+ * x86, always true for the ARMv8 generic timer). Falls back to steady_clock
+ * on other targets.
+ */
+struct TscClock {
+  static constexpr uint64_t CALIBRATION_NS = 1000000U;     /**< First scale window */
+  static constexpr uint64_t RECALIBRATION_NS = 1000000000U; /**< Longest window between re-anchors */
+  static constexpr uint64_t MAX_BRACKET_NS = 4000U;        /**< Widest accepted steady/counter/steady bracket */
+  static constexpr uint32_t SAMPLE_TRIES = 8U;             /**< Bracketed reads per update attempt */
+
+  static uint64_t NowNs() noexcept {
+    State& state = GetState();
+    const uint32_t seq = state.seq.load(std::memory_order_acquire);
+    const uint64_t base_ticks = state.base_ticks.load(std::memory_order_relaxed);
+    const uint64_t base_ns = state.base_ns.load(std::memory_order_relaxed);
+    const uint64_t mult = state.mult.load(std::memory_order_relaxed);
+    const uint64_t due_ns = state.due_ns.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (((seq & 1U) != 0U) || (state.seq.load(std::memory_order_relaxed) != seq)) {
+      return SteadyClock::NowNs();  // update in progress: never wait for it
+    }
+    const uint64_t now_ns =
+        (mult != 0U) ? (base_ns + detail::MulShift32(ReadCounter() - base_ticks, mult)) : SteadyClock::NowNs();
+    if (now_ns >= due_ns) {
+      Update(state, seq);
+    }
+    return now_ns;
+  }
 
-template <typename T, typename... Types>
-struct VariantIndex<T, std::variant<Types...>> {
-  static constexpr size_t value = detail::VariantIndexImpl<T, 0U, std::variant<Types...>>::value;
-  static_assert(value != static_cast<size_t>(-1), "Type not found in PayloadVariant");
-};
+  /** @brief Block until the counter scale is known (at most CALIBRATION_NS after the first use). */
+  static void Calibrate() noexcept {
+    while (!Calibrated()) {
+      (void)NowNs();
+      detail::CpuRelax();
+    }
+  }
 
-// ============================================================================
-// Bus Error Types
-// ============================================================================
+  /** @brief true once the counter scale is known (always on ARMv8). */
+  static bool Calibrated() noexcept { return GetState().mult.load(std::memory_order_acquire) != 0U; }
 
-enum class BusError : uint8_t { QUEUE_FULL = 0U, INVALID_MESSAGE = 1U, PROCESSING_ERROR = 2U, OVERFLOW_DETECTED = 3U };
+  /** @brief Number of scale updates attempted so far (diagnostics; at most one per NowNs() call). */
+  static uint64_t CalibrationCount() noexcept { return GetState().updates.load(std::memory_order_relaxed); }
 
-using ErrorCallback = void (*)(BusError, uint64_t);
+  /** @brief Raw counter value (ticks). */
+  static uint64_t ReadCounter() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+    return __builtin_ia32_rdtsc();
+#elif defined(__aarch64__)
+    uint64_t ticks;
+    __asm__ __volatile__("mrs %0, cntvct_el0" : "=r"(ticks));
+    return ticks;
+#else
+    return SteadyClock::NowNs();
+#endif
+  }
 
-// ============================================================================
-// Statistics
-// ============================================================================
+ private:
+  struct Sample {
+    uint64_t ticks;
+    uint64_t ns;
+  };
 
-struct MCCC_ALIGN_CACHELINE BusStatistics {
-  std::atomic<uint64_t> messages_published{0U};
-  std::atomic<uint64_t> messages_dropped{0U};
-  std::atomic<uint64_t> messages_processed{0U};
-  std::atomic<uint64_t> processing_errors{0U};
+  /** Seqlock-protected epoch (odd seq = update in progress; the writer owns it via CAS). */
+  struct State {
+    State() noexcept {
+      Sample anchor{0U, 0U};
+      const bool good = TakeSample(anchor);  // a loose anchor is only used until the next call re-anchors
+      base_ticks.store(anchor.ticks, std::memory_order_relaxed);
+      base_ns.store(anchor.ns, std::memory_order_relaxed);
+      mult.store(KnownMult(), std::memory_order_relaxed);
+      window_ns.store(good ? CALIBRATION_NS : 0U, std::memory_order_relaxed);
+      due_ns.store(good ? (anchor.ns + CALIBRATION_NS) : anchor.ns, std::memory_order_relaxed);
+    }
+    std::atomic<uint32_t> seq{0U};
+    std::atomic<uint64_t> base_ticks{0U};
+    std::atomic<uint64_t> base_ns{0U};
+    std::atomic<uint64_t> mult{0U}; /**< ns per tick, 32.32 fixed point; 0 until calibrated */
+    std::atomic<uint64_t> due_ns{0U};
+    std::atomic<uint64_t> window_ns{0U}; /**< Length of the current window, 0 = loose anchor (writer only) */
+    std::atomic<uint64_t> updates{0U};
+  };
 
-  std::atomic<uint64_t> high_priority_published{0U};
-  std::atomic<uint64_t> medium_priority_published{0U};
-  std::atomic<uint64_t> low_priority_published{0U};
+  static State& GetState() noexcept {
+    static State state;
+    return state;
+  }
 
-  std::atomic<uint64_t> high_priority_dropped{0U};
-  std::atomic<uint64_t> medium_priority_dropped{0U};
-  std::atomic<uint64_t> low_priority_dropped{0U};
+  /** Scale known without measuring (0 on x86). */
+  static uint64_t KnownMult() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+    return 0U;
+#elif defined(__aarch64__)
+    uint64_t freq;
+    __asm__ __volatile__("mrs %0, cntfrq_el0" : "=r"(freq));
+    return (static_cast<uint64_t>(1000000000U) << 32U) / ((freq != 0U) ? freq : 1U);
+#else
+    return static_cast<uint64_t>(1U) << 32U;
+#endif
+  }
 
-  std::atomic<uint64_t> admission_recheck_count{0U};
-  std::atomic<uint64_t> stale_cache_depth_delta{0U};
+  /**
+   * Counter read bracketed by two steady_clock reads, stamped with their
+   * midpoint. false when every try was wider than MAX_BRACKET_NS (out keeps
+   * the narrowest one).
+   */
+  static bool TakeSample(Sample& out) noexcept {
+    uint64_t best_width = ~uint64_t{0U};
+    for (uint32_t i = 0U; i < SAMPLE_TRIES; ++i) {
+      const uint64_t before = SteadyClock::NowNs();
+      const uint64_t ticks = ReadCounter();
+      const uint64_t after = SteadyClock::NowNs();
+      const uint64_t width = after - before;
+      if (width < best_width) {
+        best_width = width;
+        out = Sample{ticks, before + (width / 2U)};
+      }
+      if (width <= MAX_BRACKET_NS) {
+        return true;
+      }
+    }
+    return false;
+  }
 
-  void Reset() noexcept {
-    messages_published.store(0U, std::memory_order_relaxed);
-    messages_dropped.store(0U, std::memory_order_relaxed);
-    messages_processed.store(0U, std::memory_order_relaxed);
-    processing_errors.store(0U, std::memory_order_relaxed);
-    high_priority_published.store(0U, std::memory_order_relaxed);
-    medium_priority_published.store(0U, std::memory_order_relaxed);
-    low_priority_published.store(0U, std::memory_order_relaxed);
-    high_priority_dropped.store(0U, std::memory_order_relaxed);
-    medium_priority_dropped.store(0U, std::memory_order_relaxed);
-    low_priority_dropped.store(0U, std::memory_order_relaxed);
-    admission_recheck_count.store(0U, std::memory_order_relaxed);
-    stale_cache_depth_delta.store(0U, std::memory_order_relaxed);
+  /** One attempt to re-measure the scale and re-anchor; skipped if another caller is updating. */
+  static void Update(State& state, uint32_t seq) noexcept {
+    uint32_t expected = seq;
+    if (!state.seq.compare_exchange_strong(expected, seq + 1U, std::memory_order_acquire,
+                                           std::memory_order_relaxed)) {
+      return;
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+    state.updates.fetch_add(1U, std::memory_order_relaxed);
+    const uint64_t base_ticks = state.base_ticks.load(std::memory_order_relaxed);
+    const uint64_t base_ns = state.base_ns.load(std::memory_order_relaxed);
+    Sample sample{0U, 0U};
+    const bool good = TakeSample(sample);
+    const uint64_t window = state.window_ns.load(std::memory_order_relaxed);
+    if (good && (window == 0U)) {
+      // Replace a loose anchor before measuring anything against it
+      state.base_ticks.store(sample.ticks, std::memory_order_relaxed);
+      state.base_ns.store(sample.ns, std::memory_order_relaxed);
+      state.window_ns.store(CALIBRATION_NS, std::memory_order_relaxed);
+      state.due_ns.store(sample.ns + CALIBRATION_NS, std::memory_order_relaxed);
+    } else if (good && (sample.ticks > base_ticks) && (sample.ns > base_ns)) {
+      uint64_t ticks = sample.ticks - base_ticks;
+      uint64_t elapsed_ns = sample.ns - base_ns;
+      while ((elapsed_ns >> 32U) != 0U) {  // keep elapsed_ns << 32 in range for long windows
+        elapsed_ns >>= 1U;
+        ticks >>= 1U;
+      }
+      const uint64_t next_window = (window < (RECALIBRATION_NS / 2U)) ? (window * 2U) : RECALIBRATION_NS;
+      state.base_ticks.store(sample.ticks, std::memory_order_relaxed);
+      state.base_ns.store(sample.ns, std::memory_order_relaxed);
+      state.mult.store((elapsed_ns << 32U) / ((ticks != 0U) ? ticks : 1U), std::memory_order_relaxed);
+      state.window_ns.store(next_window, std::memory_order_relaxed);
+      state.due_ns.store(sample.ns + next_window, std::memory_order_relaxed);
+    } else {
+      // Preempted while sampling: keep the current epoch and retry a window later
+      state.due_ns.store(SteadyClock::NowNs() + CALIBRATION_NS, std::memory_order_relaxed);
+    }
+    state.seq.store(seq + 2U, std::memory_order_release);
   }
 };
 
-struct BusStatisticsSnapshot {
-  uint64_t messages_published;
-  uint64_t messages_dropped;
-  uint64_t messages_processed;
-  uint64_t processing_errors;
-  uint64_t high_priority_published;
-  uint64_t medium_priority_published;
-  uint64_t low_priority_published;
-  uint64_t high_priority_dropped;
-  uint64_t medium_priority_dropped;
-  uint64_t low_priority_dropped;
-  uint64_t admission_recheck_count;
-  uint64_t stale_cache_depth_delta;
+/**
+ * @brief Kernel tick-granular clock (Linux CLOCK_MONOTONIC_COARSE, ~1-4 ms).
+ *
+ * Cheapest real clock: a plain vDSO read without counter access. Same epoch as
+ * steady_clock. Falls back to steady_clock where the coarse clock is missing.
+ */
+struct CoarseClock {
+  static uint64_t NowNs() noexcept {
+#if defined(CLOCK_MONOTONIC_COARSE)
+    struct timespec ts;
+    (void)clock_gettime(CLOCK_MONOTONIC_COARSE, &ts);
+    return (static_cast<uint64_t>(ts.tv_sec) * 1000000000U) + static_cast<uint64_t>(ts.tv_nsec);
+#else
+    return SteadyClock::NowNs();
+#endif
+  }
 };
 
-enum class BackpressureLevel : uint8_t {
-  NORMAL = 0U,   /**< < 75% full */
-  WARNING = 1U,  /**< 75-90% full */
-  CRITICAL = 2U, /**< 90-100% full */
-  FULL = 3U      /**< 100% full */
+/**
+ * @brief No timestamps: every header carries 0 and no clock is read.
+ */
+struct NoClock {
+  static constexpr uint64_t NowNs() noexcept { return 0U; }
 };
 
 // ============================================================================
-// Subscription Handle
+// Message Priority & Header
 // ============================================================================
 
-struct SubscriptionHandle {
-  size_t type_index;  /**< Message type index */
-  size_t callback_id; /**< Callback ID within type */
+/**
+ * @brief Message priority levels for backpressure control.
+ */
+enum class MessagePriority : uint8_t {
+  LOW = 0U,    /** Dropped when queue >= 60% full */
+  MEDIUM = 1U, /** Dropped when queue >= 80% full */
+  HIGH = 2U    /** Dropped when queue >= 99% full (highest admission threshold) */
+};
+
+/**
+ * @brief Message header for tracing and debugging.
+ */
+struct MessageHeader {
+  uint64_t msg_id;          /** Global incremental ID */
+  uint64_t timestamp_us;    /** Microsecond timestamp */
+  uint32_t sender_id;       /** Sender identifier */
+  MessagePriority priority; /** Message priority level */
+#if MCCC_HEADER_HAS_TIMESTAMP_NS
+  uint64_t timestamp_ns{0U}; /** Nanosecond publish time from the bus Clock (always bus-stamped) */
+#endif
+
+  MessageHeader() noexcept : msg_id(0U), timestamp_us(0U), sender_id(0U), priority(MessagePriority::MEDIUM) {}
+  MessageHeader(uint64_t id, uint64_t ts, uint32_t sender, MessagePriority prio) noexcept
+      : msg_id(id), timestamp_us(ts), sender_id(sender), priority(prio) {}
 };
 
 // ============================================================================
-// AsyncBus<PayloadVariant>
+// Message Envelope (templatized on user-defined PayloadVariant)
 // ============================================================================
 
 /**
- * @brief Lock-free MPSC message bus with priority admission control.
+ * @brief Message envelope (value type, embeddable directly in ring buffer).
  *
  * @tparam PayloadVariant A std::variant<...> of user-defined message types.
+ *
+ * Example:
+ *   using MyPayload = std::variant<SensorData, MotorCommand, AlarmEvent>;
+ *   using MyEnvelope = mccc::MessageEnvelope<MyPayload>;
  */
 template <typename PayloadVariant>
-class AsyncBus {
- public:
-  using EnvelopeType = MessageEnvelope<PayloadVariant>;
+struct MessageEnvelope {
+  MessageHeader header;
+  PayloadVariant payload;
 
-  enum class PerformanceMode : uint8_t { FULL_FEATURED = 0U, BARE_METAL = 1U, NO_STATS = 2U };
+  /** @brief Default constructor for ring buffer pre-allocation */
+  MessageEnvelope() noexcept : header(), payload() {}
 
-  static constexpr uint32_t MAX_QUEUE_DEPTH = static_cast<uint32_t>(MCCC_QUEUE_DEPTH);
-  static constexpr uint32_t BATCH_PROCESS_SIZE = 1024U;
-  static constexpr uint64_t MSG_ID_WRAP_THRESHOLD = std::numeric_limits<uint64_t>::max() - 10000U;
+  explicit MessageEnvelope(const MessageHeader& hdr, PayloadVariant&& pl) noexcept
+      : header(hdr), payload(std::move(pl)) {}
 
-  static constexpr uint32_t LOW_PRIORITY_THRESHOLD = (MAX_QUEUE_DEPTH * 60U) / 100U;
-  static constexpr uint32_t MEDIUM_PRIORITY_THRESHOLD = (MAX_QUEUE_DEPTH * 80U) / 100U;
-  static constexpr uint32_t HIGH_PRIORITY_THRESHOLD = (MAX_QUEUE_DEPTH * 99U) / 100U;
+  MessageEnvelope(MessageEnvelope&&) noexcept = default;
+  MessageEnvelope& operator=(MessageEnvelope&&) noexcept = default;
+  MessageEnvelope(const MessageEnvelope&) = default;
+  MessageEnvelope& operator=(const MessageEnvelope&) = default;
+};
 
-  static constexpr uint32_t BACKPRESSURE_WARNING_THRESHOLD = (MAX_QUEUE_DEPTH * 75U) / 100U;
-  static constexpr uint32_t BACKPRESSURE_CRITICAL_THRESHOLD = (MAX_QUEUE_DEPTH * 90U) / 100U;
+// ============================================================================
+// Template Helpers
+// ============================================================================
 
-  using CallbackType = FixedFunction<void(const EnvelopeType&), 64U>;
+/**
+ * @brief Compile-time variant index calculation (C++17 recursive template).
+ */
+namespace detail {
 
-  static AsyncBus& Instance() noexcept {
-    static AsyncBus instance;
-    return instance;
-  }
+template <typename T, size_t I, typename Variant>
+struct VariantIndexImpl;
+
+template <typename T, size_t I>
+struct VariantIndexImpl<T, I, std::variant<>> {
+  static constexpr size_t value = static_cast<size_t>(-1);
+};
+
+template <typename T, size_t I, typename First, typename... Rest>
+struct VariantIndexImpl<T, I, std::variant<First, Rest...>> {
+  static constexpr size_t value =
+      std::is_same<T, First>::value ? I : VariantIndexImpl<T, I + 1U, std::variant<Rest...>>::value;
+};
+
+}  // namespace detail
+
+template <typename T, typename Variant>
+struct VariantIndex;
+
+template <typename T, typename... Types>
+struct VariantIndex<T, std::variant<Types...>> {
+  static constexpr size_t value = detail::VariantIndexImpl<T, 0U, std::variant<Types...>>::value;
+  static_assert(value != static_cast<size_t>(-1), "Type not found in PayloadVariant");
+};
+
+namespace detail {
+
+template <typename Visitor, typename Variant, size_t... I>
+inline void VisitByIndexImpl(Visitor& vis, Variant& variant, size_t index, std::index_sequence<I...> /*unused*/) {
+  (void)((index == I ? (vis(*std::get_if<I>(&variant)), true) : false) || ...);
+}
+
+/**
+ * @brief Visit a variant through a switch on index() generated at compile time.
+ *
+ * Expands to `if (index == 0) vis(alt0) else if (index == 1) vis(alt1) ...`,
+ * which compilers lower to a jump table or compare chain with every visitor
+ * call inlined, unlike the function-pointer table std::visit may produce. A
+ * valueless variant (index() == variant_npos) matches no arm and is skipped
+ * instead of throwing std::bad_variant_access.
+ */
+template <typename Visitor, typename Variant>
+inline void VisitByIndex(Visitor& vis, Variant& variant) {
+  using Alternatives = std::make_index_sequence<std::variant_size<std::remove_const_t<Variant>>::value>;
+  VisitByIndexImpl(vis, variant, variant.index(), Alternatives{});
+}
+
+}  // namespace detail
+
+/**
+ * @brief Detect a MessageKey(const T&) overload reachable by ADL (FilterKey::PAYLOAD_KEY).
+ */
+namespace detail {
+
+template <typename T, typename = void>
+struct HasMessageKey : std::false_type {};
+
+template <typename T>
+struct HasMessageKey<T, std::void_t<decltype(static_cast<uint32_t>(MessageKey(std::declval<const T&>())))>>
+    : std::true_type {};
+
+}  // namespace detail
+
+// ============================================================================
+// Latest-Value Conflation
+// ============================================================================
+
+/**
+ * @brief Opt-in latest-value conflation for message type T.
+ *
+ * Specialize with a non-zero KEYS to stop queuing T: each sender_id then owns
+ * one seqlock slot that Publish() overwrites, and the consumer delivers every
+ * updated slot once per ProcessBatch(). For state (pose, battery) where only
+ * the newest sample matters. T must be trivially copyable. Senders beyond
+ * KEYS distinct sender_ids fall back to the ring.
+ *
+ * Every publish path honours it: PublishBatch() stores conflated elements in
+ * their slots and queues only the others, and TryReserve<T>() does not
+ * compile for a conflated T (there is no ring slot to construct it in).
+ *
+ * @code
+ * template <>
+ * struct mccc::ConflationTraits<Pose> {
+ *   static constexpr uint32_t KEYS = 16U;  // up to 16 robots
+ * };
+ * @endcode
+ */
+template <typename T>
+struct ConflationTraits {
+  static constexpr uint32_t KEYS = 0U; /**< Distinct sender_ids kept; 0 = not conflated */
+};
+
+namespace detail {
+
+/**
+ * @brief Per-type table of latest-value slots (empty when T is not conflated).
+ *
+ * The sample is copied through relaxed atomic words under a seqlock, so a
+ * reader racing with a writer sees a torn copy only as a sequence mismatch.
+ * Writers of the same key serialize on the odd sequence; the consumer never
+ * waits and leaves a slot being written for the next batch.
+ */
+template <typename T, uint32_t Keys>
+class ConflationTable {
+  static_assert(std::is_trivially_copyable<T>::value, "Conflated message types must be trivially copyable");
+
+ public:
+  static constexpr bool ENABLED = true;
+
+  struct Sample {
+    MessageHeader header;
+    T value;
+  };
+
+  /** @brief Slot owned by key, claimed on first use; -1 when all Keys slots belong to other keys. */
+  int32_t Find(uint32_t key) noexcept {
+    const uint64_t tag = static_cast<uint64_t>(key) + 1U;
+    for (uint32_t i = 0U; i < Keys; ++i) {
+      Slot& slot = slots_[(key + i) % Keys];
+      uint64_t current = slot.tag.load(std::memory_order_acquire);
+      if ((current == 0U) && slot.tag.compare_exchange_strong(current, tag, std::memory_order_acq_rel,
+                                                              std::memory_order_acquire)) {
+        return static_cast<int32_t>((key + i) % Keys);
+      }
+      if (current == tag) {
+        return static_cast<int32_t>((key + i) % Keys);
+      }
+    }
+    return -1;
+  }
+
+  /**
+   * @brief Overwrite one slot with a new sample.
+   * @return true if an undelivered sample was replaced
+   */
+  bool Store(int32_t index, const MessageHeader& header, const T& value) noexcept {
+    Slot& slot = slots_[static_cast<uint32_t>(index)];
+    uint32_t seq = slot.seq.load(std::memory_order_relaxed);
+    while (((seq & 1U) != 0U) ||
+           !slot.seq.compare_exchange_weak(seq, seq + 1U, std::memory_order_acquire, std::memory_order_relaxed)) {
+      CpuRelax();
+      seq = slot.seq.load(std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+
+    const Sample sample{header, value};
+    Words words;
+    std::memcpy(words.data(), &sample, sizeof(Sample));
+    for (uint32_t w = 0U; w < WORDS; ++w) {
+      slot.words[w].store(words[w], std::memory_order_relaxed);
+    }
+    slot.seq.store(seq + 2U, std::memory_order_release);
+    pending_.store(true, std::memory_order_release);
+    return seq != slot.delivered_seq.load(std::memory_order_relaxed);
+  }
+
+  bool Pending() const noexcept { return pending_.load(std::memory_order_relaxed); }
+
+  /**
+   * @brief Hand each updated slot to sink(header, value) once (consumer only).
+   *
+   * @param budget Deliveries allowed; updated slots left over stay pending
+   * @return Number of samples delivered
+   */
+  template <typename Sink>
+  uint32_t Drain(uint32_t budget, Sink&& sink) noexcept {
+    if (!pending_.load(std::memory_order_relaxed) || !pending_.exchange(false, std::memory_order_acq_rel)) {
+      return 0U;
+    }
+    uint32_t delivered = 0U;
+    for (uint32_t k = 0U; k < Keys; ++k) {
+      Slot& slot = slots_[(cursor_ + k) % Keys];
+      const uint32_t seq = slot.seq.load(std::memory_order_acquire);
+      if ((seq & 1U) != 0U) {
+        continue;  // the writer re-marks the table when it finishes
+      }
+      if (seq == slot.delivered_seq.load(std::memory_order_relaxed)) {
+        continue;
+      }
+      if (delivered == budget) {
+        cursor_ = (cursor_ + k) % Keys;
+        pending_.store(true, std::memory_order_relaxed);
+        return delivered;
+      }
+      Words words;
+      for (uint32_t w = 0U; w < WORDS; ++w) {
+        words[w] = slot.words[w].load(std::memory_order_relaxed);
+      }
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (slot.seq.load(std::memory_order_relaxed) != seq) {
+        continue;  // overwritten while copying; re-marked too
+      }
+      slot.delivered_seq.store(seq, std::memory_order_relaxed);
+      const Sample* sample = std::launder(reinterpret_cast<const Sample*>(words.data()));
+      sink(sample->header, sample->value);
+      ++delivered;
+    }
+    return delivered;
+  }
+
+ private:
+  static constexpr uint32_t WORDS = static_cast<uint32_t>((sizeof(Sample) + 7U) / 8U);
+  struct alignas((alignof(Sample) > 8U) ? alignof(Sample) : 8U) Words : std::array<uint64_t, WORDS> {};
+
+  struct MCCC_ALIGN_CACHELINE Slot {
+    std::atomic<uint64_t> tag{0U}; /**< sender_id + 1 of the owner, 0 = free */
+    std::atomic<uint32_t> seq{0U};           /**< Odd while a writer copies the sample in */
+    std::atomic<uint32_t> delivered_seq{0U}; /**< seq last handed out; written by the consumer only */
+    std::array<std::atomic<uint64_t>, WORDS> words{};
+  };
+
+  std::array<Slot, Keys> slots_{};
+  std::atomic<bool> pending_{false};
+  uint32_t cursor_{0U}; /**< Consumer only: first slot scanned by the next Drain() */
+};
+
+template <typename T>
+class ConflationTable<T, 0U> {
+ public:
+  static constexpr bool ENABLED = false;
+};
+
+template <typename Variant>
+struct ConflationTables;
+
+template <typename... Ts>
+struct ConflationTables<std::variant<Ts...>> {
+  using Tuple = std::tuple<ConflationTable<Ts, ConflationTraits<Ts>::KEYS>...>;
+  static constexpr bool ANY = ((ConflationTraits<Ts>::KEYS > 0U) || ...);
+  static constexpr bool BY_INDEX[sizeof...(Ts)] = {(ConflationTraits<Ts>::KEYS > 0U)...};
+};
+
+}  // namespace detail
+
+// ============================================================================
+// Message Expiry
+// ============================================================================
+
+/**
+ * @brief Opt-in time-to-live for message type T.
+ *
+ * Specialize with a non-zero TTL_US to make the consumer skip a T whose
+ * header.timestamp_us is more than TTL_US microseconds old (bus Clock) when
+ * it reaches dispatch: no callback runs, the slot is released and the message
+ * is counted in messages_expired. For commands that are useless once stale,
+ * so an overloaded bus catches up instead of replaying old traffic.
+ *
+ * @code
+ * template <>
+ * struct mccc::ExpiryTraits<MotorCmd> {
+ *   static constexpr uint64_t TTL_US = 200000U;  // 200 ms
+ * };
+ * @endcode
+ */
+template <typename T>
+struct ExpiryTraits {
+  static constexpr uint64_t TTL_US = 0U; /**< Maximum age at dispatch; 0 = never expires */
+};
+
+namespace detail {
+
+template <typename Variant>
+struct ExpiryTtls;
+
+template <typename... Ts>
+struct ExpiryTtls<std::variant<Ts...>> {
+  static constexpr std::array<uint64_t, sizeof...(Ts)> TTL_US{ExpiryTraits<Ts>::TTL_US...};
+  static constexpr bool ANY = ((ExpiryTraits<Ts>::TTL_US > 0U) || ...);
+};
+
+/** @brief True if a message stamped at timestamp_us is older than ttl_us at now_us (ttl_us 0 = never). */
+constexpr bool IsExpired(uint64_t timestamp_us, uint64_t ttl_us, uint64_t now_us) noexcept {
+  return (ttl_us > 0U) && (now_us > timestamp_us) && ((now_us - timestamp_us) > ttl_us);
+}
+
+}  // namespace detail
+
+namespace detail {
+
+/** @brief FNV-1a step over the 8 bytes of word (little end first), usable in constant expressions. */
+constexpr uint64_t Fnv1aWord(uint64_t hash, uint64_t word) noexcept {
+  for (uint32_t i = 0U; i < 8U; ++i) {
+    hash = (hash ^ (word & 0xFFU)) * 1099511628211ULL;
+    word >>= 8U;
+  }
+  return hash;
+}
+
+template <typename Variant>
+struct PayloadLayout;
+
+template <typename... Ts>
+struct PayloadLayout<std::variant<Ts...>> {
+  static constexpr uint64_t Hash() noexcept {
+    uint64_t hash = Fnv1aWord(14695981039346656037ULL, sizeof...(Ts));
+    uint64_t index = 0U;
+    ((hash = Fnv1aWord(Fnv1aWord(Fnv1aWord(hash, index++), sizeof(Ts)), alignof(Ts))), ...);
+    return hash;
+  }
+};
+
+/**
+ * @brief Compile-time hash of a PayloadVariant's layout, for wire/segment
+ * checks between separately built binaries (ShmBus, UdpBridge, BusRecorder).
+ *
+ * Covers the alternative count and, per index, sizeof and alignof. Unlike a
+ * type-name signature it does not depend on the compiler or its version, so
+ * matched peers always agree; alternatives that differ only in field meaning
+ * (same size and alignment at the same index) are not told apart.
+ */
+template <typename Variant>
+constexpr uint64_t PayloadLayoutHash() noexcept {
+  return PayloadLayout<Variant>::Hash();
+}
+
+template <typename Variant, size_t I>
+bool DecodeTrivialAs(const uint8_t* bytes, size_t size, Variant& out) noexcept {
+  using T = std::variant_alternative_t<I, Variant>;
+  if constexpr (std::is_trivially_copyable<T>::value) {
+    if (size != sizeof(T)) {
+      return false;
+    }
+    T& value = out.template emplace<I>();
+    (void)std::memcpy(&value, bytes, sizeof(T));
+    return true;
+  } else {
+    return false;  // never serialized
+  }
+}
+
+template <typename Variant, size_t... I>
+bool DecodeTrivialByIndex(size_t type_index, const uint8_t* bytes, size_t size, Variant& out,
+                          std::index_sequence<I...> /*unused*/) noexcept {
+  return ((type_index == I ? DecodeTrivialAs<Variant, I>(bytes, size, out) : false) || ...);
+}
+
+/**
+ * @brief Rebuild alternative type_index of Variant from its raw bytes.
+ *
+ * Inverse of the memcpy serialization used by UdpBridge datagrams and
+ * BusRecorder segments. Fails for an unknown index, a size that does not
+ * match sizeof(T), or a non-trivially-copyable T.
+ */
+template <typename Variant>
+bool DecodeTrivialPayload(size_t type_index, const uint8_t* bytes, size_t size, Variant& out) noexcept {
+  return DecodeTrivialByIndex(type_index, bytes, size, out,
+                              std::make_index_sequence<std::variant_size<Variant>::value>{});
+}
+
+}  // namespace detail
+
+// ============================================================================
+// Bus Error Types
+// ============================================================================
+
+enum class BusError : uint8_t { QUEUE_FULL = 0U, INVALID_MESSAGE = 1U, PROCESSING_ERROR = 2U, OVERFLOW_DETECTED = 3U };
+
+using ErrorCallback = void (*)(BusError, uint64_t);
+
+/**
+ * @brief Admission policy for PublishBatch() when the whole run does not fit.
+ */
+enum class BatchAdmission : uint8_t {
+  PARTIAL = 0U,       /**< Enqueue the longest prefix that fits, drop the rest */
+  ALL_OR_NOTHING = 1U /**< Enqueue the whole run or nothing */
+};
+
+// ============================================================================
+// Statistics
+// ============================================================================
+
+struct MCCC_ALIGN_CACHELINE BusStatistics {
+  std::atomic<uint64_t> messages_published{0U};
+  std::atomic<uint64_t> messages_dropped{0U};
+  std::atomic<uint64_t> messages_processed{0U};
+  std::atomic<uint64_t> processing_errors{0U};
+
+  std::atomic<uint64_t> high_priority_published{0U};
+  std::atomic<uint64_t> medium_priority_published{0U};
+  std::atomic<uint64_t> low_priority_published{0U};
+
+  std::atomic<uint64_t> high_priority_dropped{0U};
+  std::atomic<uint64_t> medium_priority_dropped{0U};
+  std::atomic<uint64_t> low_priority_dropped{0U};
+
+  std::atomic<uint64_t> admission_recheck_count{0U};
+  std::atomic<uint64_t> stale_cache_depth_delta{0U};
+
+  std::atomic<uint64_t> messages_conflated{0U};
+  std::atomic<uint64_t> messages_expired{0U};
+
+  void Reset() noexcept {
+    messages_published.store(0U, std::memory_order_relaxed);
+    messages_dropped.store(0U, std::memory_order_relaxed);
+    messages_processed.store(0U, std::memory_order_relaxed);
+    processing_errors.store(0U, std::memory_order_relaxed);
+    high_priority_published.store(0U, std::memory_order_relaxed);
+    medium_priority_published.store(0U, std::memory_order_relaxed);
+    low_priority_published.store(0U, std::memory_order_relaxed);
+    high_priority_dropped.store(0U, std::memory_order_relaxed);
+    medium_priority_dropped.store(0U, std::memory_order_relaxed);
+    low_priority_dropped.store(0U, std::memory_order_relaxed);
+    admission_recheck_count.store(0U, std::memory_order_relaxed);
+    stale_cache_depth_delta.store(0U, std::memory_order_relaxed);
+    messages_conflated.store(0U, std::memory_order_relaxed);
+    messages_expired.store(0U, std::memory_order_relaxed);
+  }
+};
+
+struct BusStatisticsSnapshot {
+  uint64_t messages_published;
+  uint64_t messages_dropped;
+  uint64_t messages_processed;
+  uint64_t processing_errors;
+  uint64_t high_priority_published;
+  uint64_t medium_priority_published;
+  uint64_t low_priority_published;
+  uint64_t high_priority_dropped;
+  uint64_t medium_priority_dropped;
+  uint64_t low_priority_dropped;
+  uint64_t admission_recheck_count;
+  uint64_t stale_cache_depth_delta;
+  uint64_t messages_conflated; /**< Latest-value samples overwritten before delivery */
+  uint64_t messages_expired;   /**< Messages older than their ExpiryTraits TTL, skipped or shed */
+};
+
+/**
+ * @brief Add the counters of one snapshot to another (aggregates over several rings).
+ */
+inline void AccumulateStatistics(BusStatisticsSnapshot& total, const BusStatisticsSnapshot& s) noexcept {
+  total.messages_published += s.messages_published;
+  total.messages_dropped += s.messages_dropped;
+  total.messages_processed += s.messages_processed;
+  total.processing_errors += s.processing_errors;
+  total.high_priority_published += s.high_priority_published;
+  total.medium_priority_published += s.medium_priority_published;
+  total.low_priority_published += s.low_priority_published;
+  total.high_priority_dropped += s.high_priority_dropped;
+  total.medium_priority_dropped += s.medium_priority_dropped;
+  total.low_priority_dropped += s.low_priority_dropped;
+  total.admission_recheck_count += s.admission_recheck_count;
+  total.stale_cache_depth_delta += s.stale_cache_depth_delta;
+  total.messages_conflated += s.messages_conflated;
+  total.messages_expired += s.messages_expired;
+}
+
+// ============================================================================
+// Latency Histogram
+// ============================================================================
+
+/**
+ * @brief Percentile summary of a latency histogram (nanoseconds).
+ */
+struct LatencySnapshot {
+  uint64_t count;   /**< Recorded samples */
+  uint64_t p50_ns;  /**< Median */
+  uint64_t p99_ns;  /**< 99th percentile */
+  uint64_t p999_ns; /**< 99.9th percentile */
+  uint64_t max_ns;  /**< Exact maximum */
+};
+
+/**
+ * @brief Lock-free log-linear (HDR-style) histogram of nanosecond values.
+ *
+ * Values below SUB_BUCKETS are exact. Above that, every power of two is split
+ * into SUB_BUCKETS linear buckets, so a reported percentile overestimates the
+ * true value by at most 1/SUB_BUCKETS (6.25%). Values >= 2^MAX_VALUE_BITS ns
+ * (~18 min) land in the last bucket; max_ns stays exact.
+ *
+ * Single writer: Record() is one relaxed load + store per sample (no atomic
+ * read-modify-write). Snapshots may be taken concurrently from any thread and
+ * are approximate while samples are being recorded, like BusStatistics.
+ */
+class LatencyHistogram {
+ public:
+  static constexpr uint32_t SUB_BUCKET_BITS = 4U;
+  static constexpr uint32_t SUB_BUCKETS = 1U << SUB_BUCKET_BITS;
+  static constexpr uint32_t MAX_VALUE_BITS = 40U;
+  static constexpr uint32_t BUCKET_COUNT = SUB_BUCKETS + ((MAX_VALUE_BITS - SUB_BUCKET_BITS) * SUB_BUCKETS);
+
+  /** @brief Plain bucket counts, used to merge several histograms before summarizing. */
+  struct Counts {
+    std::array<uint64_t, BUCKET_COUNT> buckets{};
+    uint64_t max_ns{0U};
+  };
+
+  static constexpr uint32_t BucketIndex(uint64_t value) noexcept {
+    if (value < SUB_BUCKETS) {
+      return static_cast<uint32_t>(value);
+    }
+    if (value >= (static_cast<uint64_t>(1U) << MAX_VALUE_BITS)) {
+      return BUCKET_COUNT - 1U;
+    }
+    const uint32_t msb = 63U - static_cast<uint32_t>(__builtin_clzll(value));
+    const uint32_t shift = msb - SUB_BUCKET_BITS;
+    const uint32_t mantissa = static_cast<uint32_t>(value >> shift);  // in [SUB_BUCKETS, 2 * SUB_BUCKETS)
+    return SUB_BUCKETS + (shift * SUB_BUCKETS) + (mantissa - SUB_BUCKETS);
+  }
+
+  /** @brief Largest value that maps to the bucket (reported for percentiles). */
+  static constexpr uint64_t BucketUpperBound(uint32_t index) noexcept {
+    if (index < SUB_BUCKETS) {
+      return index;
+    }
+    const uint32_t shift = (index - SUB_BUCKETS) / SUB_BUCKETS;
+    const uint64_t mantissa = SUB_BUCKETS + ((index - SUB_BUCKETS) % SUB_BUCKETS);
+    return ((mantissa + 1U) << shift) - 1U;
+  }
+
+  void Record(uint64_t value_ns) noexcept {
+    std::atomic<uint64_t>& bucket = buckets_[BucketIndex(value_ns)];
+    bucket.store(bucket.load(std::memory_order_relaxed) + 1U, std::memory_order_relaxed);
+    if (value_ns > max_ns_.load(std::memory_order_relaxed)) {
+      max_ns_.store(value_ns, std::memory_order_relaxed);
+    }
+  }
+
+  void AddTo(Counts& counts) const noexcept {
+    for (uint32_t i = 0U; i < BUCKET_COUNT; ++i) {
+      counts.buckets[i] += buckets_[i].load(std::memory_order_relaxed);
+    }
+    const uint64_t max_ns = max_ns_.load(std::memory_order_relaxed);
+    if (max_ns > counts.max_ns) {
+      counts.max_ns = max_ns;
+    }
+  }
+
+  LatencySnapshot Snapshot() const noexcept {
+    Counts counts;
+    AddTo(counts);
+    return Summarize(counts);
+  }
+
+  /** @brief Not synchronized with Record(); call while the writer is quiescent for an exact reset. */
+  void Reset() noexcept {
+    for (auto& bucket : buckets_) {
+      bucket.store(0U, std::memory_order_relaxed);
+    }
+    max_ns_.store(0U, std::memory_order_relaxed);
+  }
+
+  static LatencySnapshot Summarize(const Counts& counts) noexcept {
+    LatencySnapshot result{0U, 0U, 0U, 0U, counts.max_ns};
+    for (uint64_t c : counts.buckets) {
+      result.count += c;
+    }
+    if (result.count == 0U) {
+      return result;
+    }
+    result.p50_ns = ValueAtPermille(counts, result.count, 500U);
+    result.p99_ns = ValueAtPermille(counts, result.count, 990U);
+    result.p999_ns = ValueAtPermille(counts, result.count, 999U);
+    return result;
+  }
+
+ private:
+  static uint64_t ValueAtPermille(const Counts& counts, uint64_t total, uint64_t permille) noexcept {
+    uint64_t rank = ((total * permille) + 999U) / 1000U;
+    if (rank == 0U) {
+      rank = 1U;
+    }
+    uint64_t seen = 0U;
+    for (uint32_t i = 0U; i < BUCKET_COUNT; ++i) {
+      seen += counts.buckets[i];
+      if (seen >= rank) {
+        const uint64_t upper = BucketUpperBound(i);
+        return (upper < counts.max_ns) ? upper : counts.max_ns;
+      }
+    }
+    return counts.max_ns;
+  }
+
+  std::array<std::atomic<uint64_t>, BUCKET_COUNT> buckets_{};
+  std::atomic<uint64_t> max_ns_{0U};
+};
+
+/**
+ * @brief Publish-to-dispatch latency of one bus (MCCC_ENABLE_LATENCY_HISTOGRAM).
+ */
+struct LatencyStatisticsSnapshot {
+  LatencySnapshot overall;                                     /**< All messages */
+  std::array<LatencySnapshot, MCCC_MAX_MESSAGE_TYPES> per_type; /**< Indexed by variant index */
+  std::array<LatencySnapshot, 3U> per_priority;                /**< Indexed by MessagePriority */
+};
+
+enum class BackpressureLevel : uint8_t {
+  NORMAL = 0U,   /**< < 75% full */
+  WARNING = 1U,  /**< 75-90% full */
+  CRITICAL = 2U, /**< 90-100% full */
+  FULL = 3U      /**< 100% full */
+};
+
+// ============================================================================
+// Adaptive Admission
+// ============================================================================
+
+/**
+ * @brief Settings of the CoDel-style admission controller (AsyncBus::EnableAdaptiveAdmission()).
+ *
+ * The consumer samples the head-of-queue sojourn time once per batch. If the
+ * smallest sample of an interval still exceeds target_delay_us the queue is
+ * standing: the LOW / MEDIUM limits shrink to what the measured drain rate
+ * clears in one / two target delays. Below half the target they double back
+ * towards the static thresholds, which stay the upper bounds; in between they
+ * hold. HIGH is never adapted.
+ */
+struct AdaptiveAdmissionConfig {
+  uint32_t target_delay_us{5000U}; /**< Queueing delay to hold */
+  uint32_t interval_us{100000U};   /**< How long a standing queue must persist before limits shrink */
+  uint32_t min_depth{32U};         /**< Floor of the adapted LOW / MEDIUM limits */
+};
+
+struct AdmissionSnapshot {
+  uint32_t low_limit;          /**< Depth at which LOW messages are dropped */
+  uint32_t medium_limit;       /**< Depth at which MEDIUM messages are dropped */
+  uint32_t high_limit;         /**< Always HIGH_PRIORITY_THRESHOLD */
+  uint64_t min_sojourn_us;     /**< Smallest head-of-queue sojourn of the last interval */
+  uint64_t drain_rate_per_sec; /**< Messages the consumer retired per second over the last interval */
+};
+
+// ============================================================================
+// Subscription Handle
+// ============================================================================
+
+struct SubscriptionHandle {
+  size_t type_index;  /**< Message type index */
+  size_t callback_id; /**< Callback ID within type */
+};
+
+// ============================================================================
+// Subscription Filter
+// ============================================================================
+
+/** @brief Key a SubscriptionFilter is evaluated on. */
+enum class FilterKey : uint8_t {
+  NONE = 0U,        /**< No filter: every message of the type */
+  SENDER_ID = 1U,   /**< MessageHeader::sender_id */
+  PAYLOAD_KEY = 2U  /**< MessageKey(const T&), found by ADL in T's namespace */
+};
+
+/**
+ * @brief Subscribe-time filter evaluated by the consumer before a callback runs.
+ *
+ * A key matches when (key & mask) == value and min <= key <= max. The bus
+ * indexes filters by key bucket, so dispatch only visits callbacks whose
+ * filter can match the message.
+ */
+struct SubscriptionFilter {
+  FilterKey key{FilterKey::NONE};
+  uint32_t mask{0U};
+  uint32_t value{0U};
+  uint32_t min{0U};
+  uint32_t max{UINT32_MAX};
+
+  constexpr bool Matches(uint32_t k) const noexcept { return ((k & mask) == value) && (k >= min) && (k <= max); }
+
+  static constexpr SubscriptionFilter Sender(uint32_t sender_id) noexcept {
+    return SubscriptionFilter{FilterKey::SENDER_ID, UINT32_MAX, sender_id, 0U, UINT32_MAX};
+  }
+  static constexpr SubscriptionFilter SenderMask(uint32_t mask, uint32_t value) noexcept {
+    return SubscriptionFilter{FilterKey::SENDER_ID, mask, value & mask, 0U, UINT32_MAX};
+  }
+  static constexpr SubscriptionFilter SenderRange(uint32_t lo, uint32_t hi) noexcept {
+    return SubscriptionFilter{FilterKey::SENDER_ID, 0U, 0U, lo, hi};
+  }
+  static constexpr SubscriptionFilter Key(uint32_t key) noexcept {
+    return SubscriptionFilter{FilterKey::PAYLOAD_KEY, UINT32_MAX, key, 0U, UINT32_MAX};
+  }
+  static constexpr SubscriptionFilter KeyMask(uint32_t mask, uint32_t value) noexcept {
+    return SubscriptionFilter{FilterKey::PAYLOAD_KEY, mask, value & mask, 0U, UINT32_MAX};
+  }
+  static constexpr SubscriptionFilter KeyRange(uint32_t lo, uint32_t hi) noexcept {
+    return SubscriptionFilter{FilterKey::PAYLOAD_KEY, 0U, 0U, lo, hi};
+  }
+};
+
+// ============================================================================
+// AsyncBus<PayloadVariant, Depth, Clock, SingleProducer>
+// ============================================================================
+
+namespace detail {
+/** @brief Percentage of queue depth, computed in 64 bits to avoid overflow. */
+constexpr uint32_t DepthPercent(uint32_t depth, uint32_t percent) noexcept {
+  return static_cast<uint32_t>((static_cast<uint64_t>(depth) * percent) / 100U);
+}
+
+/** @brief Header timestamps derived from one clock read. */
+struct HeaderStamp {
+  uint64_t us; /**< MessageHeader::timestamp_us */
+  uint64_t ns; /**< MessageHeader::timestamp_ns (0 when the header has no such field) */
+};
+}  // namespace detail
+
+/**
+ * @brief Lock-free MPSC message bus with priority admission control.
+ *
+ * Instance() returns a process-wide bus per template instantiation.
+ * Buses can also be constructed directly and owned by a pipeline stage, e.g.
+ * a small control-traffic bus next to a large data bus. The ring buffer is
+ * embedded in the object, so large instances belong in static storage or on
+ * the heap (std::make_unique), not on the stack.
+ *
+ * @tparam PayloadVariant A std::variant<...> of user-defined message types.
+ * @tparam Depth          Ring buffer slots, must be a power of 2 (default MCCC_QUEUE_DEPTH).
+ * @tparam Clock          Header timestamp source: SteadyClock, TscClock, CoarseClock, NoClock
+ *                        or any type with `static uint64_t NowNs() noexcept`.
+ * @tparam SingleProducer Wait-free SPSC claim without CAS (default MCCC_SINGLE_PRODUCER). Only
+ *                        one thread may publish to such an instance; see LaneBus for many producers.
+ */
+template <typename PayloadVariant, uint32_t Depth = static_cast<uint32_t>(MCCC_QUEUE_DEPTH),
+          typename Clock = SteadyClock, bool SingleProducer = (MCCC_SINGLE_PRODUCER != 0)>
+class AsyncBus {
+ public:
+  using EnvelopeType = MessageEnvelope<PayloadVariant>;
+
+  enum class PerformanceMode : uint8_t { FULL_FEATURED = 0U, BARE_METAL = 1U, NO_STATS = 2U };
+
+  static constexpr uint32_t MAX_QUEUE_DEPTH = Depth;
+  static constexpr bool SINGLE_PRODUCER = SingleProducer;
+  static constexpr uint32_t BATCH_PROCESS_SIZE = 1024U;
+  static constexpr uint32_t WAIT_SPIN_COUNT = 256U;
+  static constexpr uint32_t WAIT_YIELD_COUNT = 16U;
+  static constexpr uint64_t MSG_ID_WRAP_THRESHOLD = std::numeric_limits<uint64_t>::max() - 10000U;
+
+  static constexpr uint32_t LOW_PRIORITY_THRESHOLD = detail::DepthPercent(MAX_QUEUE_DEPTH, 60U);
+  static constexpr uint32_t MEDIUM_PRIORITY_THRESHOLD = detail::DepthPercent(MAX_QUEUE_DEPTH, 80U);
+  static constexpr uint32_t HIGH_PRIORITY_THRESHOLD = detail::DepthPercent(MAX_QUEUE_DEPTH, 99U);
+
+  static constexpr uint32_t BACKPRESSURE_WARNING_THRESHOLD = detail::DepthPercent(MAX_QUEUE_DEPTH, 75U);
+  static constexpr uint32_t BACKPRESSURE_CRITICAL_THRESHOLD = detail::DepthPercent(MAX_QUEUE_DEPTH, 90U);
+
+  using CallbackType = FixedFunction<void(const EnvelopeType&), 64U>;
+
+  /**
+   * @brief Run of consecutive same-type messages handed to a SubscribeBatch() callback.
+   *
+   * Elements point into the ring and are valid only during the callback.
+   */
+  struct EnvelopeSpan {
+    const EnvelopeType* const* data; /**< Envelope pointers in publish order */
+    uint32_t size;                   /**< Number of messages in the run */
+
+    const EnvelopeType& operator[](uint32_t i) const noexcept { return *data[i]; }
+    const EnvelopeType* const* begin() const noexcept { return data; }
+    const EnvelopeType* const* end() const noexcept { return data + size; }
+  };
+
+  using BatchCallbackType = FixedFunction<void(EnvelopeSpan), 64U>;
+
+  AsyncBus() noexcept : producer_pos_(0U), cached_consumer_pos_(0U), consumer_pos_(0U), next_msg_id_(1U), stats_() {
+    for (uint32_t i = 0U; i < BUFFER_SIZE; ++i) {
+      NodeAt(i).sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  ~AsyncBus() = default;
+  AsyncBus(const AsyncBus&) = delete;             // NOLINT(modernize-use-equals-delete)
+  AsyncBus& operator=(const AsyncBus&) = delete;  // NOLINT(modernize-use-equals-delete)
+  AsyncBus(AsyncBus&&) = delete;                  // NOLINT(modernize-use-equals-delete)
+  AsyncBus& operator=(AsyncBus&&) = delete;       // NOLINT(modernize-use-equals-delete)
+
+  /**
+   * @brief Process-wide convenience instance for this <PayloadVariant, Depth>.
+   */
+  static AsyncBus& Instance() noexcept {
+    static AsyncBus instance;
+    return instance;
+  }
 
   void SetErrorCallback(ErrorCallback callback) noexcept { error_callback_.store(callback, std::memory_order_release); }
 
@@ -814,258 +1744,1264 @@ class AsyncBus {
                                  stats_.medium_priority_dropped.load(std::memory_order_relaxed),
                                  stats_.low_priority_dropped.load(std::memory_order_relaxed),
                                  stats_.admission_recheck_count.load(std::memory_order_relaxed),
-                                 stats_.stale_cache_depth_delta.load(std::memory_order_relaxed)};
+                                 stats_.stale_cache_depth_delta.load(std::memory_order_relaxed),
+                                 stats_.messages_conflated.load(std::memory_order_relaxed),
+                                 stats_.messages_expired.load(std::memory_order_relaxed)};
   }
 
-  void ResetStatistics() noexcept { stats_.Reset(); }
+  void ResetStatistics() noexcept {
+    stats_.Reset();
+#if MCCC_ENABLE_LATENCY_HISTOGRAM
+    for (auto& per_type : latency_) {
+      for (auto& histogram : per_type) {
+        histogram.Reset();
+      }
+    }
+#endif
+  }
+
+#if MCCC_ENABLE_LATENCY_HISTOGRAM
+  /**
+   * @brief Publish-to-dispatch latency percentiles, per message type and per priority.
+   *
+   * Latency is measured with the bus Clock, from the bus-stamped
+   * MessageHeader::timestamp_ns to the moment the consumer starts dispatching
+   * the message (callbacks or visitor), independent of PerformanceMode and of
+   * the user timestamp_us. Needs a fine clock (SteadyClock or TscClock);
+   * NoClock records zeros. Cancelled slots are not recorded. Reset together
+   * with ResetStatistics().
+   */
+  LatencyStatisticsSnapshot GetLatencyStatistics() const noexcept {
+    LatencyStatisticsSnapshot result{};
+    LatencyHistogram::Counts overall;
+    std::array<LatencyHistogram::Counts, 3U> per_priority;
+    for (uint32_t t = 0U; t < MCCC_MAX_MESSAGE_TYPES; ++t) {
+      LatencyHistogram::Counts per_type;
+      for (uint32_t p = 0U; p < 3U; ++p) {
+        latency_[t][p].AddTo(per_type);
+        latency_[t][p].AddTo(per_priority[p]);
+      }
+      for (uint32_t i = 0U; i < LatencyHistogram::BUCKET_COUNT; ++i) {
+        overall.buckets[i] += per_type.buckets[i];
+      }
+      overall.max_ns = (per_type.max_ns > overall.max_ns) ? per_type.max_ns : overall.max_ns;
+      result.per_type[t] = LatencyHistogram::Summarize(per_type);
+    }
+    for (uint32_t p = 0U; p < 3U; ++p) {
+      result.per_priority[p] = LatencyHistogram::Summarize(per_priority[p]);
+    }
+    result.overall = LatencyHistogram::Summarize(overall);
+    return result;
+  }
+#endif
 
   void SetPerformanceMode(PerformanceMode mode) noexcept { performance_mode_.store(mode, std::memory_order_relaxed); }
 
+  /**
+   * @brief Let the consumer lower the LOW / MEDIUM drop thresholds to hold a target queueing delay.
+   *
+   * Trades LOW / MEDIUM drops for end-to-end latency under sustained overload
+   * (see AdaptiveAdmissionConfig). Sojourn is measured from
+   * MessageHeader::timestamp_us with the bus Clock, so PublishFast() stamps
+   * must come from the same clock; NoClock never tightens. Drops are counted
+   * as usual. Call before the consumer starts or from the consumer thread.
+   */
+  void EnableAdaptiveAdmission(const AdaptiveAdmissionConfig& config = AdaptiveAdmissionConfig{}) noexcept {
+    admission_ = AdmissionState{};
+    admission_.config = config;
+    admission_.config.interval_us = (config.interval_us > 0U) ? config.interval_us : 1U;
+    admission_.config.min_depth = (config.min_depth < LOW_PRIORITY_THRESHOLD) ? config.min_depth
+                                                                               : LOW_PRIORITY_THRESHOLD;
+    admission_.enabled = true;
+  }
+
+  /** @brief Back to the static thresholds. Same threading rule as EnableAdaptiveAdmission(). */
+  void DisableAdaptiveAdmission() noexcept {
+    admission_.enabled = false;
+    StoreAdmissionLimits(LOW_PRIORITY_THRESHOLD, MEDIUM_PRIORITY_THRESHOLD, 0U, 0U);
+  }
+
+  AdmissionSnapshot GetAdmissionSnapshot() const noexcept {
+    return AdmissionSnapshot{low_limit_.load(std::memory_order_relaxed),
+                             medium_limit_.load(std::memory_order_relaxed), HIGH_PRIORITY_THRESHOLD,
+                             admission_sojourn_us_.load(std::memory_order_relaxed),
+                             admission_drain_rate_.load(std::memory_order_relaxed)};
+  }
+
   // ======================== Publish API ========================
 
   bool Publish(PayloadVariant&& payload, uint32_t sender_id) noexcept {
-    return PublishInternal(std::move(payload), sender_id, GetTimestampUs(), MessagePriority::MEDIUM);
+    return PublishInternal(std::move(payload), sender_id, StampNow(), MessagePriority::MEDIUM);
   }
 
   bool PublishWithPriority(PayloadVariant&& payload, uint32_t sender_id, MessagePriority priority) noexcept {
-    return PublishInternal(std::move(payload), sender_id, GetTimestampUs(), priority);
+    return PublishInternal(std::move(payload), sender_id, StampNow(), priority);
+  }
+
+  bool PublishFast(PayloadVariant&& payload, uint32_t sender_id, uint64_t timestamp_us) noexcept {
+    return PublishInternal(std::move(payload), sender_id, StampWithUs(timestamp_us), MessagePriority::MEDIUM);
   }
 
-  bool PublishFast(PayloadVariant&& payload, uint32_t sender_id, uint64_t timestamp_us) noexcept {
-    return PublishInternal(std::move(payload), sender_id, timestamp_us, MessagePriority::MEDIUM);
+  /**
+   * @brief Publish a run of messages with one slot reservation.
+   *
+   * Reserves a contiguous run of ring slots with a single CAS (plain store in
+   * SPSC mode), assigns a block of message IDs with one fetch_add and updates
+   * statistics once per batch. Admission is checked for the whole run against
+   * the priority threshold; the admission policy selects between enqueueing
+   * the longest prefix that fits and rejecting the whole run.
+   *
+   * Elements are moved from. All messages share sender_id, priority and one
+   * timestamp, and are dispatched in iteration order. Elements of a
+   * ConflationTraits type overwrite their latest-value slot instead of
+   * taking ring slots (and, like Publish(), are delivered ahead of the ring).
+   *
+   * @tparam ForwardIt Iterator over PayloadVariant (or any alternative type)
+   * @return Number of messages enqueued (prefix of [first, last))
+   */
+  template <typename ForwardIt>
+  uint32_t PublishBatch(ForwardIt first, ForwardIt last, uint32_t sender_id,
+                        MessagePriority priority = MessagePriority::MEDIUM,
+                        BatchAdmission admission = BatchAdmission::PARTIAL) noexcept {
+    const auto count = static_cast<uint32_t>(std::distance(first, last));
+    return PublishBatchInternal(first, count, sender_id, StampNow(), priority, admission);
+  }
+
+  /**
+   * @brief Batched publish with an externally provided timestamp.
+   */
+  template <typename ForwardIt>
+  uint32_t PublishBatchFast(ForwardIt first, ForwardIt last, uint32_t sender_id, uint64_t timestamp_us,
+                            MessagePriority priority = MessagePriority::MEDIUM,
+                            BatchAdmission admission = BatchAdmission::PARTIAL) noexcept {
+    const auto count = static_cast<uint32_t>(std::distance(first, last));
+    return PublishBatchInternal(first, count, sender_id, StampWithUs(timestamp_us), priority, admission);
+  }
+
+  // ======================== In-Place Publish API ========================
+
+  /**
+   * @brief Reserved ring slot holding a T constructed in place.
+   *
+   * Obtained from TryReserve<T>(). The producer fills the payload through the
+   * dereference operators and then calls Commit(), which stamps the header and
+   * releases the slot to the consumer. A slot destroyed without Commit() is
+   * cancelled: the consumer skips it without dispatching.
+   *
+   * The consumer cannot pass an uncommitted slot, so commit promptly.
+   * Move-only; not thread-safe.
+   */
+  template <typename T>
+  class PublishSlot {
+   public:
+    PublishSlot() noexcept = default;
+
+    PublishSlot(PublishSlot&& other) noexcept
+        : bus_(other.bus_),
+          envelope_(other.envelope_),
+          sequence_(other.sequence_),
+          value_(other.value_),
+          pos_(other.pos_),
+          priority_(other.priority_) {
+      other.bus_ = nullptr;
+    }
+
+    PublishSlot& operator=(PublishSlot&& other) noexcept {
+      if (this != &other) {
+        Cancel();
+        bus_ = other.bus_;
+        envelope_ = other.envelope_;
+        sequence_ = other.sequence_;
+        value_ = other.value_;
+        pos_ = other.pos_;
+        priority_ = other.priority_;
+        other.bus_ = nullptr;
+      }
+      return *this;
+    }
+
+    PublishSlot(const PublishSlot&) = delete;             // NOLINT(modernize-use-equals-delete)
+    PublishSlot& operator=(const PublishSlot&) = delete;  // NOLINT(modernize-use-equals-delete)
+
+    ~PublishSlot() { Cancel(); }
+
+    /** @brief true while the slot is reserved (not yet committed or cancelled). */
+    explicit operator bool() const noexcept { return bus_ != nullptr; }
+
+    T& operator*() const noexcept { return *value_; }
+    T* operator->() const noexcept { return value_; }
+
+    /**
+     * @brief Stamp the header and hand the message to the consumer.
+     * @return false if the slot was not reserved
+     */
+    bool Commit(uint32_t sender_id) noexcept { return CommitStamped(sender_id, StampNow()); }
+
+    /** @brief Commit with an externally provided timestamp. */
+    bool CommitFast(uint32_t sender_id, uint64_t timestamp_us) noexcept {
+      return CommitStamped(sender_id, StampWithUs(timestamp_us));
+    }
+
+    /** @brief Release the slot without publishing (the consumer skips it). */
+    void Cancel() noexcept {
+      if (bus_ != nullptr) {
+        bus_->CancelSlot(*envelope_, *sequence_, pos_);
+        bus_ = nullptr;
+      }
+    }
+
+   private:
+    friend class AsyncBus;
+
+    PublishSlot(AsyncBus* bus, EnvelopeType* envelope, std::atomic<uint32_t>* sequence, T* value, uint32_t pos,
+                MessagePriority priority) noexcept
+        : bus_(bus), envelope_(envelope), sequence_(sequence), value_(value), pos_(pos), priority_(priority) {}
+
+    bool CommitStamped(uint32_t sender_id, detail::HeaderStamp stamp) noexcept {
+      if (bus_ == nullptr) {
+        return false;
+      }
+      bus_->CommitSlot(*envelope_, *sequence_, pos_, sender_id, stamp, priority_);
+      bus_ = nullptr;
+      return true;
+    }
+
+    AsyncBus* bus_{nullptr};
+    EnvelopeType* envelope_{nullptr};
+    std::atomic<uint32_t>* sequence_{nullptr};
+    T* value_{nullptr};
+    uint32_t pos_{0U};
+    MessagePriority priority_{MessagePriority::MEDIUM};
+  };
+
+  /**
+   * @brief Reserve a ring slot and construct a T directly inside it.
+   *
+   * Avoids building the variant on the producer stack and moving it into the
+   * ring, which for large trivially-copyable payloads is a full extra copy.
+   * Admission control is applied here, with the given priority.
+   *
+   * If the slot already holds a trivially-copyable T, it is reused as is and
+   * its previous contents remain: the producer must write every field it
+   * relies on. Otherwise T is value-initialised. T must not be a
+   * ConflationTraits type (static_assert).
+   *
+   * @return Reserved slot; empty (operator bool false) if the message was rejected
+   */
+  template <typename T>
+  PublishSlot<T> TryReserve(MessagePriority priority = MessagePriority::MEDIUM) noexcept {
+    static_assert(VariantIndex<T, PayloadVariant>::value < std::variant_size<PayloadVariant>::value,
+                  "T must be an alternative of PayloadVariant");
+    static_assert(ConflationTraits<T>::KEYS == 0U,
+                  "Conflated types have no ring slot to reserve; publish them with Publish()");
+    uint32_t prod_pos = 0U;
+    if (!ReserveSlot(priority, performance_mode_.load(std::memory_order_relaxed), prod_pos)) {
+      return PublishSlot<T>();
+    }
+
+    NodeRef node = NodeAt(prod_pos);
+    T* value = std::get_if<T>(&node.envelope.payload);
+    if (!std::is_trivially_copyable<T>::value || (value == nullptr)) {
+      value = &node.envelope.payload.template emplace<T>();
+    }
+    return PublishSlot<T>(this, &node.envelope, &node.sequence, value, prod_pos, priority);
   }
 
   // ======================== Subscribe API ========================
 
+  /**
+   * @brief Register a callback for message type T.
+   *
+   * Safe to call while the consumer is dispatching: the new callback table is
+   * published atomically and becomes visible from the next ProcessBatch().
+   * Must not be called from a callback running on this bus.
+   */
   template <typename T, typename Func>
   SubscriptionHandle Subscribe(Func&& func) {
+    return Subscribe<T>(SubscriptionFilter{}, std::forward<Func>(func));
+  }
+
+  /**
+   * @brief Register a callback for the T messages that pass filter.
+   *
+   * The filter is checked by the consumer before the callback is invoked,
+   * through a per-type bucket index, so a message only visits the callbacks
+   * whose filter can match it. FilterKey::PAYLOAD_KEY requires a
+   * `uint32_t MessageKey(const T&) noexcept` overload in T's namespace;
+   * without one the subscription fails (invalid handle).
+   */
+  template <typename T, typename Func>
+  SubscriptionHandle Subscribe(const SubscriptionFilter& filter, Func&& func) {
     constexpr size_t type_idx = VariantIndex<T, PayloadVariant>::value;
     static_assert(type_idx < MCCC_MAX_MESSAGE_TYPES, "Type index exceeds MCCC_MAX_MESSAGE_TYPES");
 
-    std::unique_lock<std::shared_mutex> lock(callback_mutex_);
-
-    CallbackSlot& slot = callback_table_[type_idx];
-    size_t callback_id = next_callback_id_++;
-
-    for (uint32_t i = 0U; i < MCCC_MAX_CALLBACKS_PER_TYPE; ++i) {
-      if (!slot.entries[i].active) {
-        slot.entries[i].id = callback_id;
-        slot.entries[i].callback = CallbackType(std::forward<Func>(func));
-        slot.entries[i].active = true;
-        ++slot.count;
-        return SubscriptionHandle{type_idx, callback_id};
+    PayloadKeyFn payload_key = nullptr;
+    if (filter.key == FilterKey::PAYLOAD_KEY) {
+      if constexpr (detail::HasMessageKey<T>::value) {
+        payload_key = &PayloadKeyOf<T>;
+      } else {
+        return SubscriptionHandle{type_idx, static_cast<size_t>(-1)};
       }
     }
 
-    return SubscriptionHandle{type_idx, static_cast<size_t>(-1)};
+    std::lock_guard<std::mutex> lock(callback_mutex_);
+    const size_t callback_id =
+        InstallCallback(callback_storage_[type_idx], type_idx, &CallbackSlot::callbacks, &CallbackSlot::count,
+                        CallbackType(std::forward<Func>(func)), filter, payload_key);
+    return SubscriptionHandle{type_idx, callback_id};
+  }
+
+  /**
+   * @brief Register a callback that receives runs of consecutive T messages.
+   *
+   * ProcessBatch() groups consecutive messages of type T within its window
+   * and calls func(EnvelopeSpan) once per run, so one indirect call covers the
+   * whole run and the callback can loop over it (e.g. a SIMD kernel). A run
+   * ends at the first message of another type, at a batch boundary, or at
+   * the end of the window; per-message callbacks of later messages run after
+   * the run is delivered, so cross-type order is preserved. Slots of a pending
+   * run are released to producers only after delivery. ProcessBatchWith()
+   * does not use batch callbacks.
+   *
+   * Handles are removed with Unsubscribe(); same threading rules as Subscribe().
+   */
+  template <typename T, typename Func>
+  SubscriptionHandle SubscribeBatch(Func&& func) {
+    constexpr size_t type_idx = VariantIndex<T, PayloadVariant>::value;
+    static_assert(type_idx < MCCC_MAX_MESSAGE_TYPES, "Type index exceeds MCCC_MAX_MESSAGE_TYPES");
+
+    std::lock_guard<std::mutex> lock(callback_mutex_);
+    return SubscriptionHandle{
+        type_idx, InstallCallback(batch_callback_storage_[type_idx], type_idx, &CallbackSlot::batch_callbacks,
+                                  &CallbackSlot::batch_count, BatchCallbackType(std::forward<Func>(func)),
+                                  SubscriptionFilter{}, nullptr)};
   }
 
+  /**
+   * @brief Remove a callback.
+   *
+   * Returns after the consumer has left any batch that could still see the
+   * callback, so objects captured by it may be destroyed afterwards.
+   * Must not be called from a callback running on this bus.
+   */
   bool Unsubscribe(const SubscriptionHandle& handle) noexcept {
     if (handle.type_index >= MCCC_MAX_MESSAGE_TYPES) {
       return false;
     }
 
-    CallbackType old_callback;  // destroyed outside lock to avoid use-after-free
+    // Destroyed outside the lock to avoid use-after-free
+    CallbackType old_callback;
+    BatchCallbackType old_batch_callback;
     {
-      std::unique_lock<std::shared_mutex> lock(callback_mutex_);
-
-      CallbackSlot& slot = callback_table_[handle.type_index];
-      for (uint32_t i = 0U; i < MCCC_MAX_CALLBACKS_PER_TYPE; ++i) {
-        if (slot.entries[i].active && (slot.entries[i].id == handle.callback_id)) {
-          slot.entries[i].active = false;
-          old_callback = std::move(slot.entries[i].callback);
-          slot.entries[i].callback = nullptr;
-          --slot.count;
-          break;
-        }
+      std::lock_guard<std::mutex> lock(callback_mutex_);
+      if (!RemoveCallback(callback_storage_[handle.type_index], handle, &CallbackSlot::callbacks,
+                          &CallbackSlot::count, old_callback) &&
+          !RemoveCallback(batch_callback_storage_[handle.type_index], handle, &CallbackSlot::batch_callbacks,
+                          &CallbackSlot::batch_count, old_batch_callback)) {
+        return false;
       }
     }
-    // old_callback destroyed here, outside the lock and after loop completes
-    return static_cast<bool>(old_callback);
+    return static_cast<bool>(old_callback) || static_cast<bool>(old_batch_callback);
   }
 
   // ======================== Processing API ========================
 
-  uint32_t ProcessBatch() noexcept {
-    uint32_t processed = 0U;
-    uint32_t cons_pos = consumer_pos_.load(std::memory_order_relaxed);
-    const PerformanceMode mode = performance_mode_.load(std::memory_order_relaxed);
-    const bool bare_metal = (mode == PerformanceMode::BARE_METAL);
-    const bool no_stats = bare_metal || (mode == PerformanceMode::NO_STATS);
-    for (uint32_t i = 0U; i < BATCH_PROCESS_SIZE; ++i) {
-      if (!ProcessOneInBatch(cons_pos, bare_metal)) {
-        break;
-      }
-      ++cons_pos;
-      ++processed;
+  /**
+   * @brief Dispatch up to max_messages queued messages (capped at BATCH_PROCESS_SIZE).
+   *
+   * Messages past their ExpiryTraits TTL are released without a callback and
+   * do not count towards max_messages (at most MAX_QUEUE_DEPTH are skipped
+   * per call). Slots released by PublishSlot::Cancel() are skipped too.
+   *
+   * @return Number of slots consumed, expired and cancelled ones included, so
+   *         `while (ProcessBatch() > 0U)` drains past them; messages_processed
+   *         counts dispatched messages only
+   */
+  uint32_t ProcessBatch(uint32_t max_messages = BATCH_PROCESS_SIZE) noexcept {
+    return ProcessBatchImpl<true>(max_messages);
+  }
+
+  /**
+   * @brief Deliver only the updated ConflationTraits latest-value slots, leaving the ring untouched.
+   *
+   * For consumers that order ring messages themselves through PeekHeader()
+   * (LaneBus TIMESTAMP merge) but still need the samples that never enter
+   * the ring. Single consumer only.
+   *
+   * @return Number of samples processed, expired ones included (0 without conflated types)
+   */
+  uint32_t ProcessConflated(uint32_t max_messages = BATCH_PROCESS_SIZE) noexcept {
+    if constexpr (HAS_CONFLATION) {
+      return ProcessBatchImpl<false>(max_messages);
+    } else {
+      (void)max_messages;
+      return 0U;
+    }
+  }
+
+  /**
+   * @brief Consume exactly the head ring slot, i.e. the one PeekHeader() returns.
+   *
+   * Dispatches it, or releases it without a callback when it was cancelled or
+   * has expired; never moves on to the next slot and drains no latest-value
+   * slot. For consumers that merge several rings by header (LaneBus
+   * TIMESTAMP): unlike ProcessBatch(1U), an expired head cannot let a later
+   * message be dispatched before the heads of the other rings are compared.
+   * Single consumer only.
+   *
+   * @return 1 if a slot was consumed, 0 if the head slot is not ready
+   */
+  uint32_t ProcessHead() noexcept { return ProcessBatchImpl<true, true>(1U); }
+
+  /** @brief True if payload's type has ConflationTraits, i.e. it normally bypasses the ring and admission. */
+  static bool IsConflated(const PayloadVariant& payload) noexcept {
+    if constexpr (HAS_CONFLATION) {
+      return detail::ConflationTables<PayloadVariant>::BY_INDEX[payload.index()];
+    } else {
+      (void)payload;
+      return false;
+    }
+  }
+
+  /**
+   * @brief ProcessBatch() that blocks until a message arrives or timeout elapses.
+   *
+   * Spins for WAIT_SPIN_COUNT polls, then yields WAIT_YIELD_COUNT times, then
+   * parks on a condition variable. Producers only take the wake-up path when
+   * the consumer is parked; buses that never call this function pay nothing.
+   * Returns early (possibly with 0) after Wakeup().
+   * Single consumer only (same constraint as ProcessBatch).
+   *
+   * @return Number of messages processed (0 on timeout)
+   */
+  template <typename Rep, typename Period>
+  uint32_t ProcessBatchWait(std::chrono::duration<Rep, Period> timeout) noexcept {
+    // A producer that read wait_enabled_ == false just before it was set may
+    // skip its notify, so the first park is capped
+    const bool first_wait = !wait_enabled_.load(std::memory_order_relaxed);
+    if (first_wait) {
+      wait_enabled_.store(true, std::memory_order_seq_cst);
     }
+    uint32_t processed = ProcessBatch();
     if (processed > 0U) {
-      consumer_pos_.store(cons_pos, std::memory_order_relaxed);
-      if (!no_stats) {
-        stats_.messages_processed.fetch_add(processed, std::memory_order_relaxed);
+      return processed;
+    }
+
+    const uint32_t cons_pos = consumer_pos_.load(std::memory_order_relaxed);
+    for (uint32_t i = 0U; i < WAIT_SPIN_COUNT; ++i) {
+      if (HasPendingWork(cons_pos)) {
+        return ProcessBatch();
       }
+      detail::CpuRelax();
     }
-    return processed;
+    for (uint32_t i = 0U; i < WAIT_YIELD_COUNT; ++i) {
+      std::this_thread::yield();
+      if (HasPendingWork(cons_pos)) {
+        return ProcessBatch();
+      }
+    }
+
+    auto park_time = std::chrono::duration_cast<std::chrono::steady_clock::duration>(timeout);
+    if (first_wait && (park_time > std::chrono::milliseconds(1))) {
+      park_time = std::chrono::milliseconds(1);
+    }
+    const auto deadline = std::chrono::steady_clock::now() + park_time;
+    {
+      std::unique_lock<std::mutex> lock(wait_mutex_);
+      consumer_sleeping_.store(true, std::memory_order_relaxed);
+      // Pairs with the fence in NotifyConsumer(): either the producer sees the
+      // flag or this thread sees the published slot.
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      while (!HasPendingWork(cons_pos) && !wakeup_requested_.load(std::memory_order_relaxed)) {
+        if (wait_cv_.wait_until(lock, deadline) == std::cv_status::timeout) {
+          break;
+        }
+      }
+      consumer_sleeping_.store(false, std::memory_order_relaxed);
+    }
+    wakeup_requested_.store(false, std::memory_order_relaxed);
+    return ProcessBatch();
+  }
+
+  /**
+   * @brief Make a pending (or the next) ProcessBatchWait() return immediately.
+   *
+   * Used to stop a parked consumer thread.
+   */
+  void Wakeup() noexcept {
+    wakeup_requested_.store(true, std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(wait_mutex_);
+    wait_cv_.notify_all();
   }
 
   /**
    * @brief Zero-overhead compile-time dispatch using a visitor.
    *
-   * Bypasses callback_table_ and shared_mutex entirely.
+   * Bypasses the callback table entirely. Messages are dispatched through a
+   * compile-time switch on payload.index() (detail::VisitByIndex), not
+   * std::visit, so visitor calls inline on every toolchain.
    * The visitor must handle all types in PayloadVariant.
-   * Single consumer only (same constraint as ProcessBatch).
+   * Single consumer only (same constraint as ProcessBatch). Expired messages and
+   * cancelled slots are skipped as in ProcessBatch().
    *
    * @tparam Visitor A callable that accepts all types in PayloadVariant
-   * @return Number of messages processed
+   * @return Number of slots consumed, expired and cancelled ones included
    */
   template <typename Visitor>
   uint32_t ProcessBatchWith(Visitor&& vis) noexcept {
-    uint32_t processed = 0U;
     uint32_t cons_pos = consumer_pos_.load(std::memory_order_relaxed);
-    for (uint32_t i = 0U; i < BATCH_PROCESS_SIZE; ++i) {
-      RingBufferNode& node = ring_buffer_[cons_pos & BUFFER_MASK];
+    uint32_t expired = 0U;
+    const uint64_t now_us = ExpiryNowUs();
+    const uint64_t admission_now_us = admission_.enabled ? AdmissionNowUs(now_us) : 0U;
+    const uint64_t head_sojourn_us = admission_.enabled ? HeadSojournUs(cons_pos, admission_now_us) : 0U;
+    const uint32_t conflated =
+        DrainConflated(BATCH_PROCESS_SIZE, [this, &vis, &expired, now_us](const EnvelopeType& envelope) {
+          if (IsEnvelopeExpired(envelope, now_us)) {
+            ++expired;
+            return;
+          }
+          RecordDispatchLatency(envelope);
+          detail::VisitByIndex(vis, envelope.payload);
+        });
+    uint32_t processed = conflated;
+    uint32_t dispatched = conflated;
+    constexpr uint32_t MAX_SLOTS = BATCH_PROCESS_SIZE + MAX_QUEUE_DEPTH;
+    while ((dispatched < BATCH_PROCESS_SIZE) && (processed < MAX_SLOTS)) {
+      const uint32_t skipped = expired;
+      NodeRef node = NodeAt(cons_pos);
       uint32_t expected_seq = cons_pos + 1U;
       uint32_t seq = node.sequence.load(MCCC_MO_ACQUIRE);
       detail::AcquireFence();
       if (seq != expected_seq) {
         break;
       }
-      std::visit(vis, node.envelope.payload);
+      if (node.envelope.header.msg_id != CANCELLED_MSG_ID) {
+        if (IsEnvelopeExpired(node.envelope, now_us)) {
+          ++expired;
+        } else {
+          RecordDispatchLatency(node.envelope);
+          detail::VisitByIndex(vis, node.envelope.payload);
+        }
+      }
+      ReleasePayload(node.envelope);
       detail::ReleaseFence();
       node.sequence.store(cons_pos + BUFFER_SIZE, MCCC_MO_RELEASE);
       ++cons_pos;
       ++processed;
+      dispatched += (expired == skipped) ? 1U : 0U;
+    }
+    if (processed > conflated) {
+      consumer_pos_.store(cons_pos, std::memory_order_relaxed);
+    }
+    if (admission_.enabled && (processed > 0U)) {
+      UpdateAdmission(admission_now_us, head_sojourn_us, processed, !IsSlotReady(cons_pos));
+    }
+    if (expired > 0U) {
+      CountExpired(expired);
+    }
+    return processed;
+  }
+
+  /**
+   * @brief Header of the next message ProcessBatch() would dispatch.
+   *
+   * Lets a consumer that drains several buses order them (e.g. LaneBus merging
+   * by timestamp). A slot released by PublishSlot::Cancel() reports msg_id 0.
+   * Single consumer only; the pointer is valid until the next ProcessBatch*().
+   *
+   * @return nullptr if no message is ready
+   */
+  const MessageHeader* PeekHeader() noexcept {
+    const uint32_t cons_pos = consumer_pos_.load(std::memory_order_relaxed);
+    NodeRef node = NodeAt(cons_pos);
+    if (node.sequence.load(MCCC_MO_ACQUIRE) != (cons_pos + 1U)) {
+      return nullptr;
+    }
+    detail::AcquireFence();
+    return &node.envelope.header;
+  }
+
+  // ======================== Queue Status API ========================
+
+  uint32_t QueueDepth() const noexcept {
+    uint32_t prod = producer_pos_.load(std::memory_order_acquire);
+    uint32_t cons = consumer_pos_.load(std::memory_order_acquire);
+    return prod - cons;
+  }
+
+  /** @brief Bytes of ring storage (sequences + envelopes) for this Depth and MCCC_COMPACT_RING. */
+  static constexpr size_t RingMemoryBytes() noexcept {
+#if MCCC_COMPACT_RING
+    return sizeof(decltype(sequences_)) + sizeof(decltype(envelopes_));
+#else
+    return sizeof(decltype(ring_buffer_));
+#endif
+  }
+
+  uint32_t QueueUtilizationPercent() const noexcept { return (QueueDepth() * 100U) / MAX_QUEUE_DEPTH; }
+
+  BackpressureLevel GetBackpressureLevel() const noexcept {
+    uint32_t depth = QueueDepth();
+    if (depth >= MAX_QUEUE_DEPTH) {
+      return BackpressureLevel::FULL;
+    }
+    if (depth >= BACKPRESSURE_CRITICAL_THRESHOLD) {
+      return BackpressureLevel::CRITICAL;
+    }
+    if (depth >= BACKPRESSURE_WARNING_THRESHOLD) {
+      return BackpressureLevel::WARNING;
+    }
+    return BackpressureLevel::NORMAL;
+  }
+
+ private:
+  // ======================== Ring Buffer Node ========================
+
+  static constexpr uint32_t BUFFER_SIZE = Depth;
+  static constexpr uint32_t BUFFER_MASK = BUFFER_SIZE - 1U;
+
+  static_assert(BUFFER_SIZE >= 2U, "Depth must be at least 2");
+
+  /** Sequence and envelope of one ring slot, independent of the storage layout. */
+  struct NodeRef {
+    std::atomic<uint32_t>& sequence;
+    EnvelopeType& envelope;
+  };
+
+#if MCCC_COMPACT_RING
+  NodeRef NodeAt(uint32_t pos) noexcept {
+    return NodeRef{sequences_[pos & BUFFER_MASK], envelopes_[pos & BUFFER_MASK]};
+  }
+  const std::atomic<uint32_t>& SequenceAt(uint32_t pos) const noexcept { return sequences_[pos & BUFFER_MASK]; }
+#else
+  struct MCCC_ALIGN_CACHELINE RingBufferNode {
+    std::atomic<uint32_t> sequence{0U};
+    EnvelopeType envelope;
+  };
+
+  NodeRef NodeAt(uint32_t pos) noexcept {
+    RingBufferNode& node = ring_buffer_[pos & BUFFER_MASK];
+    return NodeRef{node.sequence, node.envelope};
+  }
+  const std::atomic<uint32_t>& SequenceAt(uint32_t pos) const noexcept {
+    return ring_buffer_[pos & BUFFER_MASK].sequence;
+  }
+#endif
+
+  /** msg_id of a slot released by PublishSlot::Cancel() (real IDs start at 1). */
+  static constexpr uint64_t CANCELLED_MSG_ID = 0U;
+
+  /** Latest-value slots of the ConflationTraits-enabled types (empty tuple when there are none). */
+  static constexpr bool HAS_CONFLATION = detail::ConflationTables<PayloadVariant>::ANY;
+  static constexpr bool HAS_EXPIRY = detail::ExpiryTtls<PayloadVariant>::ANY;
+  using ConflationStorage =
+      std::conditional_t<HAS_CONFLATION, typename detail::ConflationTables<PayloadVariant>::Tuple, std::tuple<>>;
+  static_assert((BUFFER_SIZE & (BUFFER_SIZE - 1U)) == 0U, "BUFFER_SIZE must be power of 2");
+
+  static_assert(MCCC_MAX_CALLBACKS_PER_TYPE <= 64U, "MCCC_MAX_CALLBACKS_PER_TYPE exceeds the filter index width");
+  static_assert((MCCC_FILTER_BUCKETS & (MCCC_FILTER_BUCKETS - 1U)) == 0U, "MCCC_FILTER_BUCKETS must be power of 2");
+  static_assert((MCCC_FILTER_BUCKETS >= 1U) && (MCCC_FILTER_BUCKETS <= 64U), "MCCC_FILTER_BUCKETS must be 1..64");
+
+  /** Stable callback storage, written only under callback_mutex_. */
+  template <typename Callback>
+  struct Entry {
+    size_t id{0U};
+    Callback callback{nullptr};
+    SubscriptionFilter filter{};
+    bool active{false};
+  };
+  template <typename Callback>
+  using EntryStorage = std::array<Entry<Callback>, MCCC_MAX_CALLBACKS_PER_TYPE>;
+
+  /** Bit i selects callbacks[i]. */
+  using CallbackMask = uint64_t;
+  using PayloadKeyFn = uint32_t (*)(const EnvelopeType&) noexcept;
+
+  /**
+   * Immutable per-type view read by the consumer: active callbacks in
+   * subscribe order, plus the filter index when any of them is filtered.
+   */
+  struct CallbackSlot {
+    std::array<const Entry<CallbackType>*, MCCC_MAX_CALLBACKS_PER_TYPE> callbacks{};
+    uint32_t count{0U};
+    uint32_t filtered_count{0U};
+    CallbackMask unfiltered{0U};
+    PayloadKeyFn payload_key{nullptr};
+    std::array<CallbackMask, MCCC_FILTER_BUCKETS> sender_buckets{};
+    std::array<CallbackMask, MCCC_FILTER_BUCKETS> key_buckets{};
+    std::array<const Entry<BatchCallbackType>*, MCCC_MAX_CALLBACKS_PER_TYPE> batch_callbacks{};
+    uint32_t batch_count{0U};
+  };
+
+  using CallbackTable = std::array<CallbackSlot, MCCC_MAX_MESSAGE_TYPES>;
+  template <typename Callback>
+  using SlotList = std::array<const Entry<Callback>*, MCCC_MAX_CALLBACKS_PER_TYPE> CallbackSlot::*;
+  using SlotCount = uint32_t CallbackSlot::*;
+
+  /** Pending SubscribeBatch() run of the current ProcessBatch() (consumer only). */
+  struct BatchRun {
+    size_t type_index;  /**< Variant index shared by the run */
+    uint32_t first_pos; /**< First ring position whose release is deferred */
+    uint32_t count;     /**< Envelopes collected in batch_run_ */
+  };
+
+  // ======================== Callback Table Snapshots ========================
+  //
+  // The consumer reads a published CallbackTable without locking. Writers
+  // (serialised by callback_mutex_) copy the active table into the inactive
+  // buffer, edit it, publish it with one atomic store and then wait until the
+  // consumer is outside any batch that started before the store. After that
+  // grace period the old buffer and removed callbacks are unreachable.
+  //
+  // dispatch_epoch_ is odd while the consumer is inside a batch. The
+  // seq_cst store/load pairs (epoch then table on the consumer side, table
+  // then epoch on the writer side) guarantee that either the writer sees the
+  // batch in progress or the batch sees the new table.
+
+  const CallbackTable& EnterDispatch() noexcept {
+    dispatch_epoch_.store(dispatch_epoch_.load(std::memory_order_relaxed) + 1U, std::memory_order_seq_cst);
+    return *active_table_.load(std::memory_order_seq_cst);
+  }
+
+  void ExitDispatch() noexcept {
+    dispatch_epoch_.store(dispatch_epoch_.load(std::memory_order_relaxed) + 1U, std::memory_order_release);
+  }
+
+  /** Caller holds callback_mutex_. Returns the inactive buffer holding a copy of the active table. */
+  CallbackTable& BeginTableUpdate() noexcept {
+    const CallbackTable* current = active_table_.load(std::memory_order_relaxed);
+    CallbackTable& next = (current == &callback_tables_[0]) ? callback_tables_[1] : callback_tables_[0];
+    next = *current;
+    return next;
+  }
+
+  /** Caller holds callback_mutex_. Publishes next and waits for the grace period. */
+  void CommitTableUpdate(CallbackTable& next) noexcept {
+    active_table_.store(&next, std::memory_order_seq_cst);
+    const uint64_t epoch = dispatch_epoch_.load(std::memory_order_seq_cst);
+    if ((epoch & 1U) != 0U) {
+      while (dispatch_epoch_.load(std::memory_order_acquire) == epoch) {
+        std::this_thread::yield();
+      }
+    }
+  }
+
+  /** Caller holds callback_mutex_. Stores the callback and publishes it; returns its id or -1 when full. */
+  template <typename Callback>
+  size_t InstallCallback(EntryStorage<Callback>& storage, size_t type_idx, SlotList<Callback> list, SlotCount count,
+                         Callback&& callback, const SubscriptionFilter& filter, PayloadKeyFn payload_key) noexcept {
+    CallbackTable& next = BeginTableUpdate();
+    CallbackSlot& slot = next[type_idx];
+    if ((slot.*count) >= MCCC_MAX_CALLBACKS_PER_TYPE) {
+      return static_cast<size_t>(-1);
+    }
+    for (auto& entry : storage) {
+      if (!entry.active) {
+        // Entry is not referenced by any published table, so it can be written freely
+        const size_t callback_id = next_callback_id_++;
+        entry.id = callback_id;
+        entry.callback = std::move(callback);
+        entry.filter = filter;
+        entry.active = true;
+        (slot.*list)[slot.*count] = &entry;
+        ++(slot.*count);
+        if (payload_key != nullptr) {
+          slot.payload_key = payload_key;
+        }
+        RebuildFilterIndex(slot);
+        CommitTableUpdate(next);
+        return callback_id;
+      }
+    }
+    return static_cast<size_t>(-1);
+  }
+
+  /**
+   * Caller holds callback_mutex_. Unpublishes the entry matching handle, waits
+   * out the grace period and moves its callback into removed.
+   */
+  template <typename Callback>
+  bool RemoveCallback(EntryStorage<Callback>& storage, const SubscriptionHandle& handle, SlotList<Callback> list,
+                      SlotCount count, Callback& removed) noexcept {
+    Entry<Callback>* found = nullptr;
+    for (auto& entry : storage) {
+      if (entry.active && (entry.id == handle.callback_id)) {
+        found = &entry;
+        break;
+      }
+    }
+    if (found == nullptr) {
+      return false;
+    }
+
+    CallbackTable& next = BeginTableUpdate();
+    CallbackSlot& slot = next[handle.type_index];
+    uint32_t out = 0U;
+    for (uint32_t i = 0U; i < (slot.*count); ++i) {
+      if ((slot.*list)[i] != found) {
+        (slot.*list)[out] = (slot.*list)[i];
+        ++out;
+      }
+    }
+    slot.*count = out;
+    RebuildFilterIndex(slot);
+    CommitTableUpdate(next);  // waits out the grace period
+
+    // No reader can reach the entry any more
+    removed = std::move(found->callback);
+    found->callback = nullptr;
+    found->filter = SubscriptionFilter{};
+    found->active = false;
+    return true;
+  }
+
+  /** Bitmask of the filter buckets (key % MCCC_FILTER_BUCKETS) that can hold a key matching filter. */
+  static uint64_t CoveredBuckets(const SubscriptionFilter& filter) noexcept {
+    constexpr uint32_t kLowBits = MCCC_FILTER_BUCKETS - 1U;
+    constexpr uint64_t kAll = (MCCC_FILTER_BUCKETS == 64U) ? ~static_cast<uint64_t>(0U)
+                                                            : ((static_cast<uint64_t>(1U) << MCCC_FILTER_BUCKETS) - 1U);
+    if ((filter.mask & kLowBits) == kLowBits) {
+      return static_cast<uint64_t>(1U) << (filter.value & kLowBits);  // bucket fixed by the mask
+    }
+    if ((filter.max >= filter.min) && ((filter.max - filter.min) < kLowBits)) {
+      uint64_t buckets = 0U;
+      for (uint32_t k = filter.min;; ++k) {
+        if (filter.Matches(k)) {
+          buckets |= static_cast<uint64_t>(1U) << (k & kLowBits);
+        }
+        if (k == filter.max) {
+          break;
+        }
+      }
+      return buckets;
+    }
+    return kAll;
+  }
+
+  /** Caller holds callback_mutex_. Recomputes the filter index of slot from its callback list. */
+  static void RebuildFilterIndex(CallbackSlot& slot) noexcept {
+    slot.filtered_count = 0U;
+    slot.unfiltered = 0U;
+    slot.sender_buckets.fill(0U);
+    slot.key_buckets.fill(0U);
+    bool payload_filtered = false;
+    for (uint32_t i = 0U; i < slot.count; ++i) {
+      const SubscriptionFilter& filter = slot.callbacks[i]->filter;
+      const CallbackMask bit = static_cast<CallbackMask>(1U) << i;
+      if (filter.key == FilterKey::NONE) {
+        slot.unfiltered |= bit;
+        continue;
+      }
+      ++slot.filtered_count;
+      payload_filtered = payload_filtered || (filter.key == FilterKey::PAYLOAD_KEY);
+      std::array<CallbackMask, MCCC_FILTER_BUCKETS>& buckets =
+          (filter.key == FilterKey::SENDER_ID) ? slot.sender_buckets : slot.key_buckets;
+      const uint64_t covered = CoveredBuckets(filter);
+      for (uint32_t b = 0U; b < MCCC_FILTER_BUCKETS; ++b) {
+        if (((covered >> b) & 1U) != 0U) {
+          buckets[b] |= bit;
+        }
+      }
+    }
+    if (!payload_filtered) {
+      slot.payload_key = nullptr;  // no payload-key filter left: skip the extraction
+    }
+  }
+
+  template <typename T>
+  static uint32_t PayloadKeyOf(const EnvelopeType& envelope) noexcept {
+    return static_cast<uint32_t>(MessageKey(*std::get_if<T>(&envelope.payload)));
+  }
+
+  bool IsSlotReady(uint32_t cons_pos) const noexcept {
+    return SequenceAt(cons_pos).load(std::memory_order_relaxed) == (cons_pos + 1U);
+  }
+
+  /** Ring slot ready or a latest-value slot updated (the latter compiles away without conflated types). */
+  bool HasPendingWork(uint32_t cons_pos) const noexcept { return ConflatedPending() || IsSlotReady(cons_pos); }
+
+  bool ConflatedPending() const noexcept {
+    bool conflated = false;
+    std::apply([&conflated](const auto&... tables) { conflated = (TablePending(tables) || ...); }, conflation_);
+    return conflated;
+  }
+
+  /**
+   * ProcessBatch() body. WithRing == false delivers the latest-value slots
+   * only (ProcessConflated()); HeadOnly consumes just the head ring slot and
+   * no latest-value slot (ProcessHead()).
+   */
+  template <bool WithRing, bool HeadOnly = false>
+  uint32_t ProcessBatchImpl(uint32_t max_messages) noexcept {
+    uint32_t processed = 0U;
+    uint32_t cons_pos = consumer_pos_.load(std::memory_order_relaxed);
+    const bool pending =
+        HeadOnly ? IsSlotReady(cons_pos) : (WithRing ? HasPendingWork(cons_pos) : ConflatedPending());
+    if ((max_messages == 0U) || !pending) {
+      return 0U;  // idle poll: no epoch traffic
+    }
+    const PerformanceMode mode = performance_mode_.load(std::memory_order_relaxed);
+    const bool no_stats = (mode == PerformanceMode::BARE_METAL) || (mode == PerformanceMode::NO_STATS);
+    const uint32_t limit = (max_messages < BATCH_PROCESS_SIZE) ? max_messages : BATCH_PROCESS_SIZE;
+    uint32_t cancelled = 0U;
+    uint32_t expired = 0U;
+    const uint64_t now_us = ExpiryNowUs();
+    const uint64_t admission_now_us = admission_.enabled ? AdmissionNowUs(now_us) : 0U;
+    const uint64_t head_sojourn_us =
+        (WithRing && admission_.enabled) ? HeadSojournUs(cons_pos, admission_now_us) : 0U;
+    BatchRun run{0U, 0U, 0U};
+    const CallbackTable& table = EnterDispatch();
+    const uint32_t conflated =
+        HeadOnly ? 0U : DrainConflated(limit, [this, &table, &expired, now_us](const EnvelopeType& envelope) {
+          if (IsEnvelopeExpired(envelope, now_us)) {
+            ++expired;
+            return;
+          }
+          RecordDispatchLatency(envelope);
+          DispatchMessage(table, envelope);
+          DispatchToBatchCallbacks(table, envelope);
+        });
+    // Expired messages do not use the budget, so one pass skims a stale backlog
+    uint32_t dispatched = conflated;
+    const uint32_t max_slots = HeadOnly ? 1U : (WithRing ? (limit + MAX_QUEUE_DEPTH) : 0U);
+    while ((dispatched < limit) && (processed < max_slots)) {
+      const uint32_t skipped = expired;
+      if (!ProcessOneInBatch(cons_pos, table, now_us, cancelled, expired, run)) {
+        break;
+      }
+      ++cons_pos;
+      ++processed;
+      dispatched += (expired == skipped) ? 1U : 0U;
+    }
+    if (run.count > 0U) {
+      FlushBatchRun(table, run, cons_pos);
+    }
+    ExitDispatch();
+    consumer_pos_.store(cons_pos, std::memory_order_relaxed);
+    if (WithRing && admission_.enabled) {
+      UpdateAdmission(admission_now_us, head_sojourn_us, processed + conflated, !IsSlotReady(cons_pos));
+    }
+    if (!no_stats) {
+      stats_.messages_processed.fetch_add((processed + conflated) - (cancelled + expired), std::memory_order_relaxed);
+      if (expired > 0U) {
+        stats_.messages_expired.fetch_add(expired, std::memory_order_relaxed);
+      }
+    }
+    return processed + conflated;
+  }
+
+  /**
+   * Drops what a consumed payload still owns (e.g. a SharedDataToken reference)
+   * before its slot is handed back, instead of when a later publish overwrites it.
+   * Compiles away for trivially destructible payload variants.
+   */
+  static void ReleasePayload(EnvelopeType& envelope) noexcept {
+    if constexpr (!std::is_trivially_destructible<PayloadVariant>::value &&
+                  std::is_nothrow_default_constructible<PayloadVariant>::value &&
+                  std::is_nothrow_move_assignable<PayloadVariant>::value) {
+      envelope.payload = PayloadVariant();
+    } else {
+      (void)envelope;
+    }
+  }
+
+  bool ProcessOneInBatch(uint32_t cons_pos, const CallbackTable& table, uint64_t now_us, uint32_t& cancelled,
+                         uint32_t& expired, BatchRun& run) noexcept {
+    NodeRef node = NodeAt(cons_pos);
+
+    uint32_t expected_seq = cons_pos + 1U;
+    uint32_t seq = node.sequence.load(MCCC_MO_ACQUIRE);
+    detail::AcquireFence();
+
+    if (seq != expected_seq) {
+      return false;
     }
-    if (processed > 0U) {
-      consumer_pos_.store(cons_pos, std::memory_order_relaxed);
+
+    if (node.envelope.header.msg_id == CANCELLED_MSG_ID) {
+      ++cancelled;
+    } else if (IsEnvelopeExpired(node.envelope, now_us)) {
+      ++expired;
+    } else {
+      RecordDispatchLatency(node.envelope);
+      const size_t type_idx = node.envelope.payload.index();
+      if ((run.count > 0U) && (type_idx != run.type_index)) {
+        FlushBatchRun(table, run, cons_pos);
+      }
+      DispatchMessage(table, node.envelope);
+      if ((type_idx < MCCC_MAX_MESSAGE_TYPES) && (table[type_idx].batch_count > 0U)) {
+        if (run.count == 0U) {
+          run.type_index = type_idx;
+          run.first_pos = cons_pos;
+        }
+        batch_run_[run.count] = &node.envelope;
+        ++run.count;
+      }
     }
-    return processed;
-  }
 
-  // ======================== Queue Status API ========================
+    if (run.count == 0U) {
+      ReleasePayload(node.envelope);
+      detail::ReleaseFence();
+      node.sequence.store(cons_pos + BUFFER_SIZE, MCCC_MO_RELEASE);
+    }  // else: released by FlushBatchRun() once the run is delivered
 
-  uint32_t QueueDepth() const noexcept {
-    uint32_t prod = producer_pos_.load(std::memory_order_acquire);
-    uint32_t cons = consumer_pos_.load(std::memory_order_acquire);
-    return prod - cons;
+    return true;
   }
 
-  uint32_t QueueUtilizationPercent() const noexcept { return (QueueDepth() * 100U) / MAX_QUEUE_DEPTH; }
-
-  BackpressureLevel GetBackpressureLevel() const noexcept {
-    uint32_t depth = QueueDepth();
-    if (depth >= MAX_QUEUE_DEPTH) {
-      return BackpressureLevel::FULL;
+  /** Delivers the pending run to the batch callbacks, then releases its slots [first_pos, end_pos). */
+  void FlushBatchRun(const CallbackTable& table, BatchRun& run, uint32_t end_pos) noexcept {
+    const CallbackSlot& slot = table[run.type_index];
+    const EnvelopeSpan span{batch_run_.data(), run.count};
+    for (uint32_t i = 0U; i < slot.batch_count; ++i) {
+      slot.batch_callbacks[i]->callback(span);
     }
-    if (depth >= BACKPRESSURE_CRITICAL_THRESHOLD) {
-      return BackpressureLevel::CRITICAL;
+    for (uint32_t pos = run.first_pos; pos != end_pos; ++pos) {
+      ReleasePayload(NodeAt(pos).envelope);
     }
-    if (depth >= BACKPRESSURE_WARNING_THRESHOLD) {
-      return BackpressureLevel::WARNING;
+    detail::ReleaseFence();
+    for (uint32_t pos = run.first_pos; pos != end_pos; ++pos) {
+      NodeAt(pos).sequence.store(pos + BUFFER_SIZE, MCCC_MO_RELEASE);
     }
-    return BackpressureLevel::NORMAL;
+    run.count = 0U;
   }
 
- private:
-  // ======================== Ring Buffer Node ========================
+  /** One-message span for the SubscribeBatch() callbacks of a latest-value delivery. */
+  static void DispatchToBatchCallbacks(const CallbackTable& table, const EnvelopeType& envelope) noexcept {
+    const size_t type_idx = envelope.payload.index();
+    if ((type_idx >= MCCC_MAX_MESSAGE_TYPES) || (table[type_idx].batch_count == 0U)) {
+      return;
+    }
+    const EnvelopeType* single = &envelope;
+    const EnvelopeSpan span{&single, 1U};
+    for (uint32_t i = 0U; i < table[type_idx].batch_count; ++i) {
+      table[type_idx].batch_callbacks[i]->callback(span);
+    }
+  }
 
-  struct MCCC_ALIGN_CACHELINE RingBufferNode {
-    std::atomic<uint32_t> sequence{0U};
-    EnvelopeType envelope;
+  // ======================== Adaptive Admission ========================
+
+  /** Consumer-owned controller state; the resulting limits reach producers via low_limit_ / medium_limit_. */
+  struct AdmissionState {
+    AdaptiveAdmissionConfig config{};
+    bool enabled{false};
+    bool started{false};
+    uint64_t interval_start_us{0U};
+    uint64_t min_sojourn_us{UINT64_MAX};
+    uint64_t retired{0U};
   };
 
-  static constexpr uint32_t BUFFER_SIZE = static_cast<uint32_t>(MCCC_QUEUE_DEPTH);
-  static constexpr uint32_t BUFFER_MASK = BUFFER_SIZE - 1U;
+  /** Consumer: controller clock, shared with the expiry check when a TTL already read it. */
+  static uint64_t AdmissionNowUs(uint64_t expiry_now_us) noexcept {
+    if constexpr (HAS_EXPIRY) {
+      return expiry_now_us;
+    } else {
+      (void)expiry_now_us;
+      return Clock::NowNs() / 1000U;
+    }
+  }
 
-  static_assert((BUFFER_SIZE & (BUFFER_SIZE - 1U)) == 0U, "BUFFER_SIZE must be power of 2");
+  /** Consumer: how long the oldest ring message has waited (0 if the head slot is empty or cancelled). */
+  uint64_t HeadSojournUs(uint32_t cons_pos, uint64_t now_us) noexcept {
+    NodeRef node = NodeAt(cons_pos);
+    if (node.sequence.load(MCCC_MO_ACQUIRE) != (cons_pos + 1U)) {
+      return 0U;
+    }
+    detail::AcquireFence();
+    const uint64_t stamped = node.envelope.header.timestamp_us;
+    return ((node.envelope.header.msg_id != CANCELLED_MSG_ID) && (now_us > stamped)) ? (now_us - stamped) : 0U;
+  }
 
-  struct CallbackEntry {
-    size_t id{0U};
-    CallbackType callback{nullptr};
-    bool active{false};
-  };
+  /**
+   * Consumer, once per non-empty batch. A batch that leaves the ring empty
+   * counts as a zero sojourn sample, so only a queue that never drained
+   * during the whole interval tightens the limits.
+   */
+  void UpdateAdmission(uint64_t now_us, uint64_t head_sojourn_us, uint32_t retired, bool drained) noexcept {
+    AdmissionState& state = admission_;
+    if (!state.started) {
+      state.started = true;
+      state.interval_start_us = now_us;
+    }
+    const uint64_t sample = drained ? 0U : head_sojourn_us;
+    state.min_sojourn_us = (sample < state.min_sojourn_us) ? sample : state.min_sojourn_us;
+    state.retired += retired;
+    const uint64_t elapsed = now_us - state.interval_start_us;
+    if ((now_us < state.interval_start_us) || (elapsed < state.config.interval_us)) {
+      return;
+    }
+    const uint64_t target = state.config.target_delay_us;
+    uint64_t low = low_limit_.load(std::memory_order_relaxed);
+    uint64_t medium = medium_limit_.load(std::memory_order_relaxed);
+    if (state.min_sojourn_us > target) {
+      // Standing queue: admit only what the consumer clears within the target delay
+      low = (state.retired * target) / elapsed;
+      medium = low * 2U;
+    } else if (state.min_sojourn_us < (target / 2U)) {
+      // Clearly below target: open up again. In between the limits hold, so they do not oscillate
+      low *= 2U;
+      medium *= 2U;
+    }
+    StoreAdmissionLimits(ClampLimit(low, LOW_PRIORITY_THRESHOLD), ClampLimit(medium, MEDIUM_PRIORITY_THRESHOLD),
+                         state.min_sojourn_us, (state.retired * 1000000U) / elapsed);
+    state.interval_start_us = now_us;
+    state.min_sojourn_us = UINT64_MAX;
+    state.retired = 0U;
+  }
 
-  struct CallbackSlot {
-    std::array<CallbackEntry, MCCC_MAX_CALLBACKS_PER_TYPE> entries{};
-    uint32_t count{0U};
-  };
+  uint32_t ClampLimit(uint64_t depth, uint32_t upper) const noexcept {
+    const uint64_t floor = admission_.config.min_depth;
+    const uint64_t clamped = (depth < floor) ? floor : ((depth > upper) ? upper : depth);
+    return static_cast<uint32_t>(clamped);
+  }
 
-  bool ProcessOne() noexcept {
-    uint32_t cons_pos = consumer_pos_.load(std::memory_order_relaxed);
-    return ProcessOneAtPos(cons_pos);
+  void StoreAdmissionLimits(uint32_t low, uint32_t medium, uint64_t sojourn_us, uint64_t rate) noexcept {
+    low_limit_.store(low, std::memory_order_relaxed);
+    medium_limit_.store(medium, std::memory_order_relaxed);
+    admission_sojourn_us_.store(sojourn_us, std::memory_order_relaxed);
+    admission_drain_rate_.store(rate, std::memory_order_relaxed);
   }
 
-  bool ProcessOneAtPos(uint32_t cons_pos) noexcept {
-    RingBufferNode& node = ring_buffer_[cons_pos & BUFFER_MASK];
+  // ======================== Message Expiry ========================
 
-    uint32_t expected_seq = cons_pos + 1U;
-    uint32_t seq = node.sequence.load(MCCC_MO_ACQUIRE);
-    detail::AcquireFence();
+  /** Consumer: time the batch checks TTLs against; the clock is read only if a type has a TTL. */
+  static uint64_t ExpiryNowUs() noexcept {
+    if constexpr (HAS_EXPIRY) {
+      return Clock::NowNs() / 1000U;
+    } else {
+      return 0U;
+    }
+  }
 
-    if (seq != expected_seq) {
+  static bool IsEnvelopeExpired(const EnvelopeType& envelope, uint64_t now_us) noexcept {
+    if constexpr (HAS_EXPIRY) {
+      const size_t type_idx = envelope.payload.index();
+      return (type_idx < std::variant_size<PayloadVariant>::value) &&
+             detail::IsExpired(envelope.header.timestamp_us, detail::ExpiryTtls<PayloadVariant>::TTL_US[type_idx],
+                               now_us);
+    } else {
+      (void)envelope;
+      (void)now_us;
       return false;
     }
-
-    DispatchMessage(node.envelope);
-    stats_.messages_processed.fetch_add(1U, std::memory_order_relaxed);
-
-    detail::ReleaseFence();
-    node.sequence.store(cons_pos + BUFFER_SIZE, MCCC_MO_RELEASE);
-    consumer_pos_.store(cons_pos + 1U, std::memory_order_relaxed);
-
-    return true;
   }
 
-  bool ProcessOneInBatch(uint32_t cons_pos, bool bare_metal) noexcept {
-    RingBufferNode& node = ring_buffer_[cons_pos & BUFFER_MASK];
+  void CountExpired(uint32_t expired) noexcept {
+    if (performance_mode_.load(std::memory_order_relaxed) == PerformanceMode::FULL_FEATURED) {
+      stats_.messages_expired.fetch_add(expired, std::memory_order_relaxed);
+    }
+  }
 
-    uint32_t expected_seq = cons_pos + 1U;
-    uint32_t seq = node.sequence.load(MCCC_MO_ACQUIRE);
-    detail::AcquireFence();
+  // ======================== Latest-Value Conflation ========================
 
-    if (seq != expected_seq) {
+  template <typename Table>
+  static bool TablePending(const Table& table) noexcept {
+    if constexpr (Table::ENABLED) {
+      return table.Pending();
+    } else {
+      (void)table;
       return false;
     }
+  }
 
-    if (bare_metal) {
-      DispatchMessageBareMetal(node.envelope);
+  /**
+   * @brief Deliver updated latest-value slots ahead of the ring (consumer only).
+   * @return Number of samples handed to sink (at most budget)
+   */
+  template <typename Sink>
+  uint32_t DrainConflated(uint32_t budget, Sink&& sink) noexcept {
+    if constexpr (HAS_CONFLATION) {
+      uint32_t delivered = 0U;
+      std::apply([&](auto&... tables) { (DrainTable(tables, budget, delivered, sink), ...); }, conflation_);
+      return delivered;
     } else {
-      DispatchMessage(node.envelope);
+      (void)budget;
+      (void)sink;
+      return 0U;
     }
+  }
 
-    detail::ReleaseFence();
-    node.sequence.store(cons_pos + BUFFER_SIZE, MCCC_MO_RELEASE);
+  template <typename Table, typename Sink>
+  static void DrainTable(Table& table, uint32_t budget, uint32_t& delivered, Sink& sink) noexcept {
+    if constexpr (Table::ENABLED) {
+      delivered += table.Drain(budget - delivered, [&sink](const MessageHeader& header, const auto& value) {
+        using T = std::decay_t<decltype(value)>;
+        sink(EnvelopeType(header, PayloadVariant(std::in_place_type<T>, value)));
+      });
+    } else {
+      (void)table;
+      (void)budget;
+      (void)delivered;
+      (void)sink;
+    }
+  }
 
-    return true;
+  /**
+   * @brief Overwrite the sender's latest-value slot if payload's type is conflated.
+   * @return false to publish through the ring instead (type not conflated, table full, ID wrap)
+   */
+  template <size_t... I>
+  bool PublishConflated(const PayloadVariant& payload, uint32_t sender_id, detail::HeaderStamp stamp,
+                        MessagePriority priority, bool no_stats, std::index_sequence<I...> /*unused*/) noexcept {
+    bool published = false;
+    (void)((payload.index() == I ? (published = StoreConflated<I>(payload, sender_id, stamp, priority, no_stats), true)
+                                 : false) ||
+           ...);
+    return published;
   }
 
-  AsyncBus() noexcept : producer_pos_(0U), cached_consumer_pos_(0U), consumer_pos_(0U), next_msg_id_(1U), stats_() {
-    for (uint32_t i = 0U; i < BUFFER_SIZE; ++i) {
-      ring_buffer_[i].sequence.store(i, std::memory_order_relaxed);
+  template <size_t I>
+  bool StoreConflated(const PayloadVariant& payload, uint32_t sender_id, detail::HeaderStamp stamp,
+                      MessagePriority priority, bool no_stats) noexcept {
+    auto& table = std::get<I>(conflation_);
+    if constexpr (std::decay_t<decltype(table)>::ENABLED) {
+      if (next_msg_id_.load(std::memory_order_relaxed) >= MSG_ID_WRAP_THRESHOLD) {
+        return false;  // let the ring path report OVERFLOW_DETECTED
+      }
+      const int32_t index = table.Find(sender_id);
+      if (index < 0) {
+        return false;
+      }
+      MessageHeader header{next_msg_id_.fetch_add(1U, std::memory_order_relaxed), stamp.us, sender_id, priority};
+      SetHeaderNs(header, stamp.ns);
+      const bool replaced = table.Store(index, header, *std::get_if<I>(&payload));
+      NotifyConsumer();
+      if (!no_stats) {
+        stats_.messages_published.fetch_add(1U, std::memory_order_relaxed);
+        UpdatePriorityPublishedStats(priority);
+        if (replaced) {
+          stats_.messages_conflated.fetch_add(1U, std::memory_order_relaxed);
+        }
+      }
+      return true;
+    } else {
+      (void)table;
+      (void)payload;
+      (void)sender_id;
+      (void)stamp;
+      (void)priority;
+      (void)no_stats;
+      return false;
     }
   }
 
-  ~AsyncBus() = default;
-  AsyncBus(const AsyncBus&) = delete;             // NOLINT(modernize-use-equals-delete)
-  AsyncBus& operator=(const AsyncBus&) = delete;  // NOLINT(modernize-use-equals-delete)
-  AsyncBus(AsyncBus&&) = delete;                  // NOLINT(modernize-use-equals-delete)
-  AsyncBus& operator=(AsyncBus&&) = delete;       // NOLINT(modernize-use-equals-delete)
-
   uint32_t GetThresholdForPriority(MessagePriority priority) const noexcept {
     switch (priority) {
       case MessagePriority::HIGH:
         return HIGH_PRIORITY_THRESHOLD;
       case MessagePriority::MEDIUM:
-        return MEDIUM_PRIORITY_THRESHOLD;
+        return medium_limit_.load(std::memory_order_relaxed);
       case MessagePriority::LOW:
       default:
-        return LOW_PRIORITY_THRESHOLD;
+        return low_limit_.load(std::memory_order_relaxed);
     }
   }
 
-  bool PublishInternal(PayloadVariant&& payload, uint32_t sender_id, uint64_t timestamp_us,
-                       MessagePriority priority) noexcept {
-    const PerformanceMode mode = performance_mode_.load(std::memory_order_relaxed);
+  /**
+   * @brief Admission check + claim of one ring slot.
+   *
+   * Drops (with statistics and error report) are handled here.
+   * @return Claimed node, or nullptr if the message was rejected
+   */
+  bool ReserveSlot(MessagePriority priority, PerformanceMode mode, uint32_t& prod_pos) noexcept {
     const bool bare_metal = (mode == PerformanceMode::BARE_METAL);
     const bool no_stats = bare_metal || (mode == PerformanceMode::NO_STATS);
 
@@ -1103,30 +3039,9 @@ class AsyncBus {
       }
     }
 
-    uint32_t prod_pos = 0U;
-    RingBufferNode* node = nullptr;
-
-#if MCCC_SINGLE_PRODUCER
-    prod_pos = producer_pos_.load(std::memory_order_relaxed);
-    node = &ring_buffer_[prod_pos & BUFFER_MASK];
-
-    uint32_t seq = node->sequence.load(MCCC_MO_ACQUIRE);
-    detail::AcquireFence();
-    if (seq != prod_pos) {
-      if (!no_stats) {
-        stats_.messages_dropped.fetch_add(1U, std::memory_order_relaxed);
-        UpdatePriorityDroppedStats(priority);
-        ReportError(BusError::QUEUE_FULL, msg_id);
-      }
-      return false;
-    }
-    producer_pos_.store(prod_pos + 1U, std::memory_order_relaxed);
-#else
-    do {
+    if constexpr (SingleProducer) {
       prod_pos = producer_pos_.load(std::memory_order_relaxed);
-      node = &ring_buffer_[prod_pos & BUFFER_MASK];
-
-      uint32_t seq = node->sequence.load(MCCC_MO_ACQUIRE);
+      uint32_t seq = NodeAt(prod_pos).sequence.load(MCCC_MO_ACQUIRE);
       detail::AcquireFence();
       if (seq != prod_pos) {
         if (!no_stats) {
@@ -1136,16 +3051,54 @@ class AsyncBus {
         }
         return false;
       }
+      producer_pos_.store(prod_pos + 1U, std::memory_order_relaxed);
+    } else {
+      do {
+        prod_pos = producer_pos_.load(std::memory_order_relaxed);
+        uint32_t seq = NodeAt(prod_pos).sequence.load(MCCC_MO_ACQUIRE);
+        detail::AcquireFence();
+        if (seq != prod_pos) {
+          if (!no_stats) {
+            stats_.messages_dropped.fetch_add(1U, std::memory_order_relaxed);
+            UpdatePriorityDroppedStats(priority);
+            ReportError(BusError::QUEUE_FULL, msg_id);
+          }
+          return false;
+        }
+
+      } while (
+          !producer_pos_.compare_exchange_weak(prod_pos, prod_pos + 1U, MCCC_MO_ACQ_REL, std::memory_order_relaxed));
+    }
+
+    return true;
+  }
+
+  bool PublishInternal(PayloadVariant&& payload, uint32_t sender_id, detail::HeaderStamp stamp,
+                       MessagePriority priority) noexcept {
+    const PerformanceMode mode = performance_mode_.load(std::memory_order_relaxed);
+    const bool no_stats = (mode == PerformanceMode::BARE_METAL) || (mode == PerformanceMode::NO_STATS);
+
+    if constexpr (HAS_CONFLATION) {
+      if (PublishConflated(payload, sender_id, stamp, priority, no_stats,
+                           std::make_index_sequence<std::variant_size<PayloadVariant>::value>{})) {
+        return true;
+      }
+    }
 
-    } while (!producer_pos_.compare_exchange_weak(prod_pos, prod_pos + 1U, MCCC_MO_ACQ_REL, std::memory_order_relaxed));
-#endif
+    uint32_t prod_pos = 0U;
+    if (!ReserveSlot(priority, mode, prod_pos)) {
+      return false;
+    }
 
+    NodeRef node = NodeAt(prod_pos);
     uint64_t assigned_id = next_msg_id_.fetch_add(1U, std::memory_order_relaxed);
-    node->envelope.header = MessageHeader{assigned_id, timestamp_us, sender_id, priority};
-    node->envelope.payload = std::move(payload);
+    node.envelope.header = MessageHeader{assigned_id, stamp.us, sender_id, priority};
+    SetHeaderNs(node.envelope.header, stamp.ns);
+    node.envelope.payload = std::move(payload);
 
     detail::ReleaseFence();
-    node->sequence.store(prod_pos + 1U, MCCC_MO_RELEASE);
+    node.sequence.store(prod_pos + 1U, MCCC_MO_RELEASE);
+    NotifyConsumer();
 
     if (!no_stats) {
       stats_.messages_published.fetch_add(1U, std::memory_order_relaxed);
@@ -1154,76 +3107,299 @@ class AsyncBus {
     return true;
   }
 
-  void DispatchMessage(const EnvelopeType& envelope) noexcept {
-    size_t type_idx = envelope.payload.index();
-    if (type_idx >= MCCC_MAX_MESSAGE_TYPES) {
-      return;
+  /**
+   * @brief Number of slots a batch starting at prod_pos may claim (0 = reject).
+   *
+   * Depth is first estimated from cached_consumer_pos_ and only refreshed from
+   * consumer_pos_ when the run would cross the limit. Since the consumer frees
+   * slots in order, a free last slot implies the whole run is free.
+   */
+  uint32_t ComputeBatchRun(uint32_t prod_pos, uint32_t count, uint32_t limit, BatchAdmission admission,
+                           bool no_stats) noexcept {
+    uint32_t depth = prod_pos - cached_consumer_pos_.load(std::memory_order_relaxed);
+    if ((depth > limit) || ((limit - depth) < count)) {
+      uint32_t real_cons = consumer_pos_.load(MCCC_MO_ACQUIRE);
+      cached_consumer_pos_.store(real_cons, std::memory_order_relaxed);
+      uint32_t real_depth = prod_pos - real_cons;
+      if (!no_stats) {
+        stats_.admission_recheck_count.fetch_add(1U, std::memory_order_relaxed);
+        if (depth > real_depth) {
+          stats_.stale_cache_depth_delta.fetch_add(depth - real_depth, std::memory_order_relaxed);
+        }
+      }
+      depth = real_depth;
     }
 
-    std::shared_lock<std::shared_mutex> lock(callback_mutex_);
+    uint32_t run = 0U;
+    if (depth < limit) {
+      run = ((limit - depth) < count) ? (limit - depth) : count;
+    }
+    if ((admission == BatchAdmission::ALL_OR_NOTHING) && (run < count)) {
+      return 0U;
+    }
 
-    const CallbackSlot& slot = callback_table_[type_idx];
-    if (slot.count == 0U) {
-      return;
+    while (run > 0U) {
+      uint32_t last_pos = prod_pos + run - 1U;
+      uint32_t seq = NodeAt(last_pos).sequence.load(MCCC_MO_ACQUIRE);
+      detail::AcquireFence();
+      if (seq == last_pos) {
+        break;
+      }
+      if (admission == BatchAdmission::ALL_OR_NOTHING) {
+        return 0U;
+      }
+      --run;
+    }
+    return run;
+  }
+
+  /** True if a batch element (PayloadVariant or alternative) is conflated. */
+  template <typename Elem>
+  static bool IsConflatedElement(const Elem& element) noexcept {
+    if constexpr (std::is_same<Elem, PayloadVariant>::value) {
+      return IsConflated(element);
+    } else {
+      (void)element;
+      return ConflationTraits<Elem>::KEYS != 0U;
+    }
+  }
+
+  template <typename ForwardIt>
+  uint32_t PublishBatchInternal(ForwardIt first, uint32_t count, uint32_t sender_id, detail::HeaderStamp stamp,
+                                MessagePriority priority, BatchAdmission admission) noexcept {
+    using Elem = std::decay_t<typename std::iterator_traits<ForwardIt>::value_type>;
+    constexpr bool MAY_CONFLATE =
+        HAS_CONFLATION && (std::is_same<Elem, PayloadVariant>::value || (ConflationTraits<Elem>::KEYS != 0U));
+    if constexpr (MAY_CONFLATE) {
+      uint32_t ring_count = 0U;
+      ForwardIt it = first;
+      for (uint32_t i = 0U; i < count; ++i, ++it) {
+        ring_count += IsConflatedElement(*it) ? 0U : 1U;
+      }
+      if (ring_count != count) {
+        return PublishBatchMixed(first, count, ring_count, sender_id, stamp, priority, admission);
+      }
+    }
+    return PublishBatchRing<false>(first, count, sender_id, stamp, priority, admission);
+  }
+
+  /**
+   * @brief Batch holding conflated elements: they go to their latest-value slots, the rest to one ring run.
+   *
+   * A ring copy of a conflated type would be delivered after a newer slot
+   * sample (slots drain ahead of the ring) and leave the consumer stale.
+   * Admission applies to the ring elements; conflated elements after the
+   * first ring element that did not fit are not published, so the result
+   * still covers a prefix of the batch.
+   */
+  template <typename ForwardIt>
+  uint32_t PublishBatchMixed(ForwardIt first, uint32_t count, uint32_t ring_count, uint32_t sender_id,
+                             detail::HeaderStamp stamp, MessagePriority priority, BatchAdmission admission) noexcept {
+    const uint32_t run = PublishBatchRing<true>(first, ring_count, sender_id, stamp, priority, admission);
+    if ((ring_count > 0U) && (run == 0U)) {
+      return 0U;
+    }
+    uint32_t published = run;
+    uint32_t ring_seen = 0U;
+    for (uint32_t i = 0U; i < count; ++i, ++first) {
+      if (!IsConflatedElement(*first)) {
+        if (ring_seen == run) {
+          break;
+        }
+        ++ring_seen;
+      } else if (PublishInternal(PayloadVariant(std::move(*first)), sender_id, stamp, priority)) {
+        ++published;
+      }
+    }
+    return published;
+  }
+
+  /** Ring part of a batch; SkipConflated steps over conflated elements (count excludes them). */
+  template <bool SkipConflated, typename ForwardIt>
+  uint32_t PublishBatchRing(ForwardIt first, uint32_t count, uint32_t sender_id, detail::HeaderStamp stamp,
+                            MessagePriority priority, BatchAdmission admission) noexcept {
+    if (count == 0U) {
+      return 0U;
+    }
+
+    const PerformanceMode mode = performance_mode_.load(std::memory_order_relaxed);
+    const bool bare_metal = (mode == PerformanceMode::BARE_METAL);
+    const bool no_stats = bare_metal || (mode == PerformanceMode::NO_STATS);
+
+    uint64_t msg_id = next_msg_id_.load(std::memory_order_relaxed);
+    if (msg_id >= (MSG_ID_WRAP_THRESHOLD - count)) {
+      if (!no_stats) {
+        ReportError(BusError::OVERFLOW_DETECTED, msg_id);
+      }
+      return 0U;
+    }
+
+    const uint32_t limit = bare_metal ? BUFFER_SIZE : GetThresholdForPriority(priority);
+    uint32_t prod_pos = 0U;
+    uint32_t run = 0U;
+
+    if constexpr (SingleProducer) {
+      prod_pos = producer_pos_.load(std::memory_order_relaxed);
+      run = ComputeBatchRun(prod_pos, count, limit, admission, no_stats);
+      if (run > 0U) {
+        producer_pos_.store(prod_pos + run, std::memory_order_relaxed);
+      }
+    } else {
+      bool reserved = false;
+      while (!reserved) {
+        prod_pos = producer_pos_.load(std::memory_order_relaxed);
+        run = ComputeBatchRun(prod_pos, count, limit, admission, no_stats);
+        if (run == 0U) {
+          // A stale prod_pos can make the depth look wrapped; retry if it moved.
+          if (producer_pos_.load(std::memory_order_relaxed) != prod_pos) {
+            continue;
+          }
+          break;
+        }
+        reserved = producer_pos_.compare_exchange_weak(prod_pos, prod_pos + run, MCCC_MO_ACQ_REL,
+                                                       std::memory_order_relaxed);
+      }
+    }
+
+    if (run > 0U) {
+      uint64_t first_id = next_msg_id_.fetch_add(run, std::memory_order_relaxed);
+      for (uint32_t i = 0U; i < run; ++i) {
+        NodeRef node = NodeAt(prod_pos + i);
+        node.envelope.header = MessageHeader{first_id + i, stamp.us, sender_id, priority};
+        SetHeaderNs(node.envelope.header, stamp.ns);
+        if constexpr (SkipConflated) {
+          while (IsConflatedElement(*first)) {
+            ++first;
+          }
+        }
+        node.envelope.payload = std::move(*first);
+        ++first;
+
+        detail::ReleaseFence();
+        node.sequence.store(prod_pos + i + 1U, MCCC_MO_RELEASE);
+      }
+      NotifyConsumer();
     }
 
-    for (uint32_t i = 0U; i < MCCC_MAX_CALLBACKS_PER_TYPE; ++i) {
-      if (slot.entries[i].active) {
-        slot.entries[i].callback(envelope);
+    if (!no_stats) {
+      if (run > 0U) {
+        stats_.messages_published.fetch_add(run, std::memory_order_relaxed);
+        UpdatePriorityPublishedStats(priority, run);
+      }
+      if (run < count) {
+        stats_.messages_dropped.fetch_add(count - run, std::memory_order_relaxed);
+        UpdatePriorityDroppedStats(priority, count - run);
+        ReportError(BusError::QUEUE_FULL, msg_id);
       }
     }
+    return run;
   }
 
-  void DispatchMessageBareMetal(const EnvelopeType& envelope) noexcept {
+  static void DispatchMessage(const CallbackTable& table, const EnvelopeType& envelope) noexcept {
     size_t type_idx = envelope.payload.index();
     if (type_idx >= MCCC_MAX_MESSAGE_TYPES) {
       return;
     }
 
-    const CallbackSlot& slot = callback_table_[type_idx];
-    if (slot.count == 0U) {
+    const CallbackSlot& slot = table[type_idx];
+    if (slot.filtered_count == 0U) {
+      for (uint32_t i = 0U; i < slot.count; ++i) {
+        slot.callbacks[i]->callback(envelope);
+      }
       return;
     }
 
-    for (uint32_t i = 0U; i < MCCC_MAX_CALLBACKS_PER_TYPE; ++i) {
-      if (slot.entries[i].active) {
-        slot.entries[i].callback(envelope);
+    // Visit only the callbacks indexed under this message's key buckets, in subscribe order
+    constexpr uint32_t kLowBits = MCCC_FILTER_BUCKETS - 1U;
+    const uint32_t sender = envelope.header.sender_id;
+    const uint32_t key = (slot.payload_key != nullptr) ? slot.payload_key(envelope) : 0U;
+    CallbackMask pending = slot.unfiltered | slot.sender_buckets[sender & kLowBits] | slot.key_buckets[key & kLowBits];
+    while (pending != 0U) {
+      const uint32_t i = static_cast<uint32_t>(__builtin_ctzll(pending));
+      pending &= pending - 1U;
+      const Entry<CallbackType>& entry = *slot.callbacks[i];
+      const uint32_t filter_key = (entry.filter.key == FilterKey::PAYLOAD_KEY) ? key : sender;
+      if ((entry.filter.key == FilterKey::NONE) || entry.filter.Matches(filter_key)) {
+        entry.callback(envelope);
       }
     }
   }
 
-  void UpdatePriorityPublishedStats(MessagePriority priority) noexcept {
+  void UpdatePriorityPublishedStats(MessagePriority priority, uint64_t count = 1U) noexcept {
     switch (priority) {
       case MessagePriority::HIGH:
-        stats_.high_priority_published.fetch_add(1U, std::memory_order_relaxed);
+        stats_.high_priority_published.fetch_add(count, std::memory_order_relaxed);
         break;
       case MessagePriority::MEDIUM:
-        stats_.medium_priority_published.fetch_add(1U, std::memory_order_relaxed);
+        stats_.medium_priority_published.fetch_add(count, std::memory_order_relaxed);
         break;
       case MessagePriority::LOW:
-        stats_.low_priority_published.fetch_add(1U, std::memory_order_relaxed);
+        stats_.low_priority_published.fetch_add(count, std::memory_order_relaxed);
         break;
       default:
         break;
     }
   }
 
-  void UpdatePriorityDroppedStats(MessagePriority priority) noexcept {
+  void UpdatePriorityDroppedStats(MessagePriority priority, uint64_t count = 1U) noexcept {
     switch (priority) {
       case MessagePriority::HIGH:
-        stats_.high_priority_dropped.fetch_add(1U, std::memory_order_relaxed);
+        stats_.high_priority_dropped.fetch_add(count, std::memory_order_relaxed);
         break;
       case MessagePriority::MEDIUM:
-        stats_.medium_priority_dropped.fetch_add(1U, std::memory_order_relaxed);
+        stats_.medium_priority_dropped.fetch_add(count, std::memory_order_relaxed);
         break;
       case MessagePriority::LOW:
-        stats_.low_priority_dropped.fetch_add(1U, std::memory_order_relaxed);
+        stats_.low_priority_dropped.fetch_add(count, std::memory_order_relaxed);
         break;
       default:
         break;
     }
   }
 
+  void CommitSlot(EnvelopeType& envelope, std::atomic<uint32_t>& sequence, uint32_t pos, uint32_t sender_id,
+                  detail::HeaderStamp stamp, MessagePriority priority) noexcept {
+    const PerformanceMode mode = performance_mode_.load(std::memory_order_relaxed);
+    const bool no_stats = (mode == PerformanceMode::BARE_METAL) || (mode == PerformanceMode::NO_STATS);
+
+    uint64_t assigned_id = next_msg_id_.fetch_add(1U, std::memory_order_relaxed);
+    envelope.header = MessageHeader{assigned_id, stamp.us, sender_id, priority};
+    SetHeaderNs(envelope.header, stamp.ns);
+
+    detail::ReleaseFence();
+    sequence.store(pos + 1U, MCCC_MO_RELEASE);
+    NotifyConsumer();
+
+    if (!no_stats) {
+      stats_.messages_published.fetch_add(1U, std::memory_order_relaxed);
+      UpdatePriorityPublishedStats(priority);
+    }
+  }
+
+  void CancelSlot(EnvelopeType& envelope, std::atomic<uint32_t>& sequence, uint32_t pos) noexcept {
+    envelope.header.msg_id = CANCELLED_MSG_ID;
+    detail::ReleaseFence();
+    sequence.store(pos + 1U, MCCC_MO_RELEASE);
+    NotifyConsumer();
+  }
+
+  /**
+   * @brief Wake a consumer parked in ProcessBatchWait().
+   *
+   * One relaxed load when blocking waits were never used; otherwise a fence
+   * and a flag check, with the mutex + notify only while the consumer sleeps.
+   */
+  void NotifyConsumer() noexcept {
+    if (!wait_enabled_.load(std::memory_order_relaxed)) {
+      return;
+    }
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (consumer_sleeping_.load(std::memory_order_relaxed)) {
+      std::lock_guard<std::mutex> lock(wait_mutex_);
+      wait_cv_.notify_one();
+    }
+  }
+
   void ReportError(BusError error, uint64_t msg_id) const noexcept {
     ErrorCallback cb = error_callback_.load(std::memory_order_acquire);
     if (cb != nullptr) {
@@ -1231,23 +3407,80 @@ class AsyncBus {
     }
   }
 
-  static uint64_t GetTimestampUs() noexcept {
-    auto now = std::chrono::steady_clock::now();
-    auto us = std::chrono::duration_cast<std::chrono::microseconds>(now.time_since_epoch());
-    return static_cast<uint64_t>(us.count());
+  /** One clock read for both header timestamps. */
+  static detail::HeaderStamp StampNow() noexcept {
+    const uint64_t now_ns = Clock::NowNs();
+    return detail::HeaderStamp{now_ns / 1000U, now_ns};
   }
 
+  /** User-supplied timestamp_us; the clock is read only if the header has timestamp_ns. */
+  static detail::HeaderStamp StampWithUs(uint64_t timestamp_us) noexcept {
+#if MCCC_HEADER_HAS_TIMESTAMP_NS
+    return detail::HeaderStamp{timestamp_us, Clock::NowNs()};
+#else
+    return detail::HeaderStamp{timestamp_us, 0U};
+#endif
+  }
+
+  static void SetHeaderNs(MessageHeader& header, uint64_t timestamp_ns) noexcept {
+#if MCCC_HEADER_HAS_TIMESTAMP_NS
+    header.timestamp_ns = timestamp_ns;
+#else
+    (void)header;
+    (void)timestamp_ns;
+#endif
+  }
+
+  /** Consumer only: one relaxed histogram increment per dispatched message. */
+  void RecordDispatchLatency(const EnvelopeType& envelope) noexcept {
+#if MCCC_ENABLE_LATENCY_HISTOGRAM
+    const size_t type_index = envelope.payload.index();
+    const uint32_t priority = static_cast<uint32_t>(envelope.header.priority);
+    if ((type_index < MCCC_MAX_MESSAGE_TYPES) && (priority < 3U)) {
+      const uint64_t now = Clock::NowNs();
+      const uint64_t stamped = envelope.header.timestamp_ns;
+      latency_[type_index][priority].Record((now > stamped) ? (now - stamped) : 0U);
+    }
+#else
+    (void)envelope;
+#endif
+  }
+
+#if MCCC_COMPACT_RING
+  MCCC_ALIGN_CACHELINE std::array<std::atomic<uint32_t>, BUFFER_SIZE> sequences_;
+  MCCC_ALIGN_CACHELINE std::array<EnvelopeType, BUFFER_SIZE> envelopes_;
+#else
   MCCC_ALIGN_CACHELINE std::array<RingBufferNode, BUFFER_SIZE> ring_buffer_;
+#endif
   MCCC_ALIGN_CACHELINE std::atomic<uint32_t> producer_pos_;
   std::atomic<uint32_t> cached_consumer_pos_{0U};
+  std::atomic<uint32_t> low_limit_{LOW_PRIORITY_THRESHOLD};  // Rewritten only at controller intervals
+  std::atomic<uint32_t> medium_limit_{MEDIUM_PRIORITY_THRESHOLD};
   MCCC_ALIGN_CACHELINE std::atomic<uint32_t> consumer_pos_;
   MCCC_ALIGN_CACHELINE std::atomic<uint64_t> next_msg_id_;
   size_t next_callback_id_{1U};
   MCCC_ALIGN_CACHELINE BusStatistics stats_;
-  std::array<CallbackSlot, MCCC_MAX_MESSAGE_TYPES> callback_table_;
-  mutable std::shared_mutex callback_mutex_;
+#if MCCC_ENABLE_LATENCY_HISTOGRAM
+  MCCC_ALIGN_CACHELINE std::array<std::array<LatencyHistogram, 3U>, MCCC_MAX_MESSAGE_TYPES> latency_{};
+#endif
+  std::array<EntryStorage<CallbackType>, MCCC_MAX_MESSAGE_TYPES> callback_storage_;
+  std::array<EntryStorage<BatchCallbackType>, MCCC_MAX_MESSAGE_TYPES> batch_callback_storage_;
+  std::array<const EnvelopeType*, BATCH_PROCESS_SIZE> batch_run_{};
+  ConflationStorage conflation_{};
+  std::array<CallbackTable, 2U> callback_tables_{};
+  std::atomic<const CallbackTable*> active_table_{&callback_tables_[0]};
+  MCCC_ALIGN_CACHELINE std::atomic<uint64_t> dispatch_epoch_{0U};
+  std::mutex callback_mutex_;
+  std::atomic<bool> wait_enabled_{false};
+  MCCC_ALIGN_CACHELINE std::atomic<bool> consumer_sleeping_{false};
+  std::atomic<bool> wakeup_requested_{false};
+  std::mutex wait_mutex_;
+  std::condition_variable wait_cv_;
   std::atomic<ErrorCallback> error_callback_{nullptr};
   std::atomic<PerformanceMode> performance_mode_{PerformanceMode::FULL_FEATURED};
+  AdmissionState admission_{};
+  std::atomic<uint64_t> admission_sojourn_us_{0U};
+  std::atomic<uint64_t> admission_drain_rate_{0U};
 };
 
 }  // namespace mccc
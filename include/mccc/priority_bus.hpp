@@ -0,0 +1,290 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2024 liudegui
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * @file priority_bus.hpp
+ * @brief Message bus with one ring per MessagePriority and ordered dequeue.
+ *
+ * In AsyncBus, priority only controls admission: an admitted HIGH message
+ * still waits behind everything queued before it. PriorityBus keeps a
+ * separate AsyncBus ring per priority, so HIGH messages never wait behind a
+ * MEDIUM/LOW backlog. The consumer drains the rings in strict priority order
+ * or by weighted round-robin.
+ */
+
+#ifndef MCCC_PRIORITY_BUS_HPP_
+#define MCCC_PRIORITY_BUS_HPP_
+
+#include "mccc/mccc.hpp"
+
+#include <array>
+#include <memory>
+#include <utility>
+
+namespace mccc {
+
+/**
+ * @brief Order in which PriorityBus::ProcessBatch drains its rings.
+ */
+enum class DequeuePolicy : uint8_t {
+  STRICT = 0U,   /**< HIGH first; lower rings in slices, HIGH re-polled between slices */
+  WEIGHTED = 1U  /**< Round-robin, up to weight[p] messages per ring per round */
+};
+
+/**
+ * @brief Per-priority ring bus layered on AsyncBus.
+ *
+ * Usage:
+ * @code
+ * using CtrlBus = mccc::PriorityBus<MyPayload, 4096U>;
+ * CtrlBus bus;                                  // STRICT
+ * bus.Subscribe<EStop>([](const auto& env) { ... });
+ * bus.PublishWithPriority(EStop{}, 1U, mccc::MessagePriority::HIGH);
+ * bus.ProcessBatch();                           // HIGH ring first
+ * @endcode
+ *
+ * Admission thresholds and per-priority statistics apply per ring, relative
+ * to that ring's depth. Message IDs are unique per ring, not across rings.
+ * Single consumer: all rings are drained by the thread calling ProcessBatch().
+ *
+ * @tparam PayloadVariant A std::variant<...> of user-defined message types.
+ * @tparam Depth          Queue depth of each priority ring (power of 2).
+ * @tparam Clock          Header timestamp source of every ring (see AsyncBus).
+ */
+template <typename PayloadVariant, uint32_t Depth = static_cast<uint32_t>(MCCC_QUEUE_DEPTH),
+          typename Clock = SteadyClock>
+class PriorityBus {
+ public:
+  using RingType = AsyncBus<PayloadVariant, Depth, Clock>;
+  using EnvelopeType = MessageEnvelope<PayloadVariant>;
+  using PerformanceMode = typename RingType::PerformanceMode;
+
+  static constexpr uint32_t PRIORITY_LEVELS = 3U;
+  static constexpr uint32_t BATCH_PROCESS_SIZE = RingType::BATCH_PROCESS_SIZE;
+  static constexpr uint32_t STRICT_SLICE = 32U; /**< Lower-ring messages between two HIGH polls (STRICT) */
+
+  /** Dequeue weights indexed by MessagePriority (LOW, MEDIUM, HIGH). */
+  using Weights = std::array<uint32_t, PRIORITY_LEVELS>;
+
+  /**
+   * @brief Subscription handle spanning the priority rings.
+   */
+  struct PrioritySubscriptionHandle {
+    std::array<SubscriptionHandle, PRIORITY_LEVELS> handles; /**< Per-ring handle */
+    bool valid;                                              /**< Every ring accepted the callback */
+  };
+
+  /**
+   * @param policy  Dequeue order
+   * @param weights Messages per round for WEIGHTED, indexed by MessagePriority (0 is treated as 1)
+   */
+  explicit PriorityBus(DequeuePolicy policy = DequeuePolicy::STRICT, Weights weights = Weights{1U, 4U, 16U})
+      : policy_(policy), weights_(weights) {
+    for (auto& w : weights_) {
+      if (w == 0U) {
+        w = 1U;
+      }
+    }
+    for (auto& ring : rings_) {
+      ring = std::make_unique<RingType>();
+    }
+  }
+
+  ~PriorityBus() = default;
+  PriorityBus(const PriorityBus&) = delete;
+  PriorityBus& operator=(const PriorityBus&) = delete;
+  PriorityBus(PriorityBus&&) = delete;
+  PriorityBus& operator=(PriorityBus&&) = delete;
+
+  // ======================== Publish API ========================
+
+  bool Publish(PayloadVariant&& payload, uint32_t sender_id) noexcept {
+    return Ring(MessagePriority::MEDIUM).Publish(std::move(payload), sender_id);
+  }
+
+  bool PublishWithPriority(PayloadVariant&& payload, uint32_t sender_id, MessagePriority priority) noexcept {
+    return Ring(priority).PublishWithPriority(std::move(payload), sender_id, priority);
+  }
+
+  bool PublishFast(PayloadVariant&& payload, uint32_t sender_id, uint64_t timestamp_us) noexcept {
+    return Ring(MessagePriority::MEDIUM).PublishFast(std::move(payload), sender_id, timestamp_us);
+  }
+
+  // ======================== Subscribe API ========================
+
+  /**
+   * @brief Subscribe on every priority ring.
+   *
+   * The callable is copied once per ring, so it must be copy-constructible.
+   */
+  template <typename T, typename Func>
+  PrioritySubscriptionHandle Subscribe(Func&& func) {
+    PrioritySubscriptionHandle result{};
+    result.valid = true;
+    for (uint32_t i = 0U; i < PRIORITY_LEVELS; ++i) {
+      result.handles[i] = rings_[i]->template Subscribe<T>(typename std::decay<Func>::type(func));
+      if (result.handles[i].callback_id == static_cast<size_t>(-1)) {
+        result.valid = false;
+      }
+    }
+    return result;
+  }
+
+  /**
+   * @return true if at least one ring removed the callback
+   */
+  bool Unsubscribe(const PrioritySubscriptionHandle& handle) noexcept {
+    bool removed = false;
+    for (uint32_t i = 0U; i < PRIORITY_LEVELS; ++i) {
+      removed = rings_[i]->Unsubscribe(handle.handles[i]) || removed;
+    }
+    return removed;
+  }
+
+  // ======================== Processing API ========================
+
+  /**
+   * @brief Dispatch up to BATCH_PROCESS_SIZE messages across the rings.
+   *
+   * STRICT: HIGH is drained first; MEDIUM and LOW are processed in slices of
+   * STRICT_SLICE with HIGH polled again before each slice, so a HIGH message
+   * waits for at most one slice of lower-priority callbacks.
+   * WEIGHTED: each round takes up to weight[p] messages from each ring, HIGH
+   * first, until the budget is spent or all rings are empty.
+   *
+   * Messages skipped for ExpiryTraits count against the budget here, so at
+   * most BATCH_PROCESS_SIZE callbacks run per call; as with
+   * AsyncBus::ProcessBatch() the returned count includes them and can
+   * exceed BATCH_PROCESS_SIZE by the expired slots of the last ring visited.
+   *
+   * @return Number of messages processed, expired ones included
+   */
+  uint32_t ProcessBatch() noexcept {
+    return (policy_ == DequeuePolicy::STRICT) ? ProcessStrict() : ProcessWeighted();
+  }
+
+  // ======================== Status API ========================
+
+  RingType& Ring(MessagePriority priority) noexcept { return *rings_[LevelOf(priority)]; }
+  const RingType& Ring(MessagePriority priority) const noexcept { return *rings_[LevelOf(priority)]; }
+
+  /** @brief Sum of all ring depths. */
+  uint32_t QueueDepth() const noexcept {
+    uint32_t depth = 0U;
+    for (const auto& ring : rings_) {
+      depth += ring->QueueDepth();
+    }
+    return depth;
+  }
+
+  uint32_t QueueDepth(MessagePriority priority) const noexcept { return Ring(priority).QueueDepth(); }
+
+  /** @brief Statistics aggregated over all rings (per-priority counters stay separate). */
+  BusStatisticsSnapshot GetStatistics() const noexcept {
+    BusStatisticsSnapshot total{};
+    for (const auto& ring : rings_) {
+      AccumulateStatistics(total, ring->GetStatistics());
+    }
+    return total;
+  }
+
+  void ResetStatistics() noexcept {
+    for (auto& ring : rings_) {
+      ring->ResetStatistics();
+    }
+  }
+
+  void SetPerformanceMode(PerformanceMode mode) noexcept {
+    for (auto& ring : rings_) {
+      ring->SetPerformanceMode(mode);
+    }
+  }
+
+  void SetErrorCallback(ErrorCallback callback) noexcept {
+    for (auto& ring : rings_) {
+      ring->SetErrorCallback(callback);
+    }
+  }
+
+ private:
+  static uint32_t LevelOf(MessagePriority priority) noexcept {
+    const auto level = static_cast<uint32_t>(priority);
+    return (level < PRIORITY_LEVELS) ? level : static_cast<uint32_t>(MessagePriority::LOW);
+  }
+
+  uint32_t ProcessStrict() noexcept {
+    RingType& high = Ring(MessagePriority::HIGH);
+    RingType& medium = Ring(MessagePriority::MEDIUM);
+    RingType& low = Ring(MessagePriority::LOW);
+
+    uint32_t processed = 0U;
+    while (processed < BATCH_PROCESS_SIZE) {
+      uint32_t budget = BATCH_PROCESS_SIZE - processed;
+      uint32_t n = high.ProcessBatch(budget);
+      if (n == 0U) {
+        const uint32_t slice = (budget < STRICT_SLICE) ? budget : STRICT_SLICE;
+        n = medium.ProcessBatch(slice);
+        if (n == 0U) {
+          n = low.ProcessBatch(slice);
+        }
+      }
+      if (n == 0U) {
+        break;
+      }
+      processed += n;
+    }
+    return processed;
+  }
+
+  uint32_t ProcessWeighted() noexcept {
+    static constexpr std::array<MessagePriority, PRIORITY_LEVELS> kOrder{MessagePriority::HIGH, MessagePriority::MEDIUM,
+                                                                        MessagePriority::LOW};
+    uint32_t processed = 0U;
+    while (processed < BATCH_PROCESS_SIZE) {
+      uint32_t round = 0U;
+      for (MessagePriority priority : kOrder) {
+        if ((processed + round) >= BATCH_PROCESS_SIZE) {
+          break;  // expired skips can return more than the budget asked for
+        }
+        const uint32_t budget = BATCH_PROCESS_SIZE - processed - round;
+        const uint32_t weight = weights_[LevelOf(priority)];
+        round += Ring(priority).ProcessBatch((weight < budget) ? weight : budget);
+      }
+      if (round == 0U) {
+        break;
+      }
+      processed += round;
+    }
+    return processed;
+  }
+
+  const DequeuePolicy policy_;
+  Weights weights_;
+  std::array<std::unique_ptr<RingType>, PRIORITY_LEVELS> rings_;
+};
+
+}  // namespace mccc
+
+#endif  // MCCC_PRIORITY_BUS_HPP_
@@ -0,0 +1,303 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2024 liudegui
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file sharded_bus.hpp
+ * @brief Multi-consumer bus: K AsyncBus shards, one consumer thread per shard.
+ *
+ * Each published message is routed to exactly one shard (by variant index,
+ * by a user key, or round-robin). Each shard is an independent MPSC ring with
+ * its own consumer, so dispatch scales past one core while messages with the
+ * same routing key keep their publish order.
+ */
+
+#ifndef MCCC_SHARDED_BUS_HPP_
+#define MCCC_SHARDED_BUS_HPP_
+
+#include "mccc/mccc.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <utility>
+
+namespace mccc {
+
+/**
+ * @brief How ShardedBus picks the shard of a published message.
+ */
+enum class ShardRouting : uint8_t {
+  BY_TYPE = 0U,     /**< payload.index() % NumShards: one shard per message type */
+  BY_KEY = 1U,      /**< KeyExtractor(payload, sender_id) % NumShards: per-key ordering */
+  ROUND_ROBIN = 2U  /**< Per-bus rotation over all producers: no ordering across messages */
+};
+
+/**
+ * @brief Sharded multi-consumer message bus layered on AsyncBus.
+ *
+ * Usage:
+ * @code
+ * using MyShardedBus = mccc::ShardedBus<MyPayload, 4U, 16384U>;
+ * MyShardedBus bus(mccc::ShardRouting::BY_KEY,
+ *                  [](const MyPayload&, uint32_t sender_id) noexcept { return sender_id; });
+ * bus.Subscribe<SensorData>([](const auto& env) { ... });
+ * bus.Start();                      // one consumer thread per shard
+ * bus.Publish(SensorData{...}, 3);  // routed to shard 3 % 4
+ * bus.Stop();
+ * @endcode
+ *
+ * Thread safety: with BY_TYPE every message type lives on a single shard, so a
+ * callback only ever runs on that shard's consumer thread. With BY_KEY and
+ * ROUND_ROBIN a callback is installed on every shard and may run concurrently
+ * on several consumer threads; it must be thread-safe.
+ *
+ * @tparam PayloadVariant A std::variant<...> of user-defined message types.
+ * @tparam NumShards      Number of internal rings / consumer threads.
+ * @tparam Depth          Queue depth of each shard (power of 2).
+ * @tparam Clock          Header timestamp source of every ring (see AsyncBus).
+ */
+template <typename PayloadVariant, uint32_t NumShards, uint32_t Depth = static_cast<uint32_t>(MCCC_QUEUE_DEPTH),
+          typename Clock = SteadyClock>
+class ShardedBus {
+  static_assert(NumShards > 0U, "ShardedBus needs at least one shard");
+
+ public:
+  using ShardType = AsyncBus<PayloadVariant, Depth, Clock>;
+  using EnvelopeType = MessageEnvelope<PayloadVariant>;
+  using PerformanceMode = typename ShardType::PerformanceMode;
+  using KeyExtractor = uint32_t (*)(const PayloadVariant& payload, uint32_t sender_id) noexcept;
+
+  static constexpr uint32_t SHARD_COUNT = NumShards;
+  static constexpr uint32_t IDLE_PARK_MS = 100U; /**< Upper bound on one idle park of a consumer thread */
+
+  /**
+   * @brief Subscription handle spanning shards (one entry per shard).
+   */
+  struct ShardedSubscriptionHandle {
+    std::array<SubscriptionHandle, NumShards> handles; /**< Per-shard handle (callback_id -1 = not subscribed) */
+    bool valid;                                        /**< Every shard carrying the type accepted the callback */
+  };
+
+  /**
+   * @param routing Routing policy
+   * @param key     Key extractor for ShardRouting::BY_KEY (BY_KEY without a key falls back to BY_TYPE)
+   */
+  explicit ShardedBus(ShardRouting routing = ShardRouting::BY_TYPE, KeyExtractor key = nullptr)
+      : routing_((routing == ShardRouting::BY_KEY && key == nullptr) ? ShardRouting::BY_TYPE : routing),
+        key_extractor_(key) {
+    for (auto& shard : shards_) {
+      shard = std::make_unique<ShardType>();
+    }
+  }
+
+  ~ShardedBus() { Stop(); }
+
+  ShardedBus(const ShardedBus&) = delete;
+  ShardedBus& operator=(const ShardedBus&) = delete;
+  ShardedBus(ShardedBus&&) = delete;
+  ShardedBus& operator=(ShardedBus&&) = delete;
+
+  // ======================== Publish API ========================
+
+  bool Publish(PayloadVariant&& payload, uint32_t sender_id) noexcept {
+    return Route(payload, sender_id).Publish(std::move(payload), sender_id);
+  }
+
+  bool PublishWithPriority(PayloadVariant&& payload, uint32_t sender_id, MessagePriority priority) noexcept {
+    return Route(payload, sender_id).PublishWithPriority(std::move(payload), sender_id, priority);
+  }
+
+  bool PublishFast(PayloadVariant&& payload, uint32_t sender_id, uint64_t timestamp_us) noexcept {
+    return Route(payload, sender_id).PublishFast(std::move(payload), sender_id, timestamp_us);
+  }
+
+  /**
+   * @brief Shard index a message would be routed to.
+   */
+  uint32_t ShardFor(const PayloadVariant& payload, uint32_t sender_id) const noexcept {
+    switch (routing_) {
+      case ShardRouting::BY_KEY:
+        return key_extractor_(payload, sender_id) % NumShards;
+      case ShardRouting::ROUND_ROBIN:
+        return next_shard_.fetch_add(1U, std::memory_order_relaxed) % NumShards;
+      case ShardRouting::BY_TYPE:
+      default:
+        return static_cast<uint32_t>(payload.index()) % NumShards;
+    }
+  }
+
+  // ======================== Subscribe API ========================
+
+  /**
+   * @brief Subscribe on every shard that can carry T.
+   *
+   * The callable is copied once per shard, so it must be copy-constructible.
+   */
+  template <typename T, typename Func>
+  ShardedSubscriptionHandle Subscribe(Func&& func) {
+    ShardedSubscriptionHandle result{};
+    result.valid = true;
+    const uint32_t only_shard = TypeShard<T>();
+    for (uint32_t i = 0U; i < NumShards; ++i) {
+      result.handles[i] = SubscriptionHandle{VariantIndex<T, PayloadVariant>::value, static_cast<size_t>(-1)};
+      if ((routing_ == ShardRouting::BY_TYPE) && (i != only_shard)) {
+        continue;
+      }
+      result.handles[i] = shards_[i]->template Subscribe<T>(typename std::decay<Func>::type(func));
+      if (result.handles[i].callback_id == static_cast<size_t>(-1)) {
+        result.valid = false;
+      }
+    }
+    return result;
+  }
+
+  /**
+   * @brief Unsubscribe from all shards.
+   * @return true if at least one shard removed the callback
+   */
+  bool Unsubscribe(const ShardedSubscriptionHandle& handle) noexcept {
+    bool removed = false;
+    for (uint32_t i = 0U; i < NumShards; ++i) {
+      if (handle.handles[i].callback_id != static_cast<size_t>(-1)) {
+        removed = shards_[i]->Unsubscribe(handle.handles[i]) || removed;
+      }
+    }
+    return removed;
+  }
+
+  // ======================== Processing API ========================
+
+  /**
+   * @brief Start one consumer thread per shard.
+   *
+   * Idle consumers park in ProcessBatchWait() instead of busy-polling.
+   */
+  void Start() {
+    if (running_.exchange(true, std::memory_order_acq_rel)) {
+      return;
+    }
+    for (uint32_t i = 0U; i < NumShards; ++i) {
+      consumers_[i] = std::thread([this, i]() { ConsumerLoop(i); });
+    }
+  }
+
+  /**
+   * @brief Stop consumer threads after draining the queued messages.
+   */
+  void Stop() {
+    if (!running_.exchange(false, std::memory_order_acq_rel)) {
+      return;
+    }
+    for (auto& shard : shards_) {
+      shard->Wakeup();
+    }
+    for (auto& consumer : consumers_) {
+      if (consumer.joinable()) {
+        consumer.join();
+      }
+    }
+  }
+
+  bool IsRunning() const noexcept { return running_.load(std::memory_order_acquire); }
+
+  /**
+   * @brief Process one batch on a shard (manual mode, without Start()).
+   *
+   * Must only be called by that shard's single consumer.
+   */
+  uint32_t ProcessShard(uint32_t shard) noexcept { return shards_[shard]->ProcessBatch(); }
+
+  ShardType& Shard(uint32_t shard) noexcept { return *shards_[shard]; }
+  const ShardType& Shard(uint32_t shard) const noexcept { return *shards_[shard]; }
+
+  // ======================== Status API ========================
+
+  /** @brief Sum of all shard depths. */
+  uint32_t QueueDepth() const noexcept {
+    uint32_t depth = 0U;
+    for (const auto& shard : shards_) {
+      depth += shard->QueueDepth();
+    }
+    return depth;
+  }
+
+  /** @brief Statistics aggregated over all shards. */
+  BusStatisticsSnapshot GetStatistics() const noexcept {
+    BusStatisticsSnapshot total{};
+    for (const auto& shard : shards_) {
+      AccumulateStatistics(total, shard->GetStatistics());
+    }
+    return total;
+  }
+
+  void ResetStatistics() noexcept {
+    for (auto& shard : shards_) {
+      shard->ResetStatistics();
+    }
+  }
+
+  void SetPerformanceMode(PerformanceMode mode) noexcept {
+    for (auto& shard : shards_) {
+      shard->SetPerformanceMode(mode);
+    }
+  }
+
+  void SetErrorCallback(ErrorCallback callback) noexcept {
+    for (auto& shard : shards_) {
+      shard->SetErrorCallback(callback);
+    }
+  }
+
+ private:
+  template <typename T>
+  static constexpr uint32_t TypeShard() noexcept {
+    return static_cast<uint32_t>(VariantIndex<T, PayloadVariant>::value) % NumShards;
+  }
+
+  ShardType& Route(const PayloadVariant& payload, uint32_t sender_id) noexcept {
+    return *shards_[ShardFor(payload, sender_id)];
+  }
+
+  void ConsumerLoop(uint32_t shard) noexcept {
+    ShardType& bus = *shards_[shard];
+    while (running_.load(std::memory_order_acquire)) {
+      (void)bus.ProcessBatchWait(std::chrono::milliseconds(IDLE_PARK_MS));
+    }
+    while (bus.ProcessBatch() > 0U) {}
+  }
+
+  const ShardRouting routing_;
+  const KeyExtractor key_extractor_;
+  std::array<std::unique_ptr<ShardType>, NumShards> shards_;
+  std::array<std::thread, NumShards> consumers_;
+  std::atomic<bool> running_{false};
+  /** ROUND_ROBIN cursor: owned by this bus so instances rotate independently */
+  MCCC_ALIGN_CACHELINE mutable std::atomic<uint32_t> next_shard_{0U};
+};
+
+}  // namespace mccc
+
+#endif  // MCCC_SHARDED_BUS_HPP_
@@ -0,0 +1,475 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2024 liudegui
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * @file shm_bus.hpp
+ * @brief Inter-process AsyncBus variant over a POSIX shared-memory segment.
+ *
+ * The ring, its sequence numbers, the message id counter and the statistics
+ * live in a shm_open()/mmap() segment, so producers in other processes
+ * publish with the same lock-free CAS path AsyncBus uses in-process. The
+ * segment starts with a layout version and a hash of the PayloadVariant
+ * type list; Attach() rejects a segment built for a different layout.
+ * Callbacks are local to the consumer process.
+ *
+ * Only trivially-copyable PayloadVariants can cross the process boundary.
+ * Always multi-producer (MCCC_SINGLE_PRODUCER does not apply across
+ * processes). A producer that dies between claiming and publishing a slot
+ * stalls the consumer at that slot, as with a stalled in-process producer.
+ */
+
+#ifndef MCCC_SHM_BUS_HPP_
+#define MCCC_SHM_BUS_HPP_
+
+#include "mccc/mccc.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+
+#include <array>
+#include <new>
+
+namespace mccc {
+
+/**
+ * @brief Result of ShmBus::Create() / ShmBus::Attach().
+ */
+enum class ShmError : uint8_t {
+  OK = 0U,
+  ALREADY_OPEN = 1U,    /**< This object is already bound to a segment */
+  OPEN_FAILED = 2U,     /**< shm_open() / ftruncate() failed (see errno) */
+  MMAP_FAILED = 3U,     /**< mmap() failed (see errno) */
+  NOT_READY = 4U,       /**< Segment exists but its creator has not finished initializing it; retry */
+  LAYOUT_MISMATCH = 5U, /**< Different magic, layout version, depth or slot size */
+  TYPE_MISMATCH = 6U,   /**< Segment was created for a different PayloadVariant */
+  EXISTS = 7U           /**< Create(): a segment with this name exists (live or stale); see ShmCreate::REPLACE */
+};
+
+/**
+ * @brief What ShmBus::Create() does when the name is already taken.
+ */
+enum class ShmCreate : uint8_t {
+  EXCLUSIVE = 0U, /**< Fail with ShmError::EXISTS (default: never takes over another consumer's segment) */
+  REPLACE = 1U    /**< Unlink the existing name first, e.g. a stale segment left by a crashed consumer */
+};
+
+/**
+ * @brief Multi-process MPSC bus whose ring lives in POSIX shared memory.
+ *
+ * Usage:
+ * @code
+ *   // consumer process (owns the segment)
+ *   mccc::ShmBus<Payload> bus;
+ *   if (bus.Create("/sensor_bus") != mccc::ShmError::OK) { ... }
+ *   bus.Subscribe<Imu>([](const auto& env) { ... });
+ *   while (running) { bus.ProcessBatch(); }
+ *
+ *   // producer process
+ *   mccc::ShmBus<Payload> bus;
+ *   while (bus.Attach("/sensor_bus") == mccc::ShmError::NOT_READY) { ... }
+ *   bus.Publish(Imu{...}, kSensorDaemonId);
+ * @endcode
+ *
+ * @tparam PayloadVariant std::variant of trivially-copyable message types
+ * @tparam Depth Ring depth (power of 2), part of the segment layout
+ * @tparam Clock Header timestamp source; must be system-wide (the default
+ *         CLOCK_MONOTONIC-based SteadyClock is) so stamps compare across processes
+ */
+template <typename PayloadVariant, uint32_t Depth = 4096U, typename Clock = SteadyClock>
+class ShmBus {
+ public:
+  using EnvelopeType = MessageEnvelope<PayloadVariant>;
+  using CallbackType = FixedFunction<void(const EnvelopeType&), 64U>;
+
+  static_assert(std::is_trivially_copyable<EnvelopeType>::value,
+                "ShmBus requires a trivially-copyable PayloadVariant (no pointers to process-local memory)");
+  static_assert((Depth >= 2U) && ((Depth & (Depth - 1U)) == 0U), "Depth must be a power of 2");
+  static_assert(std::atomic<uint32_t>::is_always_lock_free && std::atomic<uint64_t>::is_always_lock_free,
+                "Shared-memory atomics must be lock-free to be address-free");
+
+  static constexpr uint32_t MAX_QUEUE_DEPTH = Depth;
+  static constexpr uint32_t BATCH_PROCESS_SIZE = 1024U;
+  static constexpr uint32_t LOW_PRIORITY_THRESHOLD = detail::DepthPercent(Depth, 60U);
+  static constexpr uint32_t MEDIUM_PRIORITY_THRESHOLD = detail::DepthPercent(Depth, 80U);
+  static constexpr uint32_t HIGH_PRIORITY_THRESHOLD = detail::DepthPercent(Depth, 99U);
+
+  static constexpr uint32_t SEGMENT_MAGIC = 0x4D434353U;  // "MCCS"
+  static constexpr uint32_t LAYOUT_VERSION = 1U;
+  /** Hash of the PayloadVariant layout and envelope size, checked on Attach(). */
+  static constexpr uint64_t TYPE_HASH =
+      detail::PayloadLayoutHash<PayloadVariant>() ^ (static_cast<uint64_t>(sizeof(EnvelopeType)) << 32U);
+
+  ShmBus() noexcept = default;
+  ~ShmBus() { Close(); }
+  ShmBus(const ShmBus&) = delete;
+  ShmBus& operator=(const ShmBus&) = delete;
+  ShmBus(ShmBus&&) = delete;
+  ShmBus& operator=(ShmBus&&) = delete;
+
+  // ======================== Segment Lifetime ========================
+
+  /**
+   * @brief Create the segment and become its consumer.
+   *
+   * An existing segment with the same name is left alone (ShmError::EXISTS)
+   * unless mode is ShmCreate::REPLACE: the name cannot tell a live consumer
+   * from one that crashed, so taking it over is the caller's decision. With
+   * REPLACE, producers attached to the old segment keep their mapping but no
+   * longer reach any consumer. The segment is unlinked when this object closes.
+   */
+  ShmError Create(const char* name, ShmCreate mode = ShmCreate::EXCLUSIVE) noexcept {
+    if (segment_ != nullptr) {
+      return ShmError::ALREADY_OPEN;
+    }
+    if (std::strlen(name) >= NAME_CAPACITY) {
+      return ShmError::OPEN_FAILED;
+    }
+    if (mode == ShmCreate::REPLACE) {
+      (void)shm_unlink(name);
+    }
+    const int fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0) {
+      return (errno == EEXIST) ? ShmError::EXISTS : ShmError::OPEN_FAILED;
+    }
+    if (ftruncate(fd, static_cast<off_t>(sizeof(Segment))) != 0) {
+      (void)close(fd);
+      (void)shm_unlink(name);
+      return ShmError::OPEN_FAILED;
+    }
+    void* addr = mmap(nullptr, sizeof(Segment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    (void)close(fd);
+    if (addr == MAP_FAILED) {
+      (void)shm_unlink(name);
+      return ShmError::MMAP_FAILED;
+    }
+
+    segment_ = new (addr) Segment();
+    for (uint32_t i = 0U; i < Depth; ++i) {
+      segment_->slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    segment_->control.magic = SEGMENT_MAGIC;
+    segment_->control.layout_version = LAYOUT_VERSION;
+    segment_->control.depth = Depth;
+    segment_->control.slot_size = static_cast<uint32_t>(sizeof(Slot));
+    segment_->control.type_hash = TYPE_HASH;
+    segment_->control.ready.store(SEGMENT_MAGIC, std::memory_order_release);
+
+    owner_ = true;
+    CopyName(name);
+    return ShmError::OK;
+  }
+
+  /**
+   * @brief Map an existing segment as a producer. Does not modify it.
+   */
+  ShmError Attach(const char* name) noexcept {
+    if (segment_ != nullptr) {
+      return ShmError::ALREADY_OPEN;
+    }
+    const int fd = shm_open(name, O_RDWR, 0600);
+    if (fd < 0) {
+      return (errno == ENOENT) ? ShmError::NOT_READY : ShmError::OPEN_FAILED;
+    }
+    struct stat st {};
+    if ((fstat(fd, &st) != 0) || (st.st_size == 0)) {
+      (void)close(fd);
+      return ShmError::NOT_READY;  // creator has not sized it yet
+    }
+    if (static_cast<size_t>(st.st_size) != sizeof(Segment)) {
+      (void)close(fd);
+      return ShmError::LAYOUT_MISMATCH;
+    }
+    void* addr = mmap(nullptr, sizeof(Segment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    (void)close(fd);
+    if (addr == MAP_FAILED) {
+      return ShmError::MMAP_FAILED;
+    }
+
+    Segment* segment = static_cast<Segment*>(addr);
+    const ShmError status = Validate(*segment);
+    if (status != ShmError::OK) {
+      (void)munmap(addr, sizeof(Segment));
+      return status;
+    }
+    segment_ = segment;
+    owner_ = false;
+    return ShmError::OK;
+  }
+
+  /** @brief Unmap the segment (and unlink it when this object created it). */
+  void Close() noexcept {
+    if (segment_ == nullptr) {
+      return;
+    }
+    (void)munmap(segment_, sizeof(Segment));
+    segment_ = nullptr;
+    if (owner_) {
+      (void)shm_unlink(name_.data());
+      owner_ = false;
+    }
+  }
+
+  bool IsOpen() const noexcept { return segment_ != nullptr; }
+  bool IsOwner() const noexcept { return owner_; }
+
+  /** @brief Bytes mapped per process. */
+  static constexpr size_t SegmentBytes() noexcept { return sizeof(Segment); }
+
+  // ======================== Publish API (any attached process) ========================
+
+  /**
+   * @brief Copy payload into the shared ring.
+   * @return false when not open, or when the ring is above the priority's threshold
+   */
+  bool Publish(const PayloadVariant& payload, uint32_t sender_id,
+               MessagePriority priority = MessagePriority::MEDIUM) noexcept {
+    if (segment_ == nullptr) {
+      return false;
+    }
+    Control& control = segment_->control;
+    const uint32_t threshold = ThresholdFor(priority);
+
+    uint32_t prod_pos = 0U;
+    do {
+      prod_pos = control.producer_pos.load(std::memory_order_relaxed);
+      if ((prod_pos - control.consumer_pos.load(MCCC_MO_ACQUIRE)) >= threshold) {
+        control.messages_dropped.fetch_add(1U, std::memory_order_relaxed);
+        return false;
+      }
+      const uint32_t seq = SlotAt(prod_pos).sequence.load(MCCC_MO_ACQUIRE);
+      detail::AcquireFence();
+      if (seq != prod_pos) {
+        control.messages_dropped.fetch_add(1U, std::memory_order_relaxed);
+        return false;
+      }
+    } while (!control.producer_pos.compare_exchange_weak(prod_pos, prod_pos + 1U, MCCC_MO_ACQ_REL,
+                                                         std::memory_order_relaxed));
+
+    Slot& slot = SlotAt(prod_pos);
+    const uint64_t now_ns = Clock::NowNs();
+    const uint64_t msg_id = control.next_msg_id.fetch_add(1U, std::memory_order_relaxed);
+    slot.envelope.header = MessageHeader{msg_id, now_ns / 1000U, sender_id, priority};
+#if MCCC_HEADER_HAS_TIMESTAMP_NS
+    slot.envelope.header.timestamp_ns = now_ns;
+#endif
+    slot.envelope.payload = payload;
+
+    detail::ReleaseFence();
+    slot.sequence.store(prod_pos + 1U, MCCC_MO_RELEASE);
+    control.messages_published.fetch_add(1U, std::memory_order_relaxed);
+    return true;
+  }
+
+  // ======================== Subscribe API (consumer process) ========================
+
+  /**
+   * @brief Register a local callback for message type T.
+   *
+   * Callbacks are process-local and not synchronized: call from the consumer
+   * thread (or before it starts), like ProcessBatch().
+   */
+  template <typename T, typename Func>
+  SubscriptionHandle Subscribe(Func&& func) {
+    constexpr size_t type_idx = VariantIndex<T, PayloadVariant>::value;
+    static_assert(type_idx < MCCC_MAX_MESSAGE_TYPES, "Type index exceeds MCCC_MAX_MESSAGE_TYPES");
+    CallbackList& list = callbacks_[type_idx];
+    if (list.count >= MCCC_MAX_CALLBACKS_PER_TYPE) {
+      return SubscriptionHandle{type_idx, static_cast<size_t>(-1)};
+    }
+    const size_t callback_id = next_callback_id_++;
+    list.ids[list.count] = callback_id;
+    list.callbacks[list.count] = CallbackType(std::forward<Func>(func));
+    ++list.count;
+    return SubscriptionHandle{type_idx, callback_id};
+  }
+
+  bool Unsubscribe(const SubscriptionHandle& handle) noexcept {
+    if (handle.type_index >= MCCC_MAX_MESSAGE_TYPES) {
+      return false;
+    }
+    CallbackList& list = callbacks_[handle.type_index];
+    for (uint32_t i = 0U; i < list.count; ++i) {
+      if (list.ids[i] == handle.callback_id) {
+        for (uint32_t j = i + 1U; j < list.count; ++j) {
+          list.ids[j - 1U] = list.ids[j];
+          list.callbacks[j - 1U] = std::move(list.callbacks[j]);
+        }
+        --list.count;
+        list.callbacks[list.count] = nullptr;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // ======================== Processing API (segment owner only) ========================
+
+  /**
+   * @brief Dispatch up to max_messages queued messages to the local callbacks.
+   *
+   * Single consumer: only the process that called Create() may drain the ring.
+   * @return Number of messages processed
+   */
+  uint32_t ProcessBatch(uint32_t max_messages = BATCH_PROCESS_SIZE) noexcept {
+    if (!owner_) {
+      return 0U;
+    }
+    Control& control = segment_->control;
+    const uint32_t limit = (max_messages < BATCH_PROCESS_SIZE) ? max_messages : BATCH_PROCESS_SIZE;
+    uint32_t cons_pos = control.consumer_pos.load(std::memory_order_relaxed);
+    uint32_t processed = 0U;
+    for (; processed < limit; ++processed) {
+      Slot& slot = SlotAt(cons_pos);
+      const uint32_t seq = slot.sequence.load(MCCC_MO_ACQUIRE);
+      detail::AcquireFence();
+      if (seq != (cons_pos + 1U)) {
+        break;
+      }
+      Dispatch(slot.envelope);
+      detail::ReleaseFence();
+      slot.sequence.store(cons_pos + Depth, MCCC_MO_RELEASE);
+      ++cons_pos;
+    }
+    if (processed > 0U) {
+      control.consumer_pos.store(cons_pos, MCCC_MO_RELEASE);
+      control.messages_processed.fetch_add(processed, std::memory_order_relaxed);
+    }
+    return processed;
+  }
+
+  // ======================== Status API ========================
+
+  uint32_t QueueDepth() const noexcept {
+    if (segment_ == nullptr) {
+      return 0U;
+    }
+    const uint32_t prod = segment_->control.producer_pos.load(std::memory_order_acquire);
+    const uint32_t cons = segment_->control.consumer_pos.load(std::memory_order_acquire);
+    return prod - cons;
+  }
+
+  /** @brief Segment-wide counters (shared by every attached process). */
+  BusStatisticsSnapshot GetStatistics() const noexcept {
+    BusStatisticsSnapshot snap{};
+    if (segment_ != nullptr) {
+      const Control& control = segment_->control;
+      snap.messages_published = control.messages_published.load(std::memory_order_relaxed);
+      snap.messages_dropped = control.messages_dropped.load(std::memory_order_relaxed);
+      snap.messages_processed = control.messages_processed.load(std::memory_order_relaxed);
+    }
+    return snap;
+  }
+
+ private:
+  /** Segment header; everything before the slots. */
+  struct Control {
+    uint32_t magic{0U};
+    uint32_t layout_version{0U};
+    uint32_t depth{0U};
+    uint32_t slot_size{0U};
+    uint64_t type_hash{0U};
+    std::atomic<uint32_t> ready{0U};  // SEGMENT_MAGIC once the creator finished initializing
+    alignas(MCCC_CACHELINE_SIZE) std::atomic<uint32_t> producer_pos{0U};
+    alignas(MCCC_CACHELINE_SIZE) std::atomic<uint32_t> consumer_pos{0U};
+    alignas(MCCC_CACHELINE_SIZE) std::atomic<uint64_t> next_msg_id{1U};
+    std::atomic<uint64_t> messages_published{0U};
+    std::atomic<uint64_t> messages_dropped{0U};
+    alignas(MCCC_CACHELINE_SIZE) std::atomic<uint64_t> messages_processed{0U};
+  };
+
+  struct MCCC_ALIGN_CACHELINE Slot {
+    std::atomic<uint32_t> sequence{0U};
+    EnvelopeType envelope;
+  };
+
+  struct Segment {
+    Control control;
+    std::array<Slot, Depth> slots;
+  };
+
+  struct CallbackList {
+    std::array<size_t, MCCC_MAX_CALLBACKS_PER_TYPE> ids{};
+    std::array<CallbackType, MCCC_MAX_CALLBACKS_PER_TYPE> callbacks{};
+    uint32_t count{0U};
+  };
+
+  static constexpr size_t NAME_CAPACITY = 64U;
+
+  Slot& SlotAt(uint32_t pos) noexcept { return segment_->slots[pos & (Depth - 1U)]; }
+
+  static uint32_t ThresholdFor(MessagePriority priority) noexcept {
+    switch (priority) {
+      case MessagePriority::HIGH:
+        return HIGH_PRIORITY_THRESHOLD;
+      case MessagePriority::LOW:
+        return LOW_PRIORITY_THRESHOLD;
+      default:
+        return MEDIUM_PRIORITY_THRESHOLD;
+    }
+  }
+
+  static ShmError Validate(const Segment& segment) noexcept {
+    const Control& control = segment.control;
+    if (control.ready.load(std::memory_order_acquire) != SEGMENT_MAGIC) {
+      return ShmError::NOT_READY;
+    }
+    if ((control.magic != SEGMENT_MAGIC) || (control.layout_version != LAYOUT_VERSION) || (control.depth != Depth) ||
+        (control.slot_size != sizeof(Slot))) {
+      return ShmError::LAYOUT_MISMATCH;
+    }
+    if (control.type_hash != TYPE_HASH) {
+      return ShmError::TYPE_MISMATCH;
+    }
+    return ShmError::OK;
+  }
+
+  void Dispatch(const EnvelopeType& envelope) noexcept {
+    const size_t type_idx = envelope.payload.index();
+    if (type_idx >= MCCC_MAX_MESSAGE_TYPES) {
+      return;
+    }
+    const CallbackList& list = callbacks_[type_idx];
+    for (uint32_t i = 0U; i < list.count; ++i) {
+      list.callbacks[i](envelope);
+    }
+  }
+
+  void CopyName(const char* name) noexcept { (void)std::memcpy(name_.data(), name, std::strlen(name) + 1U); }
+
+  Segment* segment_{nullptr};
+  bool owner_{false};
+  std::array<char, NAME_CAPACITY> name_{};
+  std::array<CallbackList, MCCC_MAX_MESSAGE_TYPES> callbacks_{};
+  size_t next_callback_id_{1U};
+};
+
+}  // namespace mccc
+
+#endif  // MCCC_SHM_BUS_HPP_
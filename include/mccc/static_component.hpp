@@ -30,6 +30,8 @@
  * - Message handlers are known at compile time
  * - No dynamic subscribe/unsubscribe needed
  * - Used with AsyncBus::ProcessBatchWith() for zero-overhead dispatch
+ *
+ * StaticDispatcher fans one ProcessBatchWith() pass out to several components.
  */
 
 #ifndef MCCC_STATIC_COMPONENT_HPP_
@@ -37,6 +39,7 @@
 
 #include "mccc/mccc.hpp"
 
+#include <tuple>
 #include <type_traits>
 #include <utility>
 
@@ -136,6 +139,61 @@ class StaticComponent {
   StaticComponent& operator=(StaticComponent&&) = delete;
 };
 
+/**
+ * @brief Compile-time fan-out of one visit to several static components.
+ *
+ * Each message is visited once; the handlers for its type are the components
+ * with a matching Handle(const T&) (HasHandler), called directly in template
+ * argument order. The per-type handler list is resolved at compile time, so
+ * a dispatch is a sequence of inlineable calls with no table or pointer
+ * indirection. Components need not derive from StaticComponent.
+ *
+ * Usage:
+ * @code
+ * MySensor sensor;
+ * MyLogger logger;
+ * MyMotor motor;
+ * mccc::StaticDispatcher<MySensor, MyLogger, MyMotor> dispatcher(sensor, logger, motor);
+ * bus.ProcessBatchWith(dispatcher);  // one pass serves all three
+ * @endcode
+ *
+ * @tparam Components Handler types (may be const-qualified for const Handle overloads)
+ */
+template <typename... Components>
+class StaticDispatcher {
+  static_assert(sizeof...(Components) > 0U, "StaticDispatcher needs at least one component");
+
+ public:
+  explicit StaticDispatcher(Components&... components) noexcept : components_(&components...) {}
+
+  /** @brief Number of components handling T (resolved at compile time). */
+  template <typename T>
+  static constexpr size_t HandlerCount() noexcept {
+    return (static_cast<size_t>(detail::HasHandler<Components, T>::value) + ... + 0U);
+  }
+
+  template <typename T>
+  void operator()(const T& data) const noexcept {
+    Dispatch(data, std::index_sequence_for<Components...>{});
+  }
+
+ private:
+  template <typename T, size_t... I>
+  void Dispatch(const T& data, std::index_sequence<I...> /*unused*/) const noexcept {
+    (CallIfHandled<I>(data), ...);
+  }
+
+  template <size_t I, typename T>
+  void CallIfHandled(const T& data) const noexcept {
+    using ComponentType = std::tuple_element_t<I, std::tuple<Components...>>;
+    if constexpr (detail::HasHandler<ComponentType, T>::value) {
+      std::get<I>(components_)->Handle(data);
+    }
+  }
+
+  std::tuple<Components*...> components_;
+};
+
 }  // namespace mccc
 
 #endif  // MCCC_STATIC_COMPONENT_HPP_
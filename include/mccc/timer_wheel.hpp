@@ -0,0 +1,478 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2024 liudegui
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * @file timer_wheel.hpp
+ * @brief Delayed and periodic publishes driven by the bus consumer loop.
+ *
+ * Components that emit heartbeats or timeouts otherwise each run a thread
+ * with a sleep_for() loop. TimerWheel keeps their envelopes in a fixed pool
+ * (no heap after construction) sorted into a 4-level hierarchical wheel of
+ * 64 slots per level, and publishes each one when it falls due from the
+ * consumer thread: TimerWheel::ProcessBatch() advances the wheel before
+ * dispatching, and TimerWheel::ProcessBatchWait() caps the park time at the
+ * next timer deadline.
+ */
+
+#ifndef MCCC_TIMER_WHEEL_HPP_
+#define MCCC_TIMER_WHEEL_HPP_
+
+#include "mccc/mccc.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <mutex>
+#include <utility>
+
+namespace mccc {
+
+/**
+ * @brief Timer returned by TimerWheel::PublishAfter() / PublishEvery().
+ *
+ * Stays safe to Cancel() after the timer fired or was cancelled: a reused
+ * pool entry has a different generation.
+ */
+struct TimerHandle {
+  uint32_t index;      /**< Pool entry; TimerHandle::INVALID if scheduling failed */
+  uint32_t generation; /**< Pool entry generation at scheduling time */
+
+  static constexpr uint32_t INVALID = 0xFFFFFFFFU;
+
+  constexpr TimerHandle() noexcept : index(INVALID), generation(0U) {}
+  constexpr TimerHandle(uint32_t idx, uint32_t gen) noexcept : index(idx), generation(gen) {}
+
+  constexpr bool Valid() const noexcept { return index != INVALID; }
+  explicit constexpr operator bool() const noexcept { return Valid(); }
+};
+
+/** @brief TimerWheel counters. */
+struct TimerStatistics {
+  uint64_t timers_scheduled; /**< PublishAfter() / PublishEvery() calls that got a pool entry */
+  uint64_t pool_exhausted;   /**< Calls rejected because all MaxTimers entries were in use */
+  uint64_t timers_cancelled; /**< Successful Cancel() calls */
+  uint64_t messages_fired;   /**< Timer messages accepted by the bus */
+  uint64_t publish_retries;  /**< One-shot messages refused by the bus and retried on the next tick */
+  uint64_t periods_dropped;  /**< Periodic messages refused by the bus (the next period is kept) */
+};
+
+/**
+ * @brief Hierarchical timer wheel publishing into one bus.
+ *
+ * Usage:
+ * @code
+ *   mccc::TimerWheel<Payload, Bus> timers(bus);            // 1 ms ticks
+ *   timers.PublishEvery(std::chrono::milliseconds(100), Heartbeat{}, kNodeId);
+ *   mccc::TimerHandle t = timers.PublishAfter(std::chrono::seconds(2), Timeout{}, kNodeId);
+ *   while (running) {
+ *     timers.ProcessBatchWait(std::chrono::milliseconds(50));  // instead of bus.ProcessBatchWait()
+ *   }
+ * @endcode
+ *
+ * PublishAfter(), PublishEvery() and Cancel() may be called from any thread
+ * (they take a mutex, like Subscribe()); Advance(), ProcessBatch() and
+ * ProcessBatchWait() belong to the single bus consumer. With no timer due,
+ * Advance() costs one atomic load and one Clock read.
+ *
+ * Timers fire at tick granularity: a message is published at the first
+ * Advance() at least its delay after scheduling, rounded up to a whole tick.
+ * The message is stamped when it is published, not when it was scheduled.
+ *
+ * @tparam PayloadVariant std::variant of message types
+ * @tparam BusT Bus the messages are published on
+ * @tparam MaxTimers Pool entries (armed one-shot + periodic timers)
+ * @tparam Clock Time source (use the bus Clock so manual test clocks stay consistent)
+ */
+template <typename PayloadVariant, typename BusT = AsyncBus<PayloadVariant>, uint32_t MaxTimers = 64U,
+          typename Clock = SteadyClock>
+class TimerWheel {
+ public:
+  static constexpr uint32_t LEVELS = 4U;
+  static constexpr uint32_t SLOT_BITS = 6U;
+  static constexpr uint32_t SLOTS = 1U << SLOT_BITS;
+  /** Longest delay (in ticks) placed exactly; longer timers are re-sorted as the wheel turns. */
+  static constexpr uint64_t SPAN_TICKS = 1ULL << (SLOT_BITS * LEVELS);
+
+  static_assert((MaxTimers > 0U) && (MaxTimers < TimerHandle::INVALID), "MaxTimers out of range");
+
+  /**
+   * @param bus Bus the timers publish on (must outlive the wheel)
+   * @param tick_us Wheel resolution; a 1 ms tick spans 4.6 hours exactly
+   */
+  explicit TimerWheel(BusT& bus, uint64_t tick_us = 1000U) noexcept
+      : bus_(bus), tick_ns_(((tick_us > 0U) ? tick_us : 1U) * 1000U), start_ns_(Clock::NowNs()) {
+    heads_.fill(NIL);
+    tails_.fill(NIL);
+    for (uint32_t i = 0U; i < MaxTimers; ++i) {
+      nodes_[i].next = (i + 1U < MaxTimers) ? (i + 1U) : NIL;
+    }
+    free_head_ = 0U;
+  }
+
+  TimerWheel(const TimerWheel&) = delete;
+  TimerWheel& operator=(const TimerWheel&) = delete;
+
+  // ======================== Scheduling ========================
+
+  /**
+   * @brief Publish payload once, delay from now.
+   * @return Invalid handle if the pool is exhausted
+   */
+  template <typename Rep, typename Period>
+  TimerHandle PublishAfter(std::chrono::duration<Rep, Period> delay, PayloadVariant&& payload, uint32_t sender_id,
+                           MessagePriority priority = MessagePriority::MEDIUM) noexcept {
+    return Schedule(ToNs(delay), 0U, std::move(payload), sender_id, priority);
+  }
+
+  /**
+   * @brief Publish a copy of payload every period, first one period from now.
+   *
+   * Firings the consumer was too late for are skipped, not published in a burst.
+   * @return Invalid handle if the pool is exhausted
+   */
+  template <typename Rep, typename Period>
+  TimerHandle PublishEvery(std::chrono::duration<Rep, Period> period, PayloadVariant&& payload, uint32_t sender_id,
+                           MessagePriority priority = MessagePriority::MEDIUM) noexcept {
+    const uint64_t period_ns = ToNs(period);
+    const uint64_t period_ticks = (period_ns + tick_ns_ - 1U) / tick_ns_;
+    return Schedule(period_ns, (period_ticks > 0U) ? period_ticks : 1U, std::move(payload), sender_id, priority);
+  }
+
+  /**
+   * @brief Disarm a timer and release its pool entry.
+   * @return false if the timer already fired (one-shot), was cancelled, or the handle is invalid
+   */
+  bool Cancel(const TimerHandle& handle) noexcept {
+    if (handle.index >= MaxTimers) {
+      return false;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    Node& node = nodes_[handle.index];
+    if (!node.armed || (node.generation != handle.generation)) {
+      return false;
+    }
+    Unlink(handle.index);
+    Release(handle.index);
+    ++stats_.timers_cancelled;
+    PublishNextEvent();
+    return true;
+  }
+
+  // ======================== Consumer ========================
+
+  /**
+   * @brief Publish every timer that is due by now.
+   * @return Timer messages the bus accepted
+   */
+  uint32_t Advance() noexcept {
+    const uint64_t next = next_event_ns_.load(std::memory_order_acquire);
+    if (next == NO_EVENT) {
+      return 0U;
+    }
+    const uint64_t now = Clock::NowNs();
+    if (now < next) {
+      return 0U;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    const uint64_t target = (now - start_ns_) / tick_ns_;
+    uint32_t fired = 0U;
+    while (current_tick_ < target) {
+      const uint64_t event = NextEventTick();
+      if (event > target) {
+        break;
+      }
+      current_tick_ = event;
+      Cascade();
+      fired += FireSlot(target);
+    }
+    current_tick_ = target;
+    PublishNextEvent();
+    return fired;
+  }
+
+  /** @brief Advance(), then BusT::ProcessBatch(): due timer messages are dispatched in the same call. */
+  uint32_t ProcessBatch(uint32_t max_messages = BusT::BATCH_PROCESS_SIZE) noexcept {
+    (void)Advance();
+    return bus_.ProcessBatch(max_messages);
+  }
+
+  /**
+   * @brief BusT::ProcessBatchWait() that also wakes for the next timer deadline.
+   *
+   * A timer scheduled from another thread with an earlier deadline than the
+   * one the consumer is parked for calls BusT::Wakeup().
+   */
+  template <typename Rep, typename Period>
+  uint32_t ProcessBatchWait(std::chrono::duration<Rep, Period> timeout) noexcept {
+    (void)Advance();
+    consumer_waiting_.store(true, std::memory_order_seq_cst);
+    auto wait = std::chrono::duration_cast<std::chrono::nanoseconds>(timeout);
+    // Pairs with the seq_cst store in PublishNextEvent(): either this load sees
+    // the new deadline or the scheduler sees consumer_waiting_ and wakes it
+    const uint64_t next = next_event_ns_.load(std::memory_order_seq_cst);
+    if (next != NO_EVENT) {
+      const uint64_t now = Clock::NowNs();
+      const auto until_next = std::chrono::nanoseconds((next > now) ? (next - now) : 0U);
+      wait = (until_next < wait) ? until_next : wait;
+    }
+    uint32_t processed = bus_.ProcessBatchWait(wait);
+    consumer_waiting_.store(false, std::memory_order_relaxed);
+    if ((processed == 0U) && (Advance() > 0U)) {
+      processed = bus_.ProcessBatch();
+    }
+    return processed;
+  }
+
+  /** @brief Clock time of the next wheel event (a firing or a re-sort); UINT64_MAX when idle. */
+  uint64_t NextDeadlineNs() const noexcept { return next_event_ns_.load(std::memory_order_acquire); }
+
+  uint32_t ActiveTimers() const noexcept {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return active_;
+  }
+
+  TimerStatistics GetStatistics() const noexcept {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+  }
+
+  uint64_t TickNs() const noexcept { return tick_ns_; }
+
+ private:
+  static constexpr uint32_t NIL = 0xFFFFFFFFU;
+  static constexpr uint64_t NO_EVENT = std::numeric_limits<uint64_t>::max();
+
+  struct Node {
+    PayloadVariant payload{};
+    uint64_t expire_tick{0U};
+    uint64_t period_ticks{0U};  // 0 = one-shot
+    uint32_t sender_id{0U};
+    uint32_t generation{0U};
+    uint32_t next{NIL};
+    uint32_t prev{NIL};
+    uint16_t slot{0U};  // level * SLOTS + index
+    MessagePriority priority{MessagePriority::MEDIUM};
+    bool armed{false};
+  };
+
+  template <typename Rep, typename Period>
+  static uint64_t ToNs(std::chrono::duration<Rep, Period> d) noexcept {
+    const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(d).count();
+    return (ns > 0) ? static_cast<uint64_t>(ns) : 0U;
+  }
+
+  TimerHandle Schedule(uint64_t delay_ns, uint64_t period_ticks, PayloadVariant&& payload, uint32_t sender_id,
+                       MessagePriority priority) noexcept {
+    const uint64_t now = Clock::NowNs();
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (free_head_ == NIL) {
+      ++stats_.pool_exhausted;
+      return TimerHandle{};
+    }
+    const uint32_t index = free_head_;
+    Node& node = nodes_[index];
+    free_head_ = node.next;
+
+    const uint64_t elapsed = (now > start_ns_) ? (now - start_ns_) : 0U;
+    uint64_t expire = (elapsed + delay_ns + tick_ns_ - 1U) / tick_ns_;
+    expire = (expire > current_tick_) ? expire : (current_tick_ + 1U);  // current tick already fired
+    node.payload = std::move(payload);
+    node.expire_tick = expire;
+    node.period_ticks = period_ticks;
+    node.sender_id = sender_id;
+    node.priority = priority;
+    node.armed = true;
+    Insert(index);
+    ++active_;
+    ++stats_.timers_scheduled;
+    PublishNextEvent();
+    return TimerHandle{index, node.generation};
+  }
+
+  /** Place a node by its distance from current_tick_ (0 = fires in this tick's level-0 slot). */
+  void Insert(uint32_t index) noexcept {
+    Node& node = nodes_[index];
+    const uint64_t delta = node.expire_tick - current_tick_;
+    uint32_t level = 0U;
+    while ((level + 1U < LEVELS) && (delta >= (1ULL << (SLOT_BITS * (level + 1U))))) {
+      ++level;
+    }
+    // Beyond the span: park in the farthest top-level slot, re-sorted when it cascades
+    const uint64_t key = (delta < SPAN_TICKS) ? node.expire_tick : (current_tick_ + SPAN_TICKS - 1U);
+    const auto slot = static_cast<uint16_t>(level * SLOTS + ((key >> (SLOT_BITS * level)) & (SLOTS - 1U)));
+    node.slot = slot;
+    node.next = NIL;
+    node.prev = tails_[slot];  // append: timers due in one tick fire in scheduling order
+    if (node.prev != NIL) {
+      nodes_[node.prev].next = index;
+    } else {
+      heads_[slot] = index;
+    }
+    tails_[slot] = index;
+    occupied_[level] |= 1ULL << (slot & (SLOTS - 1U));
+  }
+
+  void Unlink(uint32_t index) noexcept {
+    Node& node = nodes_[index];
+    if (node.prev != NIL) {
+      nodes_[node.prev].next = node.next;
+    } else {
+      heads_[node.slot] = node.next;
+    }
+    if (node.next != NIL) {
+      nodes_[node.next].prev = node.prev;
+    } else {
+      tails_[node.slot] = node.prev;
+    }
+    if (heads_[node.slot] == NIL) {
+      occupied_[node.slot / SLOTS] &= ~(1ULL << (node.slot & (SLOTS - 1U)));
+    }
+  }
+
+  void Release(uint32_t index) noexcept {
+    Node& node = nodes_[index];
+    node.armed = false;
+    ++node.generation;
+    node.payload = PayloadVariant();  // drop held resources now
+    node.next = free_head_;
+    free_head_ = index;
+    --active_;
+  }
+
+  /** Detach and return the list of one slot. */
+  uint32_t TakeSlot(uint32_t slot) noexcept {
+    const uint32_t head = heads_[slot];
+    heads_[slot] = NIL;
+    tails_[slot] = NIL;
+    occupied_[slot / SLOTS] &= ~(1ULL << (slot & (SLOTS - 1U)));
+    return head;
+  }
+
+  /**
+   * First tick after current_tick_ at which the wheel has work: an occupied
+   * level-0 slot fires, or an occupied higher-level slot cascades.
+   */
+  uint64_t NextEventTick() const noexcept {
+    uint64_t best = NO_EVENT;
+    for (uint32_t level = 0U; level < LEVELS; ++level) {
+      const uint64_t mask = occupied_[level];
+      if (mask == 0U) {
+        continue;
+      }
+      const uint32_t shift = SLOT_BITS * level;
+      const uint64_t pos = current_tick_ >> shift;
+      const auto from = static_cast<uint32_t>((pos + 1U) & (SLOTS - 1U));
+      const uint64_t rotated = (from == 0U) ? mask : ((mask >> from) | (mask << (SLOTS - from)));
+      const uint64_t steps = static_cast<uint64_t>(__builtin_ctzll(rotated)) + 1U;
+      const uint64_t tick = (pos + steps) << shift;
+      best = (tick < best) ? tick : best;
+    }
+    return best;
+  }
+
+  /** On a level boundary, re-sort that level's current slot into the levels below. */
+  void Cascade() noexcept {
+    for (uint32_t level = LEVELS - 1U; level > 0U; --level) {
+      const uint32_t shift = SLOT_BITS * level;
+      if ((current_tick_ & ((1ULL << shift) - 1U)) != 0U) {
+        continue;
+      }
+      uint32_t index = TakeSlot(level * SLOTS + static_cast<uint32_t>((current_tick_ >> shift) & (SLOTS - 1U)));
+      while (index != NIL) {
+        const uint32_t next = nodes_[index].next;
+        Insert(index);
+        index = next;
+      }
+    }
+  }
+
+  /** Publish the level-0 slot of current_tick_; target is the tick Advance() is catching up to. */
+  uint32_t FireSlot(uint64_t target) noexcept {
+    uint32_t fired = 0U;
+    uint32_t index = TakeSlot(static_cast<uint32_t>(current_tick_ & (SLOTS - 1U)));
+    while (index != NIL) {
+      Node& node = nodes_[index];
+      const uint32_t next = node.next;
+      if (node.period_ticks == 0U) {
+        if (bus_.PublishWithPriority(std::move(node.payload), node.sender_id, node.priority)) {
+          ++fired;
+          Release(index);
+        } else {
+          // A refused publish leaves the payload in place; deliver it late rather than never
+          ++stats_.publish_retries;
+          node.expire_tick = target + 1U;
+          Insert(index);
+        }
+      } else {
+        PayloadVariant copy(node.payload);
+        if (bus_.PublishWithPriority(std::move(copy), node.sender_id, node.priority)) {
+          ++fired;
+        } else {
+          ++stats_.periods_dropped;
+        }
+        node.expire_tick += node.period_ticks;
+        if (node.expire_tick <= target) {  // consumer was late: skip the missed periods
+          node.expire_tick += ((target - node.expire_tick) / node.period_ticks + 1U) * node.period_ticks;
+        }
+        Insert(index);
+      }
+      index = next;
+    }
+    stats_.messages_fired += fired;
+    return fired;
+  }
+
+  /** Recompute next_event_ns_ and wake a parked consumer if it moved earlier. */
+  void PublishNextEvent() noexcept {
+    const uint64_t tick = NextEventTick();
+    const uint64_t next = (tick == NO_EVENT) ? NO_EVENT : (start_ns_ + tick * tick_ns_);
+    const uint64_t previous = next_event_ns_.exchange(next, std::memory_order_seq_cst);
+    if ((next < previous) && consumer_waiting_.load(std::memory_order_seq_cst)) {
+      bus_.Wakeup();
+    }
+  }
+
+  BusT& bus_;
+  const uint64_t tick_ns_;
+  const uint64_t start_ns_;
+
+  mutable std::mutex mutex_;
+  std::array<Node, MaxTimers> nodes_{};
+  std::array<uint32_t, LEVELS * SLOTS> heads_{};
+  std::array<uint32_t, LEVELS * SLOTS> tails_{};
+  std::array<uint64_t, LEVELS> occupied_{};  // bit i: slot i of the level is non-empty
+  uint32_t free_head_{NIL};
+  uint32_t active_{0U};
+  uint64_t current_tick_{0U};  // last tick processed
+  TimerStatistics stats_{};
+
+  std::atomic<uint64_t> next_event_ns_{NO_EVENT};
+  std::atomic<bool> consumer_waiting_{false};
+};
+
+}  // namespace mccc
+
+#endif  // MCCC_TIMER_WHEEL_HPP_
@@ -0,0 +1,429 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2024 liudegui
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * @file udp_bridge.hpp
+ * @brief Batched UDP forwarding of selected message types between buses on different nodes.
+ *
+ * A UdpBridge is a Component that subscribes to chosen alternatives on its
+ * local bus, serialises each MessageHeader + trivially-copyable payload into
+ * a compact record and packs records into datagrams of up to MaxDatagram
+ * bytes. Full datagrams are queued and sent SEND_BATCH at a time with one
+ * sendmmsg(); Poll() flushes a partial batch once it is older than the flush
+ * deadline. On the receive side Poll() drains up to SEND_BATCH datagrams
+ * with one recvmmsg() and re-publishes runs of records with PublishBatch().
+ *
+ * Wire format (native byte order; both ends must run the same build, which
+ * the frame's PayloadVariant type hash enforces):
+ *   BridgeFrameHeader, then record_count x (BridgeRecordHeader + payload bytes)
+ *
+ * Linux only: sendmmsg() / recvmmsg() are not POSIX (the BSDs have them as
+ * extensions). Forward callbacks run on the bus consumer thread; call Poll()
+ * and Flush() from that same thread.
+ */
+
+#ifndef MCCC_UDP_BRIDGE_HPP_
+#define MCCC_UDP_BRIDGE_HPP_
+
+#include "mccc/component.hpp"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cstring>
+
+#include <array>
+#include <utility>
+
+namespace mccc {
+
+/** @brief Datagram header. */
+struct BridgeFrameHeader {
+  uint32_t magic;        /**< UdpBridge::FRAME_MAGIC */
+  uint16_t version;      /**< UdpBridge::WIRE_VERSION */
+  uint16_t record_count; /**< Records that follow */
+  uint64_t type_hash;    /**< PayloadVariant signature hash of the sender */
+};
+
+/** @brief Per-message record header, followed by payload_size payload bytes. */
+struct BridgeRecordHeader {
+  uint64_t timestamp_us; /**< Sender-side MessageHeader::timestamp_us */
+  uint32_t sender_id;    /**< Original sender_id, kept on re-publish */
+  uint16_t payload_size; /**< sizeof(alternative) */
+  uint8_t type_index;    /**< PayloadVariant alternative index */
+  uint8_t priority;      /**< MessagePriority, kept on re-publish */
+};
+
+static_assert(sizeof(BridgeFrameHeader) == 16U, "BridgeFrameHeader must stay packed");
+static_assert(sizeof(BridgeRecordHeader) == 16U, "BridgeRecordHeader must stay packed");
+
+/** @brief UdpBridge endpoint configuration. */
+struct UdpBridgeConfig {
+  const char* bind_address = "0.0.0.0"; /**< Receive address (IPv4) */
+  uint16_t bind_port = 0U;              /**< 0 = ephemeral (see LocalPort()) */
+  const char* remote_address = nullptr; /**< Forward destination (IPv4); nullptr = receive only */
+  uint16_t remote_port = 0U;
+  uint32_t flush_deadline_us = 1000U; /**< Max age of a partially filled batch before Poll() sends it */
+};
+
+/** @brief Bridge counters (consumer thread only). */
+struct BridgeStatistics {
+  uint64_t messages_forwarded;  /**< Records queued for sending */
+  uint64_t datagrams_sent;      /**< Datagrams accepted by the kernel */
+  uint64_t send_syscalls;       /**< sendmmsg() calls */
+  uint64_t send_errors;         /**< Datagrams the kernel rejected */
+  uint64_t messages_received;   /**< Records re-published on the local bus */
+  uint64_t datagrams_received;  /**< Datagrams read */
+  uint64_t decode_errors;       /**< Datagrams or records rejected (bad magic/version/hash/size) */
+  uint64_t republish_dropped;   /**< Records the local bus did not admit */
+};
+
+/**
+ * @brief Component forwarding selected message types to a remote bus over UDP.
+ *
+ * Usage:
+ * @code
+ *   auto bridge = std::make_shared<mccc::UdpBridge<Payload, Bus>>(bus);
+ *   mccc::UdpBridgeConfig cfg;
+ *   cfg.bind_port = 7400U;
+ *   cfg.remote_address = "192.168.1.20";
+ *   cfg.remote_port = 7400U;
+ *   bridge->Open(cfg);
+ *   bridge->Forward<Imu>(mccc::SubscriptionFilter::SenderRange(0U, 99U));  // local senders only
+ *   while (running) { bus.ProcessBatch(); bridge->Poll(); }
+ * @endcode
+ *
+ * Received records are re-published with their original sender_id and
+ * priority. When both nodes forward the same type, filter Forward() on the
+ * local sender range so re-published messages are not sent back.
+ *
+ * @tparam PayloadVariant std::variant of message types (forwarded ones must be trivially copyable)
+ * @tparam BusT Local bus type
+ * @tparam MaxDatagram Datagram size limit in bytes (1472 = Ethernet MTU minus IPv4/UDP headers)
+ */
+template <typename PayloadVariant, typename BusT = AsyncBus<PayloadVariant>, uint32_t MaxDatagram = 1472U>
+class UdpBridge : public Component<PayloadVariant, BusT> {
+  using Base = Component<PayloadVariant, BusT>;
+
+ public:
+  using EnvelopeType = MessageEnvelope<PayloadVariant>;
+
+  static constexpr uint32_t FRAME_MAGIC = 0x4D434342U;  // "MCCB"
+  static constexpr uint16_t WIRE_VERSION = 1U;
+  static constexpr uint64_t TYPE_HASH = detail::PayloadLayoutHash<PayloadVariant>();
+  /** Datagrams per sendmmsg()/recvmmsg(). */
+  static constexpr uint32_t SEND_BATCH = 16U;
+  static constexpr uint32_t MAX_RECORDS_PER_DATAGRAM =
+      (MaxDatagram - sizeof(BridgeFrameHeader)) / sizeof(BridgeRecordHeader);
+
+  static_assert(MaxDatagram > sizeof(BridgeFrameHeader) + sizeof(BridgeRecordHeader), "MaxDatagram too small");
+  static_assert(MaxDatagram <= 65507U, "MaxDatagram exceeds the UDP payload limit");
+
+  explicit UdpBridge(BusT& bus) noexcept : Base(bus) {}
+
+  ~UdpBridge() override {
+    this->UnsubscribeAll();  // forward callbacks capture this
+    Close();
+  }
+
+  // ======================== Lifetime ========================
+
+  /**
+   * @brief Create and bind the socket.
+   * @return false on socket/bind failure or an unparsable address
+   */
+  bool Open(const UdpBridgeConfig& config) noexcept {
+    if (fd_ >= 0) {
+      return false;
+    }
+    sockaddr_in bind_addr{};
+    bind_addr.sin_family = AF_INET;
+    bind_addr.sin_port = htons(config.bind_port);
+    if (inet_pton(AF_INET, config.bind_address, &bind_addr.sin_addr) != 1) {
+      return false;
+    }
+    has_remote_ = (config.remote_address != nullptr);
+    if (has_remote_) {
+      remote_ = sockaddr_in{};
+      remote_.sin_family = AF_INET;
+      remote_.sin_port = htons(config.remote_port);
+      if (inet_pton(AF_INET, config.remote_address, &remote_.sin_addr) != 1) {
+        return false;
+      }
+    }
+
+    fd_ = socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK, 0);
+    if (fd_ < 0) {
+      return false;
+    }
+    if (bind(fd_, reinterpret_cast<const sockaddr*>(&bind_addr), sizeof(bind_addr)) != 0) {
+      Close();
+      return false;
+    }
+    flush_deadline_ns_ = static_cast<uint64_t>(config.flush_deadline_us) * 1000U;
+    return true;
+  }
+
+  void Close() noexcept {
+    if (fd_ >= 0) {
+      (void)close(fd_);
+      fd_ = -1;
+    }
+  }
+
+  /** @brief Bound UDP port (useful with bind_port = 0), 0 when closed. */
+  uint16_t LocalPort() const noexcept {
+    sockaddr_in addr{};
+    socklen_t len = sizeof(addr);
+    if ((fd_ < 0) || (getsockname(fd_, reinterpret_cast<sockaddr*>(&addr), &len) != 0)) {
+      return 0U;
+    }
+    return ntohs(addr.sin_port);
+  }
+
+  // ======================== Forwarding ========================
+
+  /**
+   * @brief Forward every local T message that passes filter to the remote node.
+   * @return false when the bus or component subscription capacity is exhausted
+   */
+  template <typename T>
+  bool Forward(const SubscriptionFilter& filter = SubscriptionFilter{}) noexcept {
+    static_assert(std::is_trivially_copyable<T>::value, "UdpBridge forwards trivially-copyable types only");
+    static_assert(sizeof(T) <= MaxDatagram - sizeof(BridgeFrameHeader) - sizeof(BridgeRecordHeader),
+                  "Message does not fit in one datagram");
+    constexpr auto type_idx = static_cast<uint8_t>(VariantIndex<T, PayloadVariant>::value);
+    return this->template SubscribeSimple<T>(filter, [this](const T& msg, const MessageHeader& header) noexcept {
+      Append(type_idx, header, &msg, static_cast<uint16_t>(sizeof(T)));
+    });
+  }
+
+  /**
+   * @brief Send all queued datagrams, including a partially filled one.
+   * @return Datagrams sent
+   */
+  uint32_t Flush() noexcept {
+    CloseOpenDatagram();
+    return SendQueued();
+  }
+
+  /**
+   * @brief Flush on deadline and re-publish received datagrams.
+   * @return Messages re-published on the local bus
+   */
+  uint32_t Poll() noexcept {
+    const bool pending = (queued_ > 0U) || (open_records_ > 0U);
+    if (pending && ((SteadyClock::NowNs() - oldest_pending_ns_) >= flush_deadline_ns_)) {
+      (void)Flush();
+    }
+    return Receive();
+  }
+
+  const BridgeStatistics& GetStatistics() const noexcept { return stats_; }
+
+ private:
+  using Datagram = std::array<uint8_t, MaxDatagram>;
+
+  /** Append one record, starting a new datagram (and sending a full batch) as needed. */
+  void Append(uint8_t type_idx, const MessageHeader& header, const void* payload, uint16_t size) noexcept {
+    if (!has_remote_ || (fd_ < 0)) {
+      return;
+    }
+    const uint32_t record_bytes = static_cast<uint32_t>(sizeof(BridgeRecordHeader)) + size;
+    if ((open_records_ > 0U) && ((open_bytes_ + record_bytes) > MaxDatagram)) {
+      CloseOpenDatagram();
+    }
+    if (queued_ == SEND_BATCH) {
+      (void)SendQueued();
+    }
+    if ((queued_ == 0U) && (open_records_ == 0U)) {
+      oldest_pending_ns_ = SteadyClock::NowNs();
+    }
+    if (open_records_ == 0U) {
+      open_bytes_ = static_cast<uint32_t>(sizeof(BridgeFrameHeader));
+    }
+
+    Datagram& datagram = send_buffers_[queued_];
+    const BridgeRecordHeader record{header.timestamp_us, header.sender_id, size, type_idx,
+                                    static_cast<uint8_t>(header.priority)};
+    (void)std::memcpy(&datagram[open_bytes_], &record, sizeof(record));
+    (void)std::memcpy(&datagram[open_bytes_ + sizeof(record)], payload, size);
+    open_bytes_ += record_bytes;
+    ++open_records_;
+    ++stats_.messages_forwarded;
+  }
+
+  /** Finalize the frame header of the datagram being filled and queue it. */
+  void CloseOpenDatagram() noexcept {
+    if (open_records_ == 0U) {
+      return;
+    }
+    const BridgeFrameHeader frame{FRAME_MAGIC, WIRE_VERSION, static_cast<uint16_t>(open_records_), TYPE_HASH};
+    (void)std::memcpy(send_buffers_[queued_].data(), &frame, sizeof(frame));
+    send_lengths_[queued_] = open_bytes_;
+    ++queued_;
+    open_records_ = 0U;
+    open_bytes_ = 0U;
+  }
+
+  uint32_t SendQueued() noexcept {
+    if (queued_ == 0U) {
+      return 0U;
+    }
+    std::array<iovec, SEND_BATCH> iov{};
+    std::array<mmsghdr, SEND_BATCH> msgs{};
+    for (uint32_t i = 0U; i < queued_; ++i) {
+      iov[i].iov_base = send_buffers_[i].data();
+      iov[i].iov_len = send_lengths_[i];
+      msgs[i].msg_hdr.msg_iov = &iov[i];
+      msgs[i].msg_hdr.msg_iovlen = 1U;
+      msgs[i].msg_hdr.msg_name = &remote_;
+      msgs[i].msg_hdr.msg_namelen = sizeof(remote_);
+    }
+
+    uint32_t sent = 0U;
+    while (sent < queued_) {
+      const int rc = sendmmsg(fd_, &msgs[sent], queued_ - sent, 0);
+      ++stats_.send_syscalls;
+      if (rc <= 0) {
+        stats_.send_errors += queued_ - sent;  // socket buffer full or unreachable: datagrams lost
+        break;
+      }
+      sent += static_cast<uint32_t>(rc);
+    }
+    stats_.datagrams_sent += sent;
+    queued_ = 0U;
+    return sent;
+  }
+
+  uint32_t Receive() noexcept {
+    if (fd_ < 0) {
+      return 0U;
+    }
+    std::array<iovec, SEND_BATCH> iov{};
+    std::array<mmsghdr, SEND_BATCH> msgs{};
+    for (uint32_t i = 0U; i < SEND_BATCH; ++i) {
+      iov[i].iov_base = recv_buffers_[i].data();
+      iov[i].iov_len = MaxDatagram;
+      msgs[i].msg_hdr.msg_iov = &iov[i];
+      msgs[i].msg_hdr.msg_iovlen = 1U;
+    }
+    const int rc = recvmmsg(fd_, msgs.data(), SEND_BATCH, MSG_DONTWAIT, nullptr);
+    if (rc <= 0) {
+      return 0U;
+    }
+
+    uint32_t published = 0U;
+    for (int i = 0; i < rc; ++i) {
+      ++stats_.datagrams_received;
+      published += Decode(recv_buffers_[static_cast<size_t>(i)].data(), msgs[static_cast<size_t>(i)].msg_len);
+    }
+    return published;
+  }
+
+  /** Parse one datagram and re-publish runs of records sharing sender_id and priority. */
+  uint32_t Decode(const uint8_t* data, uint32_t length) noexcept {
+    BridgeFrameHeader frame{};
+    if (length < sizeof(frame)) {
+      ++stats_.decode_errors;
+      return 0U;
+    }
+    (void)std::memcpy(&frame, data, sizeof(frame));
+    if ((frame.magic != FRAME_MAGIC) || (frame.version != WIRE_VERSION) || (frame.type_hash != TYPE_HASH)) {
+      ++stats_.decode_errors;
+      return 0U;
+    }
+
+    uint32_t offset = static_cast<uint32_t>(sizeof(frame));
+    uint32_t run = 0U;
+    uint32_t run_sender = 0U;
+    uint8_t run_priority = 0U;
+    uint32_t published = 0U;
+    for (uint32_t r = 0U; r < frame.record_count; ++r) {
+      BridgeRecordHeader record{};
+      if ((length - offset) < sizeof(record)) {
+        ++stats_.decode_errors;
+        break;
+      }
+      (void)std::memcpy(&record, data + offset, sizeof(record));
+      offset += static_cast<uint32_t>(sizeof(record));
+      if (((length - offset) < record.payload_size) ||
+          (record.priority > static_cast<uint8_t>(MessagePriority::HIGH))) {
+        ++stats_.decode_errors;
+        break;
+      }
+      if ((run > 0U) && ((record.sender_id != run_sender) || (record.priority != run_priority))) {
+        published += PublishRun(run, run_sender, run_priority);
+        run = 0U;
+      }
+      if (DecodePayload(record, data + offset, decoded_[run])) {
+        run_sender = record.sender_id;
+        run_priority = record.priority;
+        ++run;
+      } else {
+        ++stats_.decode_errors;
+      }
+      offset += record.payload_size;
+    }
+    if (run > 0U) {
+      published += PublishRun(run, run_sender, run_priority);
+    }
+    return published;
+  }
+
+  uint32_t PublishRun(uint32_t count, uint32_t sender_id, uint8_t priority) noexcept {
+    const uint32_t accepted = this->Bus().PublishBatch(decoded_.begin(), decoded_.begin() + count, sender_id,
+                                                       static_cast<MessagePriority>(priority));
+    stats_.messages_received += accepted;
+    stats_.republish_dropped += count - accepted;
+    return accepted;
+  }
+
+  static bool DecodePayload(const BridgeRecordHeader& record, const uint8_t* bytes, PayloadVariant& out) noexcept {
+    return detail::DecodeTrivialPayload(record.type_index, bytes, record.payload_size, out);
+  }
+
+  int fd_{-1};
+  bool has_remote_{false};
+  sockaddr_in remote_{};
+  uint64_t flush_deadline_ns_{0U};
+  uint64_t oldest_pending_ns_{0U};
+
+  std::array<Datagram, SEND_BATCH> send_buffers_{};
+  std::array<uint32_t, SEND_BATCH> send_lengths_{};
+  uint32_t queued_{0U};       // datagrams ready in send_buffers_[0, queued_)
+  uint32_t open_records_{0U}; // records in send_buffers_[queued_]
+  uint32_t open_bytes_{0U};
+
+  std::array<Datagram, SEND_BATCH> recv_buffers_{};
+  std::array<PayloadVariant, MAX_RECORDS_PER_DATAGRAM> decoded_{};
+  BridgeStatistics stats_{};
+};
+
+}  // namespace mccc
+
+#endif  // MCCC_UDP_BRIDGE_HPP_
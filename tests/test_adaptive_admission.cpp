@@ -0,0 +1,147 @@
+/**
+ * @file test_adaptive_admission.cpp
+ * @brief Unit tests for the CoDel-style adaptive admission controller.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <mccc/mccc.hpp>
+
+#include <memory>
+
+struct AaWork {
+  uint32_t seq;
+};
+
+struct AaAlarm {
+  uint32_t code;
+};
+
+namespace {
+
+/** Manually advanced clock: one loop iteration = one millisecond. */
+struct AaClock {
+  static uint64_t NowNs() noexcept { return now_ns; }
+  static uint64_t now_ns;
+};
+uint64_t AaClock::now_ns = 0U;
+
+constexpr uint64_t kMs = 1000000U;  // ns
+
+using AaPayload = std::variant<AaWork, AaAlarm>;
+using AaEnvelope = mccc::MessageEnvelope<AaPayload>;
+using AaBus = mccc::AsyncBus<AaPayload, 1024U, AaClock>;
+
+constexpr mccc::AdaptiveAdmissionConfig kConfig{1000U, 10000U, 16U};  // 1 ms target, 10 ms interval
+
+/** Delivered-message sojourn, measured against the manual clock. */
+struct SojournProbe {
+  uint64_t max_us{0U};
+  uint64_t delivered{0U};
+};
+
+/**
+ * Twice the incoming rate the consumer drains: 20 LOW messages per tick,
+ * ProcessBatch(10). Tracks the worst sojourn over the last half of the run.
+ */
+void RunOverload(AaBus& bus, SojournProbe& probe, uint32_t ticks) {
+  uint32_t seq = 0U;
+  for (uint32_t t = 0U; t < ticks; ++t) {
+    if (t == ticks / 2U) {
+      probe = SojournProbe{};
+    }
+    for (uint32_t i = 0U; i < 20U; ++i) {
+      (void)bus.PublishWithPriority(AaWork{seq++}, 1U, mccc::MessagePriority::LOW);
+    }
+    (void)bus.ProcessBatch(10U);
+    AaClock::now_ns += kMs;
+  }
+}
+
+void Probe(AaBus& bus, SojournProbe& probe) {
+  bus.Subscribe<AaWork>([&probe](const AaEnvelope& env) {
+    const uint64_t now_us = AaClock::now_ns / 1000U;
+    const uint64_t sojourn = now_us - env.header.timestamp_us;
+    probe.max_us = (sojourn > probe.max_us) ? sojourn : probe.max_us;
+    ++probe.delivered;
+  });
+}
+
+}  // namespace
+
+TEST_CASE("Static thresholds apply until adaptive admission is enabled", "[AdaptiveAdmission]") {
+  AaClock::now_ns = 1000U * kMs;
+  auto bus = std::make_unique<AaBus>();
+  SojournProbe probe;
+  Probe(*bus, probe);
+
+  mccc::AdmissionSnapshot snap = bus->GetAdmissionSnapshot();
+  REQUIRE(snap.low_limit == AaBus::LOW_PRIORITY_THRESHOLD);
+  REQUIRE(snap.medium_limit == AaBus::MEDIUM_PRIORITY_THRESHOLD);
+  REQUIRE(snap.high_limit == AaBus::HIGH_PRIORITY_THRESHOLD);
+
+  RunOverload(*bus, probe, 200U);
+  snap = bus->GetAdmissionSnapshot();
+  REQUIRE(snap.low_limit == AaBus::LOW_PRIORITY_THRESHOLD);
+  REQUIRE(snap.drain_rate_per_sec == 0U);
+  // The LOW backlog parks at 60% of the ring: every message waits ~60 ms
+  REQUIRE(bus->QueueDepth() + 10U >= AaBus::LOW_PRIORITY_THRESHOLD);
+  REQUIRE(probe.max_us > 50000U);
+}
+
+TEST_CASE("A standing queue shrinks LOW and MEDIUM limits to the drain rate", "[AdaptiveAdmission]") {
+  AaClock::now_ns = 1000U * kMs;
+  auto bus = std::make_unique<AaBus>();
+  SojournProbe probe;
+  Probe(*bus, probe);
+  bus->EnableAdaptiveAdmission(kConfig);
+
+  RunOverload(*bus, probe, 200U);
+  const mccc::AdmissionSnapshot snap = bus->GetAdmissionSnapshot();
+  REQUIRE(snap.low_limit >= kConfig.min_depth);
+  REQUIRE(snap.low_limit <= 64U);
+  REQUIRE(snap.medium_limit <= 2U * snap.low_limit);
+  REQUIRE(snap.high_limit == AaBus::HIGH_PRIORITY_THRESHOLD);
+  REQUIRE(snap.drain_rate_per_sec == 10000U);
+  REQUIRE(bus->QueueDepth() <= snap.medium_limit);
+  REQUIRE(probe.delivered == 1000U);  // throughput unchanged, only the backlog is shorter
+  REQUIRE(probe.max_us < 10000U);  // a few target delays instead of ~60 ms
+  REQUIRE(bus->GetStatistics().low_priority_dropped > 0U);
+
+  // HIGH is never adapted: admitted well above the LOW / MEDIUM limits
+  for (uint32_t i = 0U; i < 100U; ++i) {
+    REQUIRE(bus->PublishWithPriority(AaAlarm{i}, 1U, mccc::MessagePriority::HIGH));
+  }
+  REQUIRE_FALSE(bus->PublishWithPriority(AaWork{0U}, 1U, mccc::MessagePriority::MEDIUM));
+  REQUIRE(bus->GetStatistics().medium_priority_dropped == 1U);
+
+  bus->DisableAdaptiveAdmission();
+  REQUIRE(bus->GetAdmissionSnapshot().low_limit == AaBus::LOW_PRIORITY_THRESHOLD);
+  REQUIRE(bus->PublishWithPriority(AaWork{0U}, 1U, mccc::MessagePriority::MEDIUM));
+}
+
+TEST_CASE("Limits relax back to the static thresholds once the queue drains", "[AdaptiveAdmission]") {
+  AaClock::now_ns = 1000U * kMs;
+  auto bus = std::make_unique<AaBus>();
+  SojournProbe probe;
+  Probe(*bus, probe);
+  bus->EnableAdaptiveAdmission(kConfig);
+  RunOverload(*bus, probe, 100U);
+  REQUIRE(bus->GetAdmissionSnapshot().low_limit <= 64U);
+
+  // Light load through ProcessBatchWith: every batch empties the ring
+  uint32_t visited = 0U;
+  for (uint32_t t = 0U; t < 200U; ++t) {
+    for (uint32_t i = 0U; i < 5U; ++i) {
+      (void)bus->PublishWithPriority(AaWork{i}, 1U, mccc::MessagePriority::LOW);
+    }
+    while (bus->ProcessBatchWith(
+               mccc::make_overloaded([&visited](const AaWork&) { ++visited; }, [](const AaAlarm&) {})) > 0U) {
+    }
+    AaClock::now_ns += kMs;
+  }
+  const mccc::AdmissionSnapshot snap = bus->GetAdmissionSnapshot();
+  REQUIRE(visited >= 1000U);
+  REQUIRE(snap.min_sojourn_us == 0U);
+  REQUIRE(snap.low_limit == AaBus::LOW_PRIORITY_THRESHOLD);
+  REQUIRE(snap.medium_limit == AaBus::MEDIUM_PRIORITY_THRESHOLD);
+}
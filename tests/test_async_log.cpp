@@ -0,0 +1,216 @@
+/**
+ * @file test_async_log.cpp
+ * @brief Unit tests for the asynchronous log_macro.hpp backend (LOG_ASYNC=1).
+ */
+
+#define LOG_LEVEL LOG_LEVEL_TRACE
+#define LOG_ASYNC 1
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "log_macro.hpp"
+
+#include <unistd.h>
+
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+/** Redirects the async backend into a temporary file for one test. */
+class LogCapture {
+ public:
+  LogCapture() {
+    char path[] = "/tmp/mccc_async_log_XXXXXX";
+    fd_ = ::mkstemp(path);
+    ::unlink(path);
+    LOG_FLUSH();
+    log_internal::AsyncLogBackend::Instance().set_fd(fd_);
+  }
+
+  ~LogCapture() {
+    LOG_FLUSH();
+    log_internal::AsyncLogBackend::Instance().set_fd(STDERR_FILENO);
+    ::close(fd_);
+  }
+
+  LogCapture(const LogCapture&) = delete;
+  LogCapture& operator=(const LogCapture&) = delete;
+
+  /** Flush and return the message part of every line written so far. */
+  std::vector<std::string> Messages() {
+    LOG_FLUSH();
+    std::string all;
+    char buf[4096];
+    ssize_t n = 0;
+    off_t off = 0;
+    while ((n = ::pread(fd_, buf, sizeof(buf), off)) > 0) {
+      all.append(buf, static_cast<size_t>(n));
+      off += n;
+    }
+    std::vector<std::string> out;
+    size_t pos = 0U;
+    while (pos < all.size()) {
+      const size_t end = all.find('\n', pos);
+      std::string line = all.substr(pos, end - pos);
+      const size_t msg = line.find("] ", line.find(":"));  // after [file:line:func]
+      out.push_back((msg == std::string::npos) ? line : line.substr(msg + 2U));
+      pos = end + 1U;
+    }
+    return out;
+  }
+
+ private:
+  int fd_{-1};
+};
+
+std::string Printf(const char* fmt, ...) __attribute__((format(printf, 1, 2)));
+std::string Printf(const char* fmt, ...) {
+  char buf[512];
+  va_list args;
+  va_start(args, fmt);
+  std::vsnprintf(buf, sizeof(buf), fmt, args);
+  va_end(args);
+  return buf;
+}
+
+enum AlColor { kRed = 1, kGreen = 2 };
+
+}  // namespace
+
+TEST_CASE("Async records format like printf", "[AsyncLog]") {
+  STATIC_REQUIRE(sizeof(log_internal::AsyncLogRecord) == 256U);
+  LogCapture capture;
+  const uint64_t big = 0xFFFFFFFFFFFFFFFFULL;
+  const int neg = -42;
+  const short small = -7;
+  const char letter = 'x';
+  const float f = 1.5F;
+  const long double ld = 2.25L;
+  const int* ptr = &neg;
+  char scratch[16];
+  std::strcpy(scratch, "volatile");
+  const char* null_str = nullptr;
+
+  LOG_INFO("plain message with 100%% literal");
+  LOG_INFO("ints %d %u %ld %lu %lld %hd %c", neg, 7U, -3L, 9UL, -5LL, small, letter);
+  LOG_INFO("u64 %" PRIu64 " hex %08x", big, 0xBEEFU);
+  LOG_INFO("float %.3f %e %Lf", static_cast<double>(f), 1e-9, ld);
+  LOG_INFO("ptr %p null %s", static_cast<const void*>(ptr), null_str);
+  LOG_INFO("width [%*d] [%-*.*s] %%", 6, neg, 8, 3, "abcdef");
+  LOG_INFO("enum %d bool %d", kGreen, true);
+  LOG_WARN("copied %s", scratch);
+  std::strcpy(scratch, "clobbered");  // the record holds a copy, not the pointer
+
+  const std::vector<std::string> lines = capture.Messages();
+  REQUIRE(lines.size() == 8U);
+  REQUIRE(lines[0] == "plain message with 100%% literal");  // no-args form is verbatim
+  REQUIRE(lines[1] == Printf("ints %d %u %ld %lu %lld %hd %c", neg, 7U, -3L, 9UL, -5LL, small, letter));
+  REQUIRE(lines[2] == Printf("u64 %" PRIu64 " hex %08x", big, 0xBEEFU));
+  REQUIRE(lines[3] == Printf("float %.3f %e %Lf", static_cast<double>(f), 1e-9, ld));
+  REQUIRE(lines[4] == Printf("ptr %p null (null)", static_cast<const void*>(ptr)));
+  REQUIRE(lines[5] == Printf("width [%*d] [%-*.*s] %%", 6, neg, 8, 3, "abcdef"));
+  REQUIRE(lines[6] == Printf("enum %d bool %d", kGreen, 1));
+  REQUIRE(lines[7] == "copied volatile");
+}
+
+TEST_CASE("Long string arguments are truncated to the record", "[AsyncLog]") {
+  LogCapture capture;
+  const std::string long_a(200U, 'a');
+  const std::string b(10U, 'b');
+  LOG_INFO("%s|%s|%d", long_a.c_str(), b.c_str(), 5);
+
+  const std::vector<std::string> lines = capture.Messages();
+  REQUIRE(lines.size() == 1U);
+  // The first string takes the text area; the second no longer fits
+  REQUIRE(lines[0] == std::string(log_internal::LOG_ASYNC_TEXT_BYTES, 'a') + "||5");
+}
+
+TEST_CASE("String copies stop at the precision and the array extent", "[AsyncLog]") {
+  LogCapture capture;
+  // Unterminated data, as from a string_view or a packet: printf reads only the precision
+  std::unique_ptr<char[]> packet(new char[4]);
+  std::memcpy(packet.get(), "abcd", 4U);
+  char raw[3] = {'x', 'y', 'z'};
+  LOG_INFO("[%.*s] [%.2s] [%-6.3s] [%.4s]", 4, packet.get(), "literal", "abcdef", packet.get());
+  LOG_INFO("[%.3s] [%*.*s] [%s]", raw, 5, 1, raw, "tail");
+
+  const std::vector<std::string> lines = capture.Messages();
+  REQUIRE(lines.size() == 2U);
+  REQUIRE(lines[0] == "[abcd] [li] [abc   ] [abcd]");
+  REQUIRE(lines[1] == "[xyz] [    x] [tail]");
+}
+
+TEST_CASE("Full rings drop and count instead of blocking", "[AsyncLog]") {
+  LogCapture capture;
+  const uint64_t dropped_before = log_internal::log_dropped();
+  constexpr uint32_t kBurst = 20000U;
+  for (uint32_t i = 0U; i < kBurst; ++i) {
+    LOG_DEBUG("burst %u", i);
+  }
+  const std::vector<std::string> lines = capture.Messages();
+  const uint64_t dropped = log_internal::log_dropped() - dropped_before;
+
+  uint32_t written = 0U;
+  uint32_t last = 0U;
+  bool ordered = true;
+  bool reported = (dropped == 0U);
+  for (const std::string& line : lines) {
+    uint32_t seq = 0U;
+    if (std::sscanf(line.c_str(), "burst %u", &seq) == 1) {
+      ordered = ordered && ((written == 0U) || (seq > last));
+      last = seq;
+      ++written;
+    } else if (line.find("async log records dropped") != std::string::npos) {
+      reported = true;
+    }
+  }
+  REQUIRE(ordered);
+  REQUIRE(written + dropped == kBurst);
+  REQUIRE(reported);
+}
+
+TEST_CASE("Each thread logs through its own ring", "[AsyncLog]") {
+  LogCapture capture;
+  constexpr uint32_t kThreads = 4U;
+  constexpr uint32_t kPerThread = 200U;  // below the ring size: nothing dropped
+  const uint64_t dropped_before = log_internal::log_dropped();
+  std::vector<std::thread> threads;
+  for (uint32_t t = 0U; t < kThreads; ++t) {
+    threads.emplace_back([t]() {
+      for (uint32_t i = 0U; i < kPerThread; ++i) {
+        LOG_INFO("t=%u seq=%u chk=%u", t, i, t * 1000003U + i);
+      }
+    });
+  }
+  for (auto& th : threads) {
+    th.join();  // rings of exited threads are still drained
+  }
+  const std::vector<std::string> lines = capture.Messages();
+
+  std::vector<uint32_t> next(kThreads, 0U);
+  uint32_t bad = 0U;
+  for (const std::string& line : lines) {
+    uint32_t t = 0U;
+    uint32_t seq = 0U;
+    uint32_t chk = 0U;
+    if ((std::sscanf(line.c_str(), "t=%u seq=%u chk=%u", &t, &seq, &chk) != 3) || (t >= kThreads) ||
+        (chk != t * 1000003U + seq) || (seq != next[t])) {
+      ++bad;
+      continue;
+    }
+    ++next[t];
+  }
+  REQUIRE(bad == 0U);
+  REQUIRE(log_internal::log_dropped() == dropped_before);
+  for (uint32_t t = 0U; t < kThreads; ++t) {
+    REQUIRE(next[t] == kPerThread);
+  }
+}
@@ -0,0 +1,433 @@
+/**
+ * @file test_buffer_pool.cpp
+ * @brief Unit tests for DMABufferPool (sharded free list, per-thread magazines).
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <mccc/mccc.hpp>
+
+#include "buffer_pool.hpp"
+
+#include <atomic>
+#include <future>
+#include <thread>
+#include <vector>
+
+using streaming::BufferPoolOptions;
+using streaming::DataToken;
+using streaming::DMABufferPool;
+using streaming::SharedDataToken;
+
+namespace {
+
+std::vector<DataToken> BorrowAll(DMABufferPool& pool) {
+  std::vector<DataToken> tokens;
+  while (true) {
+    DataToken token = pool.Borrow();
+    if (!token.Valid()) {
+      break;
+    }
+    tokens.push_back(std::move(token));
+  }
+  return tokens;
+}
+
+}  // namespace
+
+TEST_CASE("Small pool runs without a thread cache", "[BufferPool]") {
+  DMABufferPool pool(256U, 8U);
+  REQUIRE(pool.MagazineCapacity() == 0U);
+  REQUIRE(pool.TotalBuffers() == 8U);
+  REQUIRE(pool.AvailableBuffers() == 8U);
+
+  std::vector<DataToken> tokens = BorrowAll(pool);
+  REQUIRE(tokens.size() == 8U);
+  REQUIRE(pool.AvailableBuffers() == 0U);
+  REQUIRE(tokens[0].Size() == 256U);
+
+  tokens.clear();
+  REQUIRE(pool.AvailableBuffers() == 8U);
+  REQUIRE(pool.BorrowCount() == 8U);
+  REQUIRE(pool.ReturnCount() == 8U);
+}
+
+TEST_CASE("Magazine serves borrow/return LIFO and keeps counts exact", "[BufferPool]") {
+  DMABufferPool pool(64U, 1024U);
+  REQUIRE(pool.MagazineCapacity() == STREAMING_POOL_MAGAZINE_SIZE);
+
+  const uint8_t* first = nullptr;
+  {
+    DataToken token = pool.Borrow();
+    REQUIRE(token.Valid());
+    first = token.Data();
+    // Buffers refilled into the magazine still count as available
+    REQUIRE(pool.AvailableBuffers() == 1023U);
+  }
+  REQUIRE(pool.AvailableBuffers() == 1024U);
+
+  // The most recently returned buffer comes back first
+  for (uint32_t i = 0U; i < 100U; ++i) {
+    DataToken token = pool.Borrow();
+    REQUIRE(token.Data() == first);
+  }
+  REQUIRE(pool.BorrowCount() == 101U);
+  REQUIRE(pool.ReturnCount() == 101U);
+}
+
+TEST_CASE("Magazine refills across shards until the pool is empty", "[BufferPool]") {
+  DMABufferPool pool(64U, 1024U);
+  std::vector<DataToken> tokens = BorrowAll(pool);
+  REQUIRE(tokens.size() == 1024U);
+  REQUIRE(pool.AvailableBuffers() == 0U);
+
+  tokens.clear();  // overflows the magazine, flushing half at a time
+  REQUIRE(pool.AvailableBuffers() == 1024U);
+  REQUIRE(BorrowAll(pool).size() == 1024U);
+  REQUIRE(pool.BorrowCount() == 2048U);
+  REQUIRE(pool.ReturnCount() == 2048U);
+}
+
+TEST_CASE("Buffers parked by a live thread come back after ReleaseThreadCache", "[BufferPool]") {
+  DMABufferPool pool(64U, 1024U);
+  const uint32_t parked = pool.MagazineCapacity() / 2U;
+
+  std::promise<bool> borrowed;
+  std::promise<void> release;
+  std::promise<void> released;
+  std::thread worker([&]() {
+    {
+      DataToken token = pool.Borrow();  // refills half a magazine
+      borrowed.set_value(token.Valid());
+    }
+    release.get_future().wait();
+    pool.ReleaseThreadCache();
+    released.set_value();
+  });
+
+  REQUIRE(borrowed.get_future().get());
+  REQUIRE(BorrowAll(pool).size() == 1024U - parked);
+
+  release.set_value();
+  released.get_future().wait();
+  REQUIRE(BorrowAll(pool).size() == 1024U);
+  worker.join();
+}
+
+TEST_CASE("Magazine of an exited thread is stolen when the shards run dry", "[BufferPool]") {
+  DMABufferPool pool(64U, 1024U);
+  std::thread([&pool]() {
+    std::vector<DataToken> tokens;
+    for (uint32_t i = 0U; i < 4U; ++i) {
+      tokens.push_back(pool.Borrow());
+    }
+  }).join();
+
+  REQUIRE(pool.AvailableBuffers() == 1024U);
+  REQUIRE(BorrowAll(pool).size() == 1024U);
+}
+
+TEST_CASE("Threads can be pinned to a shard", "[BufferPool]") {
+  BufferPoolOptions options;
+  options.shard_count = 4U;
+  options.thread_cache = false;
+  DMABufferPool pool(64U, 8U, options);
+  REQUIRE(pool.ShardCount() == 4U);
+  REQUIRE_FALSE(pool.BindThreadToShard(4U));
+  REQUIRE(pool.BindThreadToShard(2U));
+
+  // Still work-steals from the other shards once its own is empty
+  REQUIRE(BorrowAll(pool).size() == 8U);
+  REQUIRE(pool.AvailableBuffers() == 8U);
+}
+
+TEST_CASE("Concurrent borrow/return keeps the pool consistent", "[BufferPool]") {
+  constexpr uint32_t kThreads = 4U;
+  constexpr uint32_t kIterations = 50000U;
+  DMABufferPool pool(64U, 2048U);
+  std::atomic<uint32_t> failures{0U};
+
+  std::vector<std::thread> threads;
+  for (uint32_t t = 0U; t < kThreads; ++t) {
+    threads.emplace_back([&pool, &failures, t]() {
+      if (!pool.BindThreadToShard(t % pool.ShardCount())) {
+        failures.fetch_add(1U, std::memory_order_relaxed);
+      }
+      std::vector<DataToken> held;
+      for (uint32_t i = 0U; i < kIterations; ++i) {
+        DataToken token = pool.Borrow();
+        if (!token.Valid()) {
+          failures.fetch_add(1U, std::memory_order_relaxed);
+          continue;
+        }
+        if ((i % 7U) == 0U) {
+          held.push_back(std::move(token));  // released out of order below
+        }
+        if (held.size() > 40U) {
+          held.clear();
+        }
+      }
+    });
+  }
+  for (auto& th : threads) {
+    th.join();
+  }
+
+  REQUIRE(failures.load() == 0U);
+  REQUIRE(pool.AvailableBuffers() == 2048U);
+  REQUIRE(pool.BorrowCount() == kThreads * kIterations);
+  REQUIRE(pool.ReturnCount() == kThreads * kIterations);
+  REQUIRE(BorrowAll(pool).size() == 2048U);
+}
+
+TEST_CASE("Default pool has no slab", "[BufferPool]") {
+  DMABufferPool pool(64U, 8U);
+  REQUIRE(pool.Slab().base == nullptr);
+  REQUIRE(pool.Slab().bytes == 0U);
+}
+
+TEST_CASE("Slab pool places buffers at base + index * stride", "[BufferPool]") {
+  BufferPoolOptions options;
+  options.slab = true;
+  DMABufferPool pool(1000U, 100U, options);
+
+  const streaming::SlabExtent slab = pool.Slab();
+  REQUIRE(slab.base != nullptr);
+  REQUIRE(slab.stride >= 1000U);
+  REQUIRE(slab.stride % STREAMING_DMA_ALIGNMENT == 0U);
+  REQUIRE(slab.bytes >= static_cast<size_t>(slab.stride) * 100U);
+  REQUIRE(slab.numa_node == -1);
+
+  std::vector<DataToken> tokens = BorrowAll(pool);
+  REQUIRE(tokens.size() == 100U);
+  std::vector<bool> seen(100U, false);
+  for (const DataToken& token : tokens) {
+    REQUIRE(token.Size() == 1000U);
+    REQUIRE(token.Data() >= slab.base);
+    const size_t offset = static_cast<size_t>(token.Data() - slab.base);
+    REQUIRE(offset % slab.stride == 0U);
+    const size_t index = offset / slab.stride;
+    REQUIRE(index < 100U);
+    REQUIRE_FALSE(seen[index]);
+    seen[index] = true;
+  }
+
+  // Buffers are writable across their whole length
+  uint8_t* last = const_cast<uint8_t*>(tokens.back().Data());
+  for (uint32_t i = 0U; i < 1000U; ++i) {
+    last[i] = static_cast<uint8_t>(i);
+  }
+  tokens.clear();
+  REQUIRE(pool.AvailableBuffers() == 100U);
+}
+
+TEST_CASE("Slab huge pages and NUMA binding degrade gracefully", "[BufferPool]") {
+  BufferPoolOptions options;
+  options.slab = true;
+  options.huge_pages = true;
+  options.numa_node = 0;
+  DMABufferPool pool(4096U, 64U, options);
+
+  // Either may be unavailable (no reserved huge pages, no NUMA); the slab still works
+  const streaming::SlabExtent slab = pool.Slab();
+  REQUIRE(slab.base != nullptr);
+  REQUIRE(slab.bytes >= static_cast<size_t>(slab.stride) * 64U);
+  REQUIRE(((slab.numa_node == 0) || (slab.numa_node == -1)));
+  REQUIRE(BorrowAll(pool).size() == 64U);
+}
+
+TEST_CASE("Borrow(len) sizes the token and tracks occupancy", "[BufferPool]") {
+  BufferPoolOptions options;
+  options.thread_cache = false;
+  DMABufferPool pool(512U, 4U, options);
+  REQUIRE(pool.BufferSize() == 512U);
+  REQUIRE_FALSE(pool.Borrow(513U).Valid());
+
+  {
+    DataToken a = pool.Borrow(100U);
+    DataToken b = pool.Borrow(512U);
+    REQUIRE(a.Size() == 100U);
+    REQUIRE(b.Size() == 512U);
+    REQUIRE(pool.InUse() == 2U);
+    std::vector<DataToken> rest = BorrowAll(pool);
+    REQUIRE(rest.size() == 2U);
+    REQUIRE(pool.InUse() == 4U);
+  }
+  REQUIRE(pool.InUse() == 0U);
+  REQUIRE(pool.HighWatermark() == 4U);
+  REQUIRE(pool.ExhaustedCount() == 1U);
+}
+
+TEST_CASE("Size-class pool picks the smallest fitting class", "[BufferPool]") {
+  BufferPoolOptions options;
+  options.thread_cache = false;
+  streaming::SizeClassBufferPool pool({{2U * 1024U * 1024U, 2U}, {256U, 64U}, {9216U, 8U}, {128U, 0U}}, options);
+
+  REQUIRE(pool.ClassCount() == 3U);
+  REQUIRE(pool.Class(0U).BufferSize() == 256U);
+  REQUIRE(pool.Class(1U).BufferSize() == 9216U);
+  REQUIRE(pool.Class(2U).BufferSize() == 2U * 1024U * 1024U);
+  REQUIRE(pool.ClassFor(1U) == 0);
+  REQUIRE(pool.ClassFor(256U) == 0);
+  REQUIRE(pool.ClassFor(257U) == 1);
+  REQUIRE(pool.ClassFor(2U * 1024U * 1024U + 1U) == -1);
+
+  DataToken can = pool.Borrow(8U);
+  DataToken jumbo = pool.Borrow(9000U);
+  REQUIRE(can.Size() == 8U);
+  REQUIRE(jumbo.Size() == 9000U);
+  REQUIRE(pool.ClassStats(0U).in_use == 1U);
+  REQUIRE(pool.ClassStats(1U).in_use == 1U);
+  REQUIRE(pool.ClassStats(2U).in_use == 0U);
+
+  REQUIRE_FALSE(pool.Borrow(3U * 1024U * 1024U).Valid());
+  REQUIRE(pool.OversizeCount() == 1U);
+
+  {
+    // A full class does not spill into a larger one
+    DataToken f1 = pool.Borrow(1000000U);
+    DataToken f2 = pool.Borrow(1000000U);
+    REQUIRE(f2.Valid());
+    REQUIRE_FALSE(pool.Borrow(1000000U).Valid());
+    REQUIRE(pool.ClassStats(1U).in_use == 1U);
+  }
+
+  // Tokens go back to their own class
+  can = DataToken();
+  jumbo = DataToken();
+  for (uint32_t i = 0U; i < pool.ClassCount(); ++i) {
+    REQUIRE(pool.ClassStats(i).in_use == 0U);
+  }
+  const streaming::BufferClassStats frames = pool.ClassStats(2U);
+  REQUIRE(frames.buffer_size == 2U * 1024U * 1024U);
+  REQUIRE(frames.total == 2U);
+  REQUIRE(frames.high_watermark == 2U);
+  REQUIRE(frames.borrows == 2U);
+  REQUIRE(frames.exhausted == 1U);
+}
+
+TEST_CASE("High watermark is an upper bound with magazines", "[BufferPool]") {
+  DMABufferPool pool(64U, 1024U);
+  {
+    DataToken token = pool.Borrow();
+    REQUIRE(pool.InUse() == 1U);
+    REQUIRE(pool.HighWatermark() >= 1U);
+    REQUIRE(pool.HighWatermark() <= pool.MagazineCapacity());
+  }
+  REQUIRE(pool.InUse() == 0U);
+}
+
+TEST_CASE("SharedDataToken clones share one pool-side refcount", "[BufferPool]") {
+  STATIC_REQUIRE(sizeof(SharedDataToken) <= sizeof(DataToken));
+  BufferPoolOptions options;
+  options.thread_cache = false;
+  DMABufferPool pool(128U, 2U, options);
+
+  SharedDataToken frame = pool.BorrowShared(100U);
+  REQUIRE(frame.valid());
+  REQUIRE(frame.size() == 100U);
+  REQUIRE(frame.use_count() == 1U);
+  REQUIRE_FALSE(pool.BorrowShared(129U).valid());
+
+  {
+    SharedDataToken a = frame.Clone();
+    SharedDataToken b = a;
+    REQUIRE(b.data() == frame.data());
+    REQUIRE(frame.use_count() == 3U);
+
+    SharedDataToken c = std::move(b);
+    REQUIRE_FALSE(b.valid());
+    REQUIRE(frame.use_count() == 3U);
+
+    c = a;  // same buffer: count unchanged
+    REQUIRE(frame.use_count() == 3U);
+  }
+  REQUIRE(frame.use_count() == 1U);
+  REQUIRE(pool.InUse() == 1U);
+
+  frame = SharedDataToken();
+  REQUIRE(pool.InUse() == 0U);
+  REQUIRE(pool.ReturnCount() == 1U);
+}
+
+TEST_CASE("Last SharedDataToken released on any thread returns the buffer once", "[BufferPool]") {
+  BufferPoolOptions options;
+  options.thread_cache = false;
+  DMABufferPool pool(128U, 4U, options);
+
+  for (uint32_t round = 0U; round < 50U; ++round) {
+    SharedDataToken frame = pool.BorrowShared();
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0U; t < 4U; ++t) {
+      threads.emplace_back([copy = frame]() mutable {
+        for (uint32_t i = 0U; i < 100U; ++i) {
+          SharedDataToken local = copy.Clone();
+        }
+      });
+    }
+    frame = SharedDataToken();
+    for (auto& th : threads) {
+      th.join();
+    }
+    REQUIRE(pool.InUse() == 0U);
+  }
+  REQUIRE(pool.ReturnCount() == 50U);
+}
+
+namespace {
+
+struct FrameMsg {
+  SharedDataToken frame;
+  uint32_t seq;
+};
+struct TickMsg {
+  uint32_t seq;
+};
+
+using FramePayload = std::variant<FrameMsg, TickMsg>;
+using FrameBus = mccc::AsyncBus<FramePayload, 64U>;
+
+}  // namespace
+
+TEST_CASE("SharedDataToken fans out through the bus with zero copies", "[BufferPool]") {
+  BufferPoolOptions options;
+  options.thread_cache = false;
+  DMABufferPool pool(1024U, 4U, options);
+  auto bus = std::make_unique<FrameBus>();
+
+  std::vector<SharedDataToken> kept;
+  std::vector<const uint8_t*> seen;
+  for (uint32_t i = 0U; i < 3U; ++i) {
+    bus->Subscribe<FrameMsg>([&kept, &seen, i](const FrameBus::EnvelopeType& env) {
+      const FrameMsg& msg = std::get<FrameMsg>(env.payload);
+      seen.push_back(msg.frame.data());
+      if (i > 0U) {
+        kept.push_back(msg.frame);  // outlives the callback
+      }
+    });
+  }
+
+  SharedDataToken frame = pool.BorrowShared();
+  const uint8_t* data = frame.data();
+  REQUIRE(bus->Publish(FrameMsg{std::move(frame), 1U}, 1U));
+  REQUIRE(pool.InUse() == 1U);
+  REQUIRE(bus->ProcessBatch() == 1U);
+
+  REQUIRE(seen == std::vector<const uint8_t*>{data, data, data});
+  REQUIRE(kept.size() == 2U);
+  REQUIRE(kept[0].use_count() == 2U);  // the ring slot no longer holds a reference
+  REQUIRE(pool.InUse() == 1U);
+  kept.clear();
+  REQUIRE(pool.InUse() == 0U);
+
+  // Unkept frames go back as soon as they are dispatched, on both consume paths
+  REQUIRE(bus->Publish(FrameMsg{pool.BorrowShared(), 2U}, 1U));
+  REQUIRE(bus->ProcessBatch() == 1U);
+  kept.clear();
+  REQUIRE(pool.InUse() == 0U);
+
+  REQUIRE(bus->Publish(FrameMsg{pool.BorrowShared(), 3U}, 1U));
+  REQUIRE(bus->Publish(TickMsg{4U}, 1U));
+  REQUIRE(bus->ProcessBatchWith([](const auto&) {}) == 2U);
+  REQUIRE(pool.InUse() == 0U);
+}
@@ -0,0 +1,119 @@
+/**
+ * @file test_bus_instance.cpp
+ * @brief Unit tests for instantiable AsyncBus with per-instance queue depth.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <mccc/component.hpp>
+#include <memory>
+
+struct InstCtrl {
+  uint32_t cmd;
+};
+struct InstData {
+  uint64_t sample;
+};
+
+using InstPayload = std::variant<InstCtrl, InstData>;
+using InstEnvelope = mccc::MessageEnvelope<InstPayload>;
+using SmallBus = mccc::AsyncBus<InstPayload, 1024U>;
+using TinyBus = mccc::AsyncBus<InstPayload, 16U>;
+
+TEST_CASE("Per-instance depth scales thresholds", "[BusInstance]") {
+  STATIC_REQUIRE(SmallBus::MAX_QUEUE_DEPTH == 1024U);
+  STATIC_REQUIRE(SmallBus::LOW_PRIORITY_THRESHOLD == 614U);
+  STATIC_REQUIRE(SmallBus::HIGH_PRIORITY_THRESHOLD == 1013U);
+  STATIC_REQUIRE(TinyBus::MEDIUM_PRIORITY_THRESHOLD == 12U);
+  STATIC_REQUIRE(mccc::AsyncBus<InstPayload>::MAX_QUEUE_DEPTH == MCCC_QUEUE_DEPTH);
+}
+
+TEST_CASE("Ring footprint follows depth and layout", "[BusInstance]") {
+  constexpr size_t kMinSlot = sizeof(std::atomic<uint32_t>) + sizeof(InstEnvelope);
+  STATIC_REQUIRE(TinyBus::RingMemoryBytes() >= 16U * kMinSlot);
+  STATIC_REQUIRE(SmallBus::RingMemoryBytes() == 64U * TinyBus::RingMemoryBytes());
+#if MCCC_COMPACT_RING
+  STATIC_REQUIRE(TinyBus::RingMemoryBytes() < 16U * (kMinSlot + MCCC_CACHELINE_SIZE));
+#else
+  STATIC_REQUIRE((TinyBus::RingMemoryBytes() / 16U) % MCCC_CACHELINE_SIZE == 0U);
+#endif
+}
+
+TEST_CASE("Owned bus instances are independent", "[BusInstance]") {
+  auto ctrl_bus = std::make_unique<SmallBus>();
+  auto data_bus = std::make_unique<SmallBus>();
+
+  uint32_t ctrl_count = 0U;
+  uint32_t data_count = 0U;
+  ctrl_bus->Subscribe<InstCtrl>([&ctrl_count](const InstEnvelope&) { ++ctrl_count; });
+  data_bus->Subscribe<InstCtrl>([&data_count](const InstEnvelope&) { ++data_count; });
+
+  REQUIRE(ctrl_bus->Publish(InstCtrl{1U}, 1U));
+  REQUIRE(ctrl_bus->Publish(InstCtrl{2U}, 1U));
+  REQUIRE(data_bus->Publish(InstCtrl{3U}, 1U));
+
+  REQUIRE(ctrl_bus->QueueDepth() == 2U);
+  REQUIRE(data_bus->QueueDepth() == 1U);
+  REQUIRE(SmallBus::Instance().QueueDepth() == 0U);
+
+  REQUIRE(ctrl_bus->ProcessBatch() == 2U);
+  REQUIRE(data_bus->ProcessBatch() == 1U);
+  REQUIRE(ctrl_count == 2U);
+  REQUIRE(data_count == 1U);
+  REQUIRE(ctrl_bus->GetStatistics().messages_published == 2U);
+  REQUIRE(data_bus->GetStatistics().messages_published == 1U);
+}
+
+TEST_CASE("Small bus admission honours its own depth", "[BusInstance]") {
+  auto bus = std::make_unique<TinyBus>();
+
+  uint32_t accepted = 0U;
+  for (uint32_t i = 0U; i < 32U; ++i) {
+    if (bus->PublishWithPriority(InstData{i}, 1U, mccc::MessagePriority::LOW)) {
+      ++accepted;
+    }
+  }
+  REQUIRE(accepted == TinyBus::LOW_PRIORITY_THRESHOLD);
+  REQUIRE(bus->GetStatistics().low_priority_dropped == 32U - accepted);
+
+  // Ring wraps correctly for a small depth
+  for (uint32_t round = 0U; round < 8U; ++round) {
+    while (bus->ProcessBatch() > 0U) {}
+    for (uint32_t i = 0U; i < TinyBus::HIGH_PRIORITY_THRESHOLD; ++i) {
+      REQUIRE(bus->PublishWithPriority(InstData{i}, 1U, mccc::MessagePriority::HIGH));
+    }
+  }
+  while (bus->ProcessBatch() > 0U) {}
+  REQUIRE(bus->QueueDepth() == 0U);
+}
+
+namespace {
+
+class InstComponent : public mccc::Component<InstPayload, SmallBus> {
+ public:
+  explicit InstComponent(SmallBus& bus) : mccc::Component<InstPayload, SmallBus>(bus) {}
+
+  void Init() {
+    SubscribeSimple<InstCtrl>([this](const InstCtrl& msg, const mccc::MessageHeader&) { last_cmd = msg.cmd; });
+  }
+
+  uint32_t last_cmd{0U};
+};
+
+}  // namespace
+
+TEST_CASE("Component binds to an owned bus", "[BusInstance]") {
+  auto bus = std::make_unique<SmallBus>();
+  {
+    auto comp = std::make_shared<InstComponent>(*bus);
+    comp->Init();
+    REQUIRE(&comp->Bus() == bus.get());
+
+    REQUIRE(bus->Publish(InstCtrl{42U}, 1U));
+    REQUIRE(bus->ProcessBatch() == 1U);
+    REQUIRE(comp->last_cmd == 42U);
+  }
+
+  // Destructor unsubscribed from the owned bus
+  REQUIRE(bus->Publish(InstCtrl{7U}, 1U));
+  REQUIRE(bus->ProcessBatch() == 1U);
+}
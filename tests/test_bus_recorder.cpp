@@ -0,0 +1,310 @@
+/**
+ * @file test_bus_recorder.cpp
+ * @brief Unit tests for BusRecorder / BusReplayer (mmap-backed capture and replay).
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <mccc/bus_recorder.hpp>
+
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct RecPose {
+  uint32_t seq;
+  float x;
+};
+
+struct RecCmd {
+  uint16_t code;
+};
+
+struct RecText {
+  RecText() noexcept = default;
+  explicit RecText(uint32_t v) noexcept : value(v) {}
+  RecText(const RecText& other) noexcept : value(other.value) {}  // not trivially copyable: never recorded
+  RecText& operator=(const RecText& other) noexcept = default;
+  uint32_t value{0U};
+};
+
+using RecPayload = std::variant<RecPose, RecCmd, RecText>;
+using RecEnvelope = mccc::MessageEnvelope<RecPayload>;
+using RecBus = mccc::AsyncBus<RecPayload, 1024U>;
+using Recorder = mccc::BusRecorder<RecPayload, RecBus, 256U>;
+using Replayer = mccc::BusReplayer<RecPayload, RecBus>;
+
+/** Unique capture prefix under /tmp; removes its segments at scope exit. */
+struct CapturePrefix {
+  explicit CapturePrefix(const char* name) {
+    prefix = std::string("/tmp/mccc_rec_") + name + "_" + std::to_string(getpid());
+  }
+  ~CapturePrefix() {
+    for (uint32_t i = 0U; i < 16U; ++i) {
+      (void)std::remove(Segment(i).c_str());
+    }
+  }
+  std::string Segment(uint32_t index) const {
+    char path[256];
+    REQUIRE(mccc::CaptureSegmentPath(path, sizeof(path), prefix.c_str(), index));
+    return path;
+  }
+  std::string prefix;
+};
+
+void DrainBus(RecBus& bus) {
+  while (bus.ProcessBatch() > 0U) {}
+}
+
+}  // namespace
+
+TEST_CASE("Recorded traffic replays with its headers", "[BusRecorder]") {
+  CapturePrefix cap("roundtrip");
+  auto bus = std::make_unique<RecBus>();
+  auto recorder = std::make_shared<Recorder>(*bus);
+  REQUIRE(recorder->RecordAll());
+  mccc::RecorderConfig cfg;
+  cfg.path_prefix = cap.prefix.c_str();
+  REQUIRE(recorder->Start(cfg) == mccc::CaptureError::OK);
+  REQUIRE(recorder->Start(cfg) == mccc::CaptureError::ALREADY_OPEN);
+
+  for (uint32_t i = 0U; i < 100U; ++i) {
+    REQUIRE(bus->PublishWithPriority(RecPose{i, static_cast<float>(i) * 0.5F}, 7U, mccc::MessagePriority::HIGH));
+    REQUIRE(bus->Publish(RecCmd{static_cast<uint16_t>(i)}, 8U));
+  }
+  REQUIRE(bus->Publish(RecText{1U}, 9U));
+  DrainBus(*bus);
+  recorder->Stop();
+  REQUIRE_FALSE(recorder->Running());
+
+  const mccc::RecorderStatistics rs = recorder->GetStatistics();
+  REQUIRE(rs.messages_staged == 200U);
+  REQUIRE(rs.records_written == 200U);
+  REQUIRE(rs.staging_dropped == 0U);
+  REQUIRE(rs.segments_written == 1U);
+  REQUIRE(rs.bytes_written == 100U * (32U + 8U) + 100U * (32U + 8U));
+
+  // Replay onto a fresh bus
+  auto target = std::make_unique<RecBus>();
+  std::vector<RecPose> poses;
+  std::vector<uint16_t> cmds;
+  std::vector<mccc::MessagePriority> priorities;
+  std::vector<uint32_t> senders;
+  target->Subscribe<RecPose>([&](const RecEnvelope& env) {
+    poses.push_back(std::get<RecPose>(env.payload));
+    priorities.push_back(env.header.priority);
+    senders.push_back(env.header.sender_id);
+  });
+  target->Subscribe<RecCmd>([&cmds](const RecEnvelope& env) { cmds.push_back(std::get<RecCmd>(env.payload).code); });
+
+  Replayer replayer(*target);
+  REQUIRE(replayer.Open(cap.Segment(0U).c_str()) == mccc::CaptureError::OK);
+  REQUIRE(replayer.RecordCount() == 200U);
+  mccc::ReplayConfig rc;
+  rc.speedup = 0U;
+  REQUIRE(replayer.Replay(rc) == 200U);
+  DrainBus(*target);
+
+  REQUIRE(poses.size() == 100U);
+  REQUIRE(cmds.size() == 100U);
+  for (uint32_t i = 0U; i < 100U; ++i) {
+    REQUIRE(poses[i].seq == i);
+    REQUIRE(poses[i].x == static_cast<float>(i) * 0.5F);
+    REQUIRE(priorities[i] == mccc::MessagePriority::HIGH);
+    REQUIRE(senders[i] == 7U);
+    REQUIRE(cmds[i] == i);
+  }
+  REQUIRE(replayer.GetStatistics().records_replayed == 200U);
+  REQUIRE(replayer.GetStatistics().decode_errors == 0U);
+}
+
+TEST_CASE("Full segments rotate to the next file", "[BusRecorder]") {
+  CapturePrefix cap("rotate");
+  auto bus = std::make_unique<RecBus>();
+  auto recorder = std::make_shared<Recorder>(*bus);
+  REQUIRE(recorder->Record<RecPose>());
+  mccc::RecorderConfig cfg;
+  cfg.path_prefix = cap.prefix.c_str();
+  cfg.segment_bytes = sizeof(mccc::CaptureFileHeader) + 10U * 40U;  // 10 poses per file
+  REQUIRE(recorder->Start(cfg) == mccc::CaptureError::OK);
+  for (uint32_t i = 0U; i < 25U; ++i) {
+    REQUIRE(bus->Publish(RecPose{i, 0.0F}, 1U));
+  }
+  DrainBus(*bus);
+  recorder->Stop();
+  REQUIRE(recorder->GetStatistics().segments_written == 3U);
+
+  auto target = std::make_unique<RecBus>();
+  std::vector<uint32_t> seqs;
+  target->Subscribe<RecPose>([&seqs](const RecEnvelope& env) { seqs.push_back(std::get<RecPose>(env.payload).seq); });
+  Replayer replayer(*target);
+  mccc::ReplayConfig rc;
+  rc.speedup = 0U;
+  const std::vector<uint64_t> expected_counts{10U, 10U, 5U};
+  for (uint32_t s = 0U; s < 3U; ++s) {
+    REQUIRE(replayer.Open(cap.Segment(s).c_str()) == mccc::CaptureError::OK);
+    REQUIRE(replayer.SegmentIndex() == s);
+    REQUIRE(replayer.RecordCount() == expected_counts[s]);
+    (void)replayer.Replay(rc);
+    replayer.Close();
+  }
+  REQUIRE(replayer.Open(cap.Segment(3U).c_str()) == mccc::CaptureError::OPEN_FAILED);
+  DrainBus(*target);
+  REQUIRE(seqs.size() == 25U);
+  for (uint32_t i = 0U; i < 25U; ++i) {
+    REQUIRE(seqs[i] == i);
+  }
+}
+
+TEST_CASE("Restarting a recorder never overwrites earlier segments", "[BusRecorder]") {
+  CapturePrefix cap("restart");
+  auto bus = std::make_unique<RecBus>();
+  auto recorder = std::make_shared<Recorder>(*bus);
+  REQUIRE(recorder->Record<RecPose>());
+  mccc::RecorderConfig cfg;
+  cfg.path_prefix = cap.prefix.c_str();
+  for (uint32_t run = 0U; run < 2U; ++run) {
+    REQUIRE(recorder->Start(cfg) == mccc::CaptureError::OK);
+    REQUIRE(bus->Publish(RecPose{run, 0.0F}, 1U));
+    DrainBus(*bus);
+    recorder->Stop();
+  }
+
+  auto target = std::make_unique<RecBus>();
+  std::vector<uint32_t> seqs;
+  target->Subscribe<RecPose>([&seqs](const RecEnvelope& env) { seqs.push_back(std::get<RecPose>(env.payload).seq); });
+  Replayer replayer(*target);
+  mccc::ReplayConfig rc;
+  rc.speedup = 0U;
+  for (uint32_t s = 0U; s < 2U; ++s) {
+    REQUIRE(replayer.Open(cap.Segment(s).c_str()) == mccc::CaptureError::OK);
+    REQUIRE(replayer.SegmentIndex() == s);
+    REQUIRE(replayer.RecordCount() == 1U);
+    (void)replayer.Replay(rc);
+    replayer.Close();
+  }
+  DrainBus(*target);
+  REQUIRE(seqs == std::vector<uint32_t>{0U, 1U});
+
+  // A fresh recorder on the same prefix would start at segment 0 again.
+  auto other = std::make_shared<Recorder>(*bus);
+  REQUIRE(other->Start(cfg) == mccc::CaptureError::EXISTS);
+  REQUIRE(replayer.Open(cap.Segment(0U).c_str()) == mccc::CaptureError::OK);
+  REQUIRE(replayer.RecordCount() == 1U);
+  replayer.Close();
+
+  cfg.overwrite = true;
+  REQUIRE(other->Start(cfg) == mccc::CaptureError::OK);
+  other->Stop();
+  REQUIRE(replayer.Open(cap.Segment(0U).c_str()) == mccc::CaptureError::OK);
+  REQUIRE(replayer.RecordCount() == 0U);
+}
+
+TEST_CASE("Replayer rejects foreign and damaged captures", "[BusRecorder]") {
+  CapturePrefix cap("reject");
+  auto bus = std::make_unique<RecBus>();
+  {
+    auto recorder = std::make_shared<Recorder>(*bus);
+    REQUIRE(recorder->Record<RecCmd>());
+    mccc::RecorderConfig cfg;
+    cfg.path_prefix = cap.prefix.c_str();
+    REQUIRE(recorder->Start(cfg) == mccc::CaptureError::OK);
+    for (uint16_t i = 0U; i < 4U; ++i) {
+      REQUIRE(bus->Publish(RecCmd{i}, 1U));
+    }
+    DrainBus(*bus);
+  }  // destructor stops the writer
+  const std::string path = cap.Segment(0U);
+
+  // Different message set
+  using OtherPayload = std::variant<RecCmd, RecPose>;
+  using OtherBus = mccc::AsyncBus<OtherPayload, 64U>;
+  auto other_bus = std::make_unique<OtherBus>();
+  mccc::BusReplayer<OtherPayload, OtherBus> other(*other_bus);
+  REQUIRE(other.Open(path.c_str()) == mccc::CaptureError::TYPE_MISMATCH);
+
+  Replayer replayer(*bus);
+  REQUIRE(replayer.Open(path.c_str()) == mccc::CaptureError::OK);
+  REQUIRE(replayer.Open(path.c_str()) == mccc::CaptureError::ALREADY_OPEN);
+  replayer.Close();
+
+  // Cut into the record area
+  REQUIRE(truncate(path.c_str(), static_cast<off_t>(sizeof(mccc::CaptureFileHeader) + 40U)) == 0);
+  REQUIRE(replayer.Open(path.c_str()) == mccc::CaptureError::TRUNCATED);
+
+  // Not a capture file
+  FILE* file = std::fopen(path.c_str(), "r+b");
+  REQUIRE(file != nullptr);
+  (void)std::fputs("JUNK", file);
+  (void)std::fclose(file);
+  REQUIRE(replayer.Open(path.c_str()) == mccc::CaptureError::LAYOUT_MISMATCH);
+  REQUIRE(truncate(path.c_str(), 8) == 0);
+  REQUIRE(replayer.Open(path.c_str()) == mccc::CaptureError::LAYOUT_MISMATCH);
+  REQUIRE(replayer.RecordCount() == 0U);
+}
+
+TEST_CASE("A full staging ring drops and counts records", "[BusRecorder]") {
+  auto bus = std::make_unique<RecBus>();
+  auto recorder = std::make_shared<Recorder>(*bus);
+  REQUIRE(recorder->Record<RecCmd>());
+  // Writer not started: nothing drains the 256-slot staging ring
+  for (uint16_t i = 0U; i < 266U; ++i) {
+    REQUIRE(bus->PublishWithPriority(RecCmd{i}, 1U, mccc::MessagePriority::HIGH));
+    (void)bus->ProcessBatch();
+  }
+  const mccc::RecorderStatistics rs = recorder->GetStatistics();
+  REQUIRE(rs.messages_staged == 256U);
+  REQUIRE(rs.staging_dropped == 10U);
+  REQUIRE(rs.records_written == 0U);
+}
+
+TEST_CASE("Replay paces by recorded gaps or keeps timestamps", "[BusRecorder]") {
+  CapturePrefix cap("pacing");
+  auto bus = std::make_unique<RecBus>();
+  auto recorder = std::make_shared<Recorder>(*bus);
+  REQUIRE(recorder->Record<RecCmd>());
+  mccc::RecorderConfig cfg;
+  cfg.path_prefix = cap.prefix.c_str();
+  REQUIRE(recorder->Start(cfg) == mccc::CaptureError::OK);
+  for (uint16_t i = 0U; i < 3U; ++i) {
+    REQUIRE(bus->Publish(RecCmd{i}, 1U));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  }
+  DrainBus(*bus);
+  recorder->Stop();
+
+  auto target = std::make_unique<RecBus>();
+  std::vector<uint64_t> stamps;
+  target->Subscribe<RecCmd>([&stamps](const RecEnvelope& env) { stamps.push_back(env.header.timestamp_us); });
+  Replayer replayer(*target);
+  REQUIRE(replayer.Open(cap.Segment(0U).c_str()) == mccc::CaptureError::OK);
+
+  // Original timing: about 2 x 20 ms
+  auto start = std::chrono::steady_clock::now();
+  REQUIRE(replayer.Replay(mccc::ReplayConfig{}) == 3U);
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  REQUIRE(elapsed >= std::chrono::milliseconds(38));
+
+  // Gaps cut to 1 ms, original timestamps kept
+  mccc::ReplayConfig fast;
+  fast.max_gap_us = 1000U;
+  fast.keep_timestamps = true;
+  start = std::chrono::steady_clock::now();
+  REQUIRE(replayer.Replay(fast) == 3U);
+  elapsed = std::chrono::steady_clock::now() - start;
+  REQUIRE(elapsed >= std::chrono::milliseconds(2));
+  REQUIRE(elapsed < std::chrono::milliseconds(38));
+
+  DrainBus(*target);
+  REQUIRE(stamps.size() == 6U);
+  for (uint32_t i = 0U; i < 3U; ++i) {
+    REQUIRE(stamps[3U + i] < stamps[i]);  // recorded, earlier than the first replay
+  }
+  REQUIRE(stamps[5U] - stamps[3U] >= 38000U);
+}
@@ -0,0 +1,146 @@
+/**
+ * @file test_callback_snapshot.cpp
+ * @brief Unit tests for the lock-free callback table (snapshot publish + grace period).
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <mccc/mccc.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+struct SnapMsg {
+  uint32_t value;
+};
+struct SnapOther {
+  uint8_t unused;
+};
+
+using SnapPayload = std::variant<SnapMsg, SnapOther>;
+using SnapBus = mccc::AsyncBus<SnapPayload, 1024U>;
+using SnapEnvelope = mccc::MessageEnvelope<SnapPayload>;
+
+TEST_CASE("Unsubscribe preserves order of remaining callbacks", "[CallbackSnapshot]") {
+  auto bus = std::make_unique<SnapBus>();
+  std::vector<char> calls;
+
+  auto a = bus->Subscribe<SnapMsg>([&calls](const SnapEnvelope&) { calls.push_back('A'); });
+  auto b = bus->Subscribe<SnapMsg>([&calls](const SnapEnvelope&) { calls.push_back('B'); });
+  auto c = bus->Subscribe<SnapMsg>([&calls](const SnapEnvelope&) { calls.push_back('C'); });
+
+  REQUIRE(bus->Unsubscribe(b));
+  REQUIRE_FALSE(bus->Unsubscribe(b));
+
+  // Reuses B's storage entry but dispatches last
+  auto d = bus->Subscribe<SnapMsg>([&calls](const SnapEnvelope&) { calls.push_back('D'); });
+
+  REQUIRE(bus->Publish(SnapMsg{1U}, 1U));
+  REQUIRE(bus->ProcessBatch() == 1U);
+  REQUIRE(calls == std::vector<char>{'A', 'C', 'D'});
+
+  bus->Unsubscribe(a);
+  bus->Unsubscribe(c);
+  bus->Unsubscribe(d);
+}
+
+TEST_CASE("Subscribe fails once the type is full", "[CallbackSnapshot]") {
+  auto bus = std::make_unique<SnapBus>();
+  uint32_t hits = 0U;
+
+  std::vector<mccc::SubscriptionHandle> handles;
+  for (uint32_t i = 0U; i < MCCC_MAX_CALLBACKS_PER_TYPE; ++i) {
+    handles.push_back(bus->Subscribe<SnapMsg>([&hits](const SnapEnvelope&) { ++hits; }));
+    REQUIRE(handles.back().callback_id != static_cast<size_t>(-1));
+  }
+  auto overflow = bus->Subscribe<SnapMsg>([&hits](const SnapEnvelope&) { ++hits; });
+  REQUIRE(overflow.callback_id == static_cast<size_t>(-1));
+
+  REQUIRE(bus->Publish(SnapMsg{1U}, 1U));
+  REQUIRE(bus->ProcessBatch() == 1U);
+  REQUIRE(hits == MCCC_MAX_CALLBACKS_PER_TYPE);
+
+  for (const auto& h : handles) {
+    REQUIRE(bus->Unsubscribe(h));
+  }
+}
+
+TEST_CASE("Unsubscribe waits for an in-flight batch", "[CallbackSnapshot]") {
+  auto bus = std::make_unique<SnapBus>();
+  std::atomic<bool> in_callback{false};
+  std::atomic<bool> release{false};
+  std::atomic<bool> unsubscribed{false};
+
+  auto handle = bus->Subscribe<SnapMsg>([&](const SnapEnvelope&) {
+    in_callback.store(true, std::memory_order_release);
+    while (!release.load(std::memory_order_acquire)) {
+      std::this_thread::yield();
+    }
+  });
+
+  REQUIRE(bus->Publish(SnapMsg{1U}, 1U));
+  std::thread consumer([&bus]() { bus->ProcessBatch(); });
+  while (!in_callback.load(std::memory_order_acquire)) {
+    std::this_thread::yield();
+  }
+
+  std::thread remover([&]() {
+    bus->Unsubscribe(handle);
+    unsubscribed.store(true, std::memory_order_release);
+  });
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  REQUIRE_FALSE(unsubscribed.load(std::memory_order_acquire));
+
+  release.store(true, std::memory_order_release);
+  remover.join();
+  consumer.join();
+  REQUIRE(unsubscribed.load(std::memory_order_acquire));
+}
+
+TEST_CASE("Hot subscribe/unsubscribe never reaches released state", "[CallbackSnapshot]") {
+  auto bus = std::make_unique<SnapBus>();
+  std::atomic<bool> stop{false};
+  std::atomic<uint32_t> violations{0U};
+  std::atomic<uint32_t> dispatched{0U};
+
+  std::thread consumer([&]() {
+    while (!stop.load(std::memory_order_acquire)) {
+      if (bus->ProcessBatch() == 0U) {
+        std::this_thread::yield();
+      }
+    }
+    while (bus->ProcessBatch() > 0U) {}
+  });
+
+  std::thread publisher([&]() {
+    uint32_t seq = 0U;
+    while (!stop.load(std::memory_order_acquire)) {
+      if (!bus->Publish(SnapMsg{seq++}, 1U)) {
+        std::this_thread::yield();
+      }
+    }
+  });
+
+  for (uint32_t i = 0U; i < 500U; ++i) {
+    auto state = std::make_shared<std::atomic<uint32_t>>(42U);
+    auto handle = bus->Subscribe<SnapMsg>([&violations, &dispatched, raw = state.get()](const SnapEnvelope&) {
+      if (raw->load(std::memory_order_relaxed) != 42U) {
+        violations.fetch_add(1U, std::memory_order_relaxed);
+      }
+      dispatched.fetch_add(1U, std::memory_order_relaxed);
+    });
+    std::this_thread::yield();
+    REQUIRE(bus->Unsubscribe(handle));
+    // After Unsubscribe returns the callback is unreachable
+    state->store(0U, std::memory_order_relaxed);
+  }
+
+  stop.store(true, std::memory_order_release);
+  publisher.join();
+  consumer.join();
+
+  REQUIRE(violations.load() == 0U);
+}
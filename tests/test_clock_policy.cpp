@@ -0,0 +1,169 @@
+/**
+ * @file test_clock_policy.cpp
+ * @brief Unit tests for the AsyncBus header timestamp Clock policies.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <mccc/mccc.hpp>
+
+#include <array>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct ClkMsg {
+  uint32_t seq;
+};
+
+using ClkPayload = std::variant<ClkMsg>;
+using ClkEnvelope = mccc::MessageEnvelope<ClkPayload>;
+
+/** User-defined policy: a manually advanced clock. */
+struct ManualClock {
+  static uint64_t NowNs() noexcept { return now_ns; }
+  static uint64_t now_ns;
+};
+uint64_t ManualClock::now_ns = 0U;
+
+template <typename Clock>
+ClkEnvelope PublishAndCapture(bool fast, uint64_t timestamp_us) {
+  auto bus = std::make_unique<mccc::AsyncBus<ClkPayload, 16U, Clock>>();
+  ClkEnvelope captured;
+  bus->template Subscribe<ClkMsg>([&captured](const ClkEnvelope& env) { captured = env; });
+  if (fast) {
+    REQUIRE(bus->PublishFast(ClkMsg{1U}, 1U, timestamp_us));
+  } else {
+    REQUIRE(bus->Publish(ClkMsg{1U}, 1U));
+  }
+  REQUIRE(bus->ProcessBatch() == 1U);
+  return captured;
+}
+
+}  // namespace
+
+TEST_CASE("TscClock never busy-waits inside NowNs", "[ClockPolicy]") {
+  // Before calibration completes NowNs() returns steady_clock time instead of measuring. Each call makes at most one
+  // bounded update attempt and attempts are at least CALIBRATION_NS apart, so the count is load-independent.
+  const uint64_t attempts0 = mccc::TscClock::CalibrationCount();
+  const uint64_t start = mccc::SteadyClock::NowNs();
+  uint64_t previous = 0U;
+  bool monotonic = true;
+  for (uint32_t i = 0U; i < 2000U; ++i) {
+    const uint64_t now = mccc::TscClock::NowNs();
+    monotonic = monotonic && (now + 100000U >= previous);  // a re-anchor may step back slightly
+    previous = now;
+  }
+  const uint64_t elapsed = mccc::SteadyClock::NowNs() - start;
+  const uint64_t attempts = mccc::TscClock::CalibrationCount() - attempts0;
+  REQUIRE(monotonic);
+  REQUIRE(attempts <= (elapsed / mccc::TscClock::CALIBRATION_NS) + 1U);
+}
+
+TEST_CASE("Split 32.32 multiply matches the 128-bit product", "[ClockPolicy]") {
+  const std::array<uint64_t, 6> ticks{0U, 1U, 0xFFFFFFFFU, 0x100000000U, 123456789012345ULL, 0x0000FFFFFFFFFFFFULL};
+  const std::array<uint64_t, 4> mults{1U, 0x55555555U, 0x100000000ULL, 1000ULL << 32U};  // 3 GHz ... 1 MHz
+  for (const uint64_t t : ticks) {
+    for (const uint64_t m : mults) {
+      REQUIRE(mccc::detail::MulShift32Split(t, m) == mccc::detail::MulShift32(t, m));
+    }
+  }
+}
+
+TEST_CASE("TscClock tracks steady_clock", "[ClockPolicy]") {
+  mccc::TscClock::Calibrate();
+  const uint64_t steady0 = mccc::SteadyClock::NowNs();
+  const uint64_t tsc0 = mccc::TscClock::NowNs();
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  const uint64_t steady1 = mccc::SteadyClock::NowNs();
+  const uint64_t tsc1 = mccc::TscClock::NowNs();
+
+  REQUIRE(tsc1 > tsc0);
+  const uint64_t steady_elapsed = steady1 - steady0;
+  const uint64_t tsc_elapsed = tsc1 - tsc0;
+  const uint64_t diff =
+      (tsc_elapsed > steady_elapsed) ? (tsc_elapsed - steady_elapsed) : (steady_elapsed - tsc_elapsed);
+  REQUIRE(diff * 20U < steady_elapsed);  // within 5%
+
+  // Same epoch as steady_clock (calibration anchors the offset)
+  const uint64_t steady = mccc::SteadyClock::NowNs();
+  const uint64_t tsc = mccc::TscClock::NowNs();
+  const uint64_t offset = (tsc > steady) ? (tsc - steady) : (steady - tsc);
+  REQUIRE(offset < 5000000U);
+}
+
+TEST_CASE("CoarseClock is monotonic and close to steady_clock", "[ClockPolicy]") {
+  const uint64_t steady = mccc::SteadyClock::NowNs();
+  const uint64_t coarse = mccc::CoarseClock::NowNs();
+  const uint64_t offset = (coarse > steady) ? (coarse - steady) : (steady - coarse);
+  REQUIRE(offset < 50000000U);
+
+  uint64_t last = coarse;
+  for (uint32_t i = 0U; i < 1000U; ++i) {
+    const uint64_t now = mccc::CoarseClock::NowNs();
+    REQUIRE(now >= last);
+    last = now;
+  }
+}
+
+TEST_CASE("Bus stamps headers from its Clock policy", "[ClockPolicy]") {
+  SECTION("SteadyClock") {
+    const uint64_t before_us = mccc::SteadyClock::NowNs() / 1000U;
+    const ClkEnvelope env = PublishAndCapture<mccc::SteadyClock>(false, 0U);
+    REQUIRE(env.header.timestamp_us >= before_us);
+    REQUIRE(env.header.timestamp_us <= mccc::SteadyClock::NowNs() / 1000U);
+  }
+
+  SECTION("TscClock") {
+    const uint64_t before_us = mccc::SteadyClock::NowNs() / 1000U;
+    const ClkEnvelope env = PublishAndCapture<mccc::TscClock>(false, 0U);
+    REQUIRE(env.header.timestamp_us + 5000U >= before_us);
+    REQUIRE(env.header.timestamp_us <= (mccc::SteadyClock::NowNs() / 1000U) + 5000U);
+  }
+
+  SECTION("NoClock") {
+    const ClkEnvelope env = PublishAndCapture<mccc::NoClock>(false, 0U);
+    REQUIRE(env.header.timestamp_us == 0U);
+    REQUIRE(env.header.msg_id != 0U);
+  }
+
+  SECTION("User-defined policy") {
+    ManualClock::now_ns = 123456789U;
+    const ClkEnvelope env = PublishAndCapture<ManualClock>(false, 0U);
+    REQUIRE(env.header.timestamp_us == 123456U);
+#if MCCC_HEADER_HAS_TIMESTAMP_NS
+    REQUIRE(env.header.timestamp_ns == 123456789U);
+#endif
+  }
+}
+
+TEST_CASE("PublishFast keeps the caller timestamp_us", "[ClockPolicy]") {
+  ManualClock::now_ns = 5000U;
+  const ClkEnvelope env = PublishAndCapture<ManualClock>(true, 42U);
+  REQUIRE(env.header.timestamp_us == 42U);
+#if MCCC_HEADER_HAS_TIMESTAMP_NS
+  REQUIRE(env.header.timestamp_ns == 5000U);  // timestamp_ns is always bus-stamped
+#endif
+}
+
+TEST_CASE("Reserve/commit and batch publish use the Clock policy", "[ClockPolicy]") {
+  using ManualBus = mccc::AsyncBus<ClkPayload, 16U, ManualClock>;
+  auto bus = std::make_unique<ManualBus>();
+  std::vector<uint64_t> stamps;
+  bus->Subscribe<ClkMsg>([&stamps](const ClkEnvelope& env) { stamps.push_back(env.header.timestamp_us); });
+
+  ManualClock::now_ns = 7000U;
+  auto slot = bus->TryReserve<ClkMsg>();
+  REQUIRE(slot);
+  slot->seq = 1U;
+  REQUIRE(slot.Commit(1U));
+
+  ManualClock::now_ns = 9000U;
+  std::array<ClkPayload, 3U> batch{ClkMsg{2U}, ClkMsg{3U}, ClkMsg{4U}};
+  REQUIRE(bus->PublishBatch(batch.begin(), batch.end(), 1U) == 3U);
+
+  REQUIRE(bus->ProcessBatch() == 4U);
+  REQUIRE(stamps == std::vector<uint64_t>{7U, 9U, 9U, 9U});
+}
@@ -0,0 +1,333 @@
+/**
+ * @file test_conflation.cpp
+ * @brief Unit tests for latest-value conflation (ConflationTraits).
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <mccc/lane_bus.hpp>
+#include <mccc/mccc.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+struct CfPose {
+  uint32_t seq;
+  uint32_t check;  // seq * 3: a torn read breaks the relation
+};
+
+struct CfTiny {
+  uint32_t seq;
+};
+
+struct CfCmd {
+  uint32_t value;
+};
+
+template <>
+struct mccc::ConflationTraits<CfPose> {
+  static constexpr uint32_t KEYS = 8U;
+};
+
+template <>
+struct mccc::ConflationTraits<CfTiny> {
+  static constexpr uint32_t KEYS = 2U;
+};
+
+namespace {
+
+using CfPayload = std::variant<CfPose, CfCmd, CfTiny>;
+using CfEnvelope = mccc::MessageEnvelope<CfPayload>;
+using CfBus = mccc::AsyncBus<CfPayload, 64U>;
+
+using PlainBus = mccc::AsyncBus<std::variant<CfCmd>, 64U>;
+using CfLaneBus = mccc::LaneBus<CfPayload, 2U, 64U>;
+
+}  // namespace
+
+TEST_CASE("Conflated publishes overwrite one slot per sender", "[Conflation]") {
+  auto bus = std::make_unique<CfBus>();
+  std::vector<CfPose> seen;
+  std::vector<uint32_t> senders;
+  bus->Subscribe<CfPose>([&](const CfEnvelope& env) {
+    seen.push_back(std::get<CfPose>(env.payload));
+    senders.push_back(env.header.sender_id);
+  });
+
+  for (uint32_t i = 0U; i < 100U; ++i) {
+    REQUIRE(bus->Publish(CfPose{i, i * 3U}, i % 2U));
+  }
+  REQUIRE(bus->QueueDepth() == 0U);  // no ring slot used
+
+  REQUIRE(bus->ProcessBatch() == 2U);
+  REQUIRE(seen.size() == 2U);
+  for (uint32_t i = 0U; i < 2U; ++i) {
+    REQUIRE(seen[i].seq == 98U + senders[i]);  // newest sample of each sender
+  }
+
+  // Each update is delivered once
+  REQUIRE(bus->ProcessBatch() == 0U);
+  REQUIRE(bus->Publish(CfPose{200U, 600U}, 1U));
+  REQUIRE(bus->ProcessBatch() == 1U);
+  REQUIRE(seen.back().seq == 200U);
+
+  const mccc::BusStatisticsSnapshot stats = bus->GetStatistics();
+  REQUIRE(stats.messages_published == 101U);
+  REQUIRE(stats.messages_conflated == 98U);
+  REQUIRE(stats.messages_processed == 3U);
+  REQUIRE(stats.messages_dropped == 0U);
+
+  bus->ResetStatistics();
+  REQUIRE(bus->GetStatistics().messages_conflated == 0U);
+}
+
+TEST_CASE("Queued types keep the ring and their order", "[Conflation]") {
+  auto bus = std::make_unique<CfBus>();
+  std::vector<uint32_t> order;  // pose: 1000 + seq, cmd: value
+  bus->Subscribe<CfPose>(
+      [&order](const CfEnvelope& env) { order.push_back(1000U + std::get<CfPose>(env.payload).seq); });
+  bus->Subscribe<CfCmd>([&order](const CfEnvelope& env) { order.push_back(std::get<CfCmd>(env.payload).value); });
+
+  REQUIRE(bus->Publish(CfCmd{1U}, 1U));
+  REQUIRE(bus->Publish(CfPose{1U, 3U}, 1U));
+  REQUIRE(bus->Publish(CfCmd{2U}, 1U));
+  REQUIRE(bus->Publish(CfPose{2U, 6U}, 1U));
+  REQUIRE(bus->QueueDepth() == 2U);
+
+  // Latest values first, then the ring in publish order
+  REQUIRE(bus->ProcessBatch() == 3U);
+  REQUIRE(order == std::vector<uint32_t>{1002U, 1U, 2U});
+}
+
+TEST_CASE("Senders beyond KEYS fall back to the ring", "[Conflation]") {
+  auto bus = std::make_unique<CfBus>();
+  std::vector<uint32_t> senders;
+  bus->Subscribe<CfTiny>([&senders](const CfEnvelope& env) { senders.push_back(env.header.sender_id); });
+
+  REQUIRE(bus->Publish(CfTiny{1U}, 10U));
+  REQUIRE(bus->Publish(CfTiny{2U}, 11U));
+  REQUIRE(bus->Publish(CfTiny{3U}, 12U));  // both slots owned by other senders
+  REQUIRE(bus->Publish(CfTiny{4U}, 12U));
+  REQUIRE(bus->Publish(CfTiny{5U}, 10U));
+  REQUIRE(bus->QueueDepth() == 2U);
+
+  REQUIRE(bus->ProcessBatch() == 4U);
+  REQUIRE(senders.size() == 4U);
+  REQUIRE(senders[2] == 12U);
+  REQUIRE(senders[3] == 12U);
+}
+
+TEST_CASE("PublishBatch stores conflated elements in their slots", "[Conflation]") {
+  auto bus = std::make_unique<CfBus>();
+  std::vector<uint32_t> order;
+  bus->Subscribe<CfPose>(
+      [&order](const CfEnvelope& env) { order.push_back(1000U + std::get<CfPose>(env.payload).seq); });
+  bus->Subscribe<CfCmd>([&order](const CfEnvelope& env) { order.push_back(std::get<CfCmd>(env.payload).value); });
+
+  std::array<CfPayload, 4U> mixed{CfCmd{1U}, CfPose{1U, 3U}, CfCmd{2U}, CfPose{2U, 6U}};
+  REQUIRE(bus->PublishBatch(mixed.begin(), mixed.end(), 1U) == 4U);
+  REQUIRE(bus->QueueDepth() == 2U);
+
+  // A newer Publish() must win over the batch sample: no stale ring copy follows it
+  REQUIRE(bus->Publish(CfPose{3U, 9U}, 1U));
+  std::array<CfPose, 2U> poses{CfPose{4U, 12U}, CfPose{5U, 15U}};
+  REQUIRE(bus->PublishBatch(poses.begin(), poses.end(), 2U) == 2U);
+  REQUIRE(bus->QueueDepth() == 2U);
+
+  REQUIRE(bus->ProcessBatch() == 4U);
+  REQUIRE(order.size() == 4U);
+  REQUIRE(std::vector<uint32_t>(order.end() - 2, order.end()) == std::vector<uint32_t>{1U, 2U});
+  std::vector<uint32_t> latest(order.begin(), order.end() - 2);
+  std::sort(latest.begin(), latest.end());
+  REQUIRE(latest == std::vector<uint32_t>{1003U, 1005U});
+
+  // All-or-nothing rejects the conflated elements with the ring run
+  for (uint32_t i = 0U; i < CfBus::MEDIUM_PRIORITY_THRESHOLD - 1U; ++i) {
+    REQUIRE(bus->PublishWithPriority(CfCmd{i}, 1U, mccc::MessagePriority::MEDIUM));
+  }
+  std::array<CfPayload, 3U> rejected{CfPose{6U, 18U}, CfCmd{7U}, CfCmd{8U}};
+  REQUIRE(bus->PublishBatch(rejected.begin(), rejected.end(), 1U, mccc::MessagePriority::MEDIUM,
+                            mccc::BatchAdmission::ALL_OR_NOTHING) == 0U);
+  order.clear();
+  while (bus->ProcessBatch() > 0U) {}
+  REQUIRE(std::find(order.begin(), order.end(), 1006U) == order.end());
+}
+
+TEST_CASE("Conflated types bypass priority admission", "[Conflation]") {
+  auto bus = std::make_unique<CfBus>();
+  for (uint32_t i = 0U; i < CfBus::LOW_PRIORITY_THRESHOLD; ++i) {
+    REQUIRE(bus->PublishWithPriority(CfCmd{i}, 1U, mccc::MessagePriority::LOW));
+  }
+  REQUIRE_FALSE(bus->PublishWithPriority(CfCmd{99U}, 1U, mccc::MessagePriority::LOW));
+
+  // The newest state sample is kept under backlog instead of dropped
+  REQUIRE(bus->PublishWithPriority(CfPose{7U, 21U}, 2U, mccc::MessagePriority::LOW));
+  uint32_t pose_seq = 0U;
+  bus->Subscribe<CfPose>([&pose_seq](const CfEnvelope& env) { pose_seq = std::get<CfPose>(env.payload).seq; });
+  REQUIRE(bus->ProcessBatch(1U) == 1U);
+  REQUIRE(pose_seq == 7U);
+  REQUIRE(bus->QueueDepth() == CfBus::LOW_PRIORITY_THRESHOLD);
+}
+
+TEST_CASE("ProcessBatchWith and SubscribeBatch receive latest values", "[Conflation]") {
+  auto bus = std::make_unique<CfBus>();
+  REQUIRE(bus->Publish(CfPose{1U, 3U}, 4U));
+  REQUIRE(bus->Publish(CfPose{2U, 6U}, 4U));
+
+  uint32_t visited = 0U;
+  REQUIRE(bus->ProcessBatchWith(mccc::make_overloaded([&visited](const CfPose& pose) { visited = pose.seq; },
+                                                      [](const CfCmd&) {}, [](const CfTiny&) {})) == 1U);
+  REQUIRE(visited == 2U);
+
+  uint32_t span_sizes = 0U;
+  bus->SubscribeBatch<CfPose>([&span_sizes](CfBus::EnvelopeSpan span) { span_sizes += span.size; });
+  REQUIRE(bus->Publish(CfPose{3U, 9U}, 4U));
+  REQUIRE(bus->Publish(CfPose{4U, 12U}, 5U));
+  REQUIRE(bus->ProcessBatch() == 2U);
+  REQUIRE(span_sizes == 2U);
+}
+
+TEST_CASE("ProcessBatchWait wakes on a latest-value update", "[Conflation]") {
+  auto bus = std::make_unique<CfBus>();
+  std::atomic<uint32_t> delivered{0U};
+  bus->Subscribe<CfPose>([&delivered](const CfEnvelope&) { delivered.fetch_add(1U, std::memory_order_relaxed); });
+  (void)bus->ProcessBatchWait(std::chrono::milliseconds(1));  // enable waiting
+
+  std::thread producer([&bus]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    (void)bus->Publish(CfPose{1U, 3U}, 1U);
+  });
+  const auto start = std::chrono::steady_clock::now();
+  uint32_t processed = 0U;
+  while ((processed == 0U) && (std::chrono::steady_clock::now() - start < std::chrono::seconds(5))) {
+    processed = bus->ProcessBatchWait(std::chrono::seconds(5));
+  }
+  producer.join();
+  REQUIRE(processed == 1U);
+  REQUIRE(delivered.load() == 1U);
+}
+
+TEST_CASE("Concurrent writers never expose a torn sample", "[Conflation]") {
+  auto bus = std::make_unique<CfBus>();
+  bus->SetPerformanceMode(CfBus::PerformanceMode::BARE_METAL);
+  constexpr uint32_t kWriters = 3U;    // one key each: per-key order is checked
+  constexpr uint32_t kShared = 2U;     // extra writers contending for kSharedKey
+  constexpr uint32_t kSharedKey = 7U;
+  constexpr uint32_t kUpdates = 50000U;
+
+  uint32_t torn = 0U;
+  uint32_t delivered = 0U;
+  std::vector<uint32_t> last(kWriters, 0U);
+  uint32_t regressions = 0U;
+  bus->Subscribe<CfPose>([&](const CfEnvelope& env) {
+    const CfPose& pose = std::get<CfPose>(env.payload);
+    torn += (pose.check != pose.seq * 3U) ? 1U : 0U;
+    ++delivered;
+    if (env.header.sender_id == kSharedKey) {
+      return;
+    }
+    const uint32_t writer = env.header.sender_id;
+    regressions += (pose.seq < last[writer]) ? 1U : 0U;
+    last[writer] = pose.seq;
+  });
+
+  std::atomic<uint32_t> finished{0U};
+  std::vector<std::thread> writers;
+  for (uint32_t w = 0U; w < kWriters + kShared; ++w) {
+    const uint32_t key = (w < kWriters) ? w : kSharedKey;
+    writers.emplace_back([&bus, &finished, key]() {
+      for (uint32_t i = 1U; i <= kUpdates; ++i) {
+        (void)bus->Publish(CfPose{i, i * 3U}, key);
+      }
+      finished.fetch_add(1U, std::memory_order_release);
+    });
+  }
+  while (finished.load(std::memory_order_acquire) < kWriters + kShared) {
+    if (bus->ProcessBatch() == 0U) {
+      std::this_thread::yield();
+    }
+  }
+  for (auto& t : writers) {
+    t.join();
+  }
+  while (bus->ProcessBatch() > 0U) {}
+
+  REQUIRE(torn == 0U);
+  REQUIRE(regressions == 0U);
+  REQUIRE(delivered >= kWriters);
+  for (uint32_t w = 0U; w < kWriters; ++w) {
+    REQUIRE(last[w] == kUpdates);
+  }
+}
+
+TEST_CASE("Buses without conflated types are unchanged", "[Conflation]") {
+  STATIC_REQUIRE(mccc::ConflationTraits<CfCmd>::KEYS == 0U);
+  auto bus = std::make_unique<PlainBus>();
+  for (uint32_t i = 0U; i < 3U; ++i) {
+    REQUIRE(bus->Publish(CfCmd{i}, 1U));
+  }
+  REQUIRE(bus->QueueDepth() == 3U);
+  REQUIRE(bus->ProcessBatch() == 3U);
+  REQUIRE(bus->GetStatistics().messages_conflated == 0U);
+}
+
+TEST_CASE("LaneBus delivers latest values in both merge modes", "[Conflation]") {
+  for (const mccc::LaneMerge merge : {mccc::LaneMerge::ROUND_ROBIN, mccc::LaneMerge::TIMESTAMP}) {
+    auto bus = std::make_unique<CfLaneBus>(merge);
+    std::vector<uint32_t> order;  // pose: 1000 + seq, cmd: value
+    (void)bus->Subscribe<CfPose>(
+        [&order](const CfEnvelope& env) { order.push_back(1000U + std::get<CfPose>(env.payload).seq); });
+    (void)bus->Subscribe<CfCmd>(
+        [&order](const CfEnvelope& env) { order.push_back(std::get<CfCmd>(env.payload).value); });
+    CfLaneBus::Producer first = bus->RegisterProducer();
+    CfLaneBus::Producer second = bus->RegisterProducer();
+
+    REQUIRE(first.Publish(CfPose{1U, 3U}, 1U));
+    REQUIRE(bus->QueueDepth() == 0U);
+    REQUIRE(bus->ProcessBatch() == 1U);
+    REQUIRE(order == std::vector<uint32_t>{1001U});
+
+    // Latest values ahead of the ring of their lane; TIMESTAMP: ahead of every lane
+    order.clear();
+    REQUIRE(first.Publish(CfCmd{1U}, 1U));
+    REQUIRE(second.Publish(CfCmd{2U}, 2U));
+    REQUIRE(second.Publish(CfPose{2U, 6U}, 2U));
+    REQUIRE(first.Publish(CfPose{3U, 9U}, 1U));
+    REQUIRE(bus->ProcessBatch() == 4U);
+    std::vector<uint32_t> sorted = order;
+    std::sort(sorted.begin(), sorted.end());
+    REQUIRE(sorted == std::vector<uint32_t>{1U, 2U, 1002U, 1003U});
+    if (merge == mccc::LaneMerge::TIMESTAMP) {
+      REQUIRE(order[0] > 1000U);
+      REQUIRE(order[1] > 1000U);
+    }
+    REQUIRE(bus->ProcessBatch() == 0U);
+  }
+}
+
+TEST_CASE("LaneBus conflated publishes bypass summed-depth admission", "[Conflation]") {
+  auto bus = std::make_unique<CfLaneBus>(mccc::LaneMerge::TIMESTAMP);
+  CfLaneBus::Producer first = bus->RegisterProducer();
+  CfLaneBus::Producer second = bus->RegisterProducer();
+  uint32_t accepted = 0U;
+  while (first.PublishWithPriority(CfCmd{accepted}, 1U, mccc::MessagePriority::LOW) &&
+         second.PublishWithPriority(CfCmd{accepted}, 2U, mccc::MessagePriority::LOW)) {
+    ++accepted;
+  }
+  REQUIRE(bus->QueueDepth() >= CfLaneBus::LOW_PRIORITY_THRESHOLD);
+  REQUIRE(bus->GetStatistics().low_priority_dropped == 1U);
+
+  REQUIRE(first.PublishWithPriority(CfPose{7U, 21U}, 1U, mccc::MessagePriority::LOW));
+  REQUIRE(second.PublishWithPriority(CfPose{8U, 24U}, 2U, mccc::MessagePriority::LOW));
+  REQUIRE(bus->GetStatistics().low_priority_dropped == 1U);
+
+  uint32_t poses = 0U;
+  (void)bus->Subscribe<CfPose>([&poses](const CfEnvelope&) { ++poses; });
+  while (bus->ProcessBatch() > 0U) {
+  }
+  REQUIRE(poses == 2U);
+}
@@ -0,0 +1,214 @@
+/**
+ * @file test_expiry.cpp
+ * @brief Unit tests for message time-to-live (ExpiryTraits).
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <mccc/lane_bus.hpp>
+#include <mccc/mccc.hpp>
+
+#include <memory>
+#include <vector>
+
+struct ExCmd {
+  uint32_t value;
+};
+
+struct ExLog {
+  uint32_t value;
+};
+
+struct ExPose {
+  uint32_t seq;
+};
+
+template <>
+struct mccc::ExpiryTraits<ExCmd> {
+  static constexpr uint64_t TTL_US = 200000U;  // 200 ms
+};
+
+template <>
+struct mccc::ExpiryTraits<ExPose> {
+  static constexpr uint64_t TTL_US = 1000U;
+};
+
+template <>
+struct mccc::ConflationTraits<ExPose> {
+  static constexpr uint32_t KEYS = 4U;
+};
+
+namespace {
+
+/** Manually advanced clock: messages age without sleeping. */
+struct ExClock {
+  static uint64_t NowNs() noexcept { return now_ns; }
+  static uint64_t now_ns;
+};
+uint64_t ExClock::now_ns = 0U;
+
+constexpr uint64_t kMs = 1000000U;  // ns
+
+using ExPayload = std::variant<ExCmd, ExLog, ExPose>;
+using ExEnvelope = mccc::MessageEnvelope<ExPayload>;
+using ExBus = mccc::AsyncBus<ExPayload, 64U, ExClock>;
+
+}  // namespace
+
+TEST_CASE("Expired messages are released without a callback", "[Expiry]") {
+  STATIC_REQUIRE(mccc::ExpiryTraits<ExLog>::TTL_US == 0U);
+  ExClock::now_ns = 1000U * kMs;
+  auto bus = std::make_unique<ExBus>();
+  std::vector<uint32_t> cmds;
+  std::vector<uint32_t> logs;
+  bus->Subscribe<ExCmd>([&cmds](const ExEnvelope& env) { cmds.push_back(std::get<ExCmd>(env.payload).value); });
+  bus->Subscribe<ExLog>([&logs](const ExEnvelope& env) { logs.push_back(std::get<ExLog>(env.payload).value); });
+
+  REQUIRE(bus->Publish(ExCmd{1U}, 1U));
+  REQUIRE(bus->Publish(ExLog{1U}, 1U));
+  ExClock::now_ns += 100U * kMs;
+  REQUIRE(bus->Publish(ExCmd{2U}, 1U));
+  ExClock::now_ns += 150U * kMs;  // ExCmd{1} is 250 ms old, ExCmd{2} 150 ms
+
+  REQUIRE(bus->ProcessBatch() == 3U);  // expired slots count as consumed
+  REQUIRE(cmds == std::vector<uint32_t>{2U});
+  REQUIRE(logs == std::vector<uint32_t>{1U});  // no TTL: never expires
+  REQUIRE(bus->QueueDepth() == 0U);
+
+  const mccc::BusStatisticsSnapshot stats = bus->GetStatistics();
+  REQUIRE(stats.messages_published == 3U);
+  REQUIRE(stats.messages_processed == 2U);
+  REQUIRE(stats.messages_expired == 1U);
+
+  // Exactly TTL old is still delivered
+  REQUIRE(bus->Publish(ExCmd{3U}, 1U));
+  ExClock::now_ns += 200U * kMs;
+  REQUIRE(bus->ProcessBatch() == 1U);
+  REQUIRE(cmds.back() == 3U);
+
+  bus->ResetStatistics();
+  REQUIRE(bus->GetStatistics().messages_expired == 0U);
+}
+
+TEST_CASE("ProcessBatchWith and batch subscribers skip expired messages", "[Expiry]") {
+  ExClock::now_ns = 1000U * kMs;
+  auto bus = std::make_unique<ExBus>();
+
+  REQUIRE(bus->Publish(ExCmd{1U}, 1U));
+  ExClock::now_ns += 300U * kMs;
+  REQUIRE(bus->Publish(ExCmd{2U}, 1U));
+  std::vector<uint32_t> visited;
+  REQUIRE(bus->ProcessBatchWith(mccc::make_overloaded(
+              [&visited](const ExCmd& cmd) { visited.push_back(cmd.value); }, [](const ExLog&) {},
+              [](const ExPose&) {})) == 2U);
+  REQUIRE(visited == std::vector<uint32_t>{2U});
+  REQUIRE(bus->GetStatistics().messages_expired == 1U);
+
+  // An expired message inside a run is left out of the span
+  std::vector<uint32_t> spans;
+  bus->SubscribeBatch<ExCmd>([&spans](ExBus::EnvelopeSpan span) {
+    for (uint32_t i = 0U; i < span.size; ++i) {
+      spans.push_back(std::get<ExCmd>(span[i].payload).value);
+    }
+  });
+  REQUIRE(bus->PublishFast(ExCmd{3U}, 1U, ExClock::now_ns / 1000U));
+  REQUIRE(bus->PublishFast(ExCmd{4U}, 1U, (ExClock::now_ns - 500U * kMs) / 1000U));
+  REQUIRE(bus->PublishFast(ExCmd{5U}, 1U, ExClock::now_ns / 1000U));
+  REQUIRE(bus->ProcessBatch() == 3U);
+  REQUIRE(spans == std::vector<uint32_t>{3U, 5U});
+  REQUIRE(bus->QueueDepth() == 0U);
+}
+
+TEST_CASE("Expired latest-value samples are not delivered", "[Expiry]") {
+  ExClock::now_ns = 1000U * kMs;
+  auto bus = std::make_unique<ExBus>();
+  std::vector<uint32_t> poses;
+  bus->Subscribe<ExPose>([&poses](const ExEnvelope& env) { poses.push_back(std::get<ExPose>(env.payload).seq); });
+
+  REQUIRE(bus->Publish(ExPose{1U}, 1U));
+  REQUIRE(bus->Publish(ExPose{2U}, 2U));
+  ExClock::now_ns += 2U * kMs;
+  REQUIRE(bus->Publish(ExPose{3U}, 2U));  // sender 1 is stale, sender 2 fresh
+
+  REQUIRE(bus->ProcessBatch() == 2U);
+  REQUIRE(poses == std::vector<uint32_t>{3U});
+  const mccc::BusStatisticsSnapshot stats = bus->GetStatistics();
+  REQUIRE(stats.messages_expired == 1U);
+  REQUIRE(stats.messages_processed == 1U);
+}
+
+TEST_CASE("Expired messages do not use the batch budget", "[Expiry]") {
+  ExClock::now_ns = 1000U * kMs;
+  auto bus = std::make_unique<ExBus>();
+  uint32_t cmds = 0U;
+  bus->Subscribe<ExCmd>([&cmds](const ExEnvelope&) { ++cmds; });
+
+  // A CRITICAL backlog that went stale while the consumer was stalled
+  while (bus->QueueDepth() < ExBus::BACKPRESSURE_CRITICAL_THRESHOLD) {
+    REQUIRE(bus->PublishWithPriority(ExCmd{0U}, 1U, mccc::MessagePriority::HIGH));
+  }
+  const uint32_t stale = bus->QueueDepth();
+  ExClock::now_ns += 300U * kMs;
+  for (uint32_t i = 0U; i < 3U; ++i) {
+    REQUIRE(bus->PublishWithPriority(ExCmd{1U}, 1U, mccc::MessagePriority::HIGH));
+  }
+
+  // One pass skims every stale message and still dispatches max_messages
+  REQUIRE(bus->ProcessBatch(2U) == stale + 2U);
+  REQUIRE(cmds == 2U);
+  REQUIRE(bus->QueueDepth() == 1U);
+  REQUIRE(bus->GetStatistics().messages_expired == stale);
+
+  REQUIRE(bus->ProcessBatchWith(mccc::make_overloaded([&cmds](const ExCmd&) { ++cmds; }, [](const ExLog&) {},
+                                                      [](const ExPose&) {})) == 1U);
+  REQUIRE(cmds == 3U);
+}
+
+TEST_CASE("Types without a TTL never expire", "[Expiry]") {
+  using PlainBus = mccc::AsyncBus<std::variant<ExLog>, 16U, ExClock>;
+  auto bus = std::make_unique<PlainBus>();
+  ExClock::now_ns = 0U;
+  REQUIRE(bus->Publish(ExLog{1U}, 1U));
+  ExClock::now_ns = 1000000U * kMs;
+  uint32_t logs = 0U;
+  bus->Subscribe<ExLog>([&logs](const mccc::MessageEnvelope<std::variant<ExLog>>&) { ++logs; });
+  REQUIRE(bus->ProcessBatch() == 1U);
+  REQUIRE(logs == 1U);
+  REQUIRE(bus->GetStatistics().messages_expired == 0U);
+}
+
+TEST_CASE("ProcessHead releases an expired head without dispatching past it", "[Expiry]") {
+  ExClock::now_ns = 1000U * kMs;
+  auto bus = std::make_unique<ExBus>();
+  std::vector<uint32_t> cmds;
+  bus->Subscribe<ExCmd>([&cmds](const ExEnvelope& env) { cmds.push_back(std::get<ExCmd>(env.payload).value); });
+  REQUIRE(bus->Publish(ExCmd{1U}, 1U));
+  ExClock::now_ns += 300U * kMs;
+  REQUIRE(bus->Publish(ExCmd{2U}, 1U));
+
+  REQUIRE(bus->ProcessHead() == 1U);  // expired: released, ExCmd{2} stays queued
+  REQUIRE(cmds.empty());
+  REQUIRE(bus->QueueDepth() == 1U);
+  REQUIRE(bus->ProcessHead() == 1U);
+  REQUIRE(cmds == std::vector<uint32_t>{2U});
+  REQUIRE(bus->ProcessHead() == 0U);
+}
+
+TEST_CASE("LaneBus timestamp merge re-selects the lane after an expired head", "[Expiry]") {
+  using ExLaneBus = mccc::LaneBus<ExPayload, 2U, 64U, ExClock>;
+  auto bus = std::make_unique<ExLaneBus>(mccc::LaneMerge::TIMESTAMP);
+  std::vector<uint32_t> order;
+  bus->Subscribe<ExCmd>([&order](const ExEnvelope& env) { order.push_back(std::get<ExCmd>(env.payload).value); });
+  bus->Subscribe<ExLog>([&order](const ExEnvelope& env) { order.push_back(std::get<ExLog>(env.payload).value); });
+  ExLaneBus::Producer first = bus->RegisterProducer();
+  ExLaneBus::Producer second = bus->RegisterProducer();
+
+  ExClock::now_ns = 1000U * kMs;
+  REQUIRE(first.Publish(ExCmd{1U}, 1U));  // expires before the merge runs
+  ExClock::now_ns = 1200U * kMs;
+  REQUIRE(second.Publish(ExLog{12U}, 2U));
+  ExClock::now_ns = 1300U * kMs;
+  REQUIRE(first.Publish(ExCmd{13U}, 1U));
+
+  REQUIRE(bus->ProcessBatch() == 3U);
+  REQUIRE(order == std::vector<uint32_t>{12U, 13U});  // not ExCmd{13} ahead of the older ExLog
+}
@@ -0,0 +1,234 @@
+/**
+ * @file test_lane_bus.cpp
+ * @brief Unit tests for LaneBus: per-producer SPSC lanes merged by one consumer.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <mccc/lane_bus.hpp>
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct LaneMsg {
+  uint32_t producer;
+  uint32_t seq;
+};
+
+using LanePayload = std::variant<LaneMsg>;
+using LaneEnvelope = mccc::MessageEnvelope<LanePayload>;
+
+/** Manually advanced clock for deterministic TIMESTAMP merges. */
+struct LaneClock {
+  static uint64_t NowNs() noexcept { return now_ns; }
+  static uint64_t now_ns;
+};
+uint64_t LaneClock::now_ns = 0U;
+
+using SmallLaneBus = mccc::LaneBus<LanePayload, 4U, 16U>;
+using ClockLaneBus = mccc::LaneBus<LanePayload, 3U, 64U, LaneClock>;
+
+std::atomic<uint32_t> g_lane_errors{0U};
+void CountLaneError(mccc::BusError error, uint64_t) {
+  if (error == mccc::BusError::QUEUE_FULL) {
+    g_lane_errors.fetch_add(1U, std::memory_order_relaxed);
+  }
+}
+
+}  // namespace
+
+TEST_CASE("Lanes are single-producer rings", "[LaneBus]") {
+  STATIC_REQUIRE(SmallLaneBus::LaneType::SINGLE_PRODUCER);
+  STATIC_REQUIRE(SmallLaneBus::LOW_PRIORITY_THRESHOLD == mccc::AsyncBus<LanePayload, 16U>::LOW_PRIORITY_THRESHOLD);
+  STATIC_REQUIRE(mccc::AsyncBus<LanePayload, 16U>::SINGLE_PRODUCER == (MCCC_SINGLE_PRODUCER != 0));
+}
+
+TEST_CASE("RegisterProducer hands out each lane once", "[LaneBus]") {
+  auto bus = std::make_unique<SmallLaneBus>();
+  std::vector<SmallLaneBus::Producer> producers;
+  for (uint32_t i = 0U; i < SmallLaneBus::LANE_COUNT; ++i) {
+    producers.push_back(bus->RegisterProducer());
+    REQUIRE(producers.back().Valid());
+    REQUIRE(producers.back().LaneIndex() == i);
+  }
+  REQUIRE(bus->RegisteredProducers() == 4U);
+
+  SmallLaneBus::Producer extra = bus->RegisterProducer();
+  REQUIRE_FALSE(extra);
+  REQUIRE_FALSE(extra.Publish(LaneMsg{9U, 0U}, 9U));
+
+  producers[2].Release();
+  REQUIRE(bus->RegisteredProducers() == 3U);
+  extra = bus->RegisterProducer();
+  REQUIRE(extra);
+  REQUIRE(extra.LaneIndex() == 2U);
+
+  {
+    SmallLaneBus::Producer moved = std::move(extra);
+    REQUIRE_FALSE(extra.Valid());
+    REQUIRE(moved.Valid());
+  }
+  REQUIRE(bus->RegisteredProducers() == 3U);  // destructor gave lane 2 back
+}
+
+TEST_CASE("Round-robin merge interleaves lanes in slices", "[LaneBus]") {
+  using RrBus = mccc::LaneBus<LanePayload, 2U, 1024U>;
+  auto bus = std::make_unique<RrBus>();
+  std::vector<uint32_t> order;
+  bus->Subscribe<LaneMsg>(
+      [&order](const LaneEnvelope& env) { order.push_back(std::get<LaneMsg>(env.payload).producer); });
+
+  RrBus::Producer a = bus->RegisterProducer();
+  RrBus::Producer b = bus->RegisterProducer();
+  constexpr uint32_t kPerLane = RrBus::LANE_SLICE * 2U;
+  for (uint32_t i = 0U; i < kPerLane; ++i) {
+    REQUIRE(a.Publish(LaneMsg{0U, i}, 1U));
+    REQUIRE(b.Publish(LaneMsg{1U, i}, 2U));
+  }
+  REQUIRE(bus->QueueDepth() == 2U * kPerLane);
+
+  REQUIRE(bus->ProcessBatch() == 2U * kPerLane);
+  REQUIRE(bus->QueueDepth() == 0U);
+  for (uint32_t i = 0U; i < order.size(); ++i) {
+    REQUIRE(order[i] == (i / RrBus::LANE_SLICE) % 2U);
+  }
+}
+
+TEST_CASE("Timestamp merge dispatches the oldest lane head first", "[LaneBus]") {
+  auto bus = std::make_unique<ClockLaneBus>(mccc::LaneMerge::TIMESTAMP);
+  std::vector<uint64_t> stamps;
+  std::vector<uint32_t> lanes;
+  bus->Subscribe<LaneMsg>([&](const LaneEnvelope& env) {
+#if MCCC_HEADER_HAS_TIMESTAMP_NS
+    stamps.push_back(env.header.timestamp_ns);
+#else
+    stamps.push_back(env.header.timestamp_us);
+#endif
+    lanes.push_back(std::get<LaneMsg>(env.payload).producer);
+  });
+
+  std::array<ClockLaneBus::Producer, 3U> producers{bus->RegisterProducer(), bus->RegisterProducer(),
+                                                   bus->RegisterProducer()};
+  // Lane 2 publishes first, lane 0 last; the merge must undo the lane order
+  const std::array<uint32_t, 9U> publisher{2U, 1U, 1U, 0U, 2U, 0U, 1U, 2U, 0U};
+  for (uint32_t i = 0U; i < publisher.size(); ++i) {
+    LaneClock::now_ns = (i + 1U) * 1000U;
+    REQUIRE(producers[publisher[i]].Publish(LaneMsg{publisher[i], i}, 1U));
+  }
+
+  REQUIRE(bus->ProcessBatch() == 9U);
+  REQUIRE(lanes == std::vector<uint32_t>(publisher.begin(), publisher.end()));
+  for (uint32_t i = 1U; i < stamps.size(); ++i) {
+    REQUIRE(stamps[i - 1U] < stamps[i]);
+  }
+}
+
+TEST_CASE("Admission is checked against the summed lane depth", "[LaneBus]") {
+  auto bus = std::make_unique<SmallLaneBus>();
+  g_lane_errors.store(0U, std::memory_order_relaxed);
+  bus->SetErrorCallback(CountLaneError);
+  SmallLaneBus::Producer a = bus->RegisterProducer();
+  SmallLaneBus::Producer b = bus->RegisterProducer();
+
+  for (uint32_t i = 0U; i < 5U; ++i) {
+    REQUIRE(a.PublishWithPriority(LaneMsg{0U, i}, 1U, mccc::MessagePriority::LOW));
+  }
+  // Lane b alone is empty, but the bus already holds 5 messages
+  uint32_t accepted = 0U;
+  for (uint32_t i = 0U; i < 16U; ++i) {
+    accepted += b.PublishWithPriority(LaneMsg{1U, i}, 2U, mccc::MessagePriority::LOW) ? 1U : 0U;
+  }
+  REQUIRE(accepted == SmallLaneBus::LOW_PRIORITY_THRESHOLD - 5U);
+  REQUIRE(bus->QueueDepth() == SmallLaneBus::LOW_PRIORITY_THRESHOLD);
+
+  // HIGH still has headroom in the summed budget
+  REQUIRE(a.PublishWithPriority(LaneMsg{0U, 5U}, 1U, mccc::MessagePriority::HIGH));
+
+  mccc::BusStatisticsSnapshot stats = bus->GetStatistics();
+  REQUIRE(stats.low_priority_dropped == 16U - accepted);
+  REQUIRE(stats.messages_dropped == 16U - accepted);
+  REQUIRE(stats.messages_published == SmallLaneBus::LOW_PRIORITY_THRESHOLD + 1U);
+  REQUIRE(g_lane_errors.load(std::memory_order_relaxed) == 16U - accepted);
+
+  // A drained bus admits again even with a stale producer estimate
+  while (bus->ProcessBatch() > 0U) {}
+  REQUIRE(b.PublishWithPriority(LaneMsg{1U, 99U}, 2U, mccc::MessagePriority::LOW));
+
+  bus->ResetStatistics();
+  REQUIRE(bus->GetStatistics().messages_dropped == 0U);
+}
+
+TEST_CASE("Bare-metal mode skips summed-depth admission", "[LaneBus]") {
+  auto bus = std::make_unique<SmallLaneBus>();
+  bus->SetPerformanceMode(SmallLaneBus::PerformanceMode::BARE_METAL);
+  SmallLaneBus::Producer a = bus->RegisterProducer();
+  SmallLaneBus::Producer b = bus->RegisterProducer();
+  for (uint32_t i = 0U; i < 16U; ++i) {
+    REQUIRE(a.PublishWithPriority(LaneMsg{0U, i}, 1U, mccc::MessagePriority::LOW));
+  }
+  REQUIRE_FALSE(a.Publish(LaneMsg{0U, 16U}, 1U));  // lane ring full
+  REQUIRE(b.PublishWithPriority(LaneMsg{1U, 0U}, 2U, mccc::MessagePriority::LOW));
+  REQUIRE(bus->QueueDepth() == 17U);
+}
+
+TEST_CASE("Concurrent producers keep per-producer order", "[LaneBus]") {
+  constexpr uint32_t kProducers = 4U;
+  constexpr uint32_t kPerProducer = 20000U;
+  using MtLaneBus = mccc::LaneBus<LanePayload, kProducers, 1024U>;
+
+  for (mccc::LaneMerge merge : {mccc::LaneMerge::ROUND_ROBIN, mccc::LaneMerge::TIMESTAMP}) {
+    auto bus = std::make_unique<MtLaneBus>(merge);
+    bus->SetPerformanceMode(MtLaneBus::PerformanceMode::BARE_METAL);
+    std::array<uint32_t, kProducers> next{};
+    uint32_t out_of_order = 0U;
+    uint32_t received = 0U;
+    bus->Subscribe<LaneMsg>([&](const LaneEnvelope& env) {
+      const LaneMsg& msg = std::get<LaneMsg>(env.payload);
+      if (msg.seq != next[msg.producer]) {
+        ++out_of_order;
+      }
+      next[msg.producer] = msg.seq + 1U;
+      ++received;
+    });
+
+    std::atomic<uint32_t> unregistered{0U};
+    std::atomic<uint32_t> finished{0U};
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0U; t < kProducers; ++t) {
+      threads.emplace_back([&bus, &unregistered, &finished]() {
+        MtLaneBus::Producer producer = bus->RegisterProducer();
+        if (!producer) {
+          unregistered.fetch_add(1U, std::memory_order_relaxed);
+          finished.fetch_add(1U, std::memory_order_release);
+          return;
+        }
+        const uint32_t id = producer.LaneIndex();
+        for (uint32_t i = 0U; i < kPerProducer; ++i) {
+          while (!producer.Publish(LaneMsg{id, i}, id)) {
+            std::this_thread::yield();
+          }
+        }
+        finished.fetch_add(1U, std::memory_order_release);
+      });
+    }
+
+    while (finished.load(std::memory_order_acquire) < kProducers) {
+      if (bus->ProcessBatch() == 0U) {
+        std::this_thread::yield();
+      }
+    }
+    for (auto& t : threads) {
+      t.join();
+    }
+    while (bus->ProcessBatch() > 0U) {}
+
+    REQUIRE(unregistered.load() == 0U);
+    REQUIRE(out_of_order == 0U);
+    REQUIRE(received == kProducers * kPerProducer);
+    REQUIRE(bus->RegisteredProducers() == 0U);
+  }
+}
@@ -0,0 +1,149 @@
+/**
+ * @file test_latency_histogram.cpp
+ * @brief Unit tests for LatencyHistogram and the bus dispatch latency instrumentation.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <mccc/mccc.hpp>
+
+#include <chrono>
+#include <memory>
+#include <thread>
+
+using mccc::LatencyHistogram;
+
+TEST_CASE("Histogram buckets are exact below the sub-bucket range", "[LatencyHistogram]") {
+  for (uint64_t v = 0U; v < LatencyHistogram::SUB_BUCKETS; ++v) {
+    REQUIRE(LatencyHistogram::BucketIndex(v) == v);
+    REQUIRE(LatencyHistogram::BucketUpperBound(static_cast<uint32_t>(v)) == v);
+  }
+}
+
+TEST_CASE("Histogram bucket bounds stay within relative error", "[LatencyHistogram]") {
+  uint32_t last_index = 0U;
+  for (uint64_t v = 1U; v < (static_cast<uint64_t>(1U) << 36U); v = v + (v / 7U) + 1U) {
+    const uint32_t index = LatencyHistogram::BucketIndex(v);
+    const uint64_t upper = LatencyHistogram::BucketUpperBound(index);
+    REQUIRE(index >= last_index);  // monotonic
+    REQUIRE(upper >= v);
+    REQUIRE((upper - v) * LatencyHistogram::SUB_BUCKETS <= v);
+    if (index > 0U) {
+      REQUIRE(LatencyHistogram::BucketUpperBound(index - 1U) < v);
+    }
+    last_index = index;
+  }
+  REQUIRE(LatencyHistogram::BucketIndex(~static_cast<uint64_t>(0U)) == LatencyHistogram::BUCKET_COUNT - 1U);
+}
+
+TEST_CASE("Histogram percentiles and exact max", "[LatencyHistogram]") {
+  auto histogram = std::make_unique<LatencyHistogram>();
+  REQUIRE(histogram->Snapshot().count == 0U);
+
+  for (uint64_t v = 1U; v <= 1000U; ++v) {
+    histogram->Record(v * 100U);  // 100 ns .. 100 us, uniform
+  }
+  histogram->Record(5000000U);  // one 5 ms outlier
+
+  mccc::LatencySnapshot snap = histogram->Snapshot();
+  REQUIRE(snap.count == 1001U);
+  REQUIRE(snap.max_ns == 5000000U);
+  REQUIRE(snap.p50_ns >= 50000U);
+  REQUIRE(snap.p50_ns <= 50000U + 50000U / LatencyHistogram::SUB_BUCKETS);
+  REQUIRE(snap.p99_ns >= 99000U);
+  REQUIRE(snap.p99_ns <= 99000U + 99000U / LatencyHistogram::SUB_BUCKETS);
+  REQUIRE(snap.p999_ns >= 100000U);
+  REQUIRE(snap.p999_ns <= snap.max_ns);
+
+  histogram->Reset();
+  snap = histogram->Snapshot();
+  REQUIRE(snap.count == 0U);
+  REQUIRE(snap.max_ns == 0U);
+}
+
+TEST_CASE("Histogram counts merge before summarizing", "[LatencyHistogram]") {
+  auto fast = std::make_unique<LatencyHistogram>();
+  auto slow = std::make_unique<LatencyHistogram>();
+  for (uint32_t i = 0U; i < 90U; ++i) {
+    fast->Record(10U);
+  }
+  for (uint32_t i = 0U; i < 10U; ++i) {
+    slow->Record(10000U);
+  }
+
+  auto counts = std::make_unique<LatencyHistogram::Counts>();
+  fast->AddTo(*counts);
+  slow->AddTo(*counts);
+  const mccc::LatencySnapshot merged = LatencyHistogram::Summarize(*counts);
+  REQUIRE(merged.count == 100U);
+  REQUIRE(merged.p50_ns == 10U);
+  REQUIRE(merged.p99_ns >= 10000U);
+  REQUIRE(merged.max_ns == 10000U);
+}
+
+#if MCCC_ENABLE_LATENCY_HISTOGRAM
+
+struct LatFast {
+  uint32_t seq;
+};
+struct LatSlow {
+  uint32_t seq;
+};
+
+using LatPayload = std::variant<LatFast, LatSlow>;
+using LatBus = mccc::AsyncBus<LatPayload, 1024U>;
+
+TEST_CASE("Bus records dispatch latency per type and priority", "[LatencyHistogram]") {
+  auto bus = std::make_unique<LatBus>();
+  uint32_t seen = 0U;
+  bus->Subscribe<LatFast>([&seen](const LatBus::EnvelopeType&) { ++seen; });
+  bus->Subscribe<LatSlow>([&seen](const LatBus::EnvelopeType&) { ++seen; });
+
+  for (uint32_t i = 0U; i < 10U; ++i) {
+    REQUIRE(bus->PublishWithPriority(LatFast{i}, 1U, mccc::MessagePriority::HIGH));
+  }
+  REQUIRE(bus->ProcessBatch() == 10U);
+
+  REQUIRE(bus->PublishWithPriority(LatSlow{0U}, 1U, mccc::MessagePriority::LOW));
+  std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  REQUIRE(bus->ProcessBatch() == 1U);
+  REQUIRE(seen == 11U);
+
+  const mccc::LatencyStatisticsSnapshot lat = bus->GetLatencyStatistics();
+  REQUIRE(lat.overall.count == 11U);
+  REQUIRE(lat.per_type[0].count == 10U);
+  REQUIRE(lat.per_type[1].count == 1U);
+  REQUIRE(lat.per_priority[static_cast<uint32_t>(mccc::MessagePriority::HIGH)].count == 10U);
+  REQUIRE(lat.per_priority[static_cast<uint32_t>(mccc::MessagePriority::MEDIUM)].count == 0U);
+  REQUIRE(lat.per_priority[static_cast<uint32_t>(mccc::MessagePriority::LOW)].count == 1U);
+
+  // The queued-while-sleeping message dominates the tail
+  REQUIRE(lat.per_type[1].max_ns >= 2000000U);
+  REQUIRE(lat.overall.max_ns == lat.per_type[1].max_ns);
+  REQUIRE(lat.per_type[0].max_ns < lat.per_type[1].max_ns);
+
+  bus->ResetStatistics();
+  REQUIRE(bus->GetLatencyStatistics().overall.count == 0U);
+}
+
+TEST_CASE("Latency ignores the user timestamp and cancelled slots", "[LatencyHistogram]") {
+  auto bus = std::make_unique<LatBus>();
+  uint32_t visited = 0U;
+
+  // A bogus timestamp_us does not leak into the latency measurement
+  REQUIRE(bus->PublishFast(LatFast{1U}, 1U, 0U));
+  {
+    auto slot = bus->TryReserve<LatSlow>();
+    REQUIRE(slot);
+    slot.Cancel();
+  }
+  REQUIRE(bus->ProcessBatchWith([&visited](const auto&) { ++visited; }) == 2U);
+  REQUIRE(visited == 1U);
+
+  const mccc::LatencyStatisticsSnapshot lat = bus->GetLatencyStatistics();
+  REQUIRE(lat.overall.count == 1U);
+  REQUIRE(lat.per_type[0].count == 1U);
+  REQUIRE(lat.per_type[1].count == 0U);
+  REQUIRE(lat.overall.max_ns < 1000000000U);
+}
+
+#endif  // MCCC_ENABLE_LATENCY_HISTOGRAM
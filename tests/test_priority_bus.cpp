@@ -0,0 +1,177 @@
+/**
+ * @file test_priority_bus.cpp
+ * @brief Unit tests for PriorityBus (per-priority rings, strict/weighted dequeue).
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <mccc/priority_bus.hpp>
+
+#include <memory>
+#include <vector>
+
+struct PrioCmd {
+  uint32_t seq;
+};
+struct PrioTelemetry {
+  float value;
+};
+
+struct PrioExpiring {
+  uint32_t seq;
+};
+
+template <>
+struct mccc::ExpiryTraits<PrioExpiring> {
+  static constexpr uint64_t TTL_US = 1000U;
+};
+
+using PrioPayload = std::variant<PrioCmd, PrioTelemetry, PrioExpiring>;
+using PrioBus = mccc::PriorityBus<PrioPayload, 1024U>;
+using PrioEnvelope = mccc::MessageEnvelope<PrioPayload>;
+
+namespace {
+
+/** Manually advanced clock: messages expire without sleeping. */
+struct PrioClock {
+  static uint64_t NowNs() noexcept { return now_ns; }
+  static uint64_t now_ns;
+};
+uint64_t PrioClock::now_ns = 0U;
+
+}  // namespace
+
+TEST_CASE("STRICT: HIGH overtakes a queued backlog", "[PriorityBus]") {
+  auto bus = std::make_unique<PrioBus>();
+  std::vector<mccc::MessagePriority> order;
+  bus->Subscribe<PrioCmd>([&order](const PrioEnvelope& env) { order.push_back(env.header.priority); });
+
+  for (uint32_t i = 0U; i < 300U; ++i) {
+    REQUIRE(bus->PublishWithPriority(PrioCmd{i}, 1U, mccc::MessagePriority::LOW));
+    REQUIRE(bus->PublishWithPriority(PrioCmd{i}, 1U, mccc::MessagePriority::MEDIUM));
+  }
+  for (uint32_t i = 0U; i < 10U; ++i) {
+    REQUIRE(bus->PublishWithPriority(PrioCmd{i}, 1U, mccc::MessagePriority::HIGH));
+  }
+  REQUIRE(bus->QueueDepth() == 610U);
+  REQUIRE(bus->QueueDepth(mccc::MessagePriority::HIGH) == 10U);
+
+  REQUIRE(bus->ProcessBatch() == 610U);
+  for (uint32_t i = 0U; i < 10U; ++i) {
+    REQUIRE(order[i] == mccc::MessagePriority::HIGH);
+  }
+  for (uint32_t i = 10U; i < 310U; ++i) {
+    REQUIRE(order[i] == mccc::MessagePriority::MEDIUM);
+  }
+  for (uint32_t i = 310U; i < 610U; ++i) {
+    REQUIRE(order[i] == mccc::MessagePriority::LOW);
+  }
+}
+
+TEST_CASE("STRICT: HIGH published mid-batch waits at most one slice", "[PriorityBus]") {
+  auto bus = std::make_unique<PrioBus>();
+  std::vector<mccc::MessagePriority> order;
+  auto* raw = bus.get();
+  bus->Subscribe<PrioCmd>([&order, raw](const PrioEnvelope& env) {
+    order.push_back(env.header.priority);
+    if (order.size() == 3U) {
+      raw->PublishWithPriority(PrioCmd{0U}, 2U, mccc::MessagePriority::HIGH);
+    }
+  });
+
+  for (uint32_t i = 0U; i < 200U; ++i) {
+    REQUIRE(bus->PublishWithPriority(PrioCmd{i}, 1U, mccc::MessagePriority::LOW));
+  }
+  REQUIRE(bus->ProcessBatch() == 201U);
+
+  uint32_t high_at = 0U;
+  for (uint32_t i = 0U; i < order.size(); ++i) {
+    if (order[i] == mccc::MessagePriority::HIGH) {
+      high_at = i;
+    }
+  }
+  REQUIRE(high_at > 2U);
+  REQUIRE(high_at <= PrioBus::STRICT_SLICE);
+}
+
+TEST_CASE("WEIGHTED: rings are served in proportion to weights", "[PriorityBus]") {
+  auto bus = std::make_unique<PrioBus>(mccc::DequeuePolicy::WEIGHTED, PrioBus::Weights{1U, 2U, 4U});
+  std::vector<mccc::MessagePriority> order;
+  bus->Subscribe<PrioCmd>([&order](const PrioEnvelope& env) { order.push_back(env.header.priority); });
+
+  for (uint32_t i = 0U; i < 100U; ++i) {
+    bus->PublishWithPriority(PrioCmd{i}, 1U, mccc::MessagePriority::LOW);
+    bus->PublishWithPriority(PrioCmd{i}, 1U, mccc::MessagePriority::MEDIUM);
+    bus->PublishWithPriority(PrioCmd{i}, 1U, mccc::MessagePriority::HIGH);
+  }
+  REQUIRE(bus->ProcessBatch() == 300U);
+
+  const std::vector<mccc::MessagePriority> round{
+      mccc::MessagePriority::HIGH,   mccc::MessagePriority::HIGH,   mccc::MessagePriority::HIGH,
+      mccc::MessagePriority::HIGH,   mccc::MessagePriority::MEDIUM, mccc::MessagePriority::MEDIUM,
+      mccc::MessagePriority::LOW};
+  for (uint32_t r = 0U; r < 3U; ++r) {
+    for (uint32_t i = 0U; i < round.size(); ++i) {
+      REQUIRE(order[r * round.size() + i] == round[i]);
+    }
+  }
+  // LOW is never starved: every message is eventually dispatched
+  REQUIRE(bus->QueueDepth() == 0U);
+}
+
+TEST_CASE("Admission and statistics apply per priority ring", "[PriorityBus]") {
+  auto bus = std::make_unique<PrioBus>();
+  uint32_t accepted_low = 0U;
+  for (uint32_t i = 0U; i < 1024U; ++i) {
+    if (bus->PublishWithPriority(PrioCmd{i}, 1U, mccc::MessagePriority::LOW)) {
+      ++accepted_low;
+    }
+  }
+  REQUIRE(accepted_low == PrioBus::RingType::LOW_PRIORITY_THRESHOLD);
+
+  // A full LOW ring does not consume HIGH capacity
+  for (uint32_t i = 0U; i < PrioBus::RingType::HIGH_PRIORITY_THRESHOLD; ++i) {
+    REQUIRE(bus->PublishWithPriority(PrioCmd{i}, 1U, mccc::MessagePriority::HIGH));
+  }
+
+  auto stats = bus->GetStatistics();
+  REQUIRE(stats.low_priority_published == accepted_low);
+  REQUIRE(stats.low_priority_dropped == 1024U - accepted_low);
+  REQUIRE(stats.high_priority_published == PrioBus::RingType::HIGH_PRIORITY_THRESHOLD);
+  REQUIRE(stats.high_priority_dropped == 0U);
+
+  while (bus->ProcessBatch() > 0U) {}
+  REQUIRE(bus->GetStatistics().messages_processed == stats.messages_published);
+}
+
+TEST_CASE("WEIGHTED: expired skips spend the budget without wrapping it", "[PriorityBus]") {
+  using ExpiryBus = mccc::PriorityBus<PrioPayload, 1024U, PrioClock>;
+  auto bus = std::make_unique<ExpiryBus>(mccc::DequeuePolicy::WEIGHTED, ExpiryBus::Weights{1U, 2U, 4U});
+  uint32_t dispatched = 0U;
+  std::vector<mccc::MessagePriority> order;
+  bus->Subscribe<PrioExpiring>([&dispatched](const PrioEnvelope&) { ++dispatched; });
+  bus->Subscribe<PrioCmd>([&order](const PrioEnvelope& env) { order.push_back(env.header.priority); });
+
+  PrioClock::now_ns = 0U;
+  for (uint32_t i = 0U; i < 900U; ++i) {
+    REQUIRE(bus->PublishWithPriority(PrioExpiring{i}, 1U, mccc::MessagePriority::HIGH));
+  }
+  for (uint32_t i = 0U; i < 800U; ++i) {
+    REQUIRE(bus->PublishWithPriority(PrioExpiring{i}, 1U, mccc::MessagePriority::MEDIUM));
+  }
+  PrioClock::now_ns = 1000000000U;  // every PrioExpiring is now stale
+  for (const auto priority : {mccc::MessagePriority::HIGH, mccc::MessagePriority::MEDIUM, mccc::MessagePriority::LOW}) {
+    REQUIRE(bus->PublishWithPriority(PrioCmd{0U}, 1U, priority));
+    REQUIRE(bus->PublishWithPriority(PrioCmd{1U}, 1U, priority));
+  }
+
+  // HIGH skips 900 and MEDIUM 800: the budget is spent before LOW is visited
+  REQUIRE(bus->ProcessBatch() == 1704U);
+  REQUIRE(order.size() == 4U);
+  REQUIRE(bus->QueueDepth(mccc::MessagePriority::LOW) == 2U);
+
+  REQUIRE(bus->ProcessBatch() == 2U);
+  REQUIRE(bus->ProcessBatch() == 0U);
+  REQUIRE(dispatched == 0U);
+  REQUIRE(order.size() == 6U);
+  REQUIRE(bus->GetStatistics().messages_expired == 1700U);
+}
@@ -0,0 +1,104 @@
+/**
+ * @file test_process_wait.cpp
+ * @brief Unit tests for AsyncBus::ProcessBatchWait (spin, yield, then park).
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <mccc/mccc.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+struct WaitMsg {
+  uint32_t seq;
+};
+struct WaitOther {
+  uint8_t unused;
+};
+
+using WaitPayload = std::variant<WaitMsg, WaitOther>;
+using WaitBus = mccc::AsyncBus<WaitPayload, 1024U>;
+using WaitEnvelope = mccc::MessageEnvelope<WaitPayload>;
+
+using std::chrono::milliseconds;
+using std::chrono::steady_clock;
+
+TEST_CASE("ProcessBatchWait returns queued messages immediately", "[ProcessWait]") {
+  auto bus = std::make_unique<WaitBus>();
+  uint32_t received = 0U;
+  bus->Subscribe<WaitMsg>([&received](const WaitEnvelope&) { ++received; });
+
+  REQUIRE(bus->Publish(WaitMsg{1U}, 1U));
+  REQUIRE(bus->Publish(WaitMsg{2U}, 1U));
+  REQUIRE(bus->ProcessBatchWait(milliseconds(1000)) == 2U);
+  REQUIRE(received == 2U);
+}
+
+TEST_CASE("ProcessBatchWait times out on an empty queue", "[ProcessWait]") {
+  auto bus = std::make_unique<WaitBus>();
+  (void)bus->ProcessBatchWait(milliseconds(1));
+
+  auto start = steady_clock::now();
+  REQUIRE(bus->ProcessBatchWait(milliseconds(30)) == 0U);
+  REQUIRE(steady_clock::now() - start >= milliseconds(25));
+}
+
+TEST_CASE("Publish wakes a parked consumer", "[ProcessWait]") {
+  auto bus = std::make_unique<WaitBus>();
+  (void)bus->ProcessBatchWait(milliseconds(1));
+
+  std::atomic<uint32_t> processed{0U};
+  std::thread consumer(
+      [&]() { processed.store(bus->ProcessBatchWait(milliseconds(5000)), std::memory_order_release); });
+
+  std::this_thread::sleep_for(milliseconds(20));
+  auto start = steady_clock::now();
+  REQUIRE(bus->Publish(WaitMsg{7U}, 1U));
+  consumer.join();
+
+  REQUIRE(processed.load(std::memory_order_acquire) == 1U);
+  REQUIRE(steady_clock::now() - start < milliseconds(2000));
+}
+
+TEST_CASE("Wakeup releases a parked consumer without messages", "[ProcessWait]") {
+  auto bus = std::make_unique<WaitBus>();
+  (void)bus->ProcessBatchWait(milliseconds(1));
+
+  std::thread consumer([&]() { REQUIRE(bus->ProcessBatchWait(milliseconds(5000)) == 0U); });
+  std::this_thread::sleep_for(milliseconds(20));
+  auto start = steady_clock::now();
+  bus->Wakeup();
+  consumer.join();
+  REQUIRE(steady_clock::now() - start < milliseconds(2000));
+}
+
+TEST_CASE("Bursty producer with parking consumer loses no wake-ups", "[ProcessWait]") {
+  auto bus = std::make_unique<WaitBus>();
+  constexpr uint32_t kTotal = 20000U;
+  std::atomic<uint32_t> received{0U};
+  bus->Subscribe<WaitMsg>([&received](const WaitEnvelope&) { received.fetch_add(1U, std::memory_order_relaxed); });
+
+  std::thread consumer([&]() {
+    while (received.load(std::memory_order_relaxed) < kTotal) {
+      // A lost wake-up would stall for the whole timeout
+      (void)bus->ProcessBatchWait(milliseconds(10000));
+    }
+  });
+
+  auto start = steady_clock::now();
+  uint32_t sent = 0U;
+  while (sent < kTotal) {
+    if (bus->Publish(WaitMsg{sent}, 1U)) {
+      ++sent;
+    }
+    if ((sent % 500U) == 0U) {
+      std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+  }
+  consumer.join();
+
+  REQUIRE(received.load() == kTotal);
+  REQUIRE(steady_clock::now() - start < milliseconds(8000));
+}
@@ -0,0 +1,154 @@
+/**
+ * @file test_publish_batch.cpp
+ * @brief Unit tests for AsyncBus::PublishBatch (single-reservation batched publish).
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <mccc/mccc.hpp>
+#include <vector>
+
+struct BatchMsgA {
+  uint32_t seq;
+};
+struct BatchMsgB {
+  float value;
+};
+
+using BatchPayload = std::variant<BatchMsgA, BatchMsgB>;
+using BatchBus = mccc::AsyncBus<BatchPayload>;
+using BatchEnvelope = mccc::MessageEnvelope<BatchPayload>;
+
+static void DrainBatchBus(BatchBus& bus) {
+  while (bus.ProcessBatch() > 0U) {}
+}
+
+static std::vector<BatchPayload> MakeRun(uint32_t count, uint32_t base = 0U) {
+  std::vector<BatchPayload> run;
+  run.reserve(count);
+  for (uint32_t i = 0U; i < count; ++i) {
+    run.emplace_back(BatchMsgA{base + i});
+  }
+  return run;
+}
+
+TEST_CASE("PublishBatch enqueues run in order with contiguous IDs", "[PublishBatch]") {
+  auto& bus = BatchBus::Instance();
+  bus.SetPerformanceMode(BatchBus::PerformanceMode::FULL_FEATURED);
+  DrainBatchBus(bus);
+  bus.ResetStatistics();
+
+  std::vector<uint32_t> seqs;
+  std::vector<uint64_t> ids;
+  auto handle = bus.Subscribe<BatchMsgA>([&seqs, &ids](const BatchEnvelope& env) {
+    seqs.push_back(std::get<BatchMsgA>(env.payload).seq);
+    ids.push_back(env.header.msg_id);
+    REQUIRE(env.header.sender_id == 7U);
+    REQUIRE(env.header.priority == mccc::MessagePriority::HIGH);
+  });
+
+  auto run = MakeRun(64U);
+  uint32_t published = bus.PublishBatch(run.begin(), run.end(), 7U, mccc::MessagePriority::HIGH);
+  REQUIRE(published == 64U);
+  REQUIRE(bus.QueueDepth() == 64U);
+
+  DrainBatchBus(bus);
+  REQUIRE(seqs.size() == 64U);
+  for (uint32_t i = 0U; i < 64U; ++i) {
+    REQUIRE(seqs[i] == i);
+    REQUIRE(ids[i] == ids[0] + i);
+  }
+
+  auto stats = bus.GetStatistics();
+  REQUIRE(stats.messages_published == 64U);
+  REQUIRE(stats.high_priority_published == 64U);
+  REQUIRE(stats.messages_dropped == 0U);
+
+  bus.Unsubscribe(handle);
+}
+
+TEST_CASE("PublishBatch accepts alternative types and empty ranges", "[PublishBatch]") {
+  auto& bus = BatchBus::Instance();
+  DrainBatchBus(bus);
+
+  std::vector<BatchMsgB> run{BatchMsgB{1.0f}, BatchMsgB{2.0f}, BatchMsgB{3.0f}};
+  float sum = 0.0f;
+  auto handle =
+      bus.Subscribe<BatchMsgB>([&sum](const BatchEnvelope& env) { sum += std::get<BatchMsgB>(env.payload).value; });
+
+  REQUIRE(bus.PublishBatch(run.begin(), run.begin(), 1U) == 0U);
+  REQUIRE(bus.PublishBatchFast(run.begin(), run.end(), 1U, 1234U) == 3U);
+  DrainBatchBus(bus);
+  REQUIRE(sum == 6.0f);
+
+  bus.Unsubscribe(handle);
+}
+
+TEST_CASE("PublishBatch ALL_OR_NOTHING rejects a run crossing the threshold", "[PublishBatch]") {
+  auto& bus = BatchBus::Instance();
+  bus.SetPerformanceMode(BatchBus::PerformanceMode::FULL_FEATURED);
+  DrainBatchBus(bus);
+  bus.ResetStatistics();
+
+  // Fill LOW priority band up to 8 slots below its threshold
+  constexpr uint32_t kFill = BatchBus::LOW_PRIORITY_THRESHOLD - 8U;
+  auto fill = MakeRun(kFill);
+  REQUIRE(bus.PublishBatch(fill.begin(), fill.end(), 1U, mccc::MessagePriority::LOW) == kFill);
+
+  auto run = MakeRun(16U);
+  REQUIRE(bus.PublishBatch(run.begin(), run.end(), 1U, mccc::MessagePriority::LOW,
+                           mccc::BatchAdmission::ALL_OR_NOTHING) == 0U);
+  REQUIRE(bus.QueueDepth() == kFill);
+
+  auto stats = bus.GetStatistics();
+  REQUIRE(stats.messages_dropped == 16U);
+  REQUIRE(stats.low_priority_dropped == 16U);
+
+  // Higher priority threshold still admits the whole run
+  REQUIRE(bus.PublishBatch(run.begin(), run.end(), 1U, mccc::MessagePriority::HIGH,
+                           mccc::BatchAdmission::ALL_OR_NOTHING) == 16U);
+
+  DrainBatchBus(bus);
+}
+
+TEST_CASE("PublishBatch PARTIAL takes the prefix that fits", "[PublishBatch]") {
+  auto& bus = BatchBus::Instance();
+  bus.SetPerformanceMode(BatchBus::PerformanceMode::FULL_FEATURED);
+  DrainBatchBus(bus);
+  bus.ResetStatistics();
+
+  constexpr uint32_t kFill = BatchBus::LOW_PRIORITY_THRESHOLD - 8U;
+  auto fill = MakeRun(kFill);
+  REQUIRE(bus.PublishBatch(fill.begin(), fill.end(), 1U, mccc::MessagePriority::LOW) == kFill);
+
+  uint32_t last_seq = 0U;
+  auto handle = bus.Subscribe<BatchMsgA>(
+      [&last_seq](const BatchEnvelope& env) { last_seq = std::get<BatchMsgA>(env.payload).seq; });
+
+  auto run = MakeRun(16U, 1000U);
+  REQUIRE(bus.PublishBatch(run.begin(), run.end(), 1U, mccc::MessagePriority::LOW, mccc::BatchAdmission::PARTIAL) ==
+          8U);
+  REQUIRE(bus.QueueDepth() == BatchBus::LOW_PRIORITY_THRESHOLD);
+
+  auto stats = bus.GetStatistics();
+  REQUIRE(stats.low_priority_published == kFill + 8U);
+  REQUIRE(stats.low_priority_dropped == 8U);
+
+  DrainBatchBus(bus);
+  REQUIRE(last_seq == 1007U);
+
+  bus.Unsubscribe(handle);
+}
+
+TEST_CASE("PublishBatch in BARE_METAL is bounded only by capacity", "[PublishBatch]") {
+  auto& bus = BatchBus::Instance();
+  bus.SetPerformanceMode(BatchBus::PerformanceMode::BARE_METAL);
+  DrainBatchBus(bus);
+
+  auto run = MakeRun(BatchBus::MAX_QUEUE_DEPTH + 4U);
+  REQUIRE(bus.PublishBatch(run.begin(), run.end(), 1U, mccc::MessagePriority::LOW) == BatchBus::MAX_QUEUE_DEPTH);
+  REQUIRE(bus.PublishBatch(run.begin(), run.begin() + 1, 1U) == 0U);
+
+  DrainBatchBus(bus);
+  REQUIRE(bus.QueueDepth() == 0U);
+  bus.SetPerformanceMode(BatchBus::PerformanceMode::FULL_FEATURED);
+}
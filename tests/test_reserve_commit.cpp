@@ -0,0 +1,140 @@
+/**
+ * @file test_reserve_commit.cpp
+ * @brief Unit tests for in-place publish (AsyncBus::TryReserve / PublishSlot).
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <mccc/mccc.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+struct Frame512 {
+  uint32_t id;
+  uint8_t data[508];
+};
+struct SmallCmd {
+  uint32_t value;
+};
+
+using ReservePayload = std::variant<Frame512, SmallCmd, std::string>;
+using ReserveBus = mccc::AsyncBus<ReservePayload, 256U>;
+using ReserveEnvelope = mccc::MessageEnvelope<ReservePayload>;
+
+TEST_CASE("TryReserve constructs in place and Commit publishes", "[ReserveCommit]") {
+  auto bus = std::make_unique<ReserveBus>();
+  uint32_t got_id = 0U;
+  uint8_t got_last = 0U;
+  uint32_t got_sender = 0U;
+  bus->Subscribe<Frame512>([&](const ReserveEnvelope& env) {
+    const auto& f = std::get<Frame512>(env.payload);
+    got_id = f.id;
+    got_last = f.data[507];
+    got_sender = env.header.sender_id;
+  });
+
+  auto slot = bus->TryReserve<Frame512>(mccc::MessagePriority::HIGH);
+  REQUIRE(static_cast<bool>(slot));
+  slot->id = 99U;
+  (*slot).data[507] = 0xA5U;
+  REQUIRE(bus->QueueDepth() == 1U);
+  REQUIRE(bus->ProcessBatch() == 0U);  // not committed yet
+
+  REQUIRE(slot.Commit(5U));
+  REQUIRE_FALSE(static_cast<bool>(slot));
+  REQUIRE_FALSE(slot.Commit(5U));
+
+  REQUIRE(bus->ProcessBatch() == 1U);
+  REQUIRE(got_id == 99U);
+  REQUIRE(got_last == 0xA5U);
+  REQUIRE(got_sender == 5U);
+
+  auto stats = bus->GetStatistics();
+  REQUIRE(stats.messages_published == 1U);
+  REQUIRE(stats.high_priority_published == 1U);
+  REQUIRE(stats.messages_processed == 1U);
+}
+
+TEST_CASE("Uncommitted slot blocks later messages until committed", "[ReserveCommit]") {
+  auto bus = std::make_unique<ReserveBus>();
+  std::vector<uint32_t> order;
+  bus->Subscribe<SmallCmd>(
+      [&order](const ReserveEnvelope& env) { order.push_back(std::get<SmallCmd>(env.payload).value); });
+
+  auto slot = bus->TryReserve<SmallCmd>();
+  REQUIRE(bus->Publish(SmallCmd{2U}, 1U));
+  REQUIRE(bus->ProcessBatch() == 0U);
+
+  slot->value = 1U;
+  REQUIRE(slot.CommitFast(1U, 1234U));
+  REQUIRE(bus->ProcessBatch() == 2U);
+  REQUIRE(order == std::vector<uint32_t>{1U, 2U});
+}
+
+TEST_CASE("Cancelled slot is skipped by the consumer", "[ReserveCommit]") {
+  auto bus = std::make_unique<ReserveBus>();
+  std::vector<uint32_t> seen;
+  bus->Subscribe<SmallCmd>(
+      [&seen](const ReserveEnvelope& env) { seen.push_back(std::get<SmallCmd>(env.payload).value); });
+
+  {
+    auto dropped = bus->TryReserve<SmallCmd>();
+    dropped->value = 1U;
+  }  // destroyed without Commit
+  auto cancelled = bus->TryReserve<SmallCmd>();
+  cancelled->value = 2U;
+  cancelled.Cancel();
+  REQUIRE(bus->Publish(SmallCmd{3U}, 1U));
+
+  REQUIRE(bus->ProcessBatch() == 3U);  // slots consumed, cancelled ones included
+  REQUIRE(seen == std::vector<uint32_t>{3U});
+  auto stats = bus->GetStatistics();
+  REQUIRE(stats.messages_published == 1U);
+  REQUIRE(stats.messages_processed == 1U);
+
+  // Visitor path skips cancelled slots too
+  { auto again = bus->TryReserve<SmallCmd>(); }
+  REQUIRE(bus->Publish(SmallCmd{4U}, 1U));
+  uint32_t visited = 0U;
+  REQUIRE(bus->ProcessBatchWith([&visited](const auto&) { ++visited; }) == 2U);
+  REQUIRE(visited == 1U);
+}
+
+TEST_CASE("TryReserve applies priority admission", "[ReserveCommit]") {
+  auto bus = std::make_unique<ReserveBus>();
+  std::vector<ReserveBus::PublishSlot<SmallCmd>> held;
+  for (uint32_t i = 0U; i < ReserveBus::LOW_PRIORITY_THRESHOLD; ++i) {
+    held.push_back(bus->TryReserve<SmallCmd>(mccc::MessagePriority::LOW));
+    REQUIRE(static_cast<bool>(held.back()));
+  }
+  auto rejected = bus->TryReserve<SmallCmd>(mccc::MessagePriority::LOW);
+  REQUIRE_FALSE(static_cast<bool>(rejected));
+  REQUIRE(bus->GetStatistics().low_priority_dropped == 1U);
+
+  auto high = bus->TryReserve<SmallCmd>(mccc::MessagePriority::HIGH);
+  REQUIRE(static_cast<bool>(high));
+
+  for (auto& s : held) {
+    s->value = 0U;
+    s.Commit(1U);
+  }
+  high.Commit(1U);
+  while (bus->ProcessBatch() > 0U) {}
+  REQUIRE(bus->QueueDepth() == 0U);
+}
+
+TEST_CASE("Non-trivial alternatives are value-initialised in the slot", "[ReserveCommit]") {
+  auto bus = std::make_unique<ReserveBus>();
+  std::string got;
+  bus->Subscribe<std::string>([&got](const ReserveEnvelope& env) { got = std::get<std::string>(env.payload); });
+
+  for (uint32_t round = 0U; round < 2U * 256U; ++round) {
+    auto slot = bus->TryReserve<std::string>();
+    REQUIRE(slot->empty());
+    slot->append("msg");
+    REQUIRE(slot.Commit(1U));
+    REQUIRE(bus->ProcessBatch() == 1U);
+    REQUIRE(got == "msg");
+  }
+}
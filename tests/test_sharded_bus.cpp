@@ -0,0 +1,163 @@
+/**
+ * @file test_sharded_bus.cpp
+ * @brief Unit tests for ShardedBus routing, ordering and aggregation.
+ */
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <mccc/sharded_bus.hpp>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+struct ShardSample {
+  uint32_t channel;
+  uint32_t seq;
+};
+struct ShardCmd {
+  uint32_t code;
+};
+struct ShardLog {
+  uint32_t level;
+};
+
+using ShardPayload = std::variant<ShardSample, ShardCmd, ShardLog>;
+using ShardEnvelope = mccc::MessageEnvelope<ShardPayload>;
+using TestShardedBus = mccc::ShardedBus<ShardPayload, 4U, 4096U>;
+
+static uint32_t ChannelKey(const ShardPayload& payload, uint32_t sender_id) noexcept {
+  const auto* sample = std::get_if<ShardSample>(&payload);
+  return (sample != nullptr) ? sample->channel : sender_id;
+}
+
+TEST_CASE("ShardedBus BY_TYPE keeps each type on one shard", "[ShardedBus]") {
+  TestShardedBus bus(mccc::ShardRouting::BY_TYPE);
+
+  uint32_t samples = 0U;
+  uint32_t cmds = 0U;
+  auto h1 = bus.Subscribe<ShardSample>([&samples](const ShardEnvelope&) { ++samples; });
+  auto h2 = bus.Subscribe<ShardCmd>([&cmds](const ShardEnvelope&) { ++cmds; });
+  REQUIRE(h1.valid);
+  REQUIRE(h2.valid);
+
+  for (uint32_t i = 0U; i < 10U; ++i) {
+    REQUIRE(bus.Publish(ShardSample{i, i}, 1U));
+  }
+  REQUIRE(bus.Publish(ShardCmd{5U}, 1U));
+
+  REQUIRE(bus.Shard(0U).QueueDepth() == 10U);
+  REQUIRE(bus.Shard(1U).QueueDepth() == 1U);
+  REQUIRE(bus.QueueDepth() == 11U);
+
+  for (uint32_t i = 0U; i < TestShardedBus::SHARD_COUNT; ++i) {
+    while (bus.ProcessShard(i) > 0U) {}
+  }
+  REQUIRE(samples == 10U);
+  REQUIRE(cmds == 1U);
+
+  auto stats = bus.GetStatistics();
+  REQUIRE(stats.messages_published == 11U);
+  REQUIRE(stats.messages_processed == 11U);
+
+  REQUIRE(bus.Unsubscribe(h1));
+  REQUIRE(!bus.Unsubscribe(h1));
+}
+
+TEST_CASE("ShardedBus BY_KEY preserves per-key order across consumer threads", "[ShardedBus]") {
+  TestShardedBus bus(mccc::ShardRouting::BY_KEY, &ChannelKey);
+
+  constexpr uint32_t kChannels = 8U;
+  constexpr uint32_t kPerChannel = 2000U;
+
+  std::array<std::atomic<uint32_t>, kChannels> next_seq{};
+  std::atomic<uint32_t> out_of_order{0U};
+  std::atomic<uint32_t> received{0U};
+  std::mutex threads_mutex;
+  std::vector<std::thread::id> threads;
+
+  auto handle = bus.Subscribe<ShardSample>([&](const ShardEnvelope& env) {
+    const auto& s = std::get<ShardSample>(env.payload);
+    // Channel c is handled by exactly one consumer thread
+    if (next_seq[s.channel].load(std::memory_order_relaxed) != s.seq) {
+      out_of_order.fetch_add(1U, std::memory_order_relaxed);
+    }
+    next_seq[s.channel].store(s.seq + 1U, std::memory_order_relaxed);
+    received.fetch_add(1U, std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(threads_mutex);
+    if (std::find(threads.begin(), threads.end(), std::this_thread::get_id()) == threads.end()) {
+      threads.push_back(std::this_thread::get_id());
+    }
+  });
+  REQUIRE(handle.valid);
+
+  bus.Start();
+  REQUIRE(bus.IsRunning());
+  uint32_t published = 0U;
+  for (uint32_t i = 0U; i < kPerChannel; ++i) {
+    for (uint32_t c = 0U; c < kChannels; ++c) {
+      while (!bus.Publish(ShardSample{c, i}, 0U)) {
+        std::this_thread::yield();
+      }
+      ++published;
+    }
+  }
+
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while ((received.load() < published) && (std::chrono::steady_clock::now() < deadline)) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  bus.Stop();
+
+  REQUIRE(received.load() == published);
+  REQUIRE(out_of_order.load() == 0U);
+  REQUIRE(threads.size() == TestShardedBus::SHARD_COUNT);
+  REQUIRE(bus.ShardFor(ShardSample{5U, 0U}, 0U) == 1U);
+
+  bus.Unsubscribe(handle);
+}
+
+TEST_CASE("ShardedBus ROUND_ROBIN spreads load over shards", "[ShardedBus]") {
+  TestShardedBus bus(mccc::ShardRouting::ROUND_ROBIN);
+  std::atomic<uint32_t> received{0U};
+  auto handle = bus.Subscribe<ShardLog>([&received](const ShardEnvelope&) { received.fetch_add(1U); });
+
+  for (uint32_t i = 0U; i < 400U; ++i) {
+    REQUIRE(bus.Publish(ShardLog{i}, 1U));
+  }
+  for (uint32_t i = 0U; i < TestShardedBus::SHARD_COUNT; ++i) {
+    REQUIRE(bus.Shard(i).QueueDepth() == 100U);
+  }
+
+  bus.Start();
+  bus.Stop();  // drains before joining
+  REQUIRE(received.load() == 400U);
+  REQUIRE(bus.GetStatistics().messages_processed == 400U);
+
+  bus.ResetStatistics();
+  REQUIRE(bus.GetStatistics().messages_published == 0U);
+  bus.Unsubscribe(handle);
+}
+
+TEST_CASE("ShardedBus ROUND_ROBIN rotation is per bus instance", "[ShardedBus]") {
+  TestShardedBus first(mccc::ShardRouting::ROUND_ROBIN);
+  TestShardedBus second(mccc::ShardRouting::ROUND_ROBIN);
+
+  // Interleaved publishes from one thread must not skew either bus
+  for (uint32_t i = 0U; i < TestShardedBus::SHARD_COUNT * 10U; ++i) {
+    REQUIRE(first.Publish(ShardLog{i}, 1U));
+    REQUIRE(second.Publish(ShardLog{i}, 1U));
+  }
+  for (uint32_t i = 0U; i < TestShardedBus::SHARD_COUNT; ++i) {
+    REQUIRE(first.Shard(i).QueueDepth() == 10U);
+    REQUIRE(second.Shard(i).QueueDepth() == 10U);
+  }
+}
+
+TEST_CASE("ShardedBus BY_KEY without extractor falls back to BY_TYPE", "[ShardedBus]") {
+  TestShardedBus bus(mccc::ShardRouting::BY_KEY, nullptr);
+  REQUIRE(bus.ShardFor(ShardCmd{1U}, 99U) == 1U);
+  REQUIRE(bus.ShardFor(ShardLog{1U}, 99U) == 2U);
+}
@@ -0,0 +1,221 @@
+/**
+ * @file test_shm_bus.cpp
+ * @brief Unit tests for the shared-memory ShmBus (segment validation, cross-process publish).
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <mccc/shm_bus.hpp>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct ShmImu {
+  uint32_t seq;
+  float accel[3];
+};
+struct ShmCmd {
+  uint32_t code;
+};
+
+using ShmPayload = std::variant<ShmImu, ShmCmd>;
+using ImuBus = mccc::ShmBus<ShmPayload, 256U>;
+using OtherTypesBus = mccc::ShmBus<std::variant<ShmCmd, ShmImu>, 256U>;
+using OtherDepthBus = mccc::ShmBus<ShmPayload, 512U>;
+
+/** Unique per test process so parallel ctest runs do not collide. */
+std::string SegmentName(const char* tag) { return "/mccc_test_" + std::string(tag) + "_" + std::to_string(getpid()); }
+
+/** Runs body in a forked child; returns the child's exit status. */
+template <typename Body>
+int RunInChild(Body body) {
+  const pid_t pid = fork();
+  if (pid == 0) {
+    _exit(body());
+  }
+  int status = 0;
+  (void)waitpid(pid, &status, 0);
+  return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+}
+
+}  // namespace
+
+TEST_CASE("Create and attach in one process", "[ShmBus]") {
+  const std::string name = SegmentName("local");
+  auto consumer = std::make_unique<ImuBus>();
+  auto producer = std::make_unique<ImuBus>();
+  REQUIRE(consumer->Create(name.c_str()) == mccc::ShmError::OK);
+  REQUIRE(consumer->Create(name.c_str()) == mccc::ShmError::ALREADY_OPEN);
+  REQUIRE(producer->Attach(name.c_str()) == mccc::ShmError::OK);
+  REQUIRE(consumer->IsOwner());
+  REQUIRE_FALSE(producer->IsOwner());
+
+  std::vector<uint32_t> seen;
+  consumer->Subscribe<ShmImu>([&seen](const ImuBus::EnvelopeType& env) {
+    seen.push_back(std::get<ShmImu>(env.payload).seq);
+    REQUIRE(env.header.sender_id == 7U);
+    REQUIRE(env.header.msg_id != 0U);
+  });
+
+  for (uint32_t i = 0U; i < 10U; ++i) {
+    REQUIRE(producer->Publish(ShmImu{i, {0.0f, 0.0f, 9.8f}}, 7U));
+  }
+  REQUIRE(consumer->QueueDepth() == 10U);
+  REQUIRE(producer->ProcessBatch() == 0U);  // only the owner consumes
+  REQUIRE(consumer->ProcessBatch() == 10U);
+  REQUIRE(seen.size() == 10U);
+  REQUIRE(seen.back() == 9U);
+
+  const mccc::BusStatisticsSnapshot stats = producer->GetStatistics();
+  REQUIRE(stats.messages_published == 10U);
+  REQUIRE(stats.messages_processed == 10U);
+}
+
+TEST_CASE("Attach validates the segment", "[ShmBus]") {
+  const std::string name = SegmentName("validate");
+  auto producer = std::make_unique<ImuBus>();
+  REQUIRE(producer->Attach(name.c_str()) == mccc::ShmError::NOT_READY);  // not created yet
+
+  auto consumer = std::make_unique<ImuBus>();
+  REQUIRE(consumer->Create(name.c_str()) == mccc::ShmError::OK);
+
+  auto reordered = std::make_unique<OtherTypesBus>();
+  REQUIRE(reordered->Attach(name.c_str()) == mccc::ShmError::TYPE_MISMATCH);
+  auto deeper = std::make_unique<OtherDepthBus>();
+  REQUIRE(deeper->Attach(name.c_str()) == mccc::ShmError::LAYOUT_MISMATCH);
+  REQUIRE_FALSE(reordered->IsOpen());
+
+  // Owner close unlinks the name
+  consumer->Close();
+  REQUIRE(producer->Attach(name.c_str()) == mccc::ShmError::NOT_READY);
+}
+
+TEST_CASE("Create does not take over an existing segment unless asked", "[ShmBus]") {
+  const std::string name = SegmentName("exclusive");
+  auto consumer = std::make_unique<ImuBus>();
+  REQUIRE(consumer->Create(name.c_str()) == mccc::ShmError::OK);
+  auto producer = std::make_unique<ImuBus>();
+  REQUIRE(producer->Attach(name.c_str()) == mccc::ShmError::OK);
+
+  auto second = std::make_unique<ImuBus>();
+  REQUIRE(second->Create(name.c_str()) == mccc::ShmError::EXISTS);
+  REQUIRE_FALSE(second->IsOpen());
+  REQUIRE(producer->Publish(ShmImu{1U, {0.0f, 0.0f, 0.0f}}, 1U));
+  REQUIRE(consumer->ProcessBatch() == 1U);  // the live consumer still owns the ring
+
+  // Explicit takeover, e.g. of a segment left behind by a crashed consumer
+  REQUIRE(second->Create(name.c_str(), mccc::ShmCreate::REPLACE) == mccc::ShmError::OK);
+  auto late = std::make_unique<ImuBus>();
+  REQUIRE(late->Attach(name.c_str()) == mccc::ShmError::OK);
+  REQUIRE(late->Publish(ShmImu{2U, {0.0f, 0.0f, 0.0f}}, 1U));
+  REQUIRE(second->ProcessBatch() == 1U);
+  REQUIRE(consumer->ProcessBatch() == 0U);
+}
+
+TEST_CASE("Type hash depends only on the payload layout", "[ShmBus]") {
+  struct Same {
+    uint32_t seq;
+    float accel[3];
+  };
+  struct Wider {
+    uint64_t seq;
+    float accel[3];
+  };
+  STATIC_REQUIRE(mccc::detail::PayloadLayoutHash<std::variant<Same, ShmCmd>>() ==
+                 mccc::detail::PayloadLayoutHash<ShmPayload>());
+  STATIC_REQUIRE(mccc::detail::PayloadLayoutHash<std::variant<Wider, ShmCmd>>() !=
+                 mccc::detail::PayloadLayoutHash<ShmPayload>());
+  STATIC_REQUIRE(ImuBus::TYPE_HASH != OtherTypesBus::TYPE_HASH);
+}
+
+TEST_CASE("Shared ring applies priority admission", "[ShmBus]") {
+  const std::string name = SegmentName("admission");
+  auto bus = std::make_unique<ImuBus>();
+  REQUIRE(bus->Create(name.c_str()) == mccc::ShmError::OK);
+
+  uint32_t accepted = 0U;
+  while (bus->Publish(ShmCmd{accepted}, 1U, mccc::MessagePriority::LOW)) {
+    ++accepted;
+  }
+  REQUIRE(accepted == ImuBus::LOW_PRIORITY_THRESHOLD);
+  REQUIRE(bus->Publish(ShmCmd{0U}, 1U, mccc::MessagePriority::HIGH));
+  REQUIRE(bus->GetStatistics().messages_dropped == 1U);
+
+  // Ring wraps
+  for (uint32_t round = 0U; round < 4U; ++round) {
+    while (bus->ProcessBatch() > 0U) {}
+    for (uint32_t i = 0U; i < ImuBus::HIGH_PRIORITY_THRESHOLD; ++i) {
+      REQUIRE(bus->Publish(ShmCmd{i}, 1U, mccc::MessagePriority::HIGH));
+    }
+  }
+  while (bus->ProcessBatch() > 0U) {}
+  REQUIRE(bus->QueueDepth() == 0U);
+}
+
+TEST_CASE("Producers in other processes publish to the consumer", "[ShmBus]") {
+  const std::string name = SegmentName("fork");
+  auto consumer = std::make_unique<ImuBus>();
+  REQUIRE(consumer->Create(name.c_str()) == mccc::ShmError::OK);
+
+  constexpr uint32_t kPerProducer = 2000U;
+  std::vector<uint32_t> next_seq(3U, 0U);
+  bool in_order = true;
+  consumer->Subscribe<ShmImu>([&next_seq, &in_order](const ImuBus::EnvelopeType& env) {
+    const uint32_t sender = env.header.sender_id;
+    in_order = in_order && (std::get<ShmImu>(env.payload).seq == next_seq[sender]);
+    ++next_seq[sender];
+  });
+
+  std::vector<pid_t> children;
+  for (uint32_t sender = 1U; sender <= 2U; ++sender) {
+    const pid_t pid = fork();
+    if (pid == 0) {
+      ImuBus producer;
+      if (producer.Attach(name.c_str()) != mccc::ShmError::OK) {
+        _exit(1);
+      }
+      for (uint32_t i = 0U; i < kPerProducer;) {
+        if (producer.Publish(ShmImu{i, {1.0f, 2.0f, 3.0f}}, sender)) {
+          ++i;
+        }
+      }
+      _exit(0);
+    }
+    children.push_back(pid);
+  }
+
+  uint32_t received = 0U;
+  while (received < 2U * kPerProducer) {
+    received += consumer->ProcessBatch();
+  }
+  for (pid_t pid : children) {
+    int status = 0;
+    REQUIRE(waitpid(pid, &status, 0) == pid);
+    REQUIRE(WIFEXITED(status));
+    REQUIRE(WEXITSTATUS(status) == 0);
+  }
+  REQUIRE(in_order);
+  REQUIRE(next_seq[1] == kPerProducer);
+  REQUIRE(next_seq[2] == kPerProducer);
+}
+
+TEST_CASE("A child attaches after the creator is ready", "[ShmBus]") {
+  const std::string name = SegmentName("child");
+  auto consumer = std::make_unique<ImuBus>();
+  REQUIRE(consumer->Create(name.c_str()) == mccc::ShmError::OK);
+  uint32_t code = 0U;
+  consumer->Subscribe<ShmCmd>([&code](const ImuBus::EnvelopeType& env) { code = std::get<ShmCmd>(env.payload).code; });
+
+  REQUIRE(RunInChild([&name]() {
+            ImuBus producer;
+            const bool ok = (producer.Attach(name.c_str()) == mccc::ShmError::OK) && producer.Publish(ShmCmd{42U}, 3U);
+            return ok ? 0 : 1;
+          }) == 0);
+  REQUIRE(consumer->ProcessBatch() == 1U);
+  REQUIRE(code == 42U);
+}
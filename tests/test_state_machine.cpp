@@ -0,0 +1,153 @@
+/**
+ * @file test_state_machine.cpp
+ * @brief Unit tests for the HSM frozen (flat table) dispatch mode.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "state_machine.hpp"
+
+#include <cstdint>
+
+#include <memory>
+#include <vector>
+
+namespace {
+
+struct SmContext {
+  std::vector<uint32_t> trace;  // state * 10 + 1 entry / + 2 exit, 100+ actions
+  bool allow{false};
+  uint32_t unhandled{0U};
+};
+
+using SmState = hsm::State<SmContext>;
+using SmMachine = hsm::StateMachine<SmContext>;
+
+/**
+ * Root(1) { A(2) { A1(3), A2(4) }, B(5) { B1(6) } }
+ * Covers guards falling through to a parent, internal and self transitions,
+ * a transition to an ancestor, default handlers and unhandled events.
+ */
+struct SmChart {
+  SmState root{"Root"};
+  SmState a{"A"};
+  SmState a1{"A1"};
+  SmState a2{"A2"};
+  SmState b{"B"};
+  SmState b1{"B1"};
+
+  SmChart() {
+    SmState* states[] = {&root, &a, &a1, &a2, &b, &b1};
+    for (uint32_t i = 0U; i < 6U; ++i) {
+      const uint32_t code = (i + 1U) * 10U;
+      states[i]->set_on_entry([code](SmContext& ctx, const hsm::Event&) { ctx.trace.push_back(code + 1U); });
+      states[i]->set_on_exit([code](SmContext& ctx, const hsm::Event&) { ctx.trace.push_back(code + 2U); });
+    }
+    a.set_parent(root);
+    a1.set_parent(a);
+    a2.set_parent(a);
+    b.set_parent(root);
+    b1.set_parent(b);
+
+    const auto action = [](uint32_t code) {
+      return [code](SmContext& ctx, const hsm::Event&) { ctx.trace.push_back(code); };
+    };
+    a1.AddTransition(1U, a2, action(101U))
+        .AddTransition(
+            2U, b1, [](const SmContext& ctx, const hsm::Event&) { return ctx.allow; }, action(102U))
+        .AddInternalTransition(3U, action(103U));
+    a.AddTransition(2U, b, action(104U)).AddTransition(4U, a, action(105U));
+    a2.AddTransition(5U, a2, action(106U)).AddTransition(1U, a1);
+    b.AddTransition(1U, a1, action(107U));
+    b1.AddInternalTransition(
+        3U, [](const SmContext& ctx, const hsm::Event&) { return ctx.allow; }, action(108U));
+    root.AddInternalTransition(7U, [](SmContext& ctx, const hsm::Event&) { ctx.allow = !ctx.allow; });
+    root.set_default_handler([](SmContext& ctx, const hsm::Event& event) {
+      ctx.trace.push_back(200U + event.id());
+      return event.id() == 9U;
+    });
+  }
+};
+
+}  // namespace
+
+TEST_CASE("Frozen dispatch matches the dynamic machine", "[StateMachine]") {
+  auto chart = std::make_unique<SmChart>();
+  SmContext dyn_ctx;
+  SmContext flat_ctx;
+  SmMachine dynamic(chart->a1, dyn_ctx);
+  SmMachine flat(chart->a1, flat_ctx);
+  REQUIRE_FALSE(flat.frozen());
+  flat.Freeze();
+  REQUIRE(flat.frozen());
+  REQUIRE_FALSE(dynamic.frozen());
+  dynamic.set_unhandled_event_handler([](SmContext& ctx, const hsm::Event&) { ++ctx.unhandled; });
+  flat.set_unhandled_event_handler([](SmContext& ctx, const hsm::Event&) { ++ctx.unhandled; });
+
+  const std::vector<uint32_t> events{3U, 1U, 5U, 1U, 2U, 3U, 1U, 7U, 3U, 2U, 1U, 4U, 1U, 1U,
+                                     9U, 8U, 42U, 7U, 2U, 3U, 0U, 1U, 1U, 5U, 4U, 9U};
+  for (uint32_t id : events) {
+    const bool dyn_handled = dynamic.Dispatch(hsm::Event(id));
+    const bool flat_handled = flat.Dispatch(hsm::Event(id));
+    REQUIRE(dyn_handled == flat_handled);
+    REQUIRE(&dynamic.current_state() == &flat.current_state());
+  }
+  REQUIRE(flat_ctx.trace == dyn_ctx.trace);
+  REQUIRE(flat_ctx.unhandled == dyn_ctx.unhandled);
+  REQUIRE(flat_ctx.unhandled > 0U);
+
+  dynamic.Reset();
+  flat.Reset();
+  REQUIRE(flat.current_state_name() == "A1");
+  REQUIRE(flat.Dispatch(hsm::Event(1U)));
+  REQUIRE(dynamic.Dispatch(hsm::Event(1U)));
+  REQUIRE(flat.IsInState(chart->a2));
+  REQUIRE(flat.IsInState(chart->root));
+  REQUIRE(flat_ctx.trace == dyn_ctx.trace);
+}
+
+TEST_CASE("Freeze starts from the current state and can be repeated", "[StateMachine]") {
+  auto chart = std::make_unique<SmChart>();
+  SmContext ctx;
+  SmMachine machine(chart->a1, ctx);
+  ctx.allow = true;
+  REQUIRE(machine.Dispatch(hsm::Event(2U)));  // A1 -> B1, dynamic
+  REQUIRE(machine.current_state_name() == "B1");
+
+  machine.Freeze();
+  ctx.trace.clear();
+  REQUIRE(machine.Dispatch(hsm::Event(3U)));  // B1 internal, guarded
+  REQUIRE(machine.Dispatch(hsm::Event(1U)));  // B -> A1 via parent
+  REQUIRE(ctx.trace == std::vector<uint32_t>{108U, 107U, 62U, 52U, 21U, 31U});
+  REQUIRE(machine.current_state_name() == "A1");
+
+  // Setup changes take effect on the next Freeze()
+  SmState c{"C"};
+  c.set_parent(chart->root);
+  chart->a1.AddTransition(11U, c);
+  machine.Freeze();
+  REQUIRE(machine.Dispatch(hsm::Event(11U)));
+  REQUIRE(machine.current_state_name() == "C");
+  REQUIRE(machine.Dispatch(hsm::Event(9U)));  // default handler still reached
+}
+
+TEST_CASE("Frozen dispatch handles sparse and maximal event ids", "[StateMachine]") {
+  auto chart = std::make_unique<SmChart>();
+  chart->a2.AddTransition(UINT32_MAX, chart->b1).AddTransition(0x10000000U, chart->a1);
+  chart->b1.AddTransition(UINT32_MAX - 1U, chart->a2);
+  SmContext dyn_ctx;
+  SmContext flat_ctx;
+  SmMachine dynamic(chart->a1, dyn_ctx);
+  SmMachine flat(chart->a1, flat_ctx);
+  flat.Freeze();
+
+  const std::vector<uint32_t> events{1U, UINT32_MAX, 3U, UINT32_MAX - 1U, 0x10000000U, 1U, 0x10000000U,
+                                     UINT32_MAX, 42U, 2U, 9U, UINT32_MAX - 1U, 4U, 1U};
+  for (uint32_t id : events) {
+    const bool dyn_handled = dynamic.Dispatch(hsm::Event(id));
+    const bool flat_handled = flat.Dispatch(hsm::Event(id));
+    REQUIRE(dyn_handled == flat_handled);
+    REQUIRE(&dynamic.current_state() == &flat.current_state());
+  }
+  REQUIRE(flat_ctx.trace == dyn_ctx.trace);
+}
@@ -1,6 +1,7 @@
 #include <catch2/catch_test_macros.hpp>
 #include <mccc/static_component.hpp>
 #include <variant>
+#include <vector>
 
 namespace {
 
@@ -104,3 +105,91 @@ TEST_CASE("StaticComponent multiple process rounds", "[StaticComponent]") {
   REQUIRE(comp.motor_count == 1);
   REQUIRE(comp.last_temp == 2.0f);
 }
+
+namespace {
+
+class LogComponent {
+ public:
+  int log_count = 0;
+  int sensor_seen = 0;
+  std::vector<int>* order = nullptr;
+
+  void Handle(const LogMsg& m) noexcept { log_count += m.level; }
+  void Handle(const SensorData&) noexcept {
+    ++sensor_seen;
+    if (order != nullptr) {
+      order->push_back(2);
+    }
+  }
+};
+
+class OrderedSensor : public mccc::StaticComponent<OrderedSensor, TestPayload> {
+ public:
+  std::vector<int>* order = nullptr;
+
+  void Handle(const SensorData&) noexcept {
+    if (order != nullptr) {
+      order->push_back(1);
+    }
+  }
+};
+
+class ConstMonitor {
+ public:
+  void Handle(const MotorCmd&) const noexcept { ++motor_seen; }
+  mutable int motor_seen = 0;
+};
+
+}  // namespace
+
+TEST_CASE("StaticDispatcher resolves handler lists at compile time", "[StaticComponent]") {
+  using Dispatcher = mccc::StaticDispatcher<TestComponent, LogComponent, const ConstMonitor>;
+  STATIC_REQUIRE(Dispatcher::HandlerCount<SensorData>() == 2U);
+  STATIC_REQUIRE(Dispatcher::HandlerCount<MotorCmd>() == 2U);
+  STATIC_REQUIRE(Dispatcher::HandlerCount<LogMsg>() == 1U);
+  STATIC_REQUIRE(mccc::StaticDispatcher<TestComponent>::HandlerCount<LogMsg>() == 0U);
+}
+
+TEST_CASE("StaticDispatcher fans one pass out to every component", "[StaticComponent]") {
+  auto& bus = TestBus::Instance();
+  TestComponent comp;
+  LogComponent logger;
+  const ConstMonitor monitor;
+  mccc::StaticDispatcher<TestComponent, LogComponent, const ConstMonitor> dispatcher(comp, logger, monitor);
+
+  while (bus.ProcessBatchWith(dispatcher) > 0U) {}
+  comp.sensor_count = 0;
+  logger.sensor_seen = 0;
+
+  bus.Publish(SensorData{3.5f}, 1);
+  bus.Publish(MotorCmd{7}, 1);
+  bus.Publish(LogMsg{4}, 1);
+  bus.Publish(LogMsg{5}, 1);
+
+  REQUIRE(bus.ProcessBatchWith(dispatcher) == 4U);
+  REQUIRE(comp.sensor_count == 1);
+  REQUIRE(comp.last_temp == 3.5f);
+  REQUIRE(comp.motor_count == 1);
+  REQUIRE(comp.last_speed == 7);
+  REQUIRE(logger.sensor_seen == 1);
+  REQUIRE(logger.log_count == 9);
+  REQUIRE(monitor.motor_seen == 1);
+}
+
+TEST_CASE("StaticDispatcher calls handlers in component order", "[StaticComponent]") {
+  auto& bus = TestBus::Instance();
+  std::vector<int> order;
+  OrderedSensor sensor;
+  LogComponent logger;
+  sensor.order = &order;
+  logger.order = &order;
+  mccc::StaticDispatcher<OrderedSensor, LogComponent> dispatcher(sensor, logger);
+
+  while (bus.ProcessBatchWith(dispatcher) > 0U) {}
+  order.clear();
+
+  bus.Publish(SensorData{1.0f}, 1);
+  bus.Publish(SensorData{2.0f}, 1);
+  REQUIRE(bus.ProcessBatchWith(dispatcher) == 2U);
+  REQUIRE(order == std::vector<int>{1, 2, 1, 2});
+}
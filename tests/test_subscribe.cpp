@@ -7,6 +7,8 @@
 #include <catch2/catch_test_macros.hpp>
 #include <mccc/component.hpp>
 #include <memory>
+#include <thread>
+#include <vector>
 
 struct SubMsgA {
   int value;
@@ -196,3 +198,92 @@ TEST_CASE("SubscribeSimple works", "[Subscribe]") {
 
   REQUIRE(comp->last_value_ == 3.14f);
 }
+
+// ============================================================================
+// Create() + SubscribeMember: raw this, no per-message weak_ptr lock
+// ============================================================================
+
+namespace {
+
+std::atomic<int> g_member_live{0};
+
+class MemberComponent : public SubComponent {
+ public:
+  explicit MemberComponent(SubBus& bus) : SubComponent(bus) { g_member_live.fetch_add(1); }
+  ~MemberComponent() override { g_member_live.fetch_sub(1); }
+
+  bool Init() {
+    return SubscribeMember<SubMsgA>(&MemberComponent::OnA) && SubscribeMember<SubMsgB>(&MemberComponent::OnB);
+  }
+
+  void OnA(const SubMsgA& msg, const mccc::MessageHeader& header) {
+    seen_.push_back(msg.value);  // heap member: a late call would be a use-after-free
+    last_sender_ = header.sender_id;
+  }
+  void OnB(const SubMsgB& msg, const mccc::MessageHeader&) { last_b_ = msg.data; }
+
+  std::vector<int> seen_;
+  uint32_t last_sender_{0U};
+  float last_b_{0.0f};
+};
+
+}  // namespace
+
+TEST_CASE("Create() components dispatch to member functions", "[Subscribe]") {
+  auto bus = std::make_unique<SubBus>();
+  std::atomic<int> external{0};
+  const mccc::SubscriptionHandle ext =
+      bus->Subscribe<SubMsgA>([&external](const SubEnvelope&) { external.fetch_add(1); });
+  {
+    std::shared_ptr<MemberComponent> comp = SubComponent::Create<MemberComponent>(*bus);
+    REQUIRE(comp->Init());
+    REQUIRE(comp->shared_from_this().get() == comp.get());
+    REQUIRE(&comp->Bus() == bus.get());
+
+    REQUIRE(bus->Publish(SubMsgA{5}, 9U));
+    REQUIRE(bus->Publish(SubMsgB{2.5f}, 1U));
+    REQUIRE(bus->Publish(SubMsgA{6}, 9U));
+    REQUIRE(bus->ProcessBatch() == 3U);
+    REQUIRE(comp->seen_ == std::vector<int>{5, 6});
+    REQUIRE(comp->last_sender_ == 9U);
+    REQUIRE(comp->last_b_ == 2.5f);
+    REQUIRE(comp.use_count() == 1);  // dispatch took no reference
+  }
+  REQUIRE(g_member_live.load() == 0);
+
+  // Deleter unsubscribed before destruction; other subscribers unaffected
+  REQUIRE(bus->Publish(SubMsgA{7}, 9U));
+  REQUIRE(bus->ProcessBatch() == 1U);
+  REQUIRE(external.load() == 3);
+  REQUIRE(bus->Unsubscribe(ext));
+}
+
+TEST_CASE("Create() components can be released while the consumer dispatches to them", "[Subscribe]") {
+  auto bus = std::make_unique<SubBus>();
+  std::atomic<bool> stop{false};
+  std::thread consumer([&bus, &stop]() {
+    while (!stop.load(std::memory_order_acquire)) {
+      (void)bus->ProcessBatch();
+    }
+    while (bus->ProcessBatch() > 0U) {}
+  });
+
+  uint32_t subscribed = 0U;
+  for (int round = 0; round < 200; ++round) {
+    std::shared_ptr<MemberComponent> comp = SubComponent::Create<MemberComponent>(*bus);
+    subscribed += comp->Init() ? 1U : 0U;
+    for (int i = 0; i < 20; ++i) {
+      (void)bus->Publish(SubMsgA{i}, 1U);
+      (void)bus->Publish(SubMsgB{static_cast<float>(i)}, 1U);
+    }
+    if ((round % 2) == 0) {
+      std::this_thread::yield();
+    }
+    comp.reset();  // usually with messages for it still queued or mid-dispatch
+  }
+  stop.store(true, std::memory_order_release);
+  consumer.join();
+
+  REQUIRE(subscribed == 200U);
+  REQUIRE(g_member_live.load() == 0);
+}
@@ -0,0 +1,155 @@
+/**
+ * @file test_subscribe_batch.cpp
+ * @brief Unit tests for SubscribeBatch() run delivery of same-type messages.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <mccc/mccc.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct RunSample {
+  uint32_t value;
+};
+struct RunMarker {
+  uint32_t id;
+};
+
+using RunPayload = std::variant<RunSample, RunMarker>;
+using RunBus = mccc::AsyncBus<RunPayload, 64U>;
+using RunEnvelope = RunBus::EnvelopeType;
+
+}  // namespace
+
+TEST_CASE("Consecutive messages arrive as one span", "[SubscribeBatch]") {
+  auto bus = std::make_unique<RunBus>();
+  std::vector<std::vector<uint32_t>> runs;
+  auto handle = bus->SubscribeBatch<RunSample>([&runs](RunBus::EnvelopeSpan span) {
+    std::vector<uint32_t> values;
+    for (const RunEnvelope* env : span) {
+      values.push_back(std::get<RunSample>(env->payload).value);
+    }
+    REQUIRE(std::get<RunSample>(span[0U].payload).value == values.front());
+    runs.push_back(values);
+  });
+  REQUIRE(handle.callback_id != static_cast<size_t>(-1));
+
+  for (uint32_t i = 0U; i < 5U; ++i) {
+    REQUIRE(bus->Publish(RunSample{i}, 1U));
+  }
+  REQUIRE(bus->ProcessBatch() == 5U);
+  REQUIRE(runs == std::vector<std::vector<uint32_t>>{{0U, 1U, 2U, 3U, 4U}});
+  REQUIRE(bus->GetStatistics().messages_processed == 5U);
+}
+
+TEST_CASE("Type changes split runs and keep publish order", "[SubscribeBatch]") {
+  auto bus = std::make_unique<RunBus>();
+  std::vector<std::string> trace;
+  bus->SubscribeBatch<RunSample>([&trace](RunBus::EnvelopeSpan span) {
+    trace.push_back("run" + std::to_string(span.size));
+  });
+  bus->Subscribe<RunSample>([&trace](const RunEnvelope& env) {
+    trace.push_back("s" + std::to_string(std::get<RunSample>(env.payload).value));
+  });
+  bus->Subscribe<RunMarker>([&trace](const RunEnvelope& env) {
+    trace.push_back("m" + std::to_string(std::get<RunMarker>(env.payload).id));
+  });
+
+  REQUIRE(bus->Publish(RunSample{1U}, 1U));
+  REQUIRE(bus->Publish(RunSample{2U}, 1U));
+  REQUIRE(bus->Publish(RunMarker{1U}, 1U));
+  REQUIRE(bus->Publish(RunSample{3U}, 1U));
+  REQUIRE(bus->ProcessBatch() == 4U);
+
+  // Per-message callbacks still run; a run is delivered before the next type dispatches
+  REQUIRE(trace == std::vector<std::string>{"s1", "s2", "run2", "m1", "s3", "run1"});
+}
+
+TEST_CASE("Batch window bounds the run", "[SubscribeBatch]") {
+  auto bus = std::make_unique<RunBus>();
+  std::vector<uint32_t> sizes;
+  bus->SubscribeBatch<RunSample>([&sizes](RunBus::EnvelopeSpan span) { sizes.push_back(span.size); });
+
+  for (uint32_t i = 0U; i < 10U; ++i) {
+    REQUIRE(bus->Publish(RunSample{i}, 1U));
+  }
+  REQUIRE(bus->ProcessBatch(4U) == 4U);
+  REQUIRE(bus->ProcessBatch() == 6U);
+  REQUIRE(sizes == std::vector<uint32_t>{4U, 6U});
+}
+
+TEST_CASE("Cancelled slots inside a run are skipped", "[SubscribeBatch]") {
+  auto bus = std::make_unique<RunBus>();
+  std::vector<uint32_t> values;
+  bus->SubscribeBatch<RunSample>([&values](RunBus::EnvelopeSpan span) {
+    for (const RunEnvelope* env : span) {
+      values.push_back(std::get<RunSample>(env->payload).value);
+    }
+  });
+
+  REQUIRE(bus->Publish(RunSample{1U}, 1U));
+  {
+    auto slot = bus->TryReserve<RunSample>();
+    REQUIRE(slot);
+    slot.Cancel();
+  }
+  REQUIRE(bus->Publish(RunSample{2U}, 1U));
+  REQUIRE(bus->ProcessBatch() == 3U);
+  REQUIRE(values == std::vector<uint32_t>{1U, 2U});
+  REQUIRE(bus->QueueDepth() == 0U);
+}
+
+TEST_CASE("Run slots are released after delivery", "[SubscribeBatch]") {
+  auto bus = std::make_unique<RunBus>();
+  uint32_t delivered = 0U;
+  bus->SubscribeBatch<RunSample>([&delivered](RunBus::EnvelopeSpan span) { delivered += span.size; });
+
+  // Several full rings: producers can only reuse slots the flush released
+  for (uint32_t round = 0U; round < 8U; ++round) {
+    uint32_t published = 0U;
+    while (bus->PublishWithPriority(RunSample{published}, 1U, mccc::MessagePriority::HIGH)) {
+      ++published;
+    }
+    REQUIRE(published == RunBus::HIGH_PRIORITY_THRESHOLD);
+    REQUIRE(bus->ProcessBatch() == published);
+    REQUIRE(bus->QueueDepth() == 0U);
+  }
+  REQUIRE(delivered == 8U * RunBus::HIGH_PRIORITY_THRESHOLD);
+}
+
+TEST_CASE("Unsubscribe removes a batch callback", "[SubscribeBatch]") {
+  auto bus = std::make_unique<RunBus>();
+  uint32_t batch_calls = 0U;
+  uint32_t single_calls = 0U;
+  auto batch = bus->SubscribeBatch<RunSample>([&batch_calls](RunBus::EnvelopeSpan) { ++batch_calls; });
+  auto single = bus->Subscribe<RunSample>([&single_calls](const RunEnvelope&) { ++single_calls; });
+  REQUIRE(batch.callback_id != single.callback_id);
+
+  REQUIRE(bus->Publish(RunSample{1U}, 1U));
+  REQUIRE(bus->ProcessBatch() == 1U);
+  REQUIRE(bus->Unsubscribe(batch));
+  REQUIRE_FALSE(bus->Unsubscribe(batch));
+
+  REQUIRE(bus->Publish(RunSample{2U}, 1U));
+  REQUIRE(bus->ProcessBatch() == 1U);
+  REQUIRE(batch_calls == 1U);
+  REQUIRE(single_calls == 2U);
+  REQUIRE(bus->Unsubscribe(single));
+}
+
+TEST_CASE("SubscribeBatch capacity is per type", "[SubscribeBatch]") {
+  auto bus = std::make_unique<RunBus>();
+  std::vector<mccc::SubscriptionHandle> handles;
+  for (uint32_t i = 0U; i < MCCC_MAX_CALLBACKS_PER_TYPE; ++i) {
+    handles.push_back(bus->SubscribeBatch<RunMarker>([](RunBus::EnvelopeSpan) {}));
+    REQUIRE(handles.back().callback_id != static_cast<size_t>(-1));
+  }
+  REQUIRE(bus->SubscribeBatch<RunMarker>([](RunBus::EnvelopeSpan) {}).callback_id == static_cast<size_t>(-1));
+  for (const auto& h : handles) {
+    REQUIRE(bus->Unsubscribe(h));
+  }
+}
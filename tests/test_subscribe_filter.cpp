@@ -0,0 +1,148 @@
+/**
+ * @file test_subscribe_filter.cpp
+ * @brief Unit tests for subscribe-time sender_id / payload key filters.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <mccc/mccc.hpp>
+
+#include <memory>
+#include <vector>
+
+namespace {
+
+struct Reading {
+  uint32_t channel;
+  uint32_t value;
+};
+struct Status {
+  uint32_t code;
+};
+
+/** Payload key used by FilterKey::PAYLOAD_KEY filters (found by ADL). */
+uint32_t MessageKey(const Reading& r) noexcept { return r.channel; }
+
+using FilterPayload = std::variant<Reading, Status>;
+using FilterBus = mccc::AsyncBus<FilterPayload, 256U>;
+using FilterEnvelope = FilterBus::EnvelopeType;
+
+}  // namespace
+
+TEST_CASE("Filter matching semantics", "[SubscribeFilter]") {
+  STATIC_REQUIRE(mccc::detail::HasMessageKey<Reading>::value);
+  STATIC_REQUIRE_FALSE(mccc::detail::HasMessageKey<Status>::value);
+
+  constexpr auto exact = mccc::SubscriptionFilter::Sender(7U);
+  STATIC_REQUIRE(exact.Matches(7U));
+  STATIC_REQUIRE_FALSE(exact.Matches(8U));
+
+  constexpr auto masked = mccc::SubscriptionFilter::SenderMask(0xF0U, 0x30U);
+  STATIC_REQUIRE(masked.Matches(0x35U));
+  STATIC_REQUIRE_FALSE(masked.Matches(0x45U));
+
+  constexpr auto range = mccc::SubscriptionFilter::KeyRange(10U, 20U);
+  STATIC_REQUIRE(range.key == mccc::FilterKey::PAYLOAD_KEY);
+  STATIC_REQUIRE(range.Matches(10U));
+  STATIC_REQUIRE(range.Matches(20U));
+  STATIC_REQUIRE_FALSE(range.Matches(21U));
+}
+
+TEST_CASE("Sender filters deliver only matching senders", "[SubscribeFilter]") {
+  auto bus = std::make_unique<FilterBus>();
+  std::vector<uint32_t> exact;
+  std::vector<uint32_t> masked;
+  std::vector<uint32_t> range;
+  std::vector<uint32_t> all;
+  bus->Subscribe<Reading>(mccc::SubscriptionFilter::Sender(3U),
+                          [&exact](const FilterEnvelope& env) { exact.push_back(env.header.sender_id); });
+  bus->Subscribe<Reading>(mccc::SubscriptionFilter::SenderMask(0x100U, 0x100U),
+                          [&masked](const FilterEnvelope& env) { masked.push_back(env.header.sender_id); });
+  bus->Subscribe<Reading>(mccc::SubscriptionFilter::SenderRange(2U, 4U),
+                          [&range](const FilterEnvelope& env) { range.push_back(env.header.sender_id); });
+  bus->Subscribe<Reading>([&all](const FilterEnvelope& env) { all.push_back(env.header.sender_id); });
+
+  // 19 and 0x103 share sender 3's bucket: the exact filter still rejects them
+  const std::vector<uint32_t> senders{1U, 2U, 3U, 4U, 5U, 19U, 0x103U, 0x1FFU};
+  for (uint32_t sender : senders) {
+    REQUIRE(bus->Publish(Reading{0U, 0U}, sender));
+  }
+  REQUIRE(bus->ProcessBatch() == senders.size());
+
+  REQUIRE(exact == std::vector<uint32_t>{3U});
+  REQUIRE(masked == std::vector<uint32_t>{0x103U, 0x1FFU});
+  REQUIRE(range == std::vector<uint32_t>{2U, 3U, 4U});
+  REQUIRE(all == senders);
+}
+
+TEST_CASE("Payload key filters use MessageKey", "[SubscribeFilter]") {
+  auto bus = std::make_unique<FilterBus>();
+  std::vector<std::vector<uint32_t>> per_channel(4U);
+  for (uint32_t ch = 0U; ch < 4U; ++ch) {
+    auto handle =
+        bus->Subscribe<Reading>(mccc::SubscriptionFilter::Key(ch), [&per_channel, ch](const FilterEnvelope& env) {
+          per_channel[ch].push_back(std::get<Reading>(env.payload).value);
+        });
+    REQUIRE(handle.callback_id != static_cast<size_t>(-1));
+  }
+
+  for (uint32_t i = 0U; i < 12U; ++i) {
+    REQUIRE(bus->Publish(Reading{i % 4U, i}, 1U));
+  }
+  REQUIRE(bus->ProcessBatch() == 12U);
+  REQUIRE(per_channel[0] == std::vector<uint32_t>{0U, 4U, 8U});
+  REQUIRE(per_channel[3] == std::vector<uint32_t>{3U, 7U, 11U});
+}
+
+TEST_CASE("Payload key filter needs a MessageKey overload", "[SubscribeFilter]") {
+  auto bus = std::make_unique<FilterBus>();
+  auto handle = bus->Subscribe<Status>(mccc::SubscriptionFilter::Key(1U), [](const FilterEnvelope&) {});
+  REQUIRE(handle.callback_id == static_cast<size_t>(-1));
+
+  // Sender filters work for any type
+  uint32_t seen = 0U;
+  bus->Subscribe<Status>(mccc::SubscriptionFilter::Sender(9U), [&seen](const FilterEnvelope&) { ++seen; });
+  REQUIRE(bus->Publish(Status{1U}, 9U));
+  REQUIRE(bus->Publish(Status{2U}, 8U));
+  REQUIRE(bus->ProcessBatch() == 2U);
+  REQUIRE(seen == 1U);
+}
+
+TEST_CASE("Mixed filtered callbacks keep subscribe order", "[SubscribeFilter]") {
+  auto bus = std::make_unique<FilterBus>();
+  std::vector<int> order;
+  bus->Subscribe<Reading>([&order](const FilterEnvelope&) { order.push_back(0); });
+  bus->Subscribe<Reading>(mccc::SubscriptionFilter::Key(5U), [&order](const FilterEnvelope&) { order.push_back(1); });
+  bus->Subscribe<Reading>([&order](const FilterEnvelope&) { order.push_back(2); });
+  bus->Subscribe<Reading>(mccc::SubscriptionFilter::Sender(1U),
+                          [&order](const FilterEnvelope&) { order.push_back(3); });
+
+  REQUIRE(bus->Publish(Reading{5U, 0U}, 1U));
+  REQUIRE(bus->Publish(Reading{6U, 0U}, 2U));
+  REQUIRE(bus->ProcessBatch() == 2U);
+  REQUIRE(order == std::vector<int>{0, 1, 2, 3, 0, 2});
+}
+
+TEST_CASE("Unsubscribe rebuilds the filter index", "[SubscribeFilter]") {
+  auto bus = std::make_unique<FilterBus>();
+  uint32_t a = 0U;
+  uint32_t b = 0U;
+  uint32_t c = 0U;
+  auto ha = bus->Subscribe<Reading>(mccc::SubscriptionFilter::Sender(1U), [&a](const FilterEnvelope&) { ++a; });
+  auto hb = bus->Subscribe<Reading>(mccc::SubscriptionFilter::Key(2U), [&b](const FilterEnvelope&) { ++b; });
+  auto hc = bus->Subscribe<Reading>(mccc::SubscriptionFilter::Sender(2U), [&c](const FilterEnvelope&) { ++c; });
+
+  REQUIRE(bus->Unsubscribe(ha));  // later callbacks shift down one index
+  REQUIRE(bus->Publish(Reading{2U, 0U}, 1U));
+  REQUIRE(bus->Publish(Reading{0U, 0U}, 2U));
+  REQUIRE(bus->ProcessBatch() == 2U);
+  REQUIRE(a == 0U);
+  REQUIRE(b == 1U);
+  REQUIRE(c == 1U);
+
+  REQUIRE(bus->Unsubscribe(hb));
+  REQUIRE(bus->Unsubscribe(hc));
+  REQUIRE(bus->Publish(Reading{2U, 0U}, 2U));
+  REQUIRE(bus->ProcessBatch() == 1U);
+  REQUIRE(b == 1U);
+  REQUIRE(c == 1U);
+}
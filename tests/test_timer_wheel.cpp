@@ -0,0 +1,213 @@
+/**
+ * @file test_timer_wheel.cpp
+ * @brief Unit tests for TimerWheel: delayed and periodic publishes from the consumer loop.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <mccc/timer_wheel.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct TwTick {
+  uint32_t id;
+};
+
+struct TwFill {
+  uint32_t value;
+};
+
+/** Manually advanced clock: timers fall due without sleeping. */
+struct TwClock {
+  static uint64_t NowNs() noexcept { return now_ns; }
+  static uint64_t now_ns;
+};
+uint64_t TwClock::now_ns = 0U;
+
+constexpr uint64_t kMs = 1000000U;  // ns
+
+using TwPayload = std::variant<TwTick, TwFill>;
+using TwEnvelope = mccc::MessageEnvelope<TwPayload>;
+using TwBus = mccc::AsyncBus<TwPayload, 64U, TwClock>;
+using TwWheel = mccc::TimerWheel<TwPayload, TwBus, 8U, TwClock>;
+
+/** Bus + wheel (1 ms ticks) on the manual clock, recording TwTick ids and their dispatch time. */
+struct TwFixture {
+  TwFixture() {
+    TwClock::now_ns = 1000U * kMs;
+    bus = std::make_unique<TwBus>();
+    wheel = std::make_unique<TwWheel>(*bus);
+    bus->Subscribe<TwTick>([this](const TwEnvelope& env) {
+      ids.push_back(std::get<TwTick>(env.payload).id);
+      at_ms.push_back(TwClock::now_ns / kMs - 1000U);
+    });
+  }
+  /** Step the clock in 1 ms increments, running the consumer loop each time. */
+  void RunFor(uint64_t ms) {
+    for (uint64_t i = 0U; i < ms; ++i) {
+      TwClock::now_ns += kMs;
+      (void)wheel->ProcessBatch();
+    }
+  }
+  std::unique_ptr<TwBus> bus;
+  std::unique_ptr<TwWheel> wheel;
+  std::vector<uint32_t> ids;
+  std::vector<uint64_t> at_ms;
+};
+
+}  // namespace
+
+TEST_CASE("PublishAfter publishes once when the delay has elapsed", "[TimerWheel]") {
+  TwFixture f;
+  REQUIRE(f.wheel->NextDeadlineNs() == UINT64_MAX);
+  REQUIRE(f.wheel->PublishAfter(std::chrono::milliseconds(5), TwTick{1U}, 1U));
+  REQUIRE(f.wheel->PublishAfter(std::chrono::microseconds(2500), TwTick{2U}, 1U));  // rounded up to 3 ms
+  REQUIRE(f.wheel->PublishAfter(std::chrono::milliseconds(0), TwTick{3U}, 1U));     // next tick
+  REQUIRE(f.wheel->ActiveTimers() == 3U);
+  REQUIRE(f.wheel->NextDeadlineNs() == TwClock::now_ns + kMs);
+
+  REQUIRE(f.wheel->ProcessBatch() == 0U);  // nothing due at t = 0
+  f.RunFor(10U);
+  REQUIRE(f.ids == std::vector<uint32_t>{3U, 2U, 1U});
+  REQUIRE(f.at_ms == std::vector<uint64_t>{1U, 3U, 5U});
+  REQUIRE(f.wheel->ActiveTimers() == 0U);
+  REQUIRE(f.wheel->NextDeadlineNs() == UINT64_MAX);
+
+  const mccc::TimerStatistics stats = f.wheel->GetStatistics();
+  REQUIRE(stats.timers_scheduled == 3U);
+  REQUIRE(stats.messages_fired == 3U);
+
+  // A consumer that polls late still publishes the overdue timer
+  REQUIRE(f.wheel->PublishAfter(std::chrono::milliseconds(2), TwTick{4U}, 1U));
+  TwClock::now_ns += 50U * kMs;
+  REQUIRE(f.wheel->ProcessBatch() == 1U);
+  REQUIRE(f.ids.back() == 4U);
+}
+
+TEST_CASE("PublishEvery repeats until cancelled and skips missed periods", "[TimerWheel]") {
+  TwFixture f;
+  const mccc::TimerHandle beat = f.wheel->PublishEvery(std::chrono::milliseconds(10), TwTick{7U}, 2U);
+  REQUIRE(beat);
+  f.RunFor(35U);
+  REQUIRE(f.at_ms == std::vector<uint64_t>{10U, 20U, 30U});
+
+  // Consumer stalled for 45 ms: one message, then back on the 10 ms grid
+  TwClock::now_ns += 45U * kMs;  // t = 80
+  REQUIRE(f.wheel->ProcessBatch() == 1U);
+  f.RunFor(15U);  // t = 95
+  REQUIRE(f.at_ms == std::vector<uint64_t>{10U, 20U, 30U, 80U, 90U});
+
+  REQUIRE(f.wheel->Cancel(beat));
+  REQUIRE_FALSE(f.wheel->Cancel(beat));
+  f.RunFor(50U);
+  REQUIRE(f.ids.size() == 5U);
+  REQUIRE(f.wheel->ActiveTimers() == 0U);
+  REQUIRE(f.wheel->GetStatistics().timers_cancelled == 1U);
+}
+
+TEST_CASE("Cancelled and fired handles do not touch reused entries", "[TimerWheel]") {
+  TwFixture f;
+  std::vector<mccc::TimerHandle> handles;
+  for (uint32_t i = 0U; i < 8U; ++i) {
+    handles.push_back(f.wheel->PublishAfter(std::chrono::milliseconds(10U + i), TwTick{i}, 1U));
+    REQUIRE(handles.back());
+  }
+  REQUIRE_FALSE(f.wheel->PublishAfter(std::chrono::milliseconds(1), TwTick{99U}, 1U));  // pool of 8
+  REQUIRE(f.wheel->GetStatistics().pool_exhausted == 1U);
+
+  REQUIRE(f.wheel->Cancel(handles[0]));
+  REQUIRE(f.wheel->Cancel(handles[5]));
+  f.RunFor(20U);
+  REQUIRE(f.ids == std::vector<uint32_t>{1U, 2U, 3U, 4U, 6U, 7U});
+  REQUIRE_FALSE(f.wheel->Cancel(handles[1]));  // already fired
+  REQUIRE_FALSE(f.wheel->Cancel(mccc::TimerHandle{}));
+
+  // The entry of handles[0] is reused with a new generation
+  const mccc::TimerHandle reused = f.wheel->PublishAfter(std::chrono::milliseconds(5), TwTick{50U}, 1U);
+  REQUIRE(reused);
+  REQUIRE_FALSE(f.wheel->Cancel(handles[0]));
+  f.RunFor(5U);
+  REQUIRE(f.ids.back() == 50U);
+}
+
+TEST_CASE("Long delays cascade down the wheel levels", "[TimerWheel]") {
+  TwFixture f;
+  // Level 1, level 2, level 3 and beyond the 2^24-tick span
+  const std::vector<uint64_t> delays_ms{70U, 5000U, 300000U, (1ULL << 24U) + 100U};
+  for (uint32_t i = 0U; i < delays_ms.size(); ++i) {
+    REQUIRE(f.wheel->PublishAfter(std::chrono::milliseconds(delays_ms[i]), TwTick{i}, 1U));
+  }
+  const uint64_t start = TwClock::now_ns;
+  for (uint32_t i = 0U; i < delays_ms.size(); ++i) {
+    // Walk the clock to one tick before the deadline in large steps
+    while (TwClock::now_ns + 1000U * kMs < start + (delays_ms[i] - 1U) * kMs) {
+      TwClock::now_ns += 1000U * kMs;
+      (void)f.wheel->ProcessBatch();
+    }
+    TwClock::now_ns = start + (delays_ms[i] - 1U) * kMs;
+    (void)f.wheel->ProcessBatch();
+    REQUIRE(f.ids.size() == i);
+    TwClock::now_ns += kMs;
+    REQUIRE(f.wheel->ProcessBatch() == 1U);
+    REQUIRE(f.ids.back() == i);
+  }
+  REQUIRE(f.wheel->ActiveTimers() == 0U);
+}
+
+TEST_CASE("Messages the bus refuses are retried or dropped per timer kind", "[TimerWheel]") {
+  TwFixture f;
+  while (f.bus->PublishWithPriority(TwFill{0U}, 9U, mccc::MessagePriority::LOW)) {}
+  REQUIRE(f.wheel->PublishAfter(std::chrono::milliseconds(1), TwTick{1U}, 1U, mccc::MessagePriority::LOW));
+  REQUIRE(f.wheel->PublishEvery(std::chrono::milliseconds(1), TwTick{2U}, 1U, mccc::MessagePriority::LOW));
+
+  TwClock::now_ns += kMs;
+  REQUIRE(f.wheel->Advance() == 0U);
+  TwClock::now_ns += kMs;
+  REQUIRE(f.wheel->Advance() == 0U);
+  mccc::TimerStatistics stats = f.wheel->GetStatistics();
+  REQUIRE(stats.publish_retries == 2U);
+  REQUIRE(stats.periods_dropped == 2U);
+  REQUIRE(f.wheel->ActiveTimers() == 2U);
+
+  while (f.bus->ProcessBatch() > 0U) {}
+  TwClock::now_ns += kMs;
+  REQUIRE(f.wheel->ProcessBatch() == 2U);
+  REQUIRE(f.ids == std::vector<uint32_t>{1U, 2U});
+  REQUIRE(f.wheel->ActiveTimers() == 1U);  // the periodic timer
+}
+
+TEST_CASE("ProcessBatchWait wakes for timer deadlines", "[TimerWheel]") {
+  using RtBus = mccc::AsyncBus<TwPayload, 64U>;
+  auto bus = std::make_unique<RtBus>();
+  mccc::TimerWheel<TwPayload, RtBus> wheel(*bus);
+  std::atomic<uint32_t> ticks{0U};
+  bus->Subscribe<TwTick>([&ticks](const TwEnvelope&) { ticks.fetch_add(1U, std::memory_order_relaxed); });
+  (void)wheel.ProcessBatchWait(std::chrono::milliseconds(1));  // enable waiting
+
+  // Scheduled before parking: the park time is capped
+  REQUIRE(wheel.PublishAfter(std::chrono::milliseconds(20), TwTick{1U}, 1U));
+  auto start = std::chrono::steady_clock::now();
+  while ((ticks.load() == 0U) && (std::chrono::steady_clock::now() - start < std::chrono::seconds(5))) {
+    (void)wheel.ProcessBatchWait(std::chrono::seconds(5));
+  }
+  REQUIRE(ticks.load() == 1U);
+  REQUIRE(std::chrono::steady_clock::now() - start < std::chrono::seconds(2));
+
+  // Scheduled by another thread while the consumer is parked
+  std::thread scheduler([&wheel]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    (void)wheel.PublishAfter(std::chrono::milliseconds(5), TwTick{2U}, 1U);
+  });
+  start = std::chrono::steady_clock::now();
+  while ((ticks.load() == 1U) && (std::chrono::steady_clock::now() - start < std::chrono::seconds(5))) {
+    (void)wheel.ProcessBatchWait(std::chrono::seconds(5));
+  }
+  scheduler.join();
+  REQUIRE(ticks.load() == 2U);
+  REQUIRE(std::chrono::steady_clock::now() - start < std::chrono::seconds(2));
+}
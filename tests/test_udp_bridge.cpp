@@ -0,0 +1,181 @@
+/**
+ * @file test_udp_bridge.cpp
+ * @brief Unit tests for UdpBridge batching, framing and re-publish over loopback.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <mccc/udp_bridge.hpp>
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct NetImu {
+  uint32_t seq;
+  float accel[3];
+};
+struct NetCmd {
+  uint32_t code;
+};
+struct NetLog {
+  std::string text;  // not trivially copyable: never forwarded
+};
+
+using NetPayload = std::variant<NetImu, NetCmd, NetLog>;
+using NetBus = mccc::AsyncBus<NetPayload, 1024U>;
+using NetBridge = mccc::UdpBridge<NetPayload, NetBus>;
+
+/** Local bus + bridge on an ephemeral loopback port. */
+struct Node {
+  std::unique_ptr<NetBus> bus = std::make_unique<NetBus>();
+  std::shared_ptr<NetBridge> bridge = std::make_shared<NetBridge>(*bus);
+};
+
+void Connect(Node& from, Node& to, uint32_t deadline_us) {
+  mccc::UdpBridgeConfig rx;
+  rx.bind_address = "127.0.0.1";
+  REQUIRE(to.bridge->Open(rx));
+
+  mccc::UdpBridgeConfig tx;
+  tx.bind_address = "127.0.0.1";
+  tx.remote_address = "127.0.0.1";
+  tx.remote_port = to.bridge->LocalPort();
+  tx.flush_deadline_us = deadline_us;
+  REQUIRE(from.bridge->Open(tx));
+}
+
+/** Poll the receiver until count messages were re-published or 1 s elapsed. */
+uint32_t Drain(Node& node, uint32_t count) {
+  uint32_t received = 0U;
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+  while ((received < count) && (std::chrono::steady_clock::now() < deadline)) {
+    received += node.bridge->Poll();
+    std::this_thread::yield();
+  }
+  return received;
+}
+
+}  // namespace
+
+TEST_CASE("Records are coalesced into MTU-sized datagrams", "[UdpBridge]") {
+  Node a;
+  Node b;
+  Connect(a, b, 1000000U);
+  REQUIRE(a.bridge->Forward<NetImu>());
+
+  std::vector<uint32_t> seqs;
+  b.bus->Subscribe<NetImu>([&seqs](const NetBus::EnvelopeType& env) {
+    seqs.push_back(std::get<NetImu>(env.payload).seq);
+    REQUIRE(env.header.sender_id == 5U);
+    REQUIRE(env.header.priority == mccc::MessagePriority::HIGH);
+  });
+
+  constexpr uint32_t kCount = 500U;
+  for (uint32_t i = 0U; i < kCount; ++i) {
+    REQUIRE(a.bus->PublishWithPriority(NetImu{i, {0.0f, 0.0f, 1.0f}}, 5U, mccc::MessagePriority::HIGH));
+  }
+  while (a.bus->ProcessBatch() > 0U) {}
+  a.bridge->Flush();
+
+  constexpr uint32_t kRecord = sizeof(mccc::BridgeRecordHeader) + sizeof(NetImu);
+  constexpr uint32_t kPerDatagram = (1472U - sizeof(mccc::BridgeFrameHeader)) / kRecord;
+  const mccc::BridgeStatistics& tx = a.bridge->GetStatistics();
+  REQUIRE(tx.messages_forwarded == kCount);
+  REQUIRE(tx.datagrams_sent == (kCount + kPerDatagram - 1U) / kPerDatagram);
+  REQUIRE(tx.send_syscalls < tx.datagrams_sent);  // sendmmsg batches datagrams
+  REQUIRE(tx.send_errors == 0U);
+
+  REQUIRE(Drain(b, kCount) == kCount);
+  while (b.bus->ProcessBatch() > 0U) {}
+  REQUIRE(seqs.size() == kCount);
+  for (uint32_t i = 0U; i < kCount; ++i) {
+    REQUIRE(seqs[i] == i);
+  }
+  REQUIRE(b.bridge->GetStatistics().datagrams_received == tx.datagrams_sent);
+}
+
+TEST_CASE("Poll sends a partial batch after the flush deadline", "[UdpBridge]") {
+  Node a;
+  Node b;
+  Connect(a, b, 2000U);
+  REQUIRE(a.bridge->Forward<NetCmd>());
+
+  REQUIRE(a.bus->Publish(NetCmd{7U}, 1U));
+  REQUIRE(a.bus->ProcessBatch() == 1U);
+  a.bridge->Poll();
+  REQUIRE(a.bridge->GetStatistics().datagrams_sent == 0U);  // still within the deadline
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  a.bridge->Poll();
+  REQUIRE(a.bridge->GetStatistics().datagrams_sent == 1U);
+  REQUIRE(Drain(b, 1U) == 1U);
+}
+
+TEST_CASE("Forward honours the subscription filter and message types", "[UdpBridge]") {
+  Node a;
+  Node b;
+  Connect(a, b, 0U);
+  REQUIRE(a.bridge->Forward<NetCmd>(mccc::SubscriptionFilter::SenderRange(0U, 9U)));
+
+  std::vector<uint32_t> senders;
+  b.bus->Subscribe<NetCmd>([&senders](const NetBus::EnvelopeType& env) { senders.push_back(env.header.sender_id); });
+
+  REQUIRE(a.bus->Publish(NetCmd{1U}, 3U));
+  REQUIRE(a.bus->Publish(NetCmd{2U}, 42U));     // remote sender range: not forwarded
+  REQUIRE(a.bus->Publish(NetImu{0U, {}}, 3U));  // type not forwarded
+  REQUIRE(a.bus->Publish(NetCmd{3U}, 4U));
+  REQUIRE(a.bus->ProcessBatch() == 4U);
+  a.bridge->Flush();
+
+  REQUIRE(Drain(b, 2U) == 2U);
+  while (b.bus->ProcessBatch() > 0U) {}
+  REQUIRE(senders == std::vector<uint32_t>{3U, 4U});
+  REQUIRE(a.bridge->GetStatistics().messages_forwarded == 2U);
+}
+
+TEST_CASE("Datagrams from a different build are rejected", "[UdpBridge]") {
+  using OtherPayload = std::variant<NetCmd, NetImu>;
+  using OtherBus = mccc::AsyncBus<OtherPayload, 1024U>;
+  auto other_bus = std::make_unique<OtherBus>();
+  auto sender = std::make_shared<mccc::UdpBridge<OtherPayload, OtherBus>>(*other_bus);
+
+  Node b;
+  mccc::UdpBridgeConfig rx;
+  rx.bind_address = "127.0.0.1";
+  REQUIRE(b.bridge->Open(rx));
+  mccc::UdpBridgeConfig tx;
+  tx.bind_address = "127.0.0.1";
+  tx.remote_address = "127.0.0.1";
+  tx.remote_port = b.bridge->LocalPort();
+  REQUIRE(sender->Open(tx));
+  REQUIRE(sender->Forward<NetCmd>());
+
+  REQUIRE(other_bus->Publish(NetCmd{1U}, 1U));
+  REQUIRE(other_bus->ProcessBatch() == 1U);
+  REQUIRE(sender->Flush() == 1U);
+
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+  while ((b.bridge->GetStatistics().datagrams_received == 0U) && (std::chrono::steady_clock::now() < deadline)) {
+    REQUIRE(b.bridge->Poll() == 0U);
+  }
+  REQUIRE(b.bridge->GetStatistics().decode_errors == 1U);
+  REQUIRE(b.bus->QueueDepth() == 0U);
+}
+
+TEST_CASE("Open rejects bad addresses", "[UdpBridge]") {
+  Node a;
+  mccc::UdpBridgeConfig cfg;
+  cfg.bind_address = "not-an-ip";
+  REQUIRE_FALSE(a.bridge->Open(cfg));
+  cfg.bind_address = "127.0.0.1";
+  cfg.remote_address = "300.1.1.1";
+  REQUIRE_FALSE(a.bridge->Open(cfg));
+  cfg.remote_address = nullptr;
+  REQUIRE(a.bridge->Open(cfg));
+  REQUIRE(a.bridge->LocalPort() != 0U);
+  REQUIRE_FALSE(a.bridge->Open(cfg));  // already open
+}
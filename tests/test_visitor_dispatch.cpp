@@ -130,3 +130,47 @@ TEST_CASE("ProcessBatchWith throughput vs ProcessBatch", "[Visitor][benchmark]")
   REQUIRE(visitor_count.load() == published1);
   REQUIRE(callback_count.load() == published2);
 }
+
+namespace {
+
+struct ThrowOnMove {
+  ThrowOnMove() = default;
+  ThrowOnMove(const ThrowOnMove&) = default;
+  ThrowOnMove(ThrowOnMove&&) { throw 1; }  // NOLINT(performance-noexcept-move-constructor)
+  ThrowOnMove& operator=(const ThrowOnMove&) = default;
+  ThrowOnMove& operator=(ThrowOnMove&&) = default;
+};
+
+}  // namespace
+
+TEST_CASE("VisitByIndex selects the active alternative", "[Visitor]") {
+  TestPayload payload = MsgB{2.5f};
+  int hits = 0;
+  auto on_b = [&hits](MsgB& m) {
+    hits += 10;
+    m.data = 4.0f;  // non-const payload reaches the visitor by reference
+  };
+  auto visitor = mccc::make_overloaded([&hits](MsgA&) { hits += 1; }, on_b, [&hits](MsgC&) { hits += 100; });
+
+  mccc::detail::VisitByIndex(visitor, payload);
+  REQUIRE(hits == 10);
+  REQUIRE(std::get<MsgB>(payload).data == 4.0f);
+
+  payload = MsgC{7U};
+  mccc::detail::VisitByIndex(visitor, payload);
+  REQUIRE(hits == 110);
+}
+
+TEST_CASE("VisitByIndex skips a valueless variant", "[Visitor]") {
+  std::variant<MsgA, ThrowOnMove> payload = MsgA{1};
+  try {
+    payload.emplace<ThrowOnMove>(ThrowOnMove{});
+  } catch (int) {
+  }
+  REQUIRE(payload.valueless_by_exception());
+
+  int hits = 0;
+  auto visitor = [&hits](const auto&) { ++hits; };
+  mccc::detail::VisitByIndex(visitor, payload);
+  REQUIRE(hits == 0);
+}